@@ -0,0 +1,112 @@
+// Apps/IDE/Benchmarks/Baseline/UCGDBMIParserBaseline.h
+// GDB/MI parser as it was before the arena parser, for benchmarking
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework / ULTRA IDE
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <cstdint>
+
+namespace UltraCanvas {
+namespace IDE {
+
+/**
+ * @brief The std::map based parser the arena parser replaced
+ *
+ * Kept only so bench_gdbmi_parser can compare against it. The one change
+ * from the original: ParseList does not take a '{', '[' or '"' for the
+ * start of a key, which made lists of tuples loop until memory ran out.
+ */
+namespace Baseline {
+
+// GDB/MI Value (string, list, or tuple)
+struct GDBMIValue;
+using GDBMIList = std::vector<GDBMIValue>;
+using GDBMITuple = std::map<std::string, GDBMIValue>;
+
+struct GDBMIValue {
+    enum class Type { String, List, Tuple };
+    Type type = Type::String;
+    std::string stringValue;
+    GDBMIList listValue;
+    GDBMITuple tupleValue;
+    
+    GDBMIValue() = default;
+    explicit GDBMIValue(const std::string& s) : type(Type::String), stringValue(s) {}
+    
+    bool IsString() const { return type == Type::String; }
+    bool IsList() const { return type == Type::List; }
+    bool IsTuple() const { return type == Type::Tuple; }
+    
+    std::string GetString(const std::string& key, const std::string& def = "") const;
+    int GetInt(const std::string& key, int def = 0) const;
+    uint64_t GetUInt64(const std::string& key, uint64_t def = 0) const;
+    const GDBMIValue* Get(const std::string& key) const;
+    bool Has(const std::string& key) const;
+};
+
+// GDB/MI Record Types
+enum class GDBMIRecordType {
+    Result, AsyncExec, AsyncStatus, AsyncNotify,
+    ConsoleStream, TargetStream, LogStream, Prompt
+};
+
+enum class GDBMIResultClass { Done, Running, Connected, Error, Exit };
+
+enum class GDBMIAsyncClass {
+    Stopped, Running, ThreadGroupAdded, ThreadGroupStarted, ThreadGroupExited,
+    ThreadCreated, ThreadExited, LibraryLoaded, LibraryUnloaded,
+    BreakpointCreated, BreakpointModified, BreakpointDeleted, Other
+};
+
+// Parsed GDB/MI Record
+struct GDBMIRecord {
+    GDBMIRecordType type = GDBMIRecordType::Prompt;
+    int token = -1;
+    GDBMIResultClass resultClass = GDBMIResultClass::Done;
+    GDBMIAsyncClass asyncClass = GDBMIAsyncClass::Other;
+    std::string asyncClassName;
+    std::string streamContent;
+    GDBMITuple results;
+    std::string rawLine;
+    
+    bool IsResult() const { return type == GDBMIRecordType::Result; }
+    bool IsAsync() const;
+    bool IsStream() const;
+    bool IsSuccess() const { return IsResult() && resultClass == GDBMIResultClass::Done; }
+    bool IsError() const { return IsResult() && resultClass == GDBMIResultClass::Error; }
+    std::string GetError() const;
+};
+
+// GDB/MI Parser
+class UCGDBMIParser {
+public:
+    UCGDBMIParser();
+    ~UCGDBMIParser();
+    
+    GDBMIRecord ParseLine(const std::string& line);
+    std::vector<GDBMIRecord> ParseOutput(const std::string& output);
+    
+    static std::string Escape(const std::string& str);
+    static std::string Unescape(const std::string& str);
+    
+private:
+    GDBMIValue ParseValue(const std::string& str, size_t& pos);
+    GDBMITuple ParseTuple(const std::string& str, size_t& pos);
+    GDBMIList ParseList(const std::string& str, size_t& pos);
+    std::string ParseString(const std::string& str, size_t& pos);
+    std::string ParseCString(const std::string& str, size_t& pos);
+    
+    GDBMIResultClass ParseResultClass(const std::string& cls);
+    GDBMIAsyncClass ParseAsyncClass(const std::string& cls);
+    
+    void SkipWhitespace(const std::string& str, size_t& pos);
+};
+
+} // namespace Baseline
+} // namespace IDE
+} // namespace UltraCanvas
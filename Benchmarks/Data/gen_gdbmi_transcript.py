@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+# Apps/IDE/Benchmarks/Data/gen_gdbmi_transcript.py
+# GDB/MI transcript generator for bench_gdbmi_parser
+# Version: 1.0.0
+# Last Modified: 2026-10-18
+# Author: UltraCanvas Framework / ULTRA IDE
+#
+# Usage: gen_gdbmi_transcript.py OUTPUT
+#
+# Writes GDB output shaped like a session on a program with large STL
+# containers. It has 40 stops, each with *stopped, a 120-frame stack,
+# -stack-list-variables with pretty-printed vectors and maps, 16 threads
+# and 80 registers. It also has one 4000-instruction -data-disassemble.
+# The output is fixed by the seed: 7,421,642 bytes, 244 lines.
+import random
+import sys
+
+
+def escape(text):
+    return text.replace('\\', '\\\\').replace('"', '\\"').replace('\n', '\\n')
+
+
+def frame(level):
+    return ('{level="%d",addr="0x%016x",'
+            'func="ns::Component<std::map<std::string, int> >::update",'
+            'file="component.h",fullname="/home/user/src/engine/component.h",'
+            'line="%d",arch="i386:x86-64"}' % (level, 0x555555554000 + level * 97, 100 + level))
+
+
+def variable(index):
+    kind = index % 4
+    if kind == 0:
+        value = ('std::vector of length 2000, capacity 2048 = {' +
+                 ', '.join(str(random.randint(0, 99999)) for _ in range(200)) + '...}')
+    elif kind == 1:
+        value = ('std::map with 300 elements = {' +
+                 ', '.join('["key%d"] = {name = "item %d", weight = %d.5}' % (i, i, i)
+                           for i in range(150)) + '...}')
+    elif kind == 2:
+        value = '"hello \\\\ world\\n"'
+    else:
+        value = '{x = %d, y = %d, next = 0x%x}' % (index, index * 2, 0x600000 + index)
+    return ('{name="var%d",arg="%d",type="std::vector<int>",value="%s"}'
+            % (index, index % 2, escape(value)))
+
+
+def thread(number):
+    return ('{id="%d",target-id="Thread 0x7ffff7d8a740 (LWP %d)",name="worker",'
+            'frame=%s,state="stopped",core="%d"}' % (number, 4000 + number, frame(0), number % 8))
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit('usage: gen_gdbmi_transcript.py OUTPUT')
+    random.seed(7)
+    lines = []
+    token = 100
+    for stop in range(40):
+        lines.append('*stopped,reason="breakpoint-hit",disp="keep",bkptno="1",'
+                     'frame={addr="0x0000555555555149",func="main",'
+                     'args=[{name="argc",value="1"},{name="argv",value="0x7fffffffe4b8"}],'
+                     'file="main.cpp",fullname="/home/user/src/main.cpp",line="%d",'
+                     'arch="i386:x86-64"},thread-id="1",stopped-threads="all",core="3"' % (10 + stop))
+        lines.append('~"Breakpoint 1, main (argc=1, argv=0x7fffffffe4b8) at main.cpp:12\\n"')
+        token += 1
+        lines.append('%d^done,stack=[%s]' % (token, ','.join('frame=' + frame(i) for i in range(120))))
+        token += 1
+        lines.append('%d^done,variables=[%s]' % (token, ','.join(variable(i) for i in range(60))))
+        token += 1
+        lines.append('%d^done,threads=[%s],current-thread-id="1"'
+                     % (token, ','.join(thread(t) for t in range(1, 17))))
+        token += 1
+        lines.append('%d^done,register-values=[%s]'
+                     % (token, ','.join('{number="%d",value="0x%x"}' % (r, random.getrandbits(64))
+                                        for r in range(80))))
+    token += 1
+    lines.append('%d^done,asm_insns=[%s]'
+                 % (token, ','.join('{address="0x%016x",func-name="ns::Component::update",'
+                                    'offset="%d",inst="mov    0x%x(%%rbp),%%rax"}'
+                                    % (0x555555555000 + i * 4, i * 4, i % 256) for i in range(4000))))
+    lines.append('=library-loaded,id="/lib/x86_64-linux-gnu/libc.so.6",'
+                 'target-name="/lib/x86_64-linux-gnu/libc.so.6",'
+                 'host-name="/lib/x86_64-linux-gnu/libc.so.6",symbols-loaded="0",thread-group="i1",'
+                 'ranges=[{from="0x00007ffff7c28800",to="0x00007ffff7dbd93d"}]')
+    lines.append('^error,msg="No symbol \\"foo\\" in current context."')
+    lines.append('(gdb)')
+
+    with open(sys.argv[1], 'w') as out:
+        out.write('\n'.join(lines) + '\n')
+    print(sum(len(line) + 1 for line in lines), 'bytes', len(lines), 'lines')
+
+
+if __name__ == '__main__':
+    main()
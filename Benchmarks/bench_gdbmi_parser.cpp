@@ -0,0 +1,227 @@
+// Apps/IDE/Benchmarks/bench_gdbmi_parser.cpp
+// GDB/MI parser: replay a transcript through the arena parser and the old one
+// Version: 1.0.0
+// Last Modified: 2026-10-18
+// Author: UltraCanvas Framework / ULTRA IDE
+//
+// Usage: bench_gdbmi_parser TRANSCRIPT
+//
+// TRANSCRIPT holds raw GDB/MI output, one record per line: a session
+// recorded with `gdb --interpreter=mi2 ... | tee session.mi`, or the
+// synthetic one written by Data/gen_gdbmi_transcript.py.
+//
+// Every line is parsed by both parsers first and the trees are compared
+// (tuple members sorted, since the old parser kept them in a std::map).
+// Then each parser replays the whole transcript, best of 5, counting heap
+// allocations through a replaced operator new:
+// - parse only
+// - parse and read every string, as the plugin does when converting
+// - the largest -stack-list-variables record on its own
+
+#include "Debug/Core/UCGDBMIParser.h"
+#include "Benchmarks/Baseline/UCGDBMIParserBaseline.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace UltraCanvas::IDE;
+
+// ============================================================================
+// ALLOCATION COUNTING
+// ============================================================================
+
+namespace {
+std::atomic<size_t> allocationCount{0};
+std::atomic<size_t> allocatedBytes{0};
+}
+
+void* operator new(size_t size) {
+    allocationCount++;
+    allocatedBytes += size;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+namespace {
+
+// ============================================================================
+// TREE DUMPS (for the comparison)
+// ============================================================================
+
+std::string DumpBaseline(const Baseline::GDBMIValue& value);
+
+std::string DumpBaselineTuple(const Baseline::GDBMITuple& tuple) {
+    std::string text = "{";
+    for (const auto& [key, member] : tuple) text += key + "=" + DumpBaseline(member) + ",";
+    return text + "}";
+}
+
+std::string DumpBaseline(const Baseline::GDBMIValue& value) {
+    if (value.IsString()) return '"' + value.stringValue + '"';
+    if (value.IsTuple()) return DumpBaselineTuple(value.tupleValue);
+    std::string text = "[";
+    for (const auto& element : value.listValue) text += DumpBaseline(element) + ",";
+    return text + "]";
+}
+
+std::string Dump(const GDBMIValue& value) {
+    if (value.IsString()) return '"' + std::string(value.AsString()) + '"';
+    if (value.IsTuple()) {
+        std::vector<std::pair<std::string, std::string>> members;
+        for (size_t i = 0; i < value.Size(); i++) {
+            members.emplace_back(std::string(value.KeyAt(i)), Dump(value.At(i)));
+        }
+        std::sort(members.begin(), members.end());
+        std::string text = "{";
+        for (const auto& [key, member] : members) text += key + "=" + member + ",";
+        return text + "}";
+    }
+    if (value.IsList()) {
+        std::string text = "[";
+        for (GDBMIValue element : value) text += Dump(element) + ",";
+        return text + "]";
+    }
+    return "{}";
+}
+
+bool SameRecord(const Baseline::GDBMIRecord& a, const GDBMIRecord& b, const std::string& line) {
+    return DumpBaselineTuple(a.results) == Dump(b.results) &&
+           static_cast<int>(a.type) == static_cast<int>(b.type) && a.token == b.token &&
+           a.streamContent == b.streamContent && a.asyncClassName == b.asyncClassName &&
+           static_cast<int>(a.resultClass) == static_cast<int>(b.resultClass) &&
+           static_cast<int>(a.asyncClass) == static_cast<int>(b.asyncClass) &&
+           (b.GetRawLine() == line || line == "(gdb)");
+}
+
+// ============================================================================
+// WALKS (read every string once)
+// ============================================================================
+
+size_t WalkBaseline(const Baseline::GDBMIValue& value) {
+    if (value.IsString()) return value.stringValue.size();
+    size_t length = 0;
+    if (value.IsTuple()) {
+        for (const auto& [key, member] : value.tupleValue) length += WalkBaseline(member);
+    } else {
+        for (const auto& element : value.listValue) length += WalkBaseline(element);
+    }
+    return length;
+}
+
+size_t Walk(const GDBMIValue& value) {
+    if (value.IsString()) return value.AsString().size();
+    size_t length = 0;
+    for (GDBMIValue child : value) length += Walk(child);
+    return length;
+}
+
+// ============================================================================
+// TIMING
+// ============================================================================
+
+template <typename Body>
+void Measure(const char* name, size_t bytes, Body&& body) {
+    const int rounds = 5;
+    double best = 1e30;
+    size_t allocations = 0;
+    size_t allocated = 0;
+    size_t sink = 0;
+    for (int round = 0; round < rounds; round++) {
+        size_t countBefore = allocationCount;
+        size_t bytesBefore = allocatedBytes;
+        auto start = std::chrono::steady_clock::now();
+        sink += body();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        best = std::min(best, ms);
+        allocations = allocationCount - countBefore;
+        allocated = allocatedBytes - bytesBefore;
+    }
+    printf("%-18s %9.3f ms %8.1f MB/s %10zu allocations %8.1f MB allocated (%zu)\n",
+           name, best, bytes / 1e3 / best, allocations, allocated / 1e6, sink % 7);
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: bench_gdbmi_parser TRANSCRIPT\n");
+        return 2;
+    }
+    std::ifstream in(argv[1]);
+    if (!in) {
+        fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 2;
+    }
+    std::vector<std::string> lines;
+    size_t bytes = 0;
+    for (std::string line; std::getline(in, line); ) {
+        bytes += line.size() + 1;
+        lines.push_back(std::move(line));
+    }
+
+    Baseline::UCGDBMIParser baseline;
+    UCGDBMIParser parser;
+
+    size_t mismatches = 0;
+    for (const auto& line : lines) {
+        if (!SameRecord(baseline.ParseLine(line), parser.ParseLine(line), line)) {
+            if (mismatches++ < 3) printf("MISMATCH %.120s\n", line.c_str());
+        }
+    }
+    printf("%zu lines, %zu bytes, %zu mismatches\n", lines.size(), bytes, mismatches);
+    printf("node %zu bytes, old value %zu bytes\n", sizeof(GDBMINode), sizeof(Baseline::GDBMIValue));
+
+    Measure("old parse", bytes, [&] {
+        size_t n = 0;
+        for (const auto& line : lines) n += baseline.ParseLine(line).results.size();
+        return n;
+    });
+    Measure("new parse", bytes, [&] {
+        size_t n = 0;
+        for (const auto& line : lines) n += parser.ParseLine(line).results.Size();
+        return n;
+    });
+    Measure("old parse+walk", bytes, [&] {
+        size_t n = 0;
+        for (const auto& line : lines) {
+            for (const auto& [key, value] : baseline.ParseLine(line).results) n += WalkBaseline(value);
+        }
+        return n;
+    });
+    Measure("new parse+walk", bytes, [&] {
+        size_t n = 0;
+        for (const auto& line : lines) n += Walk(parser.ParseLine(line).results);
+        return n;
+    });
+
+    auto largest = lines.end();
+    for (auto it = lines.begin(); it != lines.end(); ++it) {
+        if (it->find("^done,variables=") != std::string::npos &&
+            (largest == lines.end() || it->size() > largest->size())) {
+            largest = it;
+        }
+    }
+    if (largest != lines.end()) {
+        const std::string& record = *largest;
+        printf("largest -stack-list-variables record: %zu bytes\n", record.size());
+        Measure("old variables", record.size(), [&] {
+            size_t n = 0;
+            for (const auto& [key, value] : baseline.ParseLine(record).results) n += WalkBaseline(value);
+            return n;
+        });
+        Measure("new variables", record.size(), [&] {
+            return Walk(parser.ParseLine(record).results);
+        });
+    }
+
+    return mismatches == 0 ? 0 : 1;
+}
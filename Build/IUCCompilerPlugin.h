@@ -12,6 +12,8 @@
 #include <functional>
 #include <atomic>
 #include <mutex>
+#include <string_view>
+#include <cstdint>
 
 namespace UltraCanvas {
 namespace IDE {
@@ -133,7 +135,7 @@ inline ProjectFileType DetectProjectFileType(const std::string& filePath) {
     if (fileName == "CMakeLists.txt") return ProjectFileType::CMakeFile;
     if (fileName == "Makefile" || fileName == "makefile") return ProjectFileType::Makefile;
     
-    if (dotPos == std::string::npos || dotPos < slashPos) {
+    if (dotPos == std::string::npos || (slashPos != std::string::npos && dotPos < slashPos)) {
         return ProjectFileType::Unknown;
     }
     
@@ -494,22 +496,44 @@ struct BuildResult {
 // PROJECT FILE STRUCTURE
 // ============================================================================
 
+class ProjectPathArena;                 // Project/UCIDEPathArena.h
+
 /**
  * @brief Represents a single file in the project
+ *
+ * Paths are not stored per file: the file references its directory and
+ * interned name in the project's ProjectPathArena, which must outlive it
+ * (the arena is owned by the UCIDEProject that scanned the tree). The
+ * path accessors are implemented with the arena, in UCIDEPathArena.cpp.
  */
 struct ProjectFile {
-    std::string absolutePath;           // Full absolute path
-    std::string relativePath;           // Path relative to project root
-    std::string fileName;               // File name only (no path)
+    const ProjectPathArena* paths = nullptr;    // Owning project's path arena
+    uint32_t directoryId = 0;           // Containing directory in paths
+    uint32_t nameId = 0;                // Interned file name in paths
     ProjectFileType type = ProjectFileType::Unknown;
     bool isOpen = false;                // Currently open in editor
     bool isModified = false;            // Has unsaved changes
     
     /**
-     * @brief Detect type from path
+     * @brief File name only (no path)
+     */
+    std::string_view GetFileName() const;
+    
+    /**
+     * @brief Path relative to project root
+     */
+    std::string GetRelativePath() const;
+    
+    /**
+     * @brief Full absolute path
+     */
+    std::string GetAbsolutePath() const;
+    
+    /**
+     * @brief Detect type from file name
      */
     void DetectType() {
-        type = DetectProjectFileType(absolutePath);
+        type = DetectProjectFileType(std::string(GetFileName()));
     }
     
     /**
@@ -528,13 +552,27 @@ struct ProjectFile {
  * @brief Represents a folder in the project hierarchy
  */
 struct ProjectFolder {
-    std::string name;                   // Folder name
-    std::string absolutePath;           // Full absolute path
-    std::string relativePath;           // Path relative to project root
+    const ProjectPathArena* paths = nullptr;    // Owning project's path arena
+    uint32_t directoryId = 0;           // ProjectPathArena::ROOT_DIRECTORY
     std::vector<ProjectFile> files;     // Files in this folder
     std::vector<ProjectFolder> subfolders;  // Subfolders
     bool isExpanded = true;             // UI expansion state
     
+    /**
+     * @brief Folder name
+     */
+    std::string_view GetName() const;
+    
+    /**
+     * @brief Path relative to project root ("" for the root folder)
+     */
+    std::string GetRelativePath() const;
+    
+    /**
+     * @brief Full absolute path
+     */
+    std::string GetAbsolutePath() const;
+    
     /**
      * @brief Get total file count (recursive)
      */
@@ -132,7 +132,7 @@ void UCBuildManager::BuildProject(std::shared_ptr<UCIDEProject> project) {
     // Get all source files
     auto sourceFiles = project->GetSourceFiles();
     for (const auto* file : sourceFiles) {
-        item.job.sourceFiles.push_back(file->absolutePath);
+        item.job.sourceFiles.push_back(file->GetAbsolutePath());
     }
     
     QueueBuild(item);
@@ -166,7 +166,7 @@ void UCBuildManager::RebuildProject(std::shared_ptr<UCIDEProject> project) {
     
     auto sourceFiles = project->GetSourceFiles();
     for (const auto* file : sourceFiles) {
-        item.job.sourceFiles.push_back(file->absolutePath);
+        item.job.sourceFiles.push_back(file->GetAbsolutePath());
     }
     
     QueueBuild(item);
@@ -48,10 +48,18 @@ UCDebugManager& UCDebugManager::Instance() {
     return instance;
 }
 
+std::unique_ptr<UCDebugManager> UCDebugManager::CreateIsolated() {
+    return std::unique_ptr<UCDebugManager>(new UCDebugManager(true));
+}
+
 UCDebugManager::UCDebugManager() 
     : config_(DebugManagerConfig::Default()) {
 }
 
+UCDebugManager::UCDebugManager(bool ownsPlugins)
+    : ownsPlugins_(ownsPlugins), config_(DebugManagerConfig::Default()) {
+}
+
 UCDebugManager::~UCDebugManager() {
     Shutdown();
 }
@@ -71,8 +79,10 @@ bool UCDebugManager::Initialize(const DebugManagerConfig& config) {
     
     config_ = config;
     
-    // Register built-in plugins
-    RegisterBuiltInDebuggerPlugins();
+    // Register built-in plugins; isolated managers only need them once
+    if (!ownsPlugins_ || UCDebuggerPluginRegistry::Instance().GetPluginCount() == 0) {
+        RegisterBuiltInDebuggerPlugins();
+    }
     
     std::cout << "[DebugManager] Initialized with "
               << UCDebuggerPluginRegistry::Instance().GetPluginCount()
@@ -92,7 +102,7 @@ void UCDebugManager::Shutdown() {
         activeDebugger_->Terminate();
     }
     
-    activeDebugger_.reset();
+    SetActiveDebugger(nullptr);
     currentProject_.reset();
     
     initialized_ = false;
@@ -120,10 +130,10 @@ bool UCDebugManager::StartDebugging(const DebugLaunchConfig& config) {
     // Select debugger
     if (!activeDebugger_) {
         if (config.debuggerType != DebuggerType::UnknownDebugger) {
-            activeDebugger_ = UCDebuggerPluginRegistry::Instance().GetPlugin(config.debuggerType);
+            SetActiveDebugger(FindDebugger(config.debuggerType));
         }
         if (!activeDebugger_) {
-            activeDebugger_ = UCDebuggerPluginRegistry::Instance().GetBestDebugger();
+            SetActiveDebugger(FindBestDebugger());
         }
     }
     
@@ -174,7 +184,7 @@ bool UCDebugManager::AttachToProcess(int pid) {
     std::lock_guard<std::mutex> lock(mutex_);
     
     if (!initialized_ || !activeDebugger_) {
-        activeDebugger_ = UCDebuggerPluginRegistry::Instance().GetBestDebugger();
+        SetActiveDebugger(FindBestDebugger());
     }
     
     if (!activeDebugger_ || !activeDebugger_->IsAvailable()) {
@@ -191,7 +201,7 @@ bool UCDebugManager::AttachToProcess(const std::string& processName) {
     std::lock_guard<std::mutex> lock(mutex_);
     
     if (!initialized_ || !activeDebugger_) {
-        activeDebugger_ = UCDebuggerPluginRegistry::Instance().GetBestDebugger();
+        SetActiveDebugger(FindBestDebugger());
     }
     
     if (!activeDebugger_ || !activeDebugger_->IsAvailable()) {
@@ -208,7 +218,7 @@ bool UCDebugManager::LoadCoreDump(const std::string& corePath, const std::string
     std::lock_guard<std::mutex> lock(mutex_);
     
     if (!initialized_ || !activeDebugger_) {
-        activeDebugger_ = UCDebuggerPluginRegistry::Instance().GetBestDebugger();
+        SetActiveDebugger(FindBestDebugger());
     }
     
     if (!activeDebugger_ || !activeDebugger_->IsAvailable()) {
@@ -230,6 +240,7 @@ bool UCDebugManager::StopDebugging() {
     
     std::cout << "[DebugManager] Stopping debug session" << std::endl;
     
+    DropStopSnapshot();
     bool result = activeDebugger_->Terminate();
     
     // Clear debugger IDs from breakpoints
@@ -252,6 +263,7 @@ bool UCDebugManager::Detach() {
     
     if (!activeDebugger_) return true;
     
+    DropStopSnapshot();
     bool result = activeDebugger_->Detach();
     breakpointManager_.ClearDebuggerIds();
     
@@ -276,48 +288,57 @@ DebugSessionState UCDebugManager::GetSessionState() const {
 bool UCDebugManager::Continue() {
     std::lock_guard<std::mutex> lock(mutex_);
     if (!activeDebugger_) return false;
+    DropStopSnapshot();
     return activeDebugger_->Continue();
 }
 
 bool UCDebugManager::Pause() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!activeDebugger_) return false;
-    return activeDebugger_->Pause();
+    // Not under mutex_: a pause must get through while another caller
+    // waits on a slow command
+    std::shared_ptr<IUCDebuggerPlugin> debugger = GetActiveDebugger();
+    if (!debugger) return false;
+    return debugger->Pause();
 }
 
 bool UCDebugManager::StepOver() {
     std::lock_guard<std::mutex> lock(mutex_);
     if (!activeDebugger_) return false;
+    DropStopSnapshot();
     return activeDebugger_->StepOver();
 }
 
 bool UCDebugManager::StepInto() {
     std::lock_guard<std::mutex> lock(mutex_);
     if (!activeDebugger_) return false;
+    DropStopSnapshot();
     return activeDebugger_->StepInto();
 }
 
 bool UCDebugManager::StepOut() {
     std::lock_guard<std::mutex> lock(mutex_);
     if (!activeDebugger_) return false;
+    DropStopSnapshot();
     return activeDebugger_->StepOut();
 }
 
 bool UCDebugManager::StepInstruction() {
     std::lock_guard<std::mutex> lock(mutex_);
     if (!activeDebugger_) return false;
+    DropStopSnapshot();
     return activeDebugger_->StepInstruction();
 }
 
 bool UCDebugManager::RunToCursor(const std::string& file, int line) {
     std::lock_guard<std::mutex> lock(mutex_);
     if (!activeDebugger_) return false;
+    DropStopSnapshot();
     return activeDebugger_->RunToCursor(file, line);
 }
 
 bool UCDebugManager::SetNextStatement(const std::string& file, int line) {
     std::lock_guard<std::mutex> lock(mutex_);
     if (!activeDebugger_) return false;
+    DropStopSnapshot();
     return activeDebugger_->SetNextStatement(file, line);
 }
 
@@ -473,7 +494,7 @@ int UCDebugManager::AddWatch(const std::string& expression) {
     int id = watchManager_.AddWatch(expression);
     
     if (IsDebugging()) {
-        watchManager_.RefreshWatch(id, activeDebugger_.get());
+        RefreshWatches();
     }
     
     return id;
@@ -484,8 +505,40 @@ bool UCDebugManager::RemoveWatch(int id) {
 }
 
 void UCDebugManager::RefreshWatches() {
-    if (IsDebugging()) {
-        watchManager_.RefreshAll(activeDebugger_.get());
+    // Not IsDebugging(): this runs from the stop handler, which must not
+    // wait for mutex_
+    std::shared_ptr<IUCDebuggerPlugin> debugger = GetActiveDebugger();
+    if (!debugger || !debugger->IsSessionActive()) return;
+    
+    uint64_t generation = stopGeneration_;
+    for (const WatchEntry& watch : watchManager_.GetAllWatches()) {
+        EvaluationResult result;
+        bool cached = false;
+        {
+            std::lock_guard<std::mutex> lock(snapshotMutex_);
+            if (IsStopSnapshotCurrent()) {
+                auto& values = stopSnapshot_.state.watchValues;
+                auto it = values.find(watch.expression);
+                if (it != values.end()) {
+                    result = it->second;
+                    cached = true;
+                }
+            }
+        }
+        
+        if (!cached) {
+            result = debugger->Evaluate(watch.expression, EvaluationContext::Watch);
+            std::lock_guard<std::mutex> lock(snapshotMutex_);
+            if (stopSnapshot_.generation == generation && IsStopSnapshotCurrent()) {
+                stopSnapshot_.state.watchValues[watch.expression] = result;
+            }
+        }
+        
+        if (result.success) {
+            watchManager_.UpdateWatchValue(watch.id, result.variable);
+        } else {
+            watchManager_.SetWatchError(watch.id, result.errorMessage);
+        }
     }
 }
 
@@ -494,12 +547,39 @@ void UCDebugManager::RefreshWatches() {
 // ============================================================================
 
 std::vector<ThreadInfo> UCDebugManager::GetThreads() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!activeDebugger_) return {};
-    return activeDebugger_->GetThreads();
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex_);
+        if (IsStopSnapshotCurrent() && stopSnapshot_.hasThreads) {
+            return stopSnapshot_.threads;
+        }
+    }
+    
+    uint64_t generation = stopGeneration_;
+    std::vector<ThreadInfo> threads;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!activeDebugger_) return {};
+        threads = activeDebugger_->GetThreads();
+    }
+    
+    std::lock_guard<std::mutex> lock(snapshotMutex_);
+    if (stopSnapshot_.generation == generation && IsStopSnapshotCurrent()) {
+        stopSnapshot_.threads = threads;
+        stopSnapshot_.hasThreads = true;
+    }
+    return threads;
 }
 
 ThreadInfo UCDebugManager::GetCurrentThread() {
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex_);
+        if (IsStopSnapshotCurrent() && stopSnapshot_.hasThreads) {
+            for (const auto& thread : stopSnapshot_.threads) {
+                if (thread.isCurrent) return thread;
+            }
+        }
+    }
+    
     std::lock_guard<std::mutex> lock(mutex_);
     if (!activeDebugger_) return {};
     return activeDebugger_->GetCurrentThread();
@@ -508,16 +588,94 @@ ThreadInfo UCDebugManager::GetCurrentThread() {
 bool UCDebugManager::SwitchThread(int threadId) {
     std::lock_guard<std::mutex> lock(mutex_);
     if (!activeDebugger_) return false;
-    return activeDebugger_->SwitchThread(threadId);
+    
+    bool switched = activeDebugger_->SwitchThread(threadId);
+    if (switched) {
+        ClearStopSnapshot(false);
+    }
+    return switched;
 }
 
 std::vector<StackFrame> UCDebugManager::GetCallStack(int maxFrames) {
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex_);
+        const DebugStopState& state = stopSnapshot_.state;
+        
+        // A stack shorter than the depth it was fetched with is complete
+        if (IsStopSnapshotCurrent() && stopSnapshot_.hasStack &&
+            (maxFrames <= state.maxFrames ||
+             state.callStack.size() < static_cast<size_t>(state.maxFrames))) {
+            size_t count = std::min(state.callStack.size(), static_cast<size_t>(maxFrames));
+            return std::vector<StackFrame>(state.callStack.begin(), state.callStack.begin() + count);
+        }
+    }
+    
+    uint64_t generation = stopGeneration_;
+    std::vector<StackFrame> frames;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!activeDebugger_) return {};
+        frames = activeDebugger_->GetCallStack(maxFrames);
+    }
+    
+    std::lock_guard<std::mutex> lock(snapshotMutex_);
+    if (stopSnapshot_.generation == generation && IsStopSnapshotCurrent()) {
+        stopSnapshot_.state.callStack = frames;
+        stopSnapshot_.state.maxFrames = maxFrames;
+        stopSnapshot_.hasStack = true;
+    }
+    return frames;
+}
+
+std::vector<StackFrame> UCDebugManager::GetCallStack(int threadId, int maxFrames) {
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex_);
+        const DebugStopState& state = stopSnapshot_.state;
+        
+        if (IsStopSnapshotCurrent() && stopSnapshot_.hasStack && state.threadId == threadId &&
+            (maxFrames <= state.maxFrames ||
+             state.callStack.size() < static_cast<size_t>(state.maxFrames))) {
+            size_t count = std::min(state.callStack.size(), static_cast<size_t>(maxFrames));
+            return std::vector<StackFrame>(state.callStack.begin(), state.callStack.begin() + count);
+        }
+    }
+    
+    // Not kept in the snapshot, which holds the selected thread's stack
     std::lock_guard<std::mutex> lock(mutex_);
     if (!activeDebugger_) return {};
-    return activeDebugger_->GetCallStack(maxFrames);
+    return activeDebugger_->GetCallStack(threadId, maxFrames);
+}
+
+std::vector<StackFrame> UCDebugManager::GetCallStackRange(int threadId, int startFrame, int count) {
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex_);
+        const DebugStopState& state = stopSnapshot_.state;
+        size_t end = static_cast<size_t>(startFrame) + count;
+        
+        if (IsStopSnapshotCurrent() && stopSnapshot_.hasStack && state.threadId == threadId &&
+            (end <= state.callStack.size() ||
+             state.callStack.size() < static_cast<size_t>(state.maxFrames))) {
+            size_t first = std::min(state.callStack.size(), static_cast<size_t>(startFrame));
+            size_t last = std::min(state.callStack.size(), end);
+            return std::vector<StackFrame>(state.callStack.begin() + first, state.callStack.begin() + last);
+        }
+    }
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!activeDebugger_) return {};
+    return activeDebugger_->GetCallStackRange(threadId, startFrame, count);
 }
 
 StackFrame UCDebugManager::GetCurrentFrame() {
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex_);
+        const auto& frames = stopSnapshot_.state.callStack;
+        size_t level = static_cast<size_t>(stopSnapshot_.frameLevel);
+        if (IsStopSnapshotCurrent() && stopSnapshot_.hasStack && level < frames.size()) {
+            return frames[level];
+        }
+    }
+    
     std::lock_guard<std::mutex> lock(mutex_);
     if (!activeDebugger_) return {};
     return activeDebugger_->GetCurrentFrame();
@@ -526,7 +684,15 @@ StackFrame UCDebugManager::GetCurrentFrame() {
 bool UCDebugManager::SwitchFrame(int frameLevel) {
     std::lock_guard<std::mutex> lock(mutex_);
     if (!activeDebugger_) return false;
-    return activeDebugger_->SwitchFrame(frameLevel);
+    
+    bool switched = activeDebugger_->SwitchFrame(frameLevel);
+    if (switched) {
+        // Same stack; the variables belonged to the previous frame
+        ClearStopSnapshot(true);
+        std::lock_guard<std::mutex> snapshotLock(snapshotMutex_);
+        stopSnapshot_.frameLevel = frameLevel;
+    }
+    return switched;
 }
 
 // ============================================================================
@@ -534,15 +700,51 @@ bool UCDebugManager::SwitchFrame(int frameLevel) {
 // ============================================================================
 
 std::vector<Variable> UCDebugManager::GetLocals() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!activeDebugger_) return {};
-    return activeDebugger_->GetLocals();
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex_);
+        if (IsStopSnapshotCurrent() && stopSnapshot_.hasLocals) {
+            return stopSnapshot_.state.locals;
+        }
+    }
+    
+    uint64_t generation = stopGeneration_;
+    std::vector<Variable> locals;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!activeDebugger_) return {};
+        locals = activeDebugger_->GetLocals();
+    }
+    
+    std::lock_guard<std::mutex> lock(snapshotMutex_);
+    if (stopSnapshot_.generation == generation && IsStopSnapshotCurrent()) {
+        stopSnapshot_.state.locals = locals;
+        stopSnapshot_.hasLocals = true;
+    }
+    return locals;
 }
 
 std::vector<Variable> UCDebugManager::GetArguments() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!activeDebugger_) return {};
-    return activeDebugger_->GetArguments();
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex_);
+        if (IsStopSnapshotCurrent() && stopSnapshot_.hasArguments) {
+            return stopSnapshot_.state.arguments;
+        }
+    }
+    
+    uint64_t generation = stopGeneration_;
+    std::vector<Variable> arguments;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!activeDebugger_) return {};
+        arguments = activeDebugger_->GetArguments();
+    }
+    
+    std::lock_guard<std::mutex> lock(snapshotMutex_);
+    if (stopSnapshot_.generation == generation && IsStopSnapshotCurrent()) {
+        stopSnapshot_.state.arguments = arguments;
+        stopSnapshot_.hasArguments = true;
+    }
+    return arguments;
 }
 
 std::vector<Variable> UCDebugManager::GetGlobals() {
@@ -565,6 +767,7 @@ EvaluationResult UCDebugManager::Evaluate(const std::string& expression) {
 bool UCDebugManager::SetVariable(const std::string& name, const std::string& value) {
     std::lock_guard<std::mutex> lock(mutex_);
     if (!activeDebugger_) return false;
+    ClearStopSnapshot(false);
     return activeDebugger_->SetVariable(name, value);
 }
 
@@ -574,19 +777,55 @@ std::vector<Variable> UCDebugManager::ExpandVariable(int variablesReference) {
     return activeDebugger_->ExpandVariable(variablesReference);
 }
 
+std::vector<Variable> UCDebugManager::ExpandVariable(int variablesReference, int start, int count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!activeDebugger_) return {};
+    return activeDebugger_->ExpandVariable(variablesReference, start, count);
+}
+
+EvaluationResult UCDebugManager::EvaluateFullValue(const Variable& variable, int maxLength) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!activeDebugger_) {
+        EvaluationResult result;
+        result.success = false;
+        result.errorMessage = "No active debug session";
+        return result;
+    }
+    return activeDebugger_->EvaluateFullValue(variable, maxLength);
+}
+
 // ============================================================================
 // REGISTERS & MEMORY
 // ============================================================================
 
 std::vector<Register> UCDebugManager::GetRegisters() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!activeDebugger_) return {};
-    return activeDebugger_->GetRegisters();
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex_);
+        if (IsStopSnapshotCurrent() && stopSnapshot_.hasRegisters) {
+            return stopSnapshot_.registers;
+        }
+    }
+    
+    uint64_t generation = stopGeneration_;
+    std::vector<Register> registers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!activeDebugger_) return {};
+        registers = activeDebugger_->GetRegisters();
+    }
+    
+    std::lock_guard<std::mutex> lock(snapshotMutex_);
+    if (stopSnapshot_.generation == generation && IsStopSnapshotCurrent()) {
+        stopSnapshot_.registers = registers;
+        stopSnapshot_.hasRegisters = true;
+    }
+    return registers;
 }
 
 bool UCDebugManager::SetRegister(const std::string& name, const std::string& value) {
     std::lock_guard<std::mutex> lock(mutex_);
     if (!activeDebugger_) return false;
+    ClearStopSnapshot(false);
     return activeDebugger_->SetRegister(name, value);
 }
 
@@ -599,9 +838,23 @@ MemoryRegion UCDebugManager::ReadMemory(uint64_t address, size_t size) {
 bool UCDebugManager::WriteMemory(uint64_t address, const std::vector<uint8_t>& data) {
     std::lock_guard<std::mutex> lock(mutex_);
     if (!activeDebugger_) return false;
+    ClearStopSnapshot(false);
     return activeDebugger_->WriteMemory(address, data);
 }
 
+MemorySearchResult UCDebugManager::SearchMemory(const MemorySearchQuery& query,
+                                                const std::function<bool(uint64_t address)>& onMatch,
+                                                const std::atomic<bool>* cancel) {
+    // Not under mutex_: a search through a large heap runs for seconds
+    std::shared_ptr<IUCDebuggerPlugin> debugger = GetActiveDebugger();
+    if (!debugger || !debugger->IsSessionActive()) {
+        MemorySearchResult result;
+        result.errorMessage = "No active debug session";
+        return result;
+    }
+    return debugger->SearchMemory(query, onMatch, cancel);
+}
+
 // ============================================================================
 // DISASSEMBLY & MODULES
 // ============================================================================
@@ -636,14 +889,35 @@ std::vector<std::shared_ptr<IUCDebuggerPlugin>> UCDebugManager::GetAvailableDebu
     return UCDebuggerPluginRegistry::Instance().GetAvailablePlugins();
 }
 
+std::shared_ptr<IUCDebuggerPlugin> UCDebugManager::FindDebugger(DebuggerType type) {
+    auto& registry = UCDebuggerPluginRegistry::Instance();
+    return ownsPlugins_ ? registry.CreatePlugin(type) : registry.GetPlugin(type);
+}
+
+std::shared_ptr<IUCDebuggerPlugin> UCDebugManager::FindBestDebugger() {
+    auto& registry = UCDebuggerPluginRegistry::Instance();
+    return ownsPlugins_ ? registry.CreateBestDebugger() : registry.GetBestDebugger();
+}
+
+std::shared_ptr<IUCDebuggerPlugin> UCDebugManager::GetActiveDebugger() const {
+    std::lock_guard<std::mutex> lock(debuggerMutex_);
+    return activeDebugger_;
+}
+
+void UCDebugManager::SetActiveDebugger(std::shared_ptr<IUCDebuggerPlugin> debugger) {
+    // Called with mutex_ held
+    std::lock_guard<std::mutex> lock(debuggerMutex_);
+    activeDebugger_ = std::move(debugger);
+}
+
 bool UCDebugManager::SelectDebugger(DebuggerType type) {
-    auto plugin = UCDebuggerPluginRegistry::Instance().GetPlugin(type);
+    auto plugin = FindDebugger(type);
     if (!plugin || !plugin->IsAvailable()) {
         return false;
     }
     
     std::lock_guard<std::mutex> lock(mutex_);
-    activeDebugger_ = plugin;
+    SetActiveDebugger(plugin);
     return true;
 }
 
@@ -678,6 +952,10 @@ void UCDebugManager::SetupDebuggerCallbacks() {
 void UCDebugManager::HandleStateChange(DebugSessionState oldState, DebugSessionState newState) {
     lastState_ = newState;
     
+    if (newState != DebugSessionState::Paused) {
+        DropStopSnapshot();
+    }
+    
     if (onStateChange) {
         onStateChange(oldState, newState);
     }
@@ -693,7 +971,10 @@ void UCDebugManager::HandleStateChange(DebugSessionState oldState, DebugSessionS
 }
 
 void UCDebugManager::HandleTargetStop(StopReason reason, const SourceLocation& location) {
-    // Refresh watches when stopped
+    // Fetch what the panels show in one batch before telling them; their
+    // getters (and the watch refresh) then answer from the snapshot
+    CaptureStopSnapshot();
+    watchManager_.BeginStop();
     RefreshWatches();
     
     if (onTargetStop) {
@@ -733,6 +1014,65 @@ void UCDebugManager::HandleError(const std::string& error) {
     }
 }
 
+void UCDebugManager::CaptureStopSnapshot() {
+    uint64_t generation = ++stopGeneration_;
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex_);
+        stopSnapshot_ = StopSnapshot();
+        stopSnapshot_.generation = generation;
+    }
+    
+    // Exits also arrive as stops; there is nothing to fetch then
+    std::shared_ptr<IUCDebuggerPlugin> debugger = GetActiveDebugger();
+    if (!debugger || debugger->GetSessionState() != DebugSessionState::Paused) {
+        return;
+    }
+    
+    std::vector<std::string> expressions;
+    for (const WatchEntry& watch : watchManager_.GetAllWatches()) {
+        expressions.push_back(watch.expression);
+    }
+    
+    DebugStopState state = debugger->CaptureStopState(config_.maxCallStackDepth, expressions);
+    
+    std::lock_guard<std::mutex> lock(snapshotMutex_);
+    if (stopSnapshot_.generation != generation || !IsStopSnapshotCurrent()) {
+        return;     // Resumed while fetching
+    }
+    stopSnapshot_.state = std::move(state);
+    stopSnapshot_.hasStack = true;
+    stopSnapshot_.hasLocals = true;
+    stopSnapshot_.hasArguments = true;
+}
+
+void UCDebugManager::DropStopSnapshot() {
+    ++stopGeneration_;
+    
+    std::lock_guard<std::mutex> lock(snapshotMutex_);
+    stopSnapshot_ = StopSnapshot();
+}
+
+void UCDebugManager::ClearStopSnapshot(bool keepStack) {
+    std::lock_guard<std::mutex> lock(snapshotMutex_);
+    StopSnapshot cleared;
+    cleared.generation = stopSnapshot_.generation;
+    if (keepStack) {
+        cleared.frameLevel = stopSnapshot_.frameLevel;
+        cleared.hasStack = stopSnapshot_.hasStack;
+        cleared.hasThreads = stopSnapshot_.hasThreads;
+        cleared.state.threadId = stopSnapshot_.state.threadId;
+        cleared.state.maxFrames = stopSnapshot_.state.maxFrames;
+        cleared.state.callStack = std::move(stopSnapshot_.state.callStack);
+        cleared.threads = std::move(stopSnapshot_.threads);
+    }
+    stopSnapshot_ = std::move(cleared);
+}
+
+bool UCDebugManager::IsStopSnapshotCurrent() const {
+    // Caller holds snapshotMutex_
+    return stopSnapshot_.generation != 0 && stopSnapshot_.generation == stopGeneration_;
+}
+
 DebugLaunchConfig UCDebugManager::CreateLaunchConfig(std::shared_ptr<UCIDEProject> project) {
     DebugLaunchConfig config;
     
@@ -759,6 +1099,7 @@ void RegisterBuiltInDebuggerPlugins() {
     // Register GDB plugin
     auto gdbPlugin = std::make_shared<UCGDBPlugin>();
     registry.RegisterPlugin(gdbPlugin);
+    registry.RegisterPluginFactory(DebuggerType::GDB, [] { return std::make_shared<UCGDBPlugin>(); });
     std::cout << "  - Registered GDB plugin";
     if (gdbPlugin->IsAvailable()) {
         std::cout << " [Available: " << gdbPlugin->GetDebuggerVersion() << "]";
@@ -770,6 +1111,7 @@ void RegisterBuiltInDebuggerPlugins() {
     // Register LLDB plugin
     auto lldbPlugin = std::make_shared<UCLLDBPlugin>();
     registry.RegisterPlugin(lldbPlugin);
+    registry.RegisterPluginFactory(DebuggerType::LLDB, [] { return std::make_shared<UCLLDBPlugin>(); });
     std::cout << "  - Registered LLDB plugin";
     if (lldbPlugin->IsAvailable()) {
         std::cout << " [Available: " << lldbPlugin->GetDebuggerVersion() << "]";
@@ -7,55 +7,178 @@
 #include "UCGDBMIParser.h"
 #include <sstream>
 #include <algorithm>
-#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <bit>
 
 namespace UltraCanvas {
 namespace IDE {
 
+namespace {
+
+bool IsSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+bool IsKeyChar(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+           (c >= '0' && c <= '9') || c == '-' || c == '_';
+}
+
+void SkipWhitespace(const std::string& str, size_t& pos) {
+    while (pos < str.size() && IsSpace(str[pos])) {
+        pos++;
+    }
+}
+
+/**
+ * @brief Decode C-string escapes; `out` may alias `in` (output never grows)
+ * @return Number of bytes written
+ */
+size_t DecodeEscapes(const char* in, size_t length, char* out) {
+    const char* end = in + length;
+    char* start = out;
+    
+    while (in < end) {
+        const char* backslash = static_cast<const char*>(
+            std::memchr(in, '\\', static_cast<size_t>(end - in)));
+        size_t run = (backslash ? backslash : end) - in;
+        if (out != in) std::memmove(out, in, run);
+        out += run;
+        in += run;
+        if (!backslash) break;
+        
+        in++; // skip '\'
+        if (in >= end) {
+            *out++ = '\\';
+            break;
+        }
+        
+        char c = *in++;
+        switch (c) {
+            case 'n': *out++ = '\n'; break;
+            case 'r': *out++ = '\r'; break;
+            case 't': *out++ = '\t'; break;
+            case 'b': *out++ = '\b'; break;
+            case 'f': *out++ = '\f'; break;
+            case 'a': *out++ = '\a'; break;
+            case 'v': *out++ = '\v'; break;
+            case 'e': *out++ = '\033'; break;
+            default:
+                if (c >= '0' && c <= '7') {
+                    // GDB prints other non-printable bytes as \ooo
+                    int value = c - '0';
+                    for (int digits = 1; digits < 3 && in < end && *in >= '0' && *in <= '7'; digits++) {
+                        value = value * 8 + (*in++ - '0');
+                    }
+                    *out++ = static_cast<char>(value);
+                } else {
+                    *out++ = c;
+                }
+                break;
+        }
+    }
+    
+    return static_cast<size_t>(out - start);
+}
+
+} // namespace
+
 // ============================================================================
 // GDBMIValue IMPLEMENTATION
 // ============================================================================
 
-std::string GDBMIValue::GetString(const std::string& key, const std::string& def) const {
-    if (type != Type::Tuple) return def;
-    auto it = tupleValue.find(key);
-    if (it == tupleValue.end()) return def;
-    if (it->second.type != Type::String) return def;
-    return it->second.stringValue;
-}
-
-int GDBMIValue::GetInt(const std::string& key, int def) const {
-    std::string s = GetString(key, "");
-    if (s.empty()) return def;
-    try {
-        return std::stoi(s);
-    } catch (...) {
-        return def;
+GDBMIValue::Type GDBMIValue::GetType() const {
+    return document_->nodes[node_].type;
+}
+
+std::string_view GDBMIValue::AsString() const {
+    if (!IsString()) return {};
+    
+    GDBMINode& node = document_->nodes[node_];
+    if (node.escaped && !node.decoded) {
+        GDBMIDocument& doc = *document_;
+        if (doc.decoded.empty()) {
+            doc.decoded.resize(doc.buffer.size());
+        }
+        char* out = doc.decoded.data() + doc.decodedUsed;
+        node.length = static_cast<uint32_t>(
+            DecodeEscapes(doc.buffer.data() + node.offset, node.length, out));
+        node.offset = static_cast<uint32_t>(doc.decodedUsed);
+        node.decoded = true;
+        doc.decodedUsed += node.length;
     }
+    
+    const std::string& source = node.decoded ? document_->decoded : document_->buffer;
+    return std::string_view(source.data() + node.offset, node.length);
+}
+
+size_t GDBMIValue::Size() const {
+    if (!IsList() && !IsTuple()) return 0;
+    return document_->nodes[node_].length;
+}
+
+GDBMIValue GDBMIValue::At(size_t index) const {
+    if (index >= Size()) return GDBMIValue();
+    return GDBMIValue(document_, document_->nodes[node_].offset + static_cast<uint32_t>(index));
+}
+
+std::string_view GDBMIValue::KeyAt(size_t index) const {
+    if (index >= Size()) return {};
+    const GDBMINode& child = document_->nodes[document_->nodes[node_].offset + index];
+    return std::string_view(document_->buffer.data() + child.keyOffset, child.keyLength);
+}
+
+GDBMIValue::Iterator GDBMIValue::begin() const {
+    return Iterator(*this, 0);
 }
 
-uint64_t GDBMIValue::GetUInt64(const std::string& key, uint64_t def) const {
-    std::string s = GetString(key, "");
-    if (s.empty()) return def;
-    try {
-        if (s.substr(0, 2) == "0x" || s.substr(0, 2) == "0X") {
-            return std::stoull(s, nullptr, 16);
+GDBMIValue::Iterator GDBMIValue::end() const {
+    return Iterator(*this, Size());
+}
+
+GDBMIValue GDBMIValue::Get(std::string_view key) const {
+    if (!IsTuple()) return GDBMIValue();
+    
+    // MI tuples hold a handful of members; a linear scan over the contiguous
+    // child nodes beats hashing them
+    const GDBMINode& tuple = document_->nodes[node_];
+    const char* buffer = document_->buffer.data();
+    for (uint32_t i = tuple.offset; i < tuple.offset + tuple.length; i++) {
+        const GDBMINode& child = document_->nodes[i];
+        if (child.keyLength == key.size() &&
+            std::memcmp(buffer + child.keyOffset, key.data(), key.size()) == 0) {
+            return GDBMIValue(document_, i);
         }
-        return std::stoull(s);
-    } catch (...) {
-        return def;
     }
+    return GDBMIValue();
 }
 
-const GDBMIValue* GDBMIValue::Get(const std::string& key) const {
-    if (type != Type::Tuple) return nullptr;
-    auto it = tupleValue.find(key);
-    return (it != tupleValue.end()) ? &it->second : nullptr;
+std::string GDBMIValue::GetString(std::string_view key, std::string_view def) const {
+    GDBMIValue value = Get(key);
+    if (!value.IsString()) return std::string(def);
+    return std::string(value.AsString());
 }
 
-bool GDBMIValue::Has(const std::string& key) const {
-    if (type != Type::Tuple) return false;
-    return tupleValue.find(key) != tupleValue.end();
+int GDBMIValue::GetInt(std::string_view key, int def) const {
+    std::string_view s = Get(key).AsString();
+    int result = 0;
+    auto [end, error] = std::from_chars(s.data(), s.data() + s.size(), result);
+    if (error != std::errc() || end == s.data()) return def;
+    return result;
+}
+
+uint64_t GDBMIValue::GetUInt64(std::string_view key, uint64_t def) const {
+    std::string_view s = Get(key).AsString();
+    int base = 10;
+    if (s.size() > 2 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X')) {
+        s.remove_prefix(2);
+        base = 16;
+    }
+    uint64_t result = 0;
+    auto [end, error] = std::from_chars(s.data(), s.data() + s.size(), result, base);
+    if (error != std::errc() || end == s.data()) return def;
+    return result;
 }
 
 // ============================================================================
@@ -76,11 +199,16 @@ bool GDBMIRecord::IsStream() const {
 
 std::string GDBMIRecord::GetError() const {
     if (!IsError()) return "";
-    auto it = results.find("msg");
-    if (it != results.end() && it->second.IsString()) {
-        return it->second.stringValue;
-    }
-    return "Unknown error";
+    return results.GetString("msg", "Unknown error");
+}
+
+std::string_view GDBMIRecord::GetRawLine() const {
+    return document ? std::string_view(document->buffer) : std::string_view();
+}
+
+GDBMIRecord GDBMIRecord::MakeError(const std::string& message) {
+    UCGDBMIParser parser;
+    return parser.ParseLine("^error,msg=\"" + UCGDBMIParser::Escape(message) + "\"");
 }
 
 // ============================================================================
@@ -90,9 +218,8 @@ std::string GDBMIRecord::GetError() const {
 UCGDBMIParser::UCGDBMIParser() = default;
 UCGDBMIParser::~UCGDBMIParser() = default;
 
-GDBMIRecord UCGDBMIParser::ParseLine(const std::string& line) {
+GDBMIRecord UCGDBMIParser::ParseLine(std::string line) {
     GDBMIRecord record;
-    record.rawLine = line;
     
     if (line.empty()) {
         return record;
@@ -104,327 +231,306 @@ GDBMIRecord UCGDBMIParser::ParseLine(const std::string& line) {
         return record;
     }
     
+    record.document = std::make_shared<GDBMIDocument>();
+    GDBMIDocument& doc = *record.document;
+    doc.buffer = std::move(line);
+    const std::string& str = doc.buffer;
+    
     size_t pos = 0;
     
     // Parse optional token
-    while (pos < line.size() && std::isdigit(line[pos])) {
+    int token = 0;
+    while (pos < str.size() && str[pos] >= '0' && str[pos] <= '9') {
+        token = token * 10 + (str[pos] - '0');
         pos++;
     }
     if (pos > 0) {
-        record.token = std::stoi(line.substr(0, pos));
+        record.token = token;
     }
     
-    if (pos >= line.size()) {
+    if (pos >= str.size()) {
         return record;
     }
     
-    char prefix = line[pos];
+    char prefix = str[pos];
     pos++;
     
     switch (prefix) {
-        case '^': {
-            // Result record: ^done, ^running, ^connected, ^error, ^exit
-            record.type = GDBMIRecordType::Result;
-            size_t classEnd = line.find(',', pos);
-            if (classEnd == std::string::npos) {
-                classEnd = line.size();
-            }
-            std::string resultClass = line.substr(pos, classEnd - pos);
-            record.resultClass = ParseResultClass(resultClass);
-            pos = classEnd;
-            
-            // Parse results
-            if (pos < line.size() && line[pos] == ',') {
-                pos++;
-                record.results = ParseTuple(line, pos);
-            }
-            break;
-        }
-        
-        case '*': {
-            // Async exec record: *stopped, *running
-            record.type = GDBMIRecordType::AsyncExec;
-            size_t classEnd = line.find(',', pos);
+        case '^':   // Result record: ^done, ^running, ^connected, ^error, ^exit
+        case '*':   // Async exec record: *stopped, *running
+        case '+':   // Async status record
+        case '=': { // Async notify record
+            size_t classEnd = str.find(',', pos);
             if (classEnd == std::string::npos) {
-                classEnd = line.size();
+                classEnd = str.size();
             }
-            record.asyncClassName = line.substr(pos, classEnd - pos);
-            record.asyncClass = ParseAsyncClass(record.asyncClassName);
-            pos = classEnd;
+            std::string_view className(str.data() + pos, classEnd - pos);
             
-            if (pos < line.size() && line[pos] == ',') {
-                pos++;
-                record.results = ParseTuple(line, pos);
-            }
-            break;
-        }
-        
-        case '+': {
-            // Async status record
-            record.type = GDBMIRecordType::AsyncStatus;
-            size_t classEnd = line.find(',', pos);
-            if (classEnd == std::string::npos) {
-                classEnd = line.size();
-            }
-            record.asyncClassName = line.substr(pos, classEnd - pos);
-            pos = classEnd;
-            
-            if (pos < line.size() && line[pos] == ',') {
-                pos++;
-                record.results = ParseTuple(line, pos);
-            }
-            break;
-        }
-        
-        case '=': {
-            // Async notify record
-            record.type = GDBMIRecordType::AsyncNotify;
-            size_t classEnd = line.find(',', pos);
-            if (classEnd == std::string::npos) {
-                classEnd = line.size();
+            if (prefix == '^') {
+                record.type = GDBMIRecordType::Result;
+                record.resultClass = ParseResultClass(className);
+            } else {
+                record.type = prefix == '*' ? GDBMIRecordType::AsyncExec :
+                              prefix == '+' ? GDBMIRecordType::AsyncStatus :
+                                              GDBMIRecordType::AsyncNotify;
+                record.asyncClassName = className;
+                if (prefix != '+') {
+                    record.asyncClass = ParseAsyncClass(className);
+                }
             }
-            record.asyncClassName = line.substr(pos, classEnd - pos);
-            record.asyncClass = ParseAsyncClass(record.asyncClassName);
             pos = classEnd;
             
-            if (pos < line.size() && line[pos] == ',') {
+            // Result list; roughly one node per 24 bytes of MI
+            doc.nodes.reserve(str.size() / 24 + 1);
+            if (pos < str.size() && str[pos] == ',') {
                 pos++;
-                record.results = ParseTuple(line, pos);
             }
+            ParseResults(doc, pos, '\0');
+            doc.nodes.push_back(scratch_.back());
+            scratch_.pop_back();
+            record.results = GDBMIValue(&doc, static_cast<uint32_t>(doc.nodes.size() - 1));
             break;
         }
         
-        case '~': {
-            // Console stream output
-            record.type = GDBMIRecordType::ConsoleStream;
-            record.streamContent = ParseCString(line, pos);
-            break;
-        }
-        
-        case '@': {
-            // Target stream output
-            record.type = GDBMIRecordType::TargetStream;
-            record.streamContent = ParseCString(line, pos);
-            break;
-        }
-        
-        case '&': {
-            // Log stream output
-            record.type = GDBMIRecordType::LogStream;
-            record.streamContent = ParseCString(line, pos);
+        case '~':   // Console stream output
+        case '@':   // Target stream output
+        case '&': { // Log stream output
+            record.type = prefix == '~' ? GDBMIRecordType::ConsoleStream :
+                          prefix == '@' ? GDBMIRecordType::TargetStream :
+                                          GDBMIRecordType::LogStream;
+            ParseCString(doc, pos);
+            GDBMINode node = scratch_.back();
+            scratch_.pop_back();
+            std::string_view raw(str.data() + node.offset, node.length);
+            record.streamContent = node.escaped ? Unescape(raw) : std::string(raw);
             break;
         }
         
         default:
             // Unknown format, treat as console output
             record.type = GDBMIRecordType::ConsoleStream;
-            record.streamContent = line;
+            record.streamContent = str;
             break;
     }
     
     return record;
 }
 
-std::vector<GDBMIRecord> UCGDBMIParser::ParseOutput(const std::string& output) {
+std::vector<GDBMIRecord> UCGDBMIParser::ParseOutput(std::string_view output) {
     std::vector<GDBMIRecord> records;
-    std::istringstream stream(output);
-    std::string line;
     
-    while (std::getline(stream, line)) {
+    size_t start = 0;
+    while (start < output.size()) {
+        size_t end = output.find('\n', start);
+        if (end == std::string_view::npos) end = output.size();
+        
+        std::string_view line = output.substr(start, end - start);
         // Remove trailing CR if present
         if (!line.empty() && line.back() == '\r') {
-            line.pop_back();
+            line.remove_suffix(1);
         }
         if (!line.empty()) {
-            records.push_back(ParseLine(line));
+            records.push_back(ParseLine(std::string(line)));
         }
+        start = end + 1;
     }
     
     return records;
 }
 
-GDBMIValue UCGDBMIParser::ParseValue(const std::string& str, size_t& pos) {
+bool UCGDBMIParser::ParseValue(GDBMIDocument& doc, size_t& pos) {
+    const std::string& str = doc.buffer;
     SkipWhitespace(str, pos);
     
     if (pos >= str.size()) {
-        return GDBMIValue("");
+        return false;
     }
     
     char c = str[pos];
     
     if (c == '"') {
-        // C-string
-        return GDBMIValue(ParseCString(str, pos));
+        ParseCString(doc, pos);
     } else if (c == '{') {
-        // Tuple
-        GDBMIValue val;
-        val.type = GDBMIValue::Type::Tuple;
-        val.tupleValue = ParseTuple(str, pos);
-        return val;
+        pos++;
+        ParseResults(doc, pos, '}');
     } else if (c == '[') {
-        // List
-        GDBMIValue val;
-        val.type = GDBMIValue::Type::List;
-        val.listValue = ParseList(str, pos);
-        return val;
+        ParseList(doc, pos);
     } else {
         // Unquoted string (until comma or end)
-        return GDBMIValue(ParseString(str, pos));
+        ParseBareString(doc, pos);
     }
+    return true;
 }
 
-GDBMITuple UCGDBMIParser::ParseTuple(const std::string& str, size_t& pos) {
-    GDBMITuple tuple;
-    
-    SkipWhitespace(str, pos);
-    
-    // Check for opening brace (optional in some contexts)
-    bool hasBrace = false;
-    if (pos < str.size() && str[pos] == '{') {
-        hasBrace = true;
-        pos++;
-    }
+void UCGDBMIParser::ParseResults(GDBMIDocument& doc, size_t& pos, char close) {
+    const std::string& str = doc.buffer;
+    size_t mark = scratch_.size();
     
     while (pos < str.size()) {
         SkipWhitespace(str, pos);
+        if (pos >= str.size()) break;
         
-        if (hasBrace && str[pos] == '}') {
+        if (str[pos] == close) {
             pos++;
             break;
         }
-        
-        // Parse key
-        std::string key;
-        while (pos < str.size() && str[pos] != '=' && str[pos] != ',' && 
-               str[pos] != '}' && !std::isspace(str[pos])) {
-            key += str[pos++];
+        if (str[pos] == ',') {
+            pos++;
+            continue;
         }
         
-        if (key.empty()) {
-            if (pos < str.size() && str[pos] == ',') {
-                pos++;
-                continue;
-            }
-            break;
+        // Parse key
+        size_t keyStart = pos;
+        while (pos < str.size() && IsKeyChar(str[pos])) {
+            pos++;
         }
+        size_t keyEnd = pos;
         
         SkipWhitespace(str, pos);
         
         if (pos < str.size() && str[pos] == '=') {
             pos++;
-            SkipWhitespace(str, pos);
-            tuple[key] = ParseValue(str, pos);
+            if (!ParseValue(doc, pos)) break;
+            scratch_.back().keyOffset = static_cast<uint32_t>(keyStart);
+            scratch_.back().keyLength = static_cast<uint32_t>(keyEnd - keyStart);
+        } else if (keyEnd == keyStart) {
+            // Keyless value (e.g. the extra location tuples of a
+            // multi-location breakpoint): keep it without a key
+            if (!ParseValue(doc, pos)) break;
         }
         
         SkipWhitespace(str, pos);
-        
         if (pos < str.size() && str[pos] == ',') {
             pos++;
-        } else if (!hasBrace) {
-            break;
+        } else if (pos < str.size() && str[pos] != close) {
+            // Malformed; give up on the rest of this tuple
+            if (close == '\0') break;
+            while (pos < str.size() && str[pos] != close) pos++;
         }
     }
     
-    return tuple;
+    CloseContainer(doc, GDBMIValue::Type::Tuple, mark);
 }
 
-GDBMIList UCGDBMIParser::ParseList(const std::string& str, size_t& pos) {
-    GDBMIList list;
-    
-    SkipWhitespace(str, pos);
-    
-    if (pos >= str.size() || str[pos] != '[') {
-        return list;
-    }
-    pos++;
+void UCGDBMIParser::ParseList(GDBMIDocument& doc, size_t& pos) {
+    const std::string& str = doc.buffer;
+    size_t mark = scratch_.size();
+    pos++; // skip '['
     
     while (pos < str.size()) {
         SkipWhitespace(str, pos);
+        if (pos >= str.size()) break;
         
         if (str[pos] == ']') {
             pos++;
             break;
         }
         
-        // Check if this is a result (key=value) or just a value
-        size_t lookAhead = pos;
-        while (lookAhead < str.size() && str[lookAhead] != '=' && 
-               str[lookAhead] != ',' && str[lookAhead] != ']') {
-            lookAhead++;
+        // A list of results (frame={...},frame={...}) stores each element
+        // as a one-member tuple, so callers can look the name up
+        size_t elementStart = pos;
+        size_t keyEnd = pos;
+        while (keyEnd < str.size() && IsKeyChar(str[keyEnd])) {
+            keyEnd++;
         }
         
-        if (lookAhead < str.size() && str[lookAhead] == '=') {
-            // It's a tuple element
-            GDBMIValue tupleVal;
-            tupleVal.type = GDBMIValue::Type::Tuple;
-            
-            std::string key;
-            while (pos < str.size() && str[pos] != '=') {
-                key += str[pos++];
-            }
-            pos++; // skip '='
-            
-            tupleVal.tupleValue[key] = ParseValue(str, pos);
-            list.push_back(tupleVal);
-        } else {
-            // Just a value
-            list.push_back(ParseValue(str, pos));
+        if (keyEnd > pos && keyEnd < str.size() && str[keyEnd] == '=') {
+            size_t elementMark = scratch_.size();
+            size_t keyStart = pos;
+            pos = keyEnd + 1;
+            if (!ParseValue(doc, pos)) break;
+            scratch_.back().keyOffset = static_cast<uint32_t>(keyStart);
+            scratch_.back().keyLength = static_cast<uint32_t>(keyEnd - keyStart);
+            CloseContainer(doc, GDBMIValue::Type::Tuple, elementMark);
+        } else if (!ParseValue(doc, pos)) {
+            break;
         }
         
         SkipWhitespace(str, pos);
         
         if (pos < str.size() && str[pos] == ',') {
             pos++;
+        } else if (pos == elementStart) {
+            pos++; // Stray character; skip it
         }
     }
     
-    return list;
+    CloseContainer(doc, GDBMIValue::Type::List, mark);
 }
 
-std::string UCGDBMIParser::ParseString(const std::string& str, size_t& pos) {
-    std::string result;
-    
-    while (pos < str.size() && str[pos] != ',' && str[pos] != '}' && 
-           str[pos] != ']' && !std::isspace(str[pos])) {
-        result += str[pos++];
-    }
+void UCGDBMIParser::ParseCString(GDBMIDocument& doc, size_t& pos) {
+    const std::string& str = doc.buffer;
+    GDBMINode node;
+    node.type = GDBMIValue::Type::String;
     
-    return result;
-}
-
-std::string UCGDBMIParser::ParseCString(const std::string& str, size_t& pos) {
     if (pos >= str.size() || str[pos] != '"') {
-        return "";
+        node.offset = static_cast<uint32_t>(pos);
+        scratch_.push_back(node);
+        return;
     }
     pos++; // skip opening quote
     
-    std::string result;
-    
-    while (pos < str.size() && str[pos] != '"') {
-        if (str[pos] == '\\' && pos + 1 < str.size()) {
-            pos++;
-            switch (str[pos]) {
-                case 'n': result += '\n'; break;
-                case 'r': result += '\r'; break;
-                case 't': result += '\t'; break;
-                case '\\': result += '\\'; break;
-                case '"': result += '"'; break;
-                default: result += str[pos]; break;
-            }
-        } else {
-            result += str[pos];
+    // Find the closing quote: the first '"' not preceded by an odd number
+    // of backslashes. memchr does the scanning; contents are not copied.
+    const char* begin = str.data() + pos;
+    const char* end = str.data() + str.size();
+    const char* scan = begin;
+    const char* quote = end;
+    while (scan < end) {
+        const char* found = static_cast<const char*>(
+            std::memchr(scan, '"', static_cast<size_t>(end - scan)));
+        if (!found) break;
+        
+        size_t backslashes = 0;
+        for (const char* b = found; b > begin && b[-1] == '\\'; b--) {
+            backslashes++;
         }
-        pos++;
+        if (backslashes % 2 == 0) {
+            quote = found;
+            break;
+        }
+        scan = found + 1;
     }
     
+    node.offset = static_cast<uint32_t>(pos);
+    node.length = static_cast<uint32_t>(quote - begin);
+    node.escaped = std::memchr(begin, '\\', node.length) != nullptr;
+    scratch_.push_back(node);
+    
+    pos += node.length;
     if (pos < str.size()) {
         pos++; // skip closing quote
     }
+}
+
+void UCGDBMIParser::ParseBareString(GDBMIDocument& doc, size_t& pos) {
+    const std::string& str = doc.buffer;
+    size_t start = pos;
     
-    return result;
+    while (pos < str.size() && str[pos] != ',' && str[pos] != '}' &&
+           str[pos] != ']' && !IsSpace(str[pos])) {
+        pos++;
+    }
+    
+    GDBMINode node;
+    node.type = GDBMIValue::Type::String;
+    node.offset = static_cast<uint32_t>(start);
+    node.length = static_cast<uint32_t>(pos - start);
+    scratch_.push_back(node);
 }
 
-GDBMIResultClass UCGDBMIParser::ParseResultClass(const std::string& cls) {
+void UCGDBMIParser::CloseContainer(GDBMIDocument& doc, GDBMIValue::Type type, size_t mark) {
+    GDBMINode node;
+    node.type = type;
+    node.offset = static_cast<uint32_t>(doc.nodes.size());
+    node.length = static_cast<uint32_t>(scratch_.size() - mark);
+    
+    doc.nodes.insert(doc.nodes.end(), scratch_.begin() + mark, scratch_.end());
+    scratch_.resize(mark);
+    scratch_.push_back(node);
+}
+
+GDBMIResultClass UCGDBMIParser::ParseResultClass(std::string_view cls) {
     if (cls == "done") return GDBMIResultClass::Done;
     if (cls == "running") return GDBMIResultClass::Running;
     if (cls == "connected") return GDBMIResultClass::Connected;
@@ -433,7 +539,7 @@ GDBMIResultClass UCGDBMIParser::ParseResultClass(const std::string& cls) {
     return GDBMIResultClass::Done;
 }
 
-GDBMIAsyncClass UCGDBMIParser::ParseAsyncClass(const std::string& cls) {
+GDBMIAsyncClass UCGDBMIParser::ParseAsyncClass(std::string_view cls) {
     if (cls == "stopped") return GDBMIAsyncClass::Stopped;
     if (cls == "running") return GDBMIAsyncClass::Running;
     if (cls == "thread-group-added") return GDBMIAsyncClass::ThreadGroupAdded;
@@ -449,12 +555,6 @@ GDBMIAsyncClass UCGDBMIParser::ParseAsyncClass(const std::string& cls) {
     return GDBMIAsyncClass::Other;
 }
 
-void UCGDBMIParser::SkipWhitespace(const std::string& str, size_t& pos) {
-    while (pos < str.size() && std::isspace(str[pos])) {
-        pos++;
-    }
-}
-
 std::string UCGDBMIParser::Escape(const std::string& str) {
     std::string result;
     result.reserve(str.size() + 10);
@@ -473,27 +573,47 @@ std::string UCGDBMIParser::Escape(const std::string& str) {
     return result;
 }
 
-std::string UCGDBMIParser::Unescape(const std::string& str) {
-    std::string result;
-    result.reserve(str.size());
-    
-    for (size_t i = 0; i < str.size(); i++) {
-        if (str[i] == '\\' && i + 1 < str.size()) {
-            i++;
-            switch (str[i]) {
-                case 'n': result += '\n'; break;
-                case 'r': result += '\r'; break;
-                case 't': result += '\t'; break;
-                case '\\': result += '\\'; break;
-                case '"': result += '"'; break;
-                default: result += str[i]; break;
-            }
-        } else {
-            result += str[i];
+std::string UCGDBMIParser::Unescape(std::string_view str) {
+    std::string result(str.size(), '\0');
+    result.resize(DecodeEscapes(str.data(), str.size(), result.data()));
+    return result;
+}
+
+size_t UCGDBMIParser::DecodeHex(std::string_view hex, uint8_t* out) {
+    const size_t count = hex.size() / 2;
+    const char* in = hex.data();
+    size_t i = 0;
+    
+    // A digit's value is its low nibble, plus 9 for 'a'-'f' and 'A'-'F',
+    // the only digits with bit 6 set
+    if constexpr (std::endian::native == std::endian::little) {
+        for (; i + 4 <= count; i += 4) {
+            uint64_t digits;
+            std::memcpy(&digits, in + i * 2, sizeof(digits));
+            uint64_t nibbles = (digits & 0x0F0F0F0F0F0F0F0FULL) +
+                               ((digits >> 6) & 0x0101010101010101ULL) * 9;
+            
+            // Pair each high nibble with the next digit's nibble, then
+            // pack the four bytes into the low half
+            uint64_t bytes = ((nibbles & 0x00FF00FF00FF00FFULL) << 4) |
+                             ((nibbles >> 8) & 0x00FF00FF00FF00FFULL);
+            bytes = (bytes | (bytes >> 8)) & 0x0000FFFF0000FFFFULL;
+            bytes = (bytes | (bytes >> 16)) & 0x00000000FFFFFFFFULL;
+            
+            uint32_t packed = static_cast<uint32_t>(bytes);
+            std::memcpy(out + i, &packed, sizeof(packed));
         }
     }
     
-    return result;
+    for (; i < count; i++) {
+        unsigned hi = static_cast<unsigned char>(in[i * 2]);
+        unsigned lo = static_cast<unsigned char>(in[i * 2 + 1]);
+        hi = (hi & 0x0F) + (hi >> 6) * 9;
+        lo = (lo & 0x0F) + (lo >> 6) * 9;
+        out[i] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+    
+    return count;
 }
 
 // ============================================================================
@@ -645,6 +765,19 @@ std::string GDBMICommandBuilder::StackListFrames(int maxDepth, int token) {
     return builder.Build();
 }
 
+std::string GDBMICommandBuilder::StackListThreadFrames(int threadId, int lowFrame, int highFrame,
+                                                       int token) {
+    GDBMICommandBuilder builder;
+    builder.SetCommand("-stack-list-frames");
+    if (token >= 0) builder.SetToken(token);
+    builder.AddOption("--thread", std::to_string(threadId));
+    if (highFrame >= 0) {
+        builder.AddArgument(std::to_string(lowFrame));
+        builder.AddArgument(std::to_string(highFrame));
+    }
+    return builder.Build();
+}
+
 std::string GDBMICommandBuilder::StackListVariables(int printValues, int token) {
     GDBMICommandBuilder builder;
     builder.SetCommand("-stack-list-variables");
@@ -715,7 +848,21 @@ std::string GDBMICommandBuilder::DataDisassemble(uint64_t start, uint64_t end, i
     
     builder.AddOption("-s", startStr.str());
     builder.AddOption("-e", endStr.str());
-    builder.AddArgument("0"); // mode: disassembly only
+    builder.AddArgument("2"); // mode: disassembly with raw opcodes
+    return builder.Build();
+}
+
+std::string GDBMICommandBuilder::DataDisassembleFunction(uint64_t addr, int token) {
+    GDBMICommandBuilder builder;
+    builder.SetCommand("-data-disassemble");
+    if (token >= 0) builder.SetToken(token);
+    
+    // The whole function containing addr
+    std::ostringstream addrStr;
+    addrStr << "0x" << std::hex << addr;
+    builder.AddOption("-a", addrStr.str());
+    builder.AddArgument("--");
+    builder.AddArgument("2");
     return builder.Build();
 }
 
@@ -729,6 +876,16 @@ std::string GDBMICommandBuilder::VarCreate(const std::string& name, const std::s
     return builder.Build();
 }
 
+std::string GDBMICommandBuilder::VarCreateInFrame(const std::string& name, const std::string& expr, int token) {
+    GDBMICommandBuilder builder;
+    builder.SetCommand("-var-create");
+    if (token >= 0) builder.SetToken(token);
+    builder.AddArgument(name);
+    builder.AddArgument("*");  // bound to the selected frame
+    builder.AddQuotedArgument(expr);
+    return builder.Build();
+}
+
 std::string GDBMICommandBuilder::VarDelete(const std::string& name, int token) {
     GDBMICommandBuilder builder;
     builder.SetCommand("-var-delete");
@@ -746,6 +903,17 @@ std::string GDBMICommandBuilder::VarListChildren(const std::string& name, int to
     return builder.Build();
 }
 
+std::string GDBMICommandBuilder::VarListChildren(const std::string& name, int from, int to, int token) {
+    GDBMICommandBuilder builder;
+    builder.SetCommand("-var-list-children");
+    if (token >= 0) builder.SetToken(token);
+    builder.AddOption("--all-values");
+    builder.AddArgument(name);
+    builder.AddArgument(std::to_string(from));  // Children [from, to)
+    builder.AddArgument(std::to_string(to));
+    return builder.Build();
+}
+
 std::string GDBMICommandBuilder::VarEvaluate(const std::string& name, int token) {
     GDBMICommandBuilder builder;
     builder.SetCommand("-var-evaluate-expression");
@@ -763,5 +931,14 @@ std::string GDBMICommandBuilder::VarAssign(const std::string& name, const std::s
     return builder.Build();
 }
 
+std::string GDBMICommandBuilder::VarUpdate(const std::string& name, int token) {
+    GDBMICommandBuilder builder;
+    builder.SetCommand("-var-update");
+    if (token >= 0) builder.SetToken(token);
+    builder.AddOption("--all-values");
+    builder.AddArgument(name);
+    return builder.Build();
+}
+
 } // namespace IDE
 } // namespace UltraCanvas
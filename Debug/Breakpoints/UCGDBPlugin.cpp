@@ -118,35 +118,17 @@ bool UCGDBPlugin::Launch(const DebugLaunchConfig& config) {
     SetState(DebugSessionState::Starting);
     
     // Start GDB process
-    process_ = std::make_unique<UCGDBProcess>();
-    
     std::vector<std::string> gdbArgs = config_.gdbArgs;
     if (config_.asyncMode) {
         gdbArgs.push_back("--async");
     }
     
-    if (!process_->Start(gdbPath_, gdbArgs)) {
+    if (!StartGDB(gdbArgs)) {
         SetState(DebugSessionState::ErrorState);
         if (onError) onError("Failed to start GDB");
         return false;
     }
     
-    // Setup process callbacks
-    process_->onStdout = [this](const std::string& line) {
-        // Output handled by output thread
-    };
-    
-    process_->onStderr = [this](const std::string& err) {
-        if (onError) onError(err);
-    };
-    
-    process_->onExit = [this](int code) {
-        SetState(DebugSessionState::Terminated);
-    };
-    
-    // Wait for initial prompt
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    
     // Set executable
     if (!config.executablePath.empty()) {
         std::string cmd = "-file-exec-and-symbols \"" + 
@@ -180,6 +162,14 @@ bool UCGDBPlugin::Launch(const DebugLaunchConfig& config) {
         SendCommand("-enable-pretty-printing");
     }
     
+    // Bound the length of string and array values: a multi-megabyte
+    // std::string is shown truncated instead of crossing the MI channel
+    // in full at every stop. EvaluateFullValue reads the rest on demand;
+    // expanding an array reads its children in pages.
+    if (config_.printElements > 0) {
+        SendCommand("-gdb-set print elements " + std::to_string(config_.printElements));
+    }
+    
     // Set non-stop mode if async
     if (config_.asyncMode) {
         SendCommand("-gdb-set non-stop on");
@@ -201,10 +191,6 @@ bool UCGDBPlugin::Launch(const DebugLaunchConfig& config) {
     SetState(DebugSessionState::Running);
     sessionActive = true;
     
-    // Start output processing thread
-    stopOutputThread_ = false;
-    outputThread_ = std::thread(&UCGDBPlugin::ProcessOutput, this);
-    
     return true;
 }
 
@@ -215,14 +201,11 @@ bool UCGDBPlugin::Attach(int pid) {
     
     SetState(DebugSessionState::Starting);
     
-    process_ = std::make_unique<UCGDBProcess>();
-    if (!process_->Start(gdbPath_, config_.gdbArgs)) {
+    if (!StartGDB(config_.gdbArgs)) {
         SetState(DebugSessionState::ErrorState);
         return false;
     }
     
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    
     GDBMIRecord result = SendCommand("-target-attach " + std::to_string(pid));
     if (result.IsError()) {
         Terminate();
@@ -233,9 +216,6 @@ bool UCGDBPlugin::Attach(int pid) {
     SetState(DebugSessionState::Paused);
     sessionActive = true;
     
-    stopOutputThread_ = false;
-    outputThread_ = std::thread(&UCGDBPlugin::ProcessOutput, this);
-    
     return true;
 }
 
@@ -253,14 +233,11 @@ bool UCGDBPlugin::ConnectRemote(const std::string& host, int port) {
     
     SetState(DebugSessionState::Starting);
     
-    process_ = std::make_unique<UCGDBProcess>();
-    if (!process_->Start(gdbPath_, config_.gdbArgs)) {
+    if (!StartGDB(config_.gdbArgs)) {
         SetState(DebugSessionState::ErrorState);
         return false;
     }
     
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    
     std::string target = host + ":" + std::to_string(port);
     GDBMIRecord result = SendCommand("-target-select remote " + target);
     if (result.IsError()) {
@@ -272,9 +249,6 @@ bool UCGDBPlugin::ConnectRemote(const std::string& host, int port) {
     SetState(DebugSessionState::Paused);
     sessionActive = true;
     
-    stopOutputThread_ = false;
-    outputThread_ = std::thread(&UCGDBPlugin::ProcessOutput, this);
-    
     return true;
 }
 
@@ -285,14 +259,11 @@ bool UCGDBPlugin::LoadCoreDump(const std::string& corePath, const std::string& e
     
     SetState(DebugSessionState::Starting);
     
-    process_ = std::make_unique<UCGDBProcess>();
-    if (!process_->Start(gdbPath_, config_.gdbArgs)) {
+    if (!StartGDB(config_.gdbArgs)) {
         SetState(DebugSessionState::ErrorState);
         return false;
     }
     
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    
     // Load executable
     GDBMIRecord result = SendCommand("-file-exec-and-symbols \"" + 
                                      UCGDBMIParser::Escape(executablePath) + "\"");
@@ -316,6 +287,31 @@ bool UCGDBPlugin::LoadCoreDump(const std::string& corePath, const std::string& e
     return true;
 }
 
+bool UCGDBPlugin::StartGDB(const std::vector<std::string>& args) {
+    process_ = std::make_unique<UCGDBProcess>();
+    
+    // Callbacks run on the process's I/O thread, so set them before it starts
+    process_->onStderr = [this](const std::string& err) {
+        if (onError) onError(err);
+    };
+    
+    process_->onExit = [this](int code) {
+        SetState(DebugSessionState::Terminated);
+    };
+    
+    if (!process_->Start(gdbPath_, args)) {
+        process_.reset();
+        return false;
+    }
+    
+    // Responses are matched up by the output thread, so it has to run
+    // before the first command. GDB queues commands sent before its
+    // first prompt; there is nothing to wait for.
+    stopOutputThread_ = false;
+    outputThread_ = std::thread(&UCGDBPlugin::ProcessOutput, this);
+    return true;
+}
+
 bool UCGDBPlugin::Detach() {
     if (!IsSessionActive()) return true;
     
@@ -362,6 +358,7 @@ bool UCGDBPlugin::IsSessionActive() const {
 bool UCGDBPlugin::Continue() {
     if (state_ != DebugSessionState::Paused) return false;
     
+    AdvanceStopGeneration();
     GDBMIRecord result = SendCommand("-exec-continue");
     if (result.IsSuccess() || result.resultClass == GDBMIResultClass::Running) {
         SetState(DebugSessionState::Running);
@@ -382,6 +379,7 @@ bool UCGDBPlugin::StepOver() {
     if (state_ != DebugSessionState::Paused) return false;
     
     SetState(DebugSessionState::Stepping);
+    AdvanceStopGeneration();
     GDBMIRecord result = SendCommand("-exec-next");
     return result.IsSuccess() || result.resultClass == GDBMIResultClass::Running;
 }
@@ -390,6 +388,7 @@ bool UCGDBPlugin::StepInto() {
     if (state_ != DebugSessionState::Paused) return false;
     
     SetState(DebugSessionState::Stepping);
+    AdvanceStopGeneration();
     GDBMIRecord result = SendCommand("-exec-step");
     return result.IsSuccess() || result.resultClass == GDBMIResultClass::Running;
 }
@@ -398,6 +397,7 @@ bool UCGDBPlugin::StepOut() {
     if (state_ != DebugSessionState::Paused) return false;
     
     SetState(DebugSessionState::Stepping);
+    AdvanceStopGeneration();
     GDBMIRecord result = SendCommand("-exec-finish");
     return result.IsSuccess() || result.resultClass == GDBMIResultClass::Running;
 }
@@ -423,6 +423,7 @@ bool UCGDBPlugin::SetNextStatement(const std::string& file, int line) {
     if (state_ != DebugSessionState::Paused) return false;
     
     std::string location = file + ":" + std::to_string(line);
+    AdvanceStopGeneration();
     GDBMIRecord result = SendCommand("-exec-jump \"" + 
                                      UCGDBMIParser::Escape(location) + "\"");
     return result.IsSuccess();
@@ -432,6 +433,7 @@ bool UCGDBPlugin::StepInstruction() {
     if (state_ != DebugSessionState::Paused) return false;
     
     SetState(DebugSessionState::Stepping);
+    AdvanceStopGeneration();
     GDBMIRecord result = SendCommand("-exec-step-instruction");
     return result.IsSuccess() || result.resultClass == GDBMIResultClass::Running;
 }
@@ -464,20 +466,46 @@ void UCGDBPlugin::SetState(DebugSessionState newState) {
 void UCGDBPlugin::Cleanup() {
     stopOutputThread_ = true;
     
+    // Stopping the process wakes the output thread out of ReadLine
+    if (process_) {
+        process_->Stop();
+    }
+    
     if (outputThread_.joinable()) {
         outputThread_.join();
     }
+    outputThreadId_ = std::thread::id();
     
-    if (process_) {
-        process_->Stop();
-        process_.reset();
-    }
+    process_.reset();
     
     // Clear state
+    FailPendingCommands("Session ended");
     breakpoints_.clear();
     watchpoints_.clear();
-    variableObjects_.clear();
-    pendingCommands_.clear();
+    {
+        std::lock_guard<std::mutex> lock(varObjectMutex_);
+        varObjects_.clear();
+        variableObjects_.clear();
+        watchVarObjects_.clear();
+        localVarObjects_.clear();
+        localValues_.clear();
+        localScope_.clear();
+        localScopeGeneration_ = 0;
+        varUpdateGeneration_ = 0;
+    }
+    inferiorPid_ = 0;
+    {
+        std::lock_guard<std::mutex> lock(memoryMutex_);
+        CloseDirectMemory();
+        memoryPages_.clear();
+    }
+    {
+        // The disassembly itself is kept for the next session
+        std::lock_guard<std::mutex> lock(disassemblyMutex_);
+        codeModules_.clear();
+        codeModulesStale_ = true;
+        disassemblyPrefetches_.clear();
+    }
     
     sessionActive = false;
 }
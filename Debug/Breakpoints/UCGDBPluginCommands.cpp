@@ -9,6 +9,7 @@
 #include <sstream>
 #include <chrono>
 #include <future>
+#include <algorithm>
 
 namespace UltraCanvas {
 namespace IDE {
@@ -18,49 +19,174 @@ namespace IDE {
 // ============================================================================
 
 GDBMIRecord UCGDBPlugin::SendCommand(const std::string& command) {
+    std::future<GDBMIRecord> future = SendCommandAsync(command, GDBCommandPriority::High);
+    return WaitForResult(future);
+}
+
+GDBMIRecord UCGDBPlugin::WaitForResult(std::future<GDBMIRecord>& future) {
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(config_.commandTimeout);
+    
+    if (std::this_thread::get_id() == outputThreadId_) {
+        // Called from an event callback (a stop handler refreshing a panel):
+        // nobody else is reading GDB's output, so read it here until our
+        // result is in. Records for other commands are dispatched as usual.
+        while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+            if (remaining <= 0 || !process_) break;
+            
+            std::string line = process_->ReadLine(static_cast<int>(remaining));
+            if (line.empty()) break;
+            DispatchLine(std::move(line));
+        }
+    } else {
+        future.wait_until(deadline);
+    }
+    
+    if (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return GDBMIRecord::MakeError("Command timeout");
+    }
+    return future.get();
+}
+
+int UCGDBPlugin::SendCommandAsync(const std::string& command, GDBCommandCallback callback,
+                                  GDBCommandPriority priority, bool stopScoped) {
     if (!process_ || !process_->IsRunning()) {
-        GDBMIRecord error;
-        error.type = GDBMIRecordType::Result;
-        error.resultClass = GDBMIResultClass::Error;
-        error.results["msg"] = GDBMIValue("Process not running");
-        return error;
+        return -1;
     }
     
-    int token = GetNextToken();
-    std::string fullCommand = std::to_string(token) + command;
+    PendingCommand pending;
+    pending.token = GetNextToken();
+    pending.command = command;
+    pending.callback = std::move(callback);
+    pending.generation = stopScoped ? stopGeneration_.load() : 0;
+    int token = pending.token;
+    
+    std::lock_guard<std::mutex> lock(commandMutex_);
+    queuedCommands_[static_cast<size_t>(priority)].push_back(std::move(pending));
+    SendQueuedCommands();
+    return token;
+}
+
+std::future<GDBMIRecord> UCGDBPlugin::SendCommandAsync(const std::string& command,
+                                                       GDBCommandPriority priority,
+                                                       bool stopScoped) {
+    auto promise = std::make_shared<std::promise<GDBMIRecord>>();
+    std::future<GDBMIRecord> future = promise->get_future();
     
-    // Create promise for response
-    std::promise<GDBMIRecord> promise;
-    std::future<GDBMIRecord> future = promise.get_future();
+    int token = SendCommandAsync(command, [promise](const GDBMIRecord& record) {
+        promise->set_value(record);
+    }, priority, stopScoped);
     
+    if (token < 0) {
+        promise->set_value(GDBMIRecord::MakeError("Process not running"));
+    }
+    return future;
+}
+
+bool UCGDBPlugin::CancelCommand(int token) {
+    GDBCommandCallback callback;
     {
         std::lock_guard<std::mutex> lock(commandMutex_);
-        pendingCommands_[token] = std::move(promise);
+        auto it = pendingCommands_.find(token);
+        if (it != pendingCommands_.end()) {
+            // Already sent: GDB will still run it, the result is dropped
+            callback = std::move(it->second.callback);
+            pendingCommands_.erase(it);
+            SendQueuedCommands();
+        } else {
+            for (auto& queue : queuedCommands_) {
+                auto queued = std::find_if(queue.begin(), queue.end(),
+                    [token](const PendingCommand& c) { return c.token == token; });
+                if (queued != queue.end()) {
+                    callback = std::move(queued->callback);
+                    queue.erase(queued);
+                    break;
+                }
+            }
+        }
     }
     
-    // Send command
-    process_->SendLine(fullCommand);
+    if (!callback) return false;
+    callback(GDBMIRecord::MakeError("Cancelled"));
+    return true;
+}
+
+void UCGDBPlugin::SendQueuedCommands() {
+    // Caller holds commandMutex_; writing under it keeps tokens in send order
+    size_t limit = static_cast<size_t>(std::max(1, config_.maxCommandsInFlight));
     
-    // Wait for response with timeout
-    auto status = future.wait_for(std::chrono::milliseconds(config_.commandTimeout));
+    for (auto& queue : queuedCommands_) {
+        while (!queue.empty() && pendingCommands_.size() < limit) {
+            PendingCommand pending = std::move(queue.front());
+            queue.pop_front();
+            
+            int token = pending.token;
+            if (!process_ || !process_->SendLine(std::to_string(token) + pending.command)) {
+                // Completed by FailPendingCommands once GDB's exit is seen
+                queue.push_front(std::move(pending));
+                return;
+            }
+            pendingCommands_.emplace(token, std::move(pending));
+        }
+    }
+}
+
+void UCGDBPlugin::AdvanceStopGeneration() {
+    uint64_t current = ++stopGeneration_;
     
-    if (status == std::future_status::timeout) {
+    // Whatever was asked about the previous stop is now stale. Queued
+    // commands are dropped unsent; sent ones keep their window slot until
+    // GDB answers, but nobody waits for the answer.
+    std::vector<GDBCommandCallback> cancelled;
+    {
         std::lock_guard<std::mutex> lock(commandMutex_);
-        pendingCommands_.erase(token);
-        
-        GDBMIRecord timeout;
-        timeout.type = GDBMIRecordType::Result;
-        timeout.resultClass = GDBMIResultClass::Error;
-        timeout.results["msg"] = GDBMIValue("Command timeout");
-        return timeout;
+        for (auto& queue : queuedCommands_) {
+            for (auto it = queue.begin(); it != queue.end();) {
+                if (it->generation != 0 && it->generation < current) {
+                    cancelled.push_back(std::move(it->callback));
+                    it = queue.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+        for (auto& pair : pendingCommands_) {
+            PendingCommand& pending = pair.second;
+            if (pending.generation != 0 && pending.generation < current && pending.callback) {
+                cancelled.push_back(std::move(pending.callback));
+                pending.callback = nullptr;
+            }
+        }
     }
     
-    return future.get();
+    GDBMIRecord record = GDBMIRecord::MakeError("Cancelled");
+    for (auto& callback : cancelled) {
+        if (callback) callback(record);
+    }
 }
 
-GDBMIRecord UCGDBPlugin::SendCommandAsync(const std::string& command) {
-    // For now, same as sync
-    return SendCommand(command);
+void UCGDBPlugin::FailPendingCommands(const std::string& error) {
+    std::vector<GDBCommandCallback> failed;
+    {
+        std::lock_guard<std::mutex> lock(commandMutex_);
+        for (auto& pair : pendingCommands_) {
+            failed.push_back(std::move(pair.second.callback));
+        }
+        pendingCommands_.clear();
+        for (auto& queue : queuedCommands_) {
+            for (auto& pending : queue) {
+                failed.push_back(std::move(pending.callback));
+            }
+            queue.clear();
+        }
+    }
+    
+    GDBMIRecord record = GDBMIRecord::MakeError(error);
+    for (auto& callback : failed) {
+        if (callback) callback(record);
+    }
 }
 
 bool UCGDBPlugin::SendCommandNoWait(const std::string& command) {
@@ -78,26 +204,49 @@ bool UCGDBPlugin::SendCommandNoWait(const std::string& command) {
 // ============================================================================
 
 void UCGDBPlugin::ProcessOutput() {
-    while (!stopOutputThread_ && process_ && process_->IsRunning()) {
-        std::string line = process_->ReadLine(100);
-        if (line.empty()) continue;
+    // Before the first record: a callback it dispatches may already wait
+    // for a result, and must read the output itself (WaitForResult)
+    outputThreadId_ = std::this_thread::get_id();
+    
+    // ReadLine wakes as soon as a line is complete, and returns "" only
+    // once GDB has exited (or Stop() was called) and its output is drained
+    while (!stopOutputThread_ && process_) {
+        std::string line = process_->ReadLine();
+        if (line.empty()) break;
         
-        GDBMIRecord record = parser_->ParseLine(line);
-        
-        if (record.type == GDBMIRecordType::Result && record.token >= 0) {
-            // This is a response to a command
+        DispatchLine(std::move(line));
+    }
+    
+    FailPendingCommands("GDB exited");
+}
+
+void UCGDBPlugin::DispatchLine(std::string line) {
+    GDBMIRecord record = parser_->ParseLine(std::move(line));
+    
+    if (record.type == GDBMIRecordType::Result && record.token >= 0) {
+        // This is a response to a command; its window slot goes to the
+        // next queued command before the callback runs
+        GDBCommandCallback callback;
+        bool stale = false;
+        {
             std::lock_guard<std::mutex> lock(commandMutex_);
             auto it = pendingCommands_.find(record.token);
-            if (it != pendingCommands_.end()) {
-                it->second.set_value(record);
-                pendingCommands_.erase(it);
-            }
-        } else if (record.IsAsync()) {
-            HandleAsyncRecord(record);
-        } else if (record.IsStream()) {
-            if (onOutput) {
-                onOutput(record.streamContent);
-            }
+            if (it == pendingCommands_.end()) return;
+            
+            callback = std::move(it->second.callback);
+            stale = it->second.generation != 0 && it->second.generation < stopGeneration_;
+            pendingCommands_.erase(it);
+            SendQueuedCommands();
+        }
+        
+        if (callback) {
+            callback(stale ? GDBMIRecord::MakeError("Cancelled") : record);
+        }
+    } else if (record.IsAsync()) {
+        HandleAsyncRecord(record);
+    } else if (record.IsStream()) {
+        if (onOutput) {
+            onOutput(record.streamContent);
         }
     }
 }
@@ -123,6 +272,11 @@ void UCGDBPlugin::HandleAsyncRecord(const GDBMIRecord& record) {
             HandleThreadEvent(record);
             break;
             
+        case GDBMIAsyncClass::ThreadGroupStarted:
+        case GDBMIAsyncClass::ThreadGroupExited:
+            HandleThreadGroupEvent(record);
+            break;
+            
         case GDBMIAsyncClass::LibraryLoaded:
         case GDBMIAsyncClass::LibraryUnloaded:
             HandleLibraryEvent(record);
@@ -140,19 +294,14 @@ void UCGDBPlugin::HandleStopEvent(const GDBMIRecord& record) {
     SourceLocation location;
     
     // Parse reason
-    std::string reasonStr;
-    auto reasonIt = record.results.find("reason");
-    if (reasonIt != record.results.end() && reasonIt->second.IsString()) {
-        reasonStr = reasonIt->second.stringValue;
-    }
+    std::string_view reasonStr = record.results.Get("reason").AsString();
     
     if (reasonStr == "breakpoint-hit") {
         reason = StopReason::Breakpoint;
         
         // Get breakpoint ID
-        auto bkptnoIt = record.results.find("bkptno");
-        if (bkptnoIt != record.results.end()) {
-            int bpNum = std::stoi(bkptnoIt->second.stringValue);
+        if (record.results.Has("bkptno")) {
+            int bpNum = record.results.GetInt("bkptno");
             for (auto& pair : breakpoints_) {
                 if (pair.second.debuggerId == bpNum) {
                     pair.second.hitCount++;
@@ -178,29 +327,21 @@ void UCGDBPlugin::HandleStopEvent(const GDBMIRecord& record) {
     }
     
     // Parse frame for location
-    auto frameIt = record.results.find("frame");
-    if (frameIt != record.results.end() && frameIt->second.IsTuple()) {
-        const auto& frame = frameIt->second.tupleValue;
-        
-        auto fileIt = frame.find("fullname");
-        if (fileIt == frame.end()) {
-            fileIt = frame.find("file");
+    GDBMIValue frame = record.results.Get("frame");
+    if (frame.IsTuple()) {
+        GDBMIValue file = frame.Get("fullname");
+        if (!file.IsValid()) {
+            file = frame.Get("file");
         }
-        if (fileIt != frame.end() && fileIt->second.IsString()) {
-            location.filePath = fileIt->second.stringValue;
+        if (file.IsString()) {
+            location.filePath = file.AsString();
         }
         
-        auto lineIt = frame.find("line");
-        if (lineIt != frame.end() && lineIt->second.IsString()) {
-            location.line = std::stoi(lineIt->second.stringValue);
-        }
+        location.line = frame.GetInt("line", location.line);
     }
     
     // Update thread ID
-    auto threadIt = record.results.find("thread-id");
-    if (threadIt != record.results.end() && threadIt->second.IsString()) {
-        currentThreadId_ = std::stoi(threadIt->second.stringValue);
-    }
+    currentThreadId_ = record.results.GetInt("thread-id", currentThreadId_);
     
     if (onTargetStop) {
         onTargetStop(reason, location);
@@ -217,6 +358,7 @@ void UCGDBPlugin::HandleStopEvent(const GDBMIRecord& record) {
 }
 
 void UCGDBPlugin::HandleRunningEvent(const GDBMIRecord& record) {
+    AdvanceStopGeneration();
     SetState(DebugSessionState::Running);
     
     if (onTargetContinue) {
@@ -225,26 +367,20 @@ void UCGDBPlugin::HandleRunningEvent(const GDBMIRecord& record) {
 }
 
 void UCGDBPlugin::HandleBreakpointEvent(const GDBMIRecord& record) {
-    auto bkptIt = record.results.find("bkpt");
-    if (bkptIt == record.results.end() || !bkptIt->second.IsTuple()) {
+    GDBMIValue bkpt = record.results.Get("bkpt");
+    if (!bkpt.IsTuple() || !bkpt.Has("number")) {
         return;
     }
     
-    const auto& bkpt = bkptIt->second.tupleValue;
-    
-    auto numIt = bkpt.find("number");
-    if (numIt == bkpt.end()) return;
-    
-    int bpNum = std::stoi(numIt->second.stringValue);
+    int bpNum = bkpt.GetInt("number");
     
     // Find our breakpoint
     for (auto& pair : breakpoints_) {
         if (pair.second.debuggerId == bpNum) {
             // Update state
-            auto enabledIt = bkpt.find("enabled");
-            if (enabledIt != bkpt.end()) {
-                bool enabled = enabledIt->second.stringValue == "y";
-                pair.second.enabled = enabled;
+            GDBMIValue enabled = bkpt.Get("enabled");
+            if (enabled.IsString()) {
+                pair.second.enabled = enabled.AsString() == "y";
             }
             
             if (onBreakpointChange) {
@@ -256,10 +392,9 @@ void UCGDBPlugin::HandleBreakpointEvent(const GDBMIRecord& record) {
 }
 
 void UCGDBPlugin::HandleThreadEvent(const GDBMIRecord& record) {
-    auto idIt = record.results.find("id");
-    if (idIt == record.results.end()) return;
+    if (!record.results.Has("id")) return;
     
-    int threadId = std::stoi(idIt->second.stringValue);
+    int threadId = record.results.GetInt("id");
     
     if (record.asyncClass == GDBMIAsyncClass::ThreadCreated) {
         if (onThreadCreate) {
@@ -274,13 +409,24 @@ void UCGDBPlugin::HandleThreadEvent(const GDBMIRecord& record) {
     }
 }
 
+void UCGDBPlugin::HandleThreadGroupEvent(const GDBMIRecord& record) {
+    // The inferior's pid lets ReadMemory read it without going through GDB
+    if (record.asyncClass == GDBMIAsyncClass::ThreadGroupStarted) {
+        inferiorPid_ = record.results.GetInt("pid");
+    } else {
+        inferiorPid_ = 0;
+    }
+    
+    std::lock_guard<std::mutex> lock(disassemblyMutex_);
+    codeModulesStale_ = true;
+}
+
 void UCGDBPlugin::HandleLibraryEvent(const GDBMIRecord& record) {
-    auto idIt = record.results.find("id");
-    auto targetIt = record.results.find("target-name");
+    std::string libPath = record.results.GetString("target-name");
     
-    std::string libPath;
-    if (targetIt != record.results.end()) {
-        libPath = targetIt->second.stringValue;
+    {
+        std::lock_guard<std::mutex> lock(disassemblyMutex_);
+        codeModulesStale_ = true;
     }
     
     if (record.asyncClass == GDBMIAsyncClass::LibraryLoaded) {
@@ -441,47 +587,29 @@ Breakpoint UCGDBPlugin::ParseBreakpointResult(const GDBMIRecord& record) {
         return bp;
     }
     
-    auto bkptIt = record.results.find("bkpt");
-    if (bkptIt == record.results.end() || !bkptIt->second.IsTuple()) {
+    GDBMIValue bkpt = record.results.Get("bkpt");
+    if (!bkpt.IsTuple()) {
         bp.state = BreakpointState::Invalid;
         return bp;
     }
     
-    const auto& bkpt = bkptIt->second.tupleValue;
-    
     // Get debugger's breakpoint number
-    auto numIt = bkpt.find("number");
-    if (numIt != bkpt.end()) {
-        bp.debuggerId = std::stoi(numIt->second.stringValue);
-    }
+    bp.debuggerId = bkpt.GetInt("number", bp.debuggerId);
     
     // Get location
-    auto fileIt = bkpt.find("fullname");
-    if (fileIt == bkpt.end()) {
-        fileIt = bkpt.find("file");
-    }
-    if (fileIt != bkpt.end()) {
-        bp.location.filePath = fileIt->second.stringValue;
-    }
-    
-    auto lineIt = bkpt.find("line");
-    if (lineIt != bkpt.end()) {
-        bp.location.line = std::stoi(lineIt->second.stringValue);
+    GDBMIValue file = bkpt.Get("fullname");
+    if (!file.IsValid()) {
+        file = bkpt.Get("file");
     }
+    bp.location.filePath = file.AsString();
+    bp.location.line = bkpt.GetInt("line", bp.location.line);
+    bp.functionName = bkpt.GetString("func");
     
-    auto funcIt = bkpt.find("func");
-    if (funcIt != bkpt.end()) {
-        bp.functionName = funcIt->second.stringValue;
-    }
-    
-    auto addrIt = bkpt.find("addr");
-    if (addrIt != bkpt.end() && addrIt->second.stringValue != "<PENDING>") {
-        bp.address = std::stoull(addrIt->second.stringValue, nullptr, 16);
-    }
+    // "<PENDING>" and "<MULTIPLE>" leave the address unset
+    bp.address = bkpt.GetUInt64("addr", bp.address);
     
     // Check if pending
-    auto pendingIt = bkpt.find("pending");
-    if (pendingIt != bkpt.end()) {
+    if (bkpt.Has("pending")) {
         bp.state = BreakpointState::Pending;
         bp.pending = true;
     } else {
@@ -527,13 +655,7 @@ Watchpoint UCGDBPlugin::AddWatchpoint(const std::string& expression,
     GDBMIRecord result = SendCommand(cmd);
     
     if (result.IsSuccess()) {
-        auto wptIt = result.results.find("wpt");
-        if (wptIt != result.results.end() && wptIt->second.IsTuple()) {
-            auto numIt = wptIt->second.tupleValue.find("number");
-            if (numIt != wptIt->second.tupleValue.end()) {
-                wp.debuggerId = std::stoi(numIt->second.stringValue);
-            }
-        }
+        wp.debuggerId = result.results.Get("wpt").GetInt("number", wp.debuggerId);
         watchpoints_[wp.id] = wp;
     }
     
@@ -7,6 +7,19 @@
 #include "UCGDBPlugin.h"
 #include <sstream>
 #include <iomanip>
+#include <charconv>
+#include <algorithm>
+#include <fstream>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+
+#ifdef __linux__
+#include <elf.h>
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace UltraCanvas {
 namespace IDE {
@@ -21,20 +34,20 @@ std::vector<ThreadInfo> UCGDBPlugin::GetThreads() {
     GDBMIRecord result = SendCommand("-thread-info");
     if (!result.IsSuccess()) return threads;
     
-    auto threadsIt = result.results.find("threads");
-    if (threadsIt == result.results.end() || !threadsIt->second.IsList()) {
+    GDBMIValue threadList = result.results.Get("threads");
+    if (!threadList.IsList()) {
         return threads;
     }
     
-    for (const auto& threadVal : threadsIt->second.listValue) {
+    threads.reserve(threadList.Size());
+    for (GDBMIValue threadVal : threadList) {
         if (threadVal.IsTuple()) {
-            threads.push_back(ParseThreadResult(threadVal.tupleValue));
+            threads.push_back(ParseThreadResult(threadVal));
         }
     }
     
-    auto currentIt = result.results.find("current-thread-id");
-    if (currentIt != result.results.end()) {
-        int currentId = std::stoi(currentIt->second.stringValue);
+    if (result.results.Has("current-thread-id")) {
+        int currentId = result.results.GetInt("current-thread-id");
         for (auto& thread : threads) {
             thread.isCurrent = (thread.id == currentId);
         }
@@ -60,33 +73,27 @@ bool UCGDBPlugin::SwitchThread(int threadId) {
     return false;
 }
 
-ThreadInfo UCGDBPlugin::ParseThreadResult(const std::map<std::string, GDBMIValue>& thread) {
+ThreadInfo UCGDBPlugin::ParseThreadResult(const GDBMIValue& thread) {
     ThreadInfo info;
     
-    auto idIt = thread.find("id");
-    if (idIt != thread.end()) info.id = std::stoi(idIt->second.stringValue);
-    
-    auto targetIdIt = thread.find("target-id");
-    if (targetIdIt != thread.end()) info.name = targetIdIt->second.stringValue;
+    info.id = thread.GetInt("id", info.id);
+    info.name = thread.GetString("target-id");
     
-    auto stateIt = thread.find("state");
-    if (stateIt != thread.end()) {
-        info.state = (stateIt->second.stringValue == "stopped") ? 
+    GDBMIValue state = thread.Get("state");
+    if (state.IsString()) {
+        info.state = (state.AsString() == "stopped") ? 
             DebugSessionState::Paused : DebugSessionState::Running;
     }
     
-    auto frameIt = thread.find("frame");
-    if (frameIt != thread.end() && frameIt->second.IsTuple()) {
-        const auto& frame = frameIt->second.tupleValue;
-        auto funcIt = frame.find("func");
-        if (funcIt != frame.end()) info.currentFunction = funcIt->second.stringValue;
+    GDBMIValue frame = thread.Get("frame");
+    if (frame.IsTuple()) {
+        info.currentFunction = frame.GetString("func");
         
-        auto fileIt = frame.find("fullname");
-        if (fileIt == frame.end()) fileIt = frame.find("file");
-        if (fileIt != frame.end()) info.currentLocation.filePath = fileIt->second.stringValue;
+        GDBMIValue file = frame.Get("fullname");
+        if (!file.IsValid()) file = frame.Get("file");
+        info.currentLocation.filePath = file.AsString();
         
-        auto lineIt = frame.find("line");
-        if (lineIt != frame.end()) info.currentLocation.line = std::stoi(lineIt->second.stringValue);
+        info.currentLocation.line = frame.GetInt("line", info.currentLocation.line);
     }
     
     return info;
@@ -101,27 +108,27 @@ std::vector<StackFrame> UCGDBPlugin::GetCallStack(int maxFrames) {
 }
 
 std::vector<StackFrame> UCGDBPlugin::GetCallStack(int threadId, int maxFrames) {
-    std::vector<StackFrame> frames;
-    
-    if (threadId != currentThreadId_) SwitchThread(threadId);
-    
-    GDBMIRecord result = SendCommand(GDBMICommandBuilder::StackListFrames(maxFrames));
-    if (!result.IsSuccess()) return frames;
-    
-    auto stackIt = result.results.find("stack");
-    if (stackIt == result.results.end() || !stackIt->second.IsList()) return frames;
+    if (maxFrames > 0) return GetCallStackRange(threadId, 0, maxFrames);
     
-    for (const auto& frameVal : stackIt->second.listValue) {
-        if (frameVal.IsTuple()) {
-            auto frameIt = frameVal.tupleValue.find("frame");
-            if (frameIt != frameVal.tupleValue.end() && frameIt->second.IsTuple()) {
-                frames.push_back(ParseFrameResult(frameIt->second.tupleValue));
-            } else {
-                frames.push_back(ParseFrameResult(frameVal.tupleValue));
-            }
-        }
+    GDBMIRecord result = SendCommand(GDBMICommandBuilder::StackListThreadFrames(threadId, 0, -1));
+    std::vector<StackFrame> frames = ParseStackResult(result);
+    for (auto& frame : frames) {
+        frame.threadId = threadId;
+    }
+    return frames;
+}
+
+std::vector<StackFrame> UCGDBPlugin::GetCallStackRange(int threadId, int startFrame, int count) {
+    if (count <= 0) return {};
+    
+    // --thread reads the stack without selecting the thread: requests
+    // running meanwhile keep evaluating in the selected one
+    GDBMIRecord result = SendCommand(GDBMICommandBuilder::StackListThreadFrames(
+        threadId, startFrame, startFrame + count - 1));
+    std::vector<StackFrame> frames = ParseStackResult(result);
+    for (auto& frame : frames) {
+        frame.threadId = threadId;
     }
-    
     return frames;
 }
 
@@ -135,50 +142,59 @@ bool UCGDBPlugin::SwitchFrame(int frameLevel) {
 }
 
 StackFrame UCGDBPlugin::GetCurrentFrame() {
-    auto frames = GetCallStack(1);
+    auto frames = GetCallStack(currentThreadId_, 1);
     return frames.empty() ? StackFrame() : frames[0];
 }
 
-StackFrame UCGDBPlugin::ParseFrameResult(const std::map<std::string, GDBMIValue>& frame) {
-    StackFrame sf;
+std::vector<StackFrame> UCGDBPlugin::ParseStackResult(const GDBMIRecord& record) {
+    std::vector<StackFrame> frames;
+    if (!record.IsSuccess()) return frames;
     
-    auto levelIt = frame.find("level");
-    if (levelIt != frame.end()) sf.level = std::stoi(levelIt->second.stringValue);
+    GDBMIValue stack = record.results.Get("stack");
+    if (!stack.IsList()) return frames;
     
-    auto funcIt = frame.find("func");
-    if (funcIt != frame.end()) sf.functionName = funcIt->second.stringValue;
+    frames.reserve(stack.Size());
+    for (GDBMIValue frameVal : stack) {
+        if (frameVal.IsTuple()) {
+            GDBMIValue frame = frameVal.Get("frame");
+            frames.push_back(ParseFrameResult(frame.IsTuple() ? frame : frameVal));
+        }
+    }
     
-    auto fileIt = frame.find("fullname");
-    if (fileIt == frame.end()) fileIt = frame.find("file");
-    if (fileIt != frame.end()) sf.location.filePath = fileIt->second.stringValue;
+    return frames;
+}
+
+StackFrame UCGDBPlugin::ParseFrameResult(const GDBMIValue& frame) {
+    StackFrame sf;
     
-    auto lineIt = frame.find("line");
-    if (lineIt != frame.end()) sf.location.line = std::stoi(lineIt->second.stringValue);
+    sf.level = frame.GetInt("level", sf.level);
+    sf.functionName = frame.GetString("func");
     
-    auto addrIt = frame.find("addr");
-    if (addrIt != frame.end()) {
-        sf.address = std::stoull(addrIt->second.stringValue, nullptr, 16);
-    }
+    GDBMIValue file = frame.Get("fullname");
+    if (!file.IsValid()) file = frame.Get("file");
+    sf.location.filePath = file.AsString();
+    
+    sf.location.line = frame.GetInt("line", sf.location.line);
+    sf.address = frame.GetUInt64("addr", sf.address);
     
-    auto argsIt = frame.find("args");
-    if (argsIt != frame.end() && argsIt->second.IsList()) {
-        std::ostringstream args;
+    GDBMIValue argList = frame.Get("args");
+    if (argList.IsList()) {
+        std::string args;
         bool first = true;
-        for (const auto& arg : argsIt->second.listValue) {
-            if (!first) args << ", ";
+        for (GDBMIValue arg : argList) {
+            if (!first) args += ", ";
             first = false;
-            if (arg.IsTuple()) {
-                auto nameIt = arg.tupleValue.find("name");
-                auto valueIt = arg.tupleValue.find("value");
-                if (nameIt != arg.tupleValue.end()) {
-                    args << nameIt->second.stringValue;
-                    if (valueIt != arg.tupleValue.end()) {
-                        args << "=" << valueIt->second.stringValue;
-                    }
+            GDBMIValue name = arg.Get("name");
+            if (name.IsString()) {
+                args += name.AsString();
+                GDBMIValue value = arg.Get("value");
+                if (value.IsString()) {
+                    args += '=';
+                    args += value.AsString();
                 }
             }
         }
-        sf.args = args.str();
+        sf.args = std::move(args);
     }
     
     sf.hasDebugInfo = !sf.location.filePath.empty();
@@ -191,42 +207,67 @@ StackFrame UCGDBPlugin::ParseFrameResult(const std::map<std::string, GDBMIValue>
 // VARIABLES
 // ============================================================================
 
+namespace {
+
+// GDB ends a value cut at "print elements" with "...": "abc"... for a
+// string, {1, 2, 3...} for an array
+bool IsCutAtLengthLimit(const std::string& value) {
+    size_t end = value.size();
+    if (end > 0 && value[end - 1] == '}') end--;
+    return end >= 3 && value.compare(end - 3, 3, "...") == 0;
+}
+
+} // anonymous namespace
+
 std::vector<Variable> UCGDBPlugin::GetLocals() {
-    std::vector<Variable> vars;
-    
     GDBMIRecord result = SendCommand(GDBMICommandBuilder::StackListLocals(2));
-    if (!result.IsSuccess()) return vars;
+    std::vector<Variable> vars = ParseLocalsResult(result);
+    TrackLocals(vars);
+    return vars;
+}
+
+std::vector<Variable> UCGDBPlugin::GetArguments() {
+    // Frame range "0 0": only the selected frame, not the whole stack
+    GDBMIRecord result = SendCommand(GDBMICommandBuilder::StackListArguments(2) + " 0 0");
+    std::vector<Variable> vars = ParseArgumentsResult(result);
+    TrackLocals(vars);
+    return vars;
+}
+
+std::vector<Variable> UCGDBPlugin::ParseLocalsResult(const GDBMIRecord& record) {
+    std::vector<Variable> vars;
+    if (!record.IsSuccess()) return vars;
     
-    auto localsIt = result.results.find("locals");
-    if (localsIt == result.results.end() || !localsIt->second.IsList()) return vars;
+    GDBMIValue locals = record.results.Get("locals");
+    if (!locals.IsList()) return vars;
     
-    for (const auto& varVal : localsIt->second.listValue) {
+    vars.reserve(locals.Size());
+    for (GDBMIValue varVal : locals) {
         if (varVal.IsTuple()) {
-            vars.push_back(ParseVariableResult(varVal.tupleValue));
+            vars.push_back(ParseVariableResult(varVal));
         }
     }
     
     return vars;
 }
 
-std::vector<Variable> UCGDBPlugin::GetArguments() {
+std::vector<Variable> UCGDBPlugin::ParseArgumentsResult(const GDBMIRecord& record) {
     std::vector<Variable> vars;
+    if (!record.IsSuccess()) return vars;
     
-    GDBMIRecord result = SendCommand(GDBMICommandBuilder::StackListArguments(2));
-    if (!result.IsSuccess()) return vars;
-    
-    auto stackArgsIt = result.results.find("stack-args");
-    if (stackArgsIt == result.results.end() || !stackArgsIt->second.IsList()) return vars;
+    GDBMIValue stackArgs = record.results.Get("stack-args");
+    if (!stackArgs.IsList()) return vars;
     
-    for (const auto& frameVal : stackArgsIt->second.listValue) {
-        if (!frameVal.IsTuple()) continue;
-        
-        auto argsIt = frameVal.tupleValue.find("args");
-        if (argsIt == frameVal.tupleValue.end() || !argsIt->second.IsList()) continue;
+    for (GDBMIValue frameVal : stackArgs) {
+        // Elements are frame={level=...,args=[...]}
+        GDBMIValue frame = frameVal.Get("frame");
+        GDBMIValue args = (frame.IsTuple() ? frame : frameVal).Get("args");
+        if (!args.IsList()) continue;
         
-        for (const auto& argVal : argsIt->second.listValue) {
+        vars.reserve(args.Size());
+        for (GDBMIValue argVal : args) {
             if (argVal.IsTuple()) {
-                vars.push_back(ParseVariableResult(argVal.tupleValue));
+                vars.push_back(ParseVariableResult(argVal));
             }
         }
         break; // Only current frame
@@ -242,14 +283,25 @@ std::vector<Variable> UCGDBPlugin::GetGlobals() {
 }
 
 EvaluationResult UCGDBPlugin::Evaluate(const std::string& expression) {
-    return Evaluate(expression, EvaluationContext::Watch);
+    return Evaluate(expression, EvaluationContext::Repl);
 }
 
 EvaluationResult UCGDBPlugin::Evaluate(const std::string& expression, EvaluationContext context) {
-    EvaluationResult result;
+    // Watches are re-read at every stop, so they live in variable objects.
+    // Everything else is evaluated once: a floating variable object would
+    // repeat the side effects of a call or assignment at each update.
+    if (context == EvaluationContext::Watch) {
+        return EvaluateWatch(expression);
+    }
     
     GDBMIRecord response = SendCommand(
         GDBMICommandBuilder::DataEvaluateExpression(expression));
+    return ParseEvaluateResult(expression, response);
+}
+
+EvaluationResult UCGDBPlugin::ParseEvaluateResult(const std::string& expression,
+                                                  const GDBMIRecord& response) {
+    EvaluationResult result;
     
     if (response.IsError()) {
         result.success = false;
@@ -258,10 +310,11 @@ EvaluationResult UCGDBPlugin::Evaluate(const std::string& expression, Evaluation
     }
     
     result.success = true;
-    auto valueIt = response.results.find("value");
-    if (valueIt != response.results.end()) {
+    GDBMIValue value = response.results.Get("value");
+    if (value.IsString()) {
         result.variable.name = expression;
-        result.variable.value = valueIt->second.stringValue;
+        result.variable.value = value.AsString();
+        result.variable.valueTruncated = IsCutAtLengthLimit(result.variable.value);
     }
     
     return result;
@@ -270,89 +323,611 @@ EvaluationResult UCGDBPlugin::Evaluate(const std::string& expression, Evaluation
 bool UCGDBPlugin::SetVariable(const std::string& name, const std::string& value) {
     std::string cmd = "-gdb-set var " + name + "=" + value;
     GDBMIRecord result = SendCommand(cmd);
-    return result.IsSuccess();
+    if (!result.IsSuccess()) return false;
+    
+    {
+        std::lock_guard<std::mutex> lock(varObjectMutex_);
+        varUpdateGeneration_ = 0;  // Watches may depend on it
+    }
+    InvalidateMemoryCache();
+    return true;
 }
 
 std::vector<Variable> UCGDBPlugin::ExpandVariable(int variablesReference) {
+    return ExpandVariable(variablesReference, 0, 0);
+}
+
+std::vector<Variable> UCGDBPlugin::ExpandVariable(int variablesReference, int start, int count) {
     std::vector<Variable> children;
     
-    auto it = variableObjects_.find(variablesReference);
-    if (it == variableObjects_.end()) return children;
-    
-    GDBMIRecord result = SendCommand(
-        GDBMICommandBuilder::VarListChildren(it->second));
-    if (!result.IsSuccess()) return children;
-    
-    auto childrenIt = result.results.find("children");
-    if (childrenIt == result.results.end() || !childrenIt->second.IsList()) return children;
+    std::string name;
+    {
+        std::lock_guard<std::mutex> lock(varObjectMutex_);
+        auto it = variableObjects_.find(variablesReference);
+        if (it == variableObjects_.end()) return children;
+        name = it->second;
+    }
     
-    for (const auto& childVal : childrenIt->second.listValue) {
-        if (!childVal.IsTuple()) continue;
+    // Fetched children are variable objects too: the update refreshes them
+    UpdateVarObjects();
+    std::unique_lock<std::mutex> lock(varObjectMutex_);
+    auto parentIt = varObjects_.find(name);
+    if (parentIt == varObjects_.end()) return children;  // Went out of scope
+    VarObject* parent = &parentIt->second;
+    
+    // A pretty printer's child count is only known as far as it was read,
+    // so an open-ended request on one lists everything (the old behaviour)
+    start = std::max(start, 0);
+    int end = count > 0 ? start + count : parent->numChildren;
+    if (!parent->dynamic) {
+        end = std::min(end, parent->numChildren);
+    }
+    bool listAll = count <= 0 && parent->dynamic;
+    
+    // Only the part of the range not fetched before goes to GDB
+    int first = start;
+    while (first < end && parent->children.count(first)) first++;
+    int last = end;
+    while (last > first && parent->children.count(last - 1)) last--;
+    
+    if (listAll || first < last) {
+        // Not held across the command: a stop dispatched while we wait
+        // updates the objects, and may drop this one
+        lock.unlock();
+        GDBMIRecord result = SendCommand(listAll
+            ? GDBMICommandBuilder::VarListChildren(name)
+            : GDBMICommandBuilder::VarListChildren(name, first, last));
+        if (!result.IsSuccess()) return children;
         
-        auto childIt = childVal.tupleValue.find("child");
-        if (childIt != childVal.tupleValue.end() && childIt->second.IsTuple()) {
-            Variable var = ParseVariableResult(childIt->second.tupleValue);
-            children.push_back(var);
+        lock.lock();
+        parentIt = varObjects_.find(name);
+        if (parentIt == varObjects_.end()) return children;
+        parent = &parentIt->second;
+        
+        // ^done,numchild="3",children=[child={name=...,exp=...},...],has_more="0"
+        int index = listAll ? 0 : first;
+        for (GDBMIValue childVal : result.results.Get("children")) {
+            GDBMIValue child = childVal.Get("child");
+            if (!child.IsTuple()) continue;
+            
+            std::string childName = child.GetString("name");
+            VarObject& object = varObjects_[childName];
+            object.expression = child.GetString("exp");
+            ReadVarObject(object, child);
+            parent->children[index++] = std::move(childName);
+        }
+        
+        if (parent->dynamic) {
+            parent->hasMore = result.results.GetInt("has_more") != 0;
+            parent->numChildren = std::max(parent->numChildren, index);
+            if (listAll) end = index;
+        }
+    }
+    
+    end = std::min(end, parent->dynamic ? parent->numChildren : end);
+    children.reserve(std::max(end - start, 0));
+    for (auto child = parent->children.lower_bound(start);
+         child != parent->children.end() && child->first < end; ++child) {
+        auto object = varObjects_.find(child->second);
+        if (object != varObjects_.end()) {
+            children.push_back(MakeVarObjectVariable(child->second, object->second));
         }
     }
     
     return children;
 }
 
-Variable UCGDBPlugin::ParseVariableResult(const std::map<std::string, GDBMIValue>& var) {
+EvaluationResult UCGDBPlugin::EvaluateFullValue(const Variable& variable, int maxLength) {
+    // A variable object is evaluated again by name; that also covers
+    // children, whose name is only a field name or index
+    std::string object;
+    if (variable.valueReference != 0) {
+        std::lock_guard<std::mutex> lock(varObjectMutex_);
+        auto it = variableObjects_.find(variable.valueReference);
+        if (it != variableObjects_.end()) object = it->second;
+    }
+    std::string expression = variable.evaluateName.empty() ? variable.name : variable.evaluateName;
+    if (object.empty() && (variable.valueReference != 0 || expression.empty())) {
+        EvaluationResult result;
+        result.success = false;
+        result.errorMessage = "The variable is no longer available";
+        return result;
+    }
+    
+    // The limit is GDB-wide, so raise it for this one evaluation only and
+    // put back what was there. The three commands are queued together to
+    // keep others from running under the raised limit.
+    GDBMIRecord shown = SendCommand("-gdb-show print elements");
+    std::string previous = shown.results.GetString("value", "200");
+    std::string limit = maxLength > 0 ? std::to_string(maxLength) : "unlimited";
+    
+    auto raise = SendCommandAsync("-gdb-set print elements " + limit, GDBCommandPriority::High);
+    auto evaluate = SendCommandAsync(object.empty()
+        ? GDBMICommandBuilder::DataEvaluateExpression(expression)
+        : GDBMICommandBuilder::VarEvaluate(object), GDBCommandPriority::High);
+    auto restore = SendCommandAsync("-gdb-set print elements " + previous, GDBCommandPriority::High);
+    
+    GDBMIRecord response = WaitForResult(evaluate);
+    WaitForResult(restore);
+    
+    EvaluationResult result = ParseEvaluateResult(expression, response);
+    if (result.success) {
+        std::string value = std::move(result.variable.value);
+        bool truncated = result.variable.valueTruncated;
+        result.variable = variable;
+        result.variable.value = std::move(value);
+        result.variable.valueTruncated = truncated;
+    }
+    return result;
+}
+
+namespace {
+
+void SetCategoryFromType(Variable& v) {
+    if (v.type.empty()) return;
+    
+    if (v.type.find('*') != std::string::npos) {
+        v.category = VariableCategory::Pointer;
+        v.isPointer = true;
+    } else if (v.type.find('&') != std::string::npos) {
+        v.category = VariableCategory::Reference;
+        v.isReference = true;
+    } else if (v.type.find('[') != std::string::npos) {
+        v.category = VariableCategory::Array;
+    } else if (v.type.find("struct") != std::string::npos) {
+        v.category = VariableCategory::Struct;
+    } else if (v.type.find("class") != std::string::npos) {
+        v.category = VariableCategory::Class;
+    } else if (v.type == "int" || v.type == "float" || v.type == "double" ||
+               v.type == "char" || v.type == "bool" || v.type == "long") {
+        v.category = VariableCategory::Primitive;
+    }
+}
+
+} // anonymous namespace
+
+Variable UCGDBPlugin::ParseVariableResult(const GDBMIValue& var) {
     Variable v;
     
-    auto nameIt = var.find("name");
-    if (nameIt != var.end()) v.name = nameIt->second.stringValue;
+    v.name = var.GetString("name");
+    v.value = var.GetString("value");
+    v.type = var.GetString("type");
+    v.valueTruncated = IsCutAtLengthLimit(v.value);
     
-    auto valueIt = var.find("value");
-    if (valueIt != var.end()) v.value = valueIt->second.stringValue;
+    if (var.Has("numchild")) {
+        v.numChildren = var.GetInt("numchild");
+        v.hasChildren = v.numChildren > 0;
+    }
     
-    auto typeIt = var.find("type");
-    if (typeIt != var.end()) v.type = typeIt->second.stringValue;
+    SetCategoryFromType(v);
+    return v;
+}
+
+// ============================================================================
+// VARIABLE OBJECTS
+// ============================================================================
+
+std::string UCGDBPlugin::NextVarObjectName(char prefix) {
+    // Called with varObjectMutex_ held
+    return std::string(1, prefix) + std::to_string(nextVarObject_++);
+}
+
+void UCGDBPlugin::UpdateVarObjects() {
+    uint64_t generation = stopGeneration_;
+    {
+        std::lock_guard<std::mutex> lock(varObjectMutex_);
+        if (varUpdateGeneration_ == generation) return;
+        if (varObjects_.empty()) {
+            varUpdateGeneration_ = generation;
+            return;
+        }
+    }
     
-    auto numchildIt = var.find("numchild");
-    if (numchildIt != var.end()) {
-        v.numChildren = std::stoi(numchildIt->second.stringValue);
-        v.hasChildren = v.numChildren > 0;
+    GDBMIRecord result = SendCommand(GDBMICommandBuilder::VarUpdate());
+    if (!result.IsSuccess()) return;
+    
+    std::lock_guard<std::mutex> lock(varObjectMutex_);
+    ApplyVarUpdate(result, generation);
+}
+
+void UCGDBPlugin::ApplyVarUpdate(const GDBMIRecord& record, uint64_t generation) {
+    // Called with varObjectMutex_ held. Two threads may update for the
+    // same stop: the second finds nothing new, and must not clear the
+    // flags the first one set. An update from before a later stop is stale.
+    if (generation < varUpdateGeneration_) return;
+    if (generation != varUpdateGeneration_) {
+        for (auto& pair : varObjects_) {
+            pair.second.changed = false;
+        }
+    }
+    varUpdateGeneration_ = generation;
+    
+    // changelist=[{name="w1",value="5",in_scope="true",type_changed="false"},...]
+    std::vector<std::string> stale;
+    for (GDBMIValue change : record.results.Get("changelist")) {
+        auto it = varObjects_.find(change.GetString("name"));
+        if (it == varObjects_.end()) continue;
+        VarObject& object = it->second;
+        
+        // "false": the frame of a local is gone; "invalid": the expression
+        // no longer compiles (e.g. its library was unloaded)
+        std::string inScope = change.GetString("in_scope", "true");
+        if (inScope != "true") {
+            stale.push_back(it->first);
+            continue;
+        }
+        
+        object.changed = true;
+        GDBMIValue value = change.Get("value");
+        if (value.IsString()) {
+            object.value = value.AsString();
+        }
+        
+        // GDB drops the children of an object whose type changed
+        bool typeChanged = change.GetString("type_changed") == "true";
+        if (typeChanged || change.Has("new_num_children") || change.Has("new_children")) {
+            if (typeChanged) {
+                object.type = change.GetString("new_type");
+            }
+            object.numChildren = change.GetInt("new_num_children", object.numChildren);
+            std::map<int, std::string> children = std::move(object.children);
+            object.children.clear();
+            for (const auto& child : children) {
+                ForgetVarObject(child.second);
+            }
+        }
+        object.hasMore = change.GetInt("has_more", object.hasMore) != 0;
     }
     
-    // Determine category from type
-    if (!v.type.empty()) {
-        if (v.type.find('*') != std::string::npos) {
-            v.category = VariableCategory::Pointer;
-            v.isPointer = true;
-        } else if (v.type.find('&') != std::string::npos) {
-            v.category = VariableCategory::Reference;
-            v.isReference = true;
-        } else if (v.type.find('[') != std::string::npos) {
-            v.category = VariableCategory::Array;
-        } else if (v.type.find("struct") != std::string::npos) {
-            v.category = VariableCategory::Struct;
-        } else if (v.type.find("class") != std::string::npos) {
-            v.category = VariableCategory::Class;
-        } else if (v.type == "int" || v.type == "float" || v.type == "double" ||
-                   v.type == "char" || v.type == "bool" || v.type == "long") {
-            v.category = VariableCategory::Primitive;
+    for (const auto& name : stale) {
+        if (varObjects_.count(name)) {
+            DeleteVarObject(name);
         }
     }
+}
+
+UCGDBPlugin::VarObject& UCGDBPlugin::AddVarObject(const std::string& name,
+                                                  const std::string& expression,
+                                                  const GDBMIRecord& created) {
+    // Called with varObjectMutex_ held
+    // ^done,name="w1",numchild="2",value="{...}",type="Point",...
+    VarObject& object = varObjects_[name];
+    object.expression = expression;
+    ReadVarObject(object, created.results);
+    return object;
+}
+
+void UCGDBPlugin::ReadVarObject(VarObject& object, const GDBMIValue& fields) {
+    object.type = fields.GetString("type");
+    object.value = fields.GetString("value");
+    object.numChildren = fields.GetInt("numchild");
+    
+    // Pretty-printed containers: dynamic="1",displayhint="array",has_more="1"
+    object.dynamic = fields.GetInt("dynamic") != 0;
+    object.hasMore = fields.GetInt("has_more") != 0;
+    object.displayHint = fields.GetString("displayhint");
+}
+
+void UCGDBPlugin::DeleteVarObject(const std::string& name) {
+    // Called with varObjectMutex_ held. GDB deletes the children with it;
+    // nothing waits for the result
+    SendCommandAsync(GDBMICommandBuilder::VarDelete(name), GDBCommandCallback(),
+                     GDBCommandPriority::Low);
+    ForgetVarObject(name);
+    
+    for (auto* owners : {&watchVarObjects_, &localVarObjects_}) {
+        for (auto it = owners->begin(); it != owners->end(); ++it) {
+            if (it->second == name) {
+                owners->erase(it);
+                break;
+            }
+        }
+    }
+}
+
+void UCGDBPlugin::ForgetVarObject(const std::string& name) {
+    // Called with varObjectMutex_ held
+    auto it = varObjects_.find(name);
+    if (it == varObjects_.end()) return;
+    
+    std::map<int, std::string> children = std::move(it->second.children);
+    if (it->second.reference != 0) {
+        variableObjects_.erase(it->second.reference);
+    }
+    varObjects_.erase(it);
     
-    // Create variable object for expansion if has children
+    for (const auto& child : children) {
+        ForgetVarObject(child.second);
+    }
+}
+
+Variable UCGDBPlugin::MakeVarObjectVariable(const std::string& name, VarObject& object) {
+    // Called with varObjectMutex_ held
+    Variable v;
+    v.name = object.expression;
+    v.value = object.value;
+    v.type = object.type;
+    v.numChildren = object.numChildren;
+    v.hasChildren = object.numChildren > 0 || object.hasMore;
+    v.valueChanged = object.changed;
+    v.valueTruncated = IsCutAtLengthLimit(object.value);
+    SetCategoryFromType(v);
+    
+    // Counts let a view page through large containers. A pretty printer
+    // that has more children than it reported gives no count.
+    if (!object.hasMore) {
+        if (object.displayHint == "array" || v.category == VariableCategory::Array) {
+            v.indexedVariables = object.numChildren;
+        } else {
+            v.namedVariables = object.numChildren;
+        }
+    }
+    if (object.dynamic && v.category == VariableCategory::UnknownCategory) {
+        v.category = VariableCategory::Container;
+    }
+    
+    // The reference outlives the stop: expanding it later lists the same
+    // children instead of creating new objects
     if (v.hasChildren) {
-        std::string varObjName = "var" + std::to_string(nextVariableRef_);
-        GDBMIRecord createResult = SendCommand(
-            GDBMICommandBuilder::VarCreate(varObjName, v.name));
-        
-        if (createResult.IsSuccess()) {
-            v.variablesReference = nextVariableRef_;
-            variableObjects_[nextVariableRef_] = varObjName;
-            nextVariableRef_++;
+        if (object.reference == 0) {
+            object.reference = nextVariableRef_++;
+            variableObjects_[object.reference] = name;
         }
+        v.variablesReference = object.reference;
+    }
+    
+    // A long string has no children, but loading it in full needs the object
+    if (v.valueTruncated) {
+        if (object.reference == 0) {
+            object.reference = nextVariableRef_++;
+            variableObjects_[object.reference] = name;
+        }
+        v.valueReference = object.reference;
     }
     
     return v;
 }
 
+EvaluationResult UCGDBPlugin::EvaluateWatch(const std::string& expression) {
+    EvaluationResult result;
+    UpdateVarObjects();
+    
+    std::unique_lock<std::mutex> lock(varObjectMutex_);
+    auto existing = watchVarObjects_.find(expression);
+    if (existing != watchVarObjects_.end()) {
+        auto object = varObjects_.find(existing->second);
+        if (object != varObjects_.end()) {
+            result.success = true;
+            result.variable = MakeVarObjectVariable(existing->second, object->second);
+            return result;
+        }
+    }
+    
+    std::string name = NextVarObjectName('w');
+    lock.unlock();
+    GDBMIRecord created = SendCommand(GDBMICommandBuilder::VarCreate(name, expression));
+    if (!created.IsSuccess()) {
+        // Not kept: an expression that is not valid here is retried next stop
+        result.success = false;
+        result.errorMessage = created.GetError();
+        return result;
+    }
+    
+    lock.lock();
+    
+    // Another thread may have created the watch meanwhile; keep its object
+    existing = watchVarObjects_.find(expression);
+    if (existing != watchVarObjects_.end()) {
+        auto object = varObjects_.find(existing->second);
+        if (object != varObjects_.end()) {
+            SendCommandAsync(GDBMICommandBuilder::VarDelete(name), GDBCommandCallback(),
+                             GDBCommandPriority::Low);
+            result.success = true;
+            result.variable = MakeVarObjectVariable(existing->second, object->second);
+            return result;
+        }
+    }
+    
+    watchVarObjects_[expression] = name;
+    result.success = true;
+    result.variable = MakeVarObjectVariable(name, AddVarObject(name, expression, created));
+    return result;
+}
+
+void UCGDBPlugin::SetLocalScope(const std::vector<StackFrame>& callStack, uint64_t generation) {
+    // Called with varObjectMutex_ held. Stepping within a function keeps
+    // the scope. A call, a return or another thread replaces it, along
+    // with its variable objects.
+    std::string scope = std::to_string(currentThreadId_) + ":" +
+                        std::to_string(callStack.size());
+    if (!callStack.empty()) {
+        scope += ":" + callStack.front().functionName;
+    }
+    
+    if (scope != localScope_) {
+        std::vector<std::string> names;
+        names.reserve(localVarObjects_.size());
+        for (const auto& pair : localVarObjects_) {
+            names.push_back(pair.second);
+        }
+        for (const auto& name : names) {
+            DeleteVarObject(name);
+        }
+        localVarObjects_.clear();
+        localValues_.clear();
+        localScope_ = std::move(scope);
+    }
+    localScopeGeneration_ = generation;
+}
+
+void UCGDBPlugin::TrackLocals(std::vector<Variable>& variables) {
+    // Only the top frame of a stop whose stack has been seen has a scope
+    {
+        std::lock_guard<std::mutex> lock(varObjectMutex_);
+        if (localScopeGeneration_ != stopGeneration_ || currentFrameLevel_ != 0) return;
+    }
+    UpdateVarObjects();
+    
+    std::vector<size_t> pending;
+    std::vector<std::pair<std::string, std::future<GDBMIRecord>>> creates;
+    std::unique_lock<std::mutex> lock(varObjectMutex_);
+    
+    for (size_t i = 0; i < variables.size(); i++) {
+        Variable& var = variables[i];
+        
+        // Simple values come with the listing: compare with the last stop
+        if (!var.value.empty()) {
+            auto previous = localValues_.find(var.name);
+            var.valueChanged = previous != localValues_.end() && previous->second != var.value;
+            localValues_[var.name] = var.value;
+            continue;
+        }
+        
+        // Aggregates are listed without a value; a frame-bound object per
+        // name carries the value, the changed flag and the children
+        auto existing = localVarObjects_.find(var.name);
+        if (existing != localVarObjects_.end()) {
+            auto object = varObjects_.find(existing->second);
+            if (object != varObjects_.end()) {
+                var = MakeVarObjectVariable(existing->second, object->second);
+                continue;
+            }
+        }
+        
+        std::string name = NextVarObjectName('l');
+        pending.push_back(i);
+        creates.emplace_back(name, SendCommandAsync(
+            GDBMICommandBuilder::VarCreateInFrame(name, var.name),
+            GDBCommandPriority::High, true));
+    }
+    lock.unlock();
+    
+    std::vector<GDBMIRecord> results;
+    results.reserve(creates.size());
+    for (auto& create : creates) {
+        results.push_back(WaitForResult(create.second));
+    }
+    
+    lock.lock();
+    for (size_t j = 0; j < creates.size(); j++) {
+        if (!results[j].IsSuccess()) continue;
+        
+        const std::string& name = creates[j].first;
+        Variable& var = variables[pending[j]];
+        localVarObjects_[var.name] = name;
+        var = MakeVarObjectVariable(name, AddVarObject(name, var.name, results[j]));
+    }
+}
+
+// ============================================================================
+// STOP STATE
+// ============================================================================
+
+DebugStopState UCGDBPlugin::CaptureStopState(int maxFrames,
+                                             const std::vector<std::string>& watchExpressions) {
+    DebugStopState state;
+    state.threadId = currentThreadId_;
+    state.maxFrames = maxFrames;
+    uint64_t generation = stopGeneration_;
+    
+    // Everything goes out back to back and is parsed as it comes in. If
+    // the target resumes meanwhile, the rest completes as "Cancelled".
+    // Variable objects from earlier stops come first: one update covers
+    // every watch and aggregate local that was already known.
+    std::unique_lock<std::mutex> lock(varObjectMutex_);
+    bool updating = !varObjects_.empty() && varUpdateGeneration_ != generation;
+    std::future<GDBMIRecord> update;
+    if (updating) {
+        update = SendCommandAsync(GDBMICommandBuilder::VarUpdate(),
+                                  GDBCommandPriority::High, true);
+    }
+    auto frames = SendCommandAsync(GDBMICommandBuilder::StackListFrames(maxFrames),
+                                   GDBCommandPriority::High, true);
+    auto locals = SendCommandAsync(GDBMICommandBuilder::StackListLocals(2),
+                                   GDBCommandPriority::High, true);
+    auto arguments = SendCommandAsync(GDBMICommandBuilder::StackListArguments(2) + " 0 0",
+                                      GDBCommandPriority::High, true);
+    
+    // Only watches seen for the first time need a command of their own
+    std::vector<std::pair<std::string, std::future<GDBMIRecord>>> creates;
+    std::vector<size_t> created;
+    for (size_t i = 0; i < watchExpressions.size(); i++) {
+        if (watchVarObjects_.count(watchExpressions[i])) continue;
+        
+        std::string name = NextVarObjectName('w');
+        created.push_back(i);
+        creates.emplace_back(name, SendCommandAsync(
+            GDBMICommandBuilder::VarCreate(name, watchExpressions[i]),
+            GDBCommandPriority::Normal, true));
+    }
+    if (!updating) {
+        varUpdateGeneration_ = generation;
+    }
+    lock.unlock();
+    
+    // Results are waited for without the lock; another thread may use the
+    // objects meanwhile, so each result is applied under it
+    if (updating) {
+        GDBMIRecord result = WaitForResult(update);
+        if (result.IsSuccess()) {
+            lock.lock();
+            ApplyVarUpdate(result, generation);
+            lock.unlock();
+        }
+    }
+    
+    GDBMIRecord stack = WaitForResult(frames);
+    state.callStack = ParseStackResult(stack);
+    if (stack.IsSuccess()) {
+        lock.lock();
+        SetLocalScope(state.callStack, generation);
+        lock.unlock();
+        PrefetchDisassembly(state.callStack);
+    }
+    state.locals = ParseLocalsResult(WaitForResult(locals));
+    state.arguments = ParseArgumentsResult(WaitForResult(arguments));
+    TrackLocals(state.locals);
+    TrackLocals(state.arguments);
+    
+    for (size_t j = 0; j < creates.size(); j++) {
+        const std::string& expression = watchExpressions[created[j]];
+        GDBMIRecord result = WaitForResult(creates[j].second);
+        if (result.IsSuccess()) {
+            lock.lock();
+            if (watchVarObjects_.count(expression)) {
+                // EvaluateWatch on another thread got there first
+                SendCommandAsync(GDBMICommandBuilder::VarDelete(creates[j].first),
+                                 GDBCommandCallback(), GDBCommandPriority::Low);
+            } else {
+                watchVarObjects_[expression] = creates[j].first;
+                AddVarObject(creates[j].first, expression, result);
+            }
+            lock.unlock();
+        } else {
+            state.watchValues[expression] = ParseEvaluateResult(expression, result);
+        }
+    }
+    for (const auto& expression : watchExpressions) {
+        if (!state.watchValues.count(expression)) {
+            state.watchValues[expression] = EvaluateWatch(expression);
+        }
+    }
+    
+    // Watches removed since the last stop
+    lock.lock();
+    std::vector<std::string> removed;
+    for (const auto& pair : watchVarObjects_) {
+        if (!state.watchValues.count(pair.first)) {
+            removed.push_back(pair.second);
+        }
+    }
+    for (const auto& name : removed) {
+        DeleteVarObject(name);
+    }
+    
+    return state;
+}
+
 // ============================================================================
 // REGISTERS
 // ============================================================================
@@ -364,37 +939,35 @@ std::vector<Register> UCGDBPlugin::GetRegisters() {
     GDBMIRecord namesResult = SendCommand("-data-list-register-names");
     if (!namesResult.IsSuccess()) return registers;
     
-    auto namesIt = namesResult.results.find("register-names");
-    if (namesIt == namesResult.results.end() || !namesIt->second.IsList()) return registers;
+    GDBMIValue nameList = namesResult.results.Get("register-names");
+    if (!nameList.IsList()) return registers;
     
-    std::vector<std::string> names;
-    for (const auto& nameVal : namesIt->second.listValue) {
-        names.push_back(nameVal.stringValue);
+    // Views stay valid while namesResult is alive
+    std::vector<std::string_view> names;
+    names.reserve(nameList.Size());
+    for (GDBMIValue nameVal : nameList) {
+        names.push_back(nameVal.AsString());
     }
     
     // Get register values
     GDBMIRecord valuesResult = SendCommand("-data-list-register-values x");
     if (!valuesResult.IsSuccess()) return registers;
     
-    auto valuesIt = valuesResult.results.find("register-values");
-    if (valuesIt == valuesResult.results.end() || !valuesIt->second.IsList()) return registers;
+    GDBMIValue valueList = valuesResult.results.Get("register-values");
+    if (!valueList.IsList()) return registers;
     
-    for (const auto& regVal : valuesIt->second.listValue) {
-        if (!regVal.IsTuple()) continue;
-        
-        Register reg;
+    registers.reserve(valueList.Size());
+    for (GDBMIValue regVal : valueList) {
+        GDBMIValue value = regVal.Get("value");
+        if (!value.IsString()) continue;
         
-        auto numIt = regVal.tupleValue.find("number");
-        auto valueIt = regVal.tupleValue.find("value");
-        
-        if (numIt != regVal.tupleValue.end() && valueIt != regVal.tupleValue.end()) {
-            int regNum = std::stoi(numIt->second.stringValue);
-            if (regNum >= 0 && regNum < static_cast<int>(names.size()) && 
-                !names[regNum].empty()) {
-                reg.name = names[regNum];
-                reg.value = valueIt->second.stringValue;
-                registers.push_back(reg);
-            }
+        int regNum = regVal.GetInt("number", -1);
+        if (regNum >= 0 && regNum < static_cast<int>(names.size()) && 
+            !names[regNum].empty()) {
+            Register reg;
+            reg.name = names[regNum];
+            reg.value = value.AsString();
+            registers.push_back(reg);
         }
     }
     
@@ -409,43 +982,453 @@ std::vector<Register> UCGDBPlugin::GetRegisters(RegisterCategory category) {
 bool UCGDBPlugin::SetRegister(const std::string& name, const std::string& value) {
     std::string cmd = "-gdb-set $" + name + "=" + value;
     GDBMIRecord result = SendCommand(cmd);
-    return result.IsSuccess();
+    if (!result.IsSuccess()) return false;
+    
+    std::lock_guard<std::mutex> lock(varObjectMutex_);
+    varUpdateGeneration_ = 0;
+    return true;
 }
 
 // ============================================================================
 // MEMORY
 // ============================================================================
 
+namespace {
+
+constexpr uint64_t kMemoryPage = 4096;
+constexpr size_t kMaxCachedPages = 16384;   // 64 MB of target memory
+constexpr size_t kMaxIovecs = 1024;         // IOV_MAX
+constexpr uint64_t kSearchChunk = 4 * 1024 * 1024;
+constexpr unsigned kMaxSearchThreads = 8;
+
+// Part of a mapping one search worker reads at a time
+struct SearchChunk {
+    uint64_t start;
+    uint64_t end;
+    uint64_t limit;                         // End of the mapping
+};
+
+#ifdef __linux__
+bool IsTracedBy(int pid, int tracerPid) {
+    std::ifstream status("/proc/" + std::to_string(pid) + "/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 10, "TracerPid:") == 0) {
+            return std::atoi(line.c_str() + 10) == tracerPid;
+        }
+    }
+    return false;
+}
+
+// One line of /proc/<pid>/maps
+struct Mapping {
+    uint64_t start = 0;
+    uint64_t end = 0;
+    uint64_t offset = 0;                    // File offset of start
+    uint64_t inode = 0;
+    std::string path;                       // Empty for anonymous memory
+};
+
+// Mappings of a process with the given permission ('r', 'w' or 'x'), in
+// address order
+std::vector<Mapping> ReadMappings(int pid, char permission) {
+    std::vector<Mapping> mappings;
+    std::ifstream maps("/proc/" + std::to_string(pid) + "/maps");
+    std::string line;
+    while (std::getline(maps, line)) {
+        // "start-end perms offset dev inode path"
+        std::istringstream fields(line);
+        std::string range, perms, offset, device;
+        Mapping mapping;
+        if (!(fields >> range >> perms >> offset >> device >> mapping.inode)) continue;
+        if (perms.find(permission) == std::string::npos) continue;
+        
+        size_t dash = range.find('-');
+        if (dash == std::string::npos) continue;
+        std::from_chars(range.data(), range.data() + dash, mapping.start, 16);
+        std::from_chars(range.data() + dash + 1, range.data() + range.size(), mapping.end, 16);
+        std::from_chars(offset.data(), offset.data() + offset.size(), mapping.offset, 16);
+        
+        std::getline(fields >> std::ws, mapping.path);
+        mappings.push_back(std::move(mapping));
+    }
+    return mappings;
+}
+
+// The GNU build ID of a 64-bit ELF file as hex, or "" if it has none
+std::string ReadBuildId(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    Elf64_Ehdr header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        std::memcmp(header.e_ident, ELFMAG, SELFMAG) != 0 ||
+        header.e_ident[EI_CLASS] != ELFCLASS64) {
+        return "";
+    }
+    
+    for (int i = 0; i < header.e_phnum; i++) {
+        Elf64_Phdr program;
+        file.seekg(header.e_phoff + i * header.e_phentsize);
+        if (!file.read(reinterpret_cast<char*>(&program), sizeof(program))) break;
+        if (program.p_type != PT_NOTE || program.p_filesz > 65536) continue;
+        
+        std::vector<char> notes(program.p_filesz);
+        file.seekg(program.p_offset);
+        if (!file.read(notes.data(), notes.size())) break;
+        
+        for (size_t pos = 0; pos + sizeof(Elf64_Nhdr) <= notes.size(); ) {
+            Elf64_Nhdr note;
+            std::memcpy(&note, notes.data() + pos, sizeof(note));
+            size_t name = pos + sizeof(note);
+            size_t desc = name + ((note.n_namesz + 3) & ~3u);
+            if (desc + note.n_descsz > notes.size()) break;
+            
+            if (note.n_type == NT_GNU_BUILD_ID && note.n_namesz == 4 &&
+                std::memcmp(notes.data() + name, "GNU", 4) == 0) {
+                std::ostringstream id;
+                for (size_t k = 0; k < note.n_descsz; k++) {
+                    id << std::hex << std::setw(2) << std::setfill('0')
+                       << (static_cast<unsigned>(notes[desc + k]) & 0xFF);
+                }
+                return id.str();
+            }
+            pos = desc + ((note.n_descsz + 3) & ~3u);
+        }
+    }
+    return "";
+}
+#endif
+
+} // anonymous namespace
+
 MemoryRegion UCGDBPlugin::ReadMemory(uint64_t address, size_t size) {
     MemoryRegion region;
     region.address = address;
     region.size = size;
     
-    GDBMIRecord result = SendCommand(
-        GDBMICommandBuilder::DataReadMemory(address, size));
+    size = static_cast<size_t>(std::min<uint64_t>(size, UINT64_MAX - address));
+    if (size == 0) return region;
+    
+    std::lock_guard<std::mutex> lock(memoryMutex_);
+    
+    int pid = inferiorPid_;
+    if (pid != directPid_) {
+        OpenDirectMemory(pid);
+    }
+    
+    // Pages stay valid until the target resumes; while it runs they are
+    // read afresh on every call
+    uint64_t generation = stopGeneration_;
+    bool paused = state_ == DebugSessionState::Paused;
+    if (!paused || generation != memoryGeneration_ ||
+        memoryPages_.size() > kMaxCachedPages) {
+        memoryPages_.clear();
+        codeRanges_.clear();
+        memoryGeneration_ = paused ? generation : 0;
+    }
     
-    if (!result.IsSuccess()) return region;
+    uint64_t end = address + size;
+    uint64_t firstPage = address & ~(kMemoryPage - 1);
+    size_t pageCount = static_cast<size_t>((end - 1 - firstPage) / kMemoryPage + 1);
     
-    auto memoryIt = result.results.find("memory");
-    if (memoryIt == result.results.end() || !memoryIt->second.IsList()) return region;
+    // Fetch each run of missing pages with one read
+    size_t missing = 0;
+    for (size_t i = 0; i <= pageCount; i++) {
+        if (i < pageCount && !memoryPages_.count(firstPage + i * kMemoryPage)) {
+            missing++;
+            continue;
+        }
+        if (missing > 0) {
+            FetchMemoryPages(firstPage + (i - missing) * kMemoryPage, missing);
+            missing = 0;
+        }
+    }
     
-    for (const auto& blockVal : memoryIt->second.listValue) {
-        if (!blockVal.IsTuple()) continue;
+    // Copy the range out, up to the first unreadable page
+    region.data.reserve(size);
+    for (size_t i = 0; i < pageCount; i++) {
+        uint64_t page = firstPage + i * kMemoryPage;
+        const std::vector<uint8_t>& data = memoryPages_[page];
+        if (data.empty()) {
+            std::ostringstream error;
+            error << "Cannot access memory at address 0x" << std::hex
+                  << std::max(page, address);
+            region.errorMessage = error.str();
+            break;
+        }
         
-        auto contentsIt = blockVal.tupleValue.find("contents");
-        if (contentsIt == blockVal.tupleValue.end()) continue;
+        uint64_t from = std::max(page, address) - page;
+        uint64_t to = std::min(kMemoryPage, end - page);
+        region.data.insert(region.data.end(), data.begin() + from, data.begin() + to);
+    }
+    region.isReadable = !region.data.empty();
+    
+    if (!paused) {
+        memoryPages_.clear();
+    }
+    
+    return region;
+}
+
+MemorySearchResult UCGDBPlugin::SearchMemory(const MemorySearchQuery& query,
+                                             const std::function<bool(uint64_t address)>& onMatch,
+                                             const std::atomic<bool>* cancel) {
+    int pid = LocalInferiorPid();
+    
+#ifdef __linux__
+    if (pid <= 0) {
+        return IUCDebuggerPlugin::SearchMemory(query, onMatch, cancel);
+    }
+    
+    // Readable mappings within the query's range, cut into chunks that the
+    // workers take in turn. Each read runs past its chunk by the match
+    // length so matches across chunk boundaries are found.
+    std::vector<SearchChunk> chunks;
+    for (const Mapping& mapping : ReadMappings(pid, 'r')) {
+        uint64_t start = std::max(mapping.start, query.startAddress);
+        uint64_t end = std::min(mapping.end, query.endAddress);
+        for (uint64_t chunk = start; chunk < end; chunk += kSearchChunk) {
+            chunks.push_back({chunk, std::min(end, chunk + kSearchChunk), end});
+        }
+    }
+    
+    size_t overlap = query.MatchLength() - 1;
+    std::atomic<size_t> nextChunk{0};
+    std::atomic<bool> stop{false};
+    std::mutex reportMutex;
+    size_t found = 0;
+    
+    auto report = [&](uint64_t address) {
+        std::lock_guard<std::mutex> lock(reportMutex);
+        if (stop) return false;
+        found++;
+        if (!onMatch(address) || found >= query.maxResults) {
+            stop = true;
+        }
+        return !stop;
+    };
+    
+    auto work = [&]() {
+        std::vector<uint8_t> buffer(kSearchChunk + overlap);
+        for (size_t i = nextChunk++; i < chunks.size() && !stop; i = nextChunk++) {
+            if (cancel && *cancel) {
+                stop = true;
+                break;
+            }
+            
+            const SearchChunk& chunk = chunks[i];
+            size_t size = static_cast<size_t>(
+                std::min(chunk.end - chunk.start + overlap, chunk.limit - chunk.start));
+            iovec local{buffer.data(), size};
+            iovec remote{reinterpret_cast<void*>(chunk.start), size};
+            
+            // Fails for [vvar] and mappings gone since they were listed
+            ssize_t transferred = process_vm_readv(pid, &local, 1, &remote, 1, 0);
+            if (transferred <= 0) continue;
+            
+            query.Scan(chunk.start, buffer.data(), static_cast<size_t>(transferred),
+                       static_cast<size_t>(chunk.end - chunk.start), report);
+        }
+    };
+    
+    size_t threadCount = std::min<size_t>(
+        std::clamp(std::thread::hardware_concurrency(), 1u, kMaxSearchThreads),
+        std::max<size_t>(chunks.size(), 1));
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < threadCount; i++) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    
+    MemorySearchResult result;
+    result.success = true;
+    result.matchCount = found;
+    return result;
+#else
+    return IUCDebuggerPlugin::SearchMemory(query, onMatch, cancel);
+#endif
+}
+
+void UCGDBPlugin::FetchMemoryPages(uint64_t firstPage, size_t pageCount) {
+    // In non-stop mode GDB keeps breakpoints inserted, and a code page read
+    // directly would show trap instructions where GDB shows the original
+    // bytes. All-stop GDB removes them whenever the target stops.
+    bool codeThroughGDB = config_.asyncMode;
+#ifdef __linux__
+    if (codeThroughGDB && directMemory_ && codeRanges_.empty()) {
+        for (const Mapping& mapping : ReadMappings(directPid_, 'x')) {
+            codeRanges_.emplace_back(mapping.start, mapping.end);
+        }
+    }
+#endif
+    auto isCode = [&](uint64_t page) {
+        if (!codeThroughGDB) return false;
+        auto next = std::upper_bound(codeRanges_.begin(), codeRanges_.end(),
+                                     std::make_pair(page, UINT64_MAX));
+        return next != codeRanges_.begin() && page < std::prev(next)->second;
+    };
+    
+    uint64_t page = firstPage;
+    size_t remaining = pageCount;
+    while (remaining > 0) {
+        size_t run = 0;
+        while (directMemory_ && run < remaining && !isCode(page + run * kMemoryPage)) {
+            run++;
+        }
         
-        std::string hexData = contentsIt->second.stringValue;
-        for (size_t i = 0; i < hexData.length(); i += 2) {
-            if (i + 1 < hexData.length()) {
-                uint8_t byte = static_cast<uint8_t>(
-                    std::stoul(hexData.substr(i, 2), nullptr, 16));
-                region.data.push_back(byte);
+        // ReadPagesDirect returns short only if direct access was refused
+        if (run > 0) {
+            run = ReadPagesDirect(page, run);
+        } else {
+            while (run < remaining &&
+                   (!directMemory_ || isCode(page + run * kMemoryPage))) {
+                run++;
             }
+            ReadPagesMI(page, run);
+        }
+        
+        page += run * kMemoryPage;
+        remaining -= run;
+    }
+}
+
+size_t UCGDBPlugin::ReadPagesDirect(uint64_t firstPage, size_t pageCount) {
+#ifdef __linux__
+    size_t chunkPages = std::min(pageCount, kMaxIovecs);
+    std::vector<uint8_t> buffer(chunkPages * kMemoryPage);
+    std::vector<iovec> remote(chunkPages);
+    
+    size_t done = 0;
+    while (done < pageCount) {
+        size_t chunk = std::min(pageCount - done, kMaxIovecs);
+        uint64_t chunkStart = firstPage + done * kMemoryPage;
+        
+        // One remote iovec per page, so an unmapped page ends the transfer
+        // after the pages before it instead of failing all of them
+        for (size_t i = 0; i < chunk; i++) {
+            remote[i].iov_base = reinterpret_cast<void*>(chunkStart + i * kMemoryPage);
+            remote[i].iov_len = kMemoryPage;
+        }
+        iovec local{buffer.data(), chunk * kMemoryPage};
+        
+        ssize_t transferred = process_vm_readv(directPid_, &local, 1,
+                                               remote.data(), chunk, 0);
+        if (transferred < 0 && errno != EFAULT) {
+            // Refused (Yama ptrace_scope for an attached process) or the
+            // process is gone: GDB reads the rest
+            directMemory_ = false;
+            return done;
+        }
+        
+        size_t pages = transferred > 0 ? static_cast<size_t>(transferred) / kMemoryPage : 0;
+        for (size_t i = 0; i < pages; i++) {
+            auto pageData = buffer.begin() + i * kMemoryPage;
+            memoryPages_[chunkStart + i * kMemoryPage].assign(pageData, pageData + kMemoryPage);
         }
+        done += pages;
+        if (pages == chunk) continue;
+        
+        // The page the transfer stopped at may still be readable through
+        // /proc/<pid>/mem, which like ptrace ignores page protections
+        uint64_t failed = chunkStart + pages * kMemoryPage;
+        std::vector<uint8_t>& data = memoryPages_[failed];
+        data.resize(kMemoryPage);
+        if (memFd_ < 0 ||
+            pread(memFd_, data.data(), kMemoryPage, static_cast<off_t>(failed)) !=
+                static_cast<ssize_t>(kMemoryPage)) {
+            data.clear();
+        }
+        done++;
     }
+    return done;
+#else
+    directMemory_ = false;
+    return 0;
+#endif
+}
+
+void UCGDBPlugin::ReadPagesMI(uint64_t firstPage, size_t pageCount) {
+    std::vector<uint8_t> buffer(pageCount * kMemoryPage);
+    std::vector<size_t> covered(pageCount, 0);
     
-    return region;
+    GDBMIRecord result = SendCommand(
+        GDBMICommandBuilder::DataReadMemory(firstPage, buffer.size()));
+    
+    GDBMIValue blocks = result.results.Get("memory");
+    if (result.IsSuccess() && blocks.IsList()) {
+        // One block per readable part of the range
+        for (GDBMIValue blockVal : blocks) {
+            uint64_t start = blockVal.GetUInt64("begin") + blockVal.GetUInt64("offset");
+            std::string_view hexData = blockVal.Get("contents").AsString();
+            if (start < firstPage || start - firstPage >= buffer.size()) continue;
+            
+            uint64_t offset = start - firstPage;
+            uint64_t length = std::min<uint64_t>(hexData.size() / 2, buffer.size() - offset);
+            UCGDBMIParser::DecodeHex(hexData.substr(0, length * 2), buffer.data() + offset);
+            
+            for (uint64_t pos = offset; pos < offset + length; ) {
+                uint64_t pageEnd = (pos / kMemoryPage + 1) * kMemoryPage;
+                uint64_t bytes = std::min(pageEnd, offset + length) - pos;
+                covered[pos / kMemoryPage] += bytes;
+                pos += bytes;
+            }
+        }
+    }
+    
+    // Pages GDB could only read in part are cached as unreadable
+    for (size_t i = 0; i < pageCount; i++) {
+        std::vector<uint8_t>& data = memoryPages_[firstPage + i * kMemoryPage];
+        if (covered[i] == kMemoryPage) {
+            auto pageData = buffer.begin() + i * kMemoryPage;
+            data.assign(pageData, pageData + kMemoryPage);
+        } else {
+            data.clear();
+        }
+    }
+}
+
+void UCGDBPlugin::OpenDirectMemory(int pid) {
+    CloseDirectMemory();
+    directPid_ = pid;
+    
+#ifdef __linux__
+    // Only a process traced by our GDB: the pid of a remote target or a
+    // core file names an unrelated local process, if any
+    if (!config_.directMemoryAccess || pid <= 0 || !process_ ||
+        !IsTracedBy(pid, process_->GetPid())) {
+        return;
+    }
+    
+    directMemory_ = true;
+    memFd_ = open(("/proc/" + std::to_string(pid) + "/mem").c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+}
+
+void UCGDBPlugin::CloseDirectMemory() {
+#ifdef __linux__
+    if (memFd_ >= 0) {
+        close(memFd_);
+    }
+#endif
+    memFd_ = -1;
+    directPid_ = 0;
+    directMemory_ = false;
+    codeRanges_.clear();
+}
+
+void UCGDBPlugin::InvalidateMemoryCache() {
+    std::lock_guard<std::mutex> lock(memoryMutex_);
+    memoryPages_.clear();
+}
+
+int UCGDBPlugin::LocalInferiorPid() {
+    std::lock_guard<std::mutex> lock(memoryMutex_);
+    if (inferiorPid_ != directPid_) {
+        OpenDirectMemory(inferiorPid_);
+    }
+    return directMemory_ ? directPid_ : 0;
 }
 
 bool UCGDBPlugin::WriteMemory(uint64_t address, const std::vector<uint8_t>& data) {
@@ -460,85 +1443,231 @@ bool UCGDBPlugin::WriteMemory(uint64_t address, const std::vector<uint8_t>& data
         << " " << hexData.str();
     
     GDBMIRecord result = SendCommand(cmd.str());
-    return result.IsSuccess();
+    if (!result.IsSuccess()) return false;
+    
+    {
+        std::lock_guard<std::mutex> lock(varObjectMutex_);
+        varUpdateGeneration_ = 0;
+    }
+    InvalidateMemoryCache();
+    return true;
 }
 
 // ============================================================================
 // DISASSEMBLY
 // ============================================================================
 
+namespace {
+
+constexpr size_t kMaxDisassemblyLines = 200000;
+constexpr size_t kPrefetchFrames = 8;
+
+// Instruction length from GDB's "opcodes" field ("48 83 ec 10")
+uint64_t OpcodeLength(const std::string& opcodes) {
+    uint64_t digits = 0;
+    for (char c : opcodes) {
+        if (c != ' ') digits++;
+    }
+    return digits / 2;
+}
+
+} // anonymous namespace
+
 std::vector<DisassemblyLine> UCGDBPlugin::GetDisassembly(uint64_t address, int count) {
     std::vector<DisassemblyLine> lines;
+    if (count <= 0) return lines;
+    
+    CodeModule module;
+    int pid = LocalInferiorPid();
+    {
+        std::lock_guard<std::mutex> lock(disassemblyMutex_);
+        if (const CodeModule* found = FindCodeModule(address, pid)) {
+            module = *found;
+            CollectDisassembly(module.key, address, count, lines);
+            if (static_cast<int>(lines.size()) >= count) return lines;
+        }
+    }
     
-    uint64_t endAddr = address + (count * 16); // Estimate
+    // Disassemble from where the cached instructions end
+    uint64_t start = address;
+    if (!lines.empty()) {
+        start = lines.back().address + OpcodeLength(lines.back().opcodes);
+    }
+    uint64_t endAddr = start + (count - lines.size()) * 16; // Estimate
     GDBMIRecord result = SendCommand(
-        GDBMICommandBuilder::DataDisassemble(address, endAddr));
+        GDBMICommandBuilder::DataDisassemble(start, endAddr));
     
     if (!result.IsSuccess()) return lines;
     
-    auto asmIt = result.results.find("asm_insns");
-    if (asmIt == result.results.end() || !asmIt->second.IsList()) return lines;
+    std::vector<DisassemblyLine> fetched = ParseDisassembly(result);
+    if (!module.key.empty()) {
+        std::lock_guard<std::mutex> lock(disassemblyMutex_);
+        CacheDisassembly(module, fetched);
+    }
     
-    for (const auto& lineVal : asmIt->second.listValue) {
-        if (!lineVal.IsTuple()) continue;
-        
-        DisassemblyLine line;
-        
-        auto addrIt = lineVal.tupleValue.find("address");
-        if (addrIt != lineVal.tupleValue.end()) {
-            line.address = std::stoull(addrIt->second.stringValue, nullptr, 16);
-        }
-        
-        auto instIt = lineVal.tupleValue.find("inst");
-        if (instIt != lineVal.tupleValue.end()) {
-            line.instruction = instIt->second.stringValue;
-        }
-        
-        auto funcIt = lineVal.tupleValue.find("func-name");
-        if (funcIt != lineVal.tupleValue.end()) {
-            line.functionName = funcIt->second.stringValue;
-        }
-        
-        lines.push_back(line);
-        
+    for (auto& line : fetched) {
         if (static_cast<int>(lines.size()) >= count) break;
+        lines.push_back(std::move(line));
     }
     
     return lines;
 }
 
 std::vector<DisassemblyLine> UCGDBPlugin::GetFunctionDisassembly(const std::string& functionName) {
-    std::vector<DisassemblyLine> lines;
-    
     std::string cmd = "-data-disassemble -f \"" + 
                       UCGDBMIParser::Escape(functionName) + "\" 0";
     GDBMIRecord result = SendCommand(cmd);
     
+    std::vector<DisassemblyLine> lines;
     if (!result.IsSuccess()) return lines;
     
-    auto asmIt = result.results.find("asm_insns");
-    if (asmIt == result.results.end() || !asmIt->second.IsList()) return lines;
+    lines = ParseDisassembly(result);
+    for (auto& line : lines) {
+        line.functionName = functionName;
+    }
     
-    for (const auto& lineVal : asmIt->second.listValue) {
+    return lines;
+}
+
+std::vector<DisassemblyLine> UCGDBPlugin::ParseDisassembly(const GDBMIRecord& record) {
+    std::vector<DisassemblyLine> lines;
+    
+    GDBMIValue instructions = record.results.Get("asm_insns");
+    if (!instructions.IsList()) return lines;
+    
+    lines.reserve(instructions.Size());
+    for (GDBMIValue lineVal : instructions) {
         if (!lineVal.IsTuple()) continue;
         
         DisassemblyLine line;
+        line.address = lineVal.GetUInt64("address", line.address);
+        line.instruction = lineVal.GetString("inst");
+        line.opcodes = lineVal.GetString("opcodes");
+        line.functionName = lineVal.GetString("func-name");
+        line.functionOffset = lineVal.GetInt("offset");
         
-        auto addrIt = lineVal.tupleValue.find("address");
-        if (addrIt != lineVal.tupleValue.end()) {
-            line.address = std::stoull(addrIt->second.stringValue, nullptr, 16);
-        }
+        lines.push_back(line);
+    }
+    
+    return lines;
+}
+
+const UCGDBPlugin::CodeModule* UCGDBPlugin::FindCodeModule(uint64_t address, int pid) {
+    // Called with disassemblyMutex_ held. pid comes from LocalInferiorPid(),
+    // read before taking it: ReadMemory holds memoryMutex_ across commands
+    // whose dispatch takes disassemblyMutex_, so the two never nest this way
+#ifdef __linux__
+    // File-backed code of the local inferior, keyed by what was mapped
+    // (build ID, else path and inode) and where
+    if (codeModulesStale_) {
+        codeModulesStale_ = false;
+        codeModules_.clear();
         
-        auto instIt = lineVal.tupleValue.find("inst");
-        if (instIt != lineVal.tupleValue.end()) {
-            line.instruction = instIt->second.stringValue;
+        for (const Mapping& mapping : pid > 0 ? ReadMappings(pid, 'x') : std::vector<Mapping>()) {
+            if (mapping.path.empty() || mapping.path[0] != '/') continue;
+            
+            std::string file = mapping.path + ":" + std::to_string(mapping.inode);
+            auto id = buildIds_.find(file);
+            if (id == buildIds_.end()) {
+                id = buildIds_.emplace(file, ReadBuildId(mapping.path)).first;
+            }
+            
+            std::ostringstream key;
+            key << (id->second.empty() ? file : id->second)
+                << "@" << std::hex << (mapping.start - mapping.offset);
+            codeModules_.push_back({mapping.start, mapping.end, key.str()});
         }
+    }
+#endif
+    
+    auto next = std::upper_bound(codeModules_.begin(), codeModules_.end(), address,
+        [](uint64_t addr, const CodeModule& module) { return addr < module.start; });
+    if (next == codeModules_.begin() || address >= std::prev(next)->end) {
+        return nullptr;
+    }
+    return &*std::prev(next);
+}
+
+void UCGDBPlugin::CollectDisassembly(const std::string& module, uint64_t address, int count,
+                                     std::vector<DisassemblyLine>& lines) {
+    auto cache = disassemblyCache_.find(module);
+    if (cache == disassemblyCache_.end()) return;
+    
+    // Follow instruction lengths from address for as long as each next
+    // instruction is cached. Decoding at an address gives the same
+    // instruction whichever request cached it.
+    uint64_t cursor = address;
+    while (static_cast<int>(lines.size()) < count) {
+        auto it = cache->second.find(cursor);
+        if (it == cache->second.end()) break;
         
-        line.functionName = functionName;
-        lines.push_back(line);
+        uint64_t length = OpcodeLength(it->second.opcodes);
+        if (length == 0) break;
+        
+        lines.push_back(it->second);
+        cursor += length;
+    }
+}
+
+void UCGDBPlugin::CacheDisassembly(const CodeModule& module,
+                                   const std::vector<DisassemblyLine>& lines) {
+    if (disassemblyLines_ + lines.size() > kMaxDisassemblyLines) {
+        disassemblyCache_.clear();
+        disassemblyLines_ = 0;
     }
     
-    return lines;
+    auto& cache = disassemblyCache_[module.key];
+    for (const auto& line : lines) {
+        if (line.address < module.start || line.address >= module.end ||
+            line.opcodes.empty()) {
+            continue;
+        }
+        if (cache.emplace(line.address, line).second) {
+            disassemblyLines_++;
+        }
+    }
+}
+
+void UCGDBPlugin::PrefetchDisassembly(const std::vector<StackFrame>& callStack) {
+    // The functions around the PC and the return addresses: where
+    // instruction stepping and stepping out go next
+    std::vector<std::pair<uint64_t, CodeModule>> prefetches;
+    int pid = LocalInferiorPid();
+    {
+        std::lock_guard<std::mutex> lock(disassemblyMutex_);
+        size_t frames = std::min(callStack.size(), kPrefetchFrames);
+        for (size_t i = 0; i < frames; i++) {
+            uint64_t address = callStack[i].address;
+            const CodeModule* module = FindCodeModule(address, pid);
+            if (!module || disassemblyPrefetches_.count(address)) continue;
+            
+            auto cache = disassemblyCache_.find(module->key);
+            if (cache != disassemblyCache_.end() && cache->second.count(address)) continue;
+            
+            disassemblyPrefetches_.insert(address);
+            prefetches.emplace_back(address, *module);
+        }
+    }
+    
+    // Not stop-scoped: code stays the same after the target resumes
+    for (const auto& [address, module] : prefetches) {
+        int token = SendCommandAsync(GDBMICommandBuilder::DataDisassembleFunction(address),
+            [this, address = address, module = module](const GDBMIRecord& record) {
+                std::vector<DisassemblyLine> lines;
+                if (record.IsSuccess()) {
+                    lines = ParseDisassembly(record);
+                }
+                
+                std::lock_guard<std::mutex> lock(disassemblyMutex_);
+                disassemblyPrefetches_.erase(address);
+                CacheDisassembly(module, lines);
+            }, GDBCommandPriority::Low);
+        
+        if (token < 0) {
+            std::lock_guard<std::mutex> lock(disassemblyMutex_);
+            disassemblyPrefetches_.erase(address);
+        }
+    }
 }
 
 // ============================================================================
@@ -551,36 +1680,28 @@ std::vector<ModuleInfo> UCGDBPlugin::GetModules() {
     GDBMIRecord result = SendCommand("-file-list-shared-libraries");
     if (!result.IsSuccess()) return modules;
     
-    auto libsIt = result.results.find("shared-libraries");
-    if (libsIt == result.results.end() || !libsIt->second.IsList()) return modules;
+    GDBMIValue libraries = result.results.Get("shared-libraries");
+    if (!libraries.IsList()) return modules;
     
-    for (const auto& libVal : libsIt->second.listValue) {
+    modules.reserve(libraries.Size());
+    for (GDBMIValue libVal : libraries) {
         if (!libVal.IsTuple()) continue;
         
         ModuleInfo mod;
         
-        auto nameIt = libVal.tupleValue.find("target-name");
-        if (nameIt != libVal.tupleValue.end()) {
-            mod.path = nameIt->second.stringValue;
+        GDBMIValue name = libVal.Get("target-name");
+        if (name.IsString()) {
+            mod.path = name.AsString();
             size_t pos = mod.path.find_last_of("/\\");
             mod.name = (pos != std::string::npos) ? mod.path.substr(pos + 1) : mod.path;
         }
         
-        auto fromIt = libVal.tupleValue.find("from");
-        if (fromIt != libVal.tupleValue.end()) {
-            mod.baseAddress = std::stoull(fromIt->second.stringValue, nullptr, 16);
+        mod.baseAddress = libVal.GetUInt64("from", mod.baseAddress);
+        if (libVal.Has("to")) {
+            mod.size = libVal.GetUInt64("to") - mod.baseAddress;
         }
         
-        auto toIt = libVal.tupleValue.find("to");
-        if (toIt != libVal.tupleValue.end()) {
-            uint64_t endAddr = std::stoull(toIt->second.stringValue, nullptr, 16);
-            mod.size = endAddr - mod.baseAddress;
-        }
-        
-        auto symbolsIt = libVal.tupleValue.find("symbols-loaded");
-        if (symbolsIt != libVal.tupleValue.end()) {
-            mod.hasDebugInfo = (symbolsIt->second.stringValue == "1");
-        }
+        mod.hasDebugInfo = libVal.Get("symbols-loaded").AsString() == "1";
         
         modules.push_back(mod);
     }
@@ -600,14 +1721,15 @@ std::vector<DebugCompletionItem> UCGDBPlugin::GetCompletions(const std::string&
     
     if (!result.IsSuccess()) return completions;
     
-    auto matchesIt = result.results.find("matches");
-    if (matchesIt == result.results.end() || !matchesIt->second.IsList()) return completions;
+    GDBMIValue matches = result.results.Get("matches");
+    if (!matches.IsList()) return completions;
     
-    for (const auto& matchVal : matchesIt->second.listValue) {
+    completions.reserve(matches.Size());
+    for (GDBMIValue matchVal : matches) {
         if (matchVal.IsString()) {
             DebugCompletionItem item;
-            item.label = matchVal.stringValue;
-            item.insertText = matchVal.stringValue;
+            item.label = matchVal.AsString();
+            item.insertText = item.label;
             completions.push_back(item);
         }
     }
@@ -9,6 +9,8 @@
 #include <sstream>
 #include <cstring>
 #include <array>
+#include <chrono>
+#include <algorithm>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -16,19 +18,250 @@
 #include <unistd.h>
 #include <sys/wait.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <signal.h>
 #include <fcntl.h>
 #include <poll.h>
 #include <errno.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#endif
 #endif
 
 namespace UltraCanvas {
 namespace IDE {
 
+namespace {
+
+/**
+ * @brief Byte ring the reader fills from stdout and splits lines from in place
+ *
+ * Lines are found with memchr over the unscanned part only, so a burst
+ * costs O(bytes) no matter how it is split across reads. The ring doubles
+ * when a single line outgrows it.
+ */
+class LineRing {
+public:
+    explicit LineRing(size_t capacity) : data_(capacity) {}
+    
+    /**
+     * @brief Free space as up to two spans (it may wrap); grows the ring when full
+     */
+    int FreeSpans(char* spans[2], size_t sizes[2]) {
+        if (tail_ - head_ == data_.size()) {
+            Grow();
+        }
+        size_t capacity = data_.size();
+        size_t free = capacity - static_cast<size_t>(tail_ - head_);
+        size_t start = static_cast<size_t>(tail_ & (capacity - 1));
+        size_t first = std::min(free, capacity - start);
+        spans[0] = data_.data() + start;
+        sizes[0] = first;
+        if (free > first) {
+            spans[1] = data_.data();
+            sizes[1] = free - first;
+            return 2;
+        }
+        return 1;
+    }
+    
+    void Commit(size_t bytes) { tail_ += bytes; }
+    
+    /**
+     * @brief Move the next complete line (without \r\n) into `line`
+     */
+    bool NextLine(std::string& line) {
+        size_t capacity = data_.size();
+        while (scan_ < tail_) {
+            size_t pos = static_cast<size_t>(scan_ & (capacity - 1));
+            size_t length = std::min(static_cast<size_t>(tail_ - scan_), capacity - pos);
+            const char* newline = static_cast<const char*>(
+                std::memchr(data_.data() + pos, '\n', length));
+            if (!newline) {
+                scan_ += length;
+                continue;
+            }
+            
+            uint64_t end = scan_ + static_cast<uint64_t>(newline - (data_.data() + pos));
+            CopyOut(head_, end, line);
+            head_ = scan_ = end + 1;
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            return true;
+        }
+        return false;
+    }
+    
+    /**
+     * @brief Whatever follows the last newline (output ended mid-line)
+     */
+    std::string TakeRest() {
+        std::string rest;
+        CopyOut(head_, tail_, rest);
+        head_ = scan_ = tail_;
+        return rest;
+    }
+    
+private:
+    void CopyOut(uint64_t from, uint64_t to, std::string& out) const {
+        size_t capacity = data_.size();
+        size_t pos = static_cast<size_t>(from & (capacity - 1));
+        size_t length = static_cast<size_t>(to - from);
+        size_t first = std::min(length, capacity - pos);
+        out.assign(data_.data() + pos, first);
+        if (length > first) {
+            out.append(data_.data(), length - first);
+        }
+    }
+    
+    void Grow() {
+        std::vector<char> larger(data_.size() * 2);
+        std::string pending;
+        CopyOut(head_, tail_, pending);
+        std::memcpy(larger.data(), pending.data(), pending.size());
+        tail_ -= head_;
+        scan_ -= head_;
+        head_ = 0;
+        data_.swap(larger);
+    }
+    
+    std::vector<char> data_;            // Power-of-two capacity
+    uint64_t head_ = 0;                 // First byte of the current line
+    uint64_t tail_ = 0;                 // End of data
+    uint64_t scan_ = 0;                 // Bytes before this hold no newline
+};
+
+const size_t STDOUT_RING_SIZE = 64 * 1024;
+
+#ifndef _WIN32
+
+// Signal and reset notification fds: an eventfd on Linux (read and write
+// ends are the same fd), a non-blocking pipe elsewhere
+bool CreateNotifyFd(int& readFd, int& writeFd) {
+#ifdef __linux__
+    readFd = writeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    return readFd >= 0;
+#else
+    int fds[2];
+    if (pipe(fds) < 0) return false;
+    for (int fd : fds) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    readFd = fds[0];
+    writeFd = fds[1];
+    return true;
+#endif
+}
+
+void SignalNotifyFd(int writeFd) {
+    uint64_t one = 1;
+    ssize_t result = write(writeFd, &one, sizeof(one));
+    (void)result; // A full pipe is still readable, which is all we need
+}
+
+void ResetNotifyFd(int readFd) {
+    uint64_t counter[8];
+    while (read(readFd, counter, sizeof(counter)) > 0) {
+    }
+}
+
+void CloseNotifyFd(int& readFd, int& writeFd) {
+    if (writeFd >= 0 && writeFd != readFd) close(writeFd);
+    if (readFd >= 0) close(readFd);
+    readFd = writeFd = -1;
+}
+
+/**
+ * @brief Readiness wait over a few fds: epoll on Linux, poll() elsewhere
+ */
+class FdPoller {
+public:
+    FdPoller() {
+#ifdef __linux__
+        epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+#endif
+    }
+    
+    ~FdPoller() {
+#ifdef __linux__
+        if (epollFd_ >= 0) close(epollFd_);
+#endif
+    }
+    
+    void Add(int fd) {
+        if (fd < 0) return;
+#ifdef __linux__
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &event);
+#else
+        fds_.push_back({fd, POLLIN, 0});
+#endif
+    }
+    
+    void Remove(int fd) {
+#ifdef __linux__
+        epoll_ctl(epollFd_, EPOLL_CTL_DEL, fd, nullptr);
+#else
+        fds_.erase(std::remove_if(fds_.begin(), fds_.end(),
+                                  [fd](const pollfd& p) { return p.fd == fd; }),
+                   fds_.end());
+#endif
+    }
+    
+    /**
+     * @brief Block until at least one fd is readable (or hung up)
+     * @return Number of ready fds written to `ready`, or -1 on error
+     */
+    int Wait(int* ready, int maxReady) {
+        for (;;) {
+#ifdef __linux__
+            epoll_event events[8];
+            int count = epoll_wait(epollFd_, events, std::min(maxReady, 8), -1);
+            if (count < 0 && errno == EINTR) continue;
+            for (int i = 0; i < count; i++) {
+                ready[i] = events[i].data.fd;
+            }
+            return count;
+#else
+            int count = poll(fds_.data(), fds_.size(), -1);
+            if (count < 0 && errno == EINTR) continue;
+            if (count < 0) return -1;
+            int found = 0;
+            for (const pollfd& p : fds_) {
+                if (p.revents && found < maxReady) ready[found++] = p.fd;
+            }
+            return found;
+#endif
+        }
+    }
+    
+private:
+#ifdef __linux__
+    int epollFd_ = -1;
+#else
+    std::vector<pollfd> fds_;
+#endif
+};
+
+#endif
+
+} // namespace
+
 UCGDBProcess::UCGDBProcess() = default;
 
 UCGDBProcess::~UCGDBProcess() {
     Stop();
+#ifndef _WIN32
+    // Closed here rather than in Stop(): a reader may still be polling them
+    CloseNotifyFd(wakeFd_, wakeWriteFd_);
+    CloseNotifyFd(outputEventFd_, outputEventWriteFd_);
+#endif
 }
 
 bool UCGDBProcess::Start(const std::string& gdbPath, const std::vector<std::string>& args) {
@@ -99,12 +332,27 @@ bool UCGDBProcess::Start(const std::string& gdbPath, const std::vector<std::stri
     
 #else
     // POSIX implementation
+    if (wakeFd_ < 0 && !CreateNotifyFd(wakeFd_, wakeWriteFd_)) {
+        return false;
+    }
+    if (outputEventFd_ < 0 && !CreateNotifyFd(outputEventFd_, outputEventWriteFd_)) {
+        return false;
+    }
+    // Left signalled by the previous session's exit
+    ResetNotifyFd(wakeFd_);
+    ResetNotifyFd(outputEventFd_);
+    
     int stdinPipe[2], stdoutPipe[2], stderrPipe[2];
     
     if (pipe(stdinPipe) < 0 || pipe(stdoutPipe) < 0 || pipe(stderrPipe) < 0) {
         return false;
     }
     
+    // Our ends must not leak into GDB (or the programs it starts)
+    fcntl(stdinPipe[1], F_SETFD, FD_CLOEXEC);
+    fcntl(stdoutPipe[0], F_SETFD, FD_CLOEXEC);
+    fcntl(stderrPipe[0], F_SETFD, FD_CLOEXEC);
+    
     pid_ = fork();
     
     if (pid_ < 0) {
@@ -159,14 +407,26 @@ bool UCGDBProcess::Start(const std::string& gdbPath, const std::vector<std::stri
     
     flags = fcntl(stderrFd_, F_GETFL, 0);
     fcntl(stderrFd_, F_SETFL, flags | O_NONBLOCK);
+    
+#if defined(__linux__) && defined(SYS_pidfd_open)
+    // Exit notification even while the debuggee still holds GDB's stdout
+    // open (Linux 5.3+; without it, exit is noticed when stdout closes)
+    pidFd_ = static_cast<int>(syscall(SYS_pidfd_open, pid_, 0));
+#endif
 #endif
     
+    exited_ = false;
+    exitCode_ = -1;
     running_ = true;
     stopThreads_ = false;
     
     // Start output reading threads
+#ifdef _WIN32
     readThread_ = std::thread(&UCGDBProcess::ReadThreadFunc, this);
     errorThread_ = std::thread(&UCGDBProcess::ErrorThreadFunc, this);
+#else
+    ioThread_ = std::thread(&UCGDBProcess::IoThreadFunc, this);
+#endif
     
     return true;
 }
@@ -182,54 +442,57 @@ void UCGDBProcess::Stop() {
     if (processHandle_) {
         TerminateProcess(processHandle_, 0);
         WaitForSingleObject(processHandle_, 1000);
+        DWORD exitCode = 0;
+        if (GetExitCodeProcess(processHandle_, &exitCode)) {
+            exitCode_ = static_cast<int>(exitCode);
+        }
         CloseHandle(processHandle_);
         CloseHandle(threadHandle_);
         processHandle_ = nullptr;
         threadHandle_ = nullptr;
     }
     
+    // The process is gone, so the blocking reads see a broken pipe
+    if (readThread_.joinable()) {
+        outputCv_.notify_all();
+        readThread_.join();
+    }
+    if (errorThread_.joinable()) {
+        errorThread_.join();
+    }
+    
     if (stdinWrite_) { CloseHandle(stdinWrite_); stdinWrite_ = nullptr; }
     if (stdoutRead_) { CloseHandle(stdoutRead_); stdoutRead_ = nullptr; }
     if (stderrRead_) { CloseHandle(stderrRead_); stderrRead_ = nullptr; }
+    exited_ = true;
 #else
-    if (pid_ > 0) {
+    if (pid_ > 0 && !exited_) {
         kill(pid_, SIGTERM);
         
-        // Wait briefly for graceful termination
-        int status;
-        int waitResult = waitpid(pid_, &status, WNOHANG);
-        if (waitResult == 0) {
-            // Still running, wait a bit more
-            usleep(100000); // 100ms
-            waitResult = waitpid(pid_, &status, WNOHANG);
-            if (waitResult == 0) {
-                // Force kill
-                kill(pid_, SIGKILL);
-                waitpid(pid_, &status, 0);
-            }
-        }
-        
-        if (WIFEXITED(status)) {
-            exitCode_ = WEXITSTATUS(status);
+        // The I/O thread reaps the process; give it a moment to exit
+        // cleanly, returning as soon as it has
+        std::unique_lock<std::mutex> lock(outputMutex_);
+        if (!outputCv_.wait_for(lock, std::chrono::milliseconds(100),
+                                [this] { return exited_.load(); })) {
+            lock.unlock();
+            kill(pid_, SIGKILL);
         }
-        pid_ = -1;
     }
     
+    SignalNotifyFd(wakeWriteFd_);
+    if (ioThread_.joinable()) {
+        ioThread_.join();
+    }
+    pid_ = -1;
+    
     if (stdinFd_ >= 0) { close(stdinFd_); stdinFd_ = -1; }
     if (stdoutFd_ >= 0) { close(stdoutFd_); stdoutFd_ = -1; }
     if (stderrFd_ >= 0) { close(stderrFd_); stderrFd_ = -1; }
+    if (pidFd_ >= 0) { close(pidFd_); pidFd_ = -1; }
 #endif
     
-    // Wait for threads
-    if (readThread_.joinable()) {
-        outputCv_.notify_all();
-        readThread_.join();
-    }
-    if (errorThread_.joinable()) {
-        errorThread_.join();
-    }
-    
     running_ = false;
+    SignalOutput();
     
     if (onExit) {
         onExit(exitCode_);
@@ -248,12 +511,8 @@ bool UCGDBProcess::IsRunning() const {
     }
     return false;
 #else
-    if (pid_ > 0) {
-        int status;
-        int result = waitpid(pid_, &status, WNOHANG);
-        return result == 0;
-    }
-    return false;
+    // Updated by the I/O thread the moment the process is reaped
+    return !exited_;
 #endif
 }
 
@@ -282,16 +541,17 @@ bool UCGDBProcess::SendLine(const std::string& line) {
 }
 
 std::string UCGDBProcess::ReadLine(int timeoutMs) {
+#ifdef _WIN32
     std::unique_lock<std::mutex> lock(outputMutex_);
     
     if (outputQueue_.empty()) {
         if (timeoutMs < 0) {
             outputCv_.wait(lock, [this] { 
-                return !outputQueue_.empty() || stopThreads_; 
+                return !outputQueue_.empty() || stopThreads_ || exited_; 
             });
         } else if (timeoutMs > 0) {
             outputCv_.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] {
-                return !outputQueue_.empty() || stopThreads_;
+                return !outputQueue_.empty() || stopThreads_ || exited_;
             });
         }
     }
@@ -300,9 +560,42 @@ std::string UCGDBProcess::ReadLine(int timeoutMs) {
         return "";
     }
     
-    std::string line = outputQueue_.front();
+    std::string line = std::move(outputQueue_.front());
     outputQueue_.pop();
     return line;
+#else
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(outputMutex_);
+            if (!outputQueue_.empty()) {
+                std::string line = std::move(outputQueue_.front());
+                outputQueue_.pop();
+                // The eventfd stays readable exactly while there is
+                // something to read (or the process is gone)
+                if (outputQueue_.empty() && !exited_ && !stopThreads_) {
+                    ResetNotifyFd(outputEventFd_);
+                }
+                return line;
+            }
+            if (exited_ || stopThreads_ || !running_) {
+                return "";
+            }
+        }
+        
+        int waitMs = -1;
+        if (timeoutMs >= 0) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+            if (remaining <= 0) return "";
+            waitMs = static_cast<int>(remaining);
+        }
+        
+        pollfd pfd{outputEventFd_, POLLIN, 0};
+        poll(&pfd, 1, waitMs);
+    }
+#endif
 }
 
 std::string UCGDBProcess::ReadAll() {
@@ -310,9 +603,15 @@ std::string UCGDBProcess::ReadAll() {
     
     std::string result;
     while (!outputQueue_.empty()) {
-        result += outputQueue_.front() + "\n";
+        result += outputQueue_.front();
+        result += '\n';
         outputQueue_.pop();
     }
+#ifndef _WIN32
+    if (outputEventFd_ >= 0 && !exited_ && !stopThreads_) {
+        ResetNotifyFd(outputEventFd_);
+    }
+#endif
     return result;
 }
 
@@ -321,122 +620,218 @@ bool UCGDBProcess::HasOutput() const {
     return !outputQueue_.empty();
 }
 
-void UCGDBProcess::ReadThreadFunc() {
-    std::string lineBuffer;
-    std::array<char, 4096> buffer;
-    
-    while (!stopThreads_ && running_) {
+int UCGDBProcess::GetOutputEventFd() const {
 #ifdef _WIN32
-        DWORD bytesAvailable = 0;
-        if (!PeekNamedPipe(stdoutRead_, NULL, 0, NULL, &bytesAvailable, NULL)) {
-            break;
-        }
-        
-        if (bytesAvailable == 0) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
-            continue;
+    return -1;
+#else
+    return outputEventFd_;
+#endif
+}
+
+void UCGDBProcess::SignalOutput() {
+#ifndef _WIN32
+    if (outputEventWriteFd_ >= 0) {
+        SignalNotifyFd(outputEventWriteFd_);
+    }
+#endif
+    outputCv_.notify_all();
+}
+
+void UCGDBProcess::QueueLines(std::vector<std::string>& lines) {
+    if (onStdout) {
+        for (const auto& line : lines) {
+            onStdout(line);
         }
-        
-        DWORD bytesRead;
-        DWORD toRead = std::min(bytesAvailable, static_cast<DWORD>(buffer.size() - 1));
-        if (!ReadFile(stdoutRead_, buffer.data(), toRead, &bytesRead, NULL) || bytesRead == 0) {
-            break;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(outputMutex_);
+        for (auto& line : lines) {
+            outputQueue_.push(std::move(line));
         }
+        SignalOutput();
+    }
+    lines.clear();
+}
+
+void UCGDBProcess::MarkExited(int status) {
+    std::lock_guard<std::mutex> lock(outputMutex_);
+#ifndef _WIN32
+    if (WIFEXITED(status)) {
+        exitCode_ = WEXITSTATUS(status);
+    } else if (WIFSIGNALED(status)) {
+        exitCode_ = 128 + WTERMSIG(status);
+    }
 #else
-        struct pollfd pfd;
-        pfd.fd = stdoutFd_;
-        pfd.events = POLLIN;
-        
-        int pollResult = poll(&pfd, 1, 100);
-        if (pollResult <= 0) {
-            continue;
-        }
+    exitCode_ = status;
+#endif
+    exited_ = true;
+    SignalOutput();
+}
+
+#ifdef _WIN32
+
+void UCGDBProcess::ReadThreadFunc() {
+    LineRing ring(STDOUT_RING_SIZE);
+    std::vector<std::string> lines;
+    
+    // Anonymous pipes cannot be waited on, so this thread blocks in ReadFile
+    while (!stopThreads_) {
+        char* spans[2];
+        size_t sizes[2];
+        ring.FreeSpans(spans, sizes);
         
-        ssize_t bytesRead = read(stdoutFd_, buffer.data(), buffer.size() - 1);
-        if (bytesRead <= 0) {
-            if (bytesRead < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
-                continue;
-            }
+        DWORD bytesRead = 0;
+        if (!ReadFile(stdoutRead_, spans[0], static_cast<DWORD>(sizes[0]), &bytesRead, NULL) ||
+            bytesRead == 0) {
             break;
         }
-#endif
+        ring.Commit(bytesRead);
         
-        buffer[bytesRead] = '\0';
-        lineBuffer += buffer.data();
-        
-        // Split into lines
-        size_t pos;
-        while ((pos = lineBuffer.find('\n')) != std::string::npos) {
-            std::string line = lineBuffer.substr(0, pos);
-            lineBuffer = lineBuffer.substr(pos + 1);
-            
-            // Remove trailing CR
-            if (!line.empty() && line.back() == '\r') {
-                line.pop_back();
-            }
-            
-            {
-                std::lock_guard<std::mutex> lock(outputMutex_);
-                outputQueue_.push(line);
-            }
-            outputCv_.notify_one();
-            
-            if (onStdout) {
-                onStdout(line);
-            }
+        std::string line;
+        while (ring.NextLine(line)) {
+            if (!line.empty()) lines.push_back(std::move(line));
         }
+        if (!lines.empty()) {
+            QueueLines(lines);
+        }
+    }
+    
+    std::string rest = ring.TakeRest();
+    if (!rest.empty()) {
+        lines.push_back(std::move(rest));
+        QueueLines(lines);
+    }
+    
+    if (!stopThreads_) {
+        DWORD exitCode = 0;
+        WaitForSingleObject(processHandle_, INFINITE);
+        GetExitCodeProcess(processHandle_, &exitCode);
+        MarkExited(static_cast<int>(exitCode));
     }
 }
 
 void UCGDBProcess::ErrorThreadFunc() {
-    std::array<char, 1024> buffer;
+    std::array<char, 4096> buffer;
     
-    while (!stopThreads_ && running_) {
-#ifdef _WIN32
-        DWORD bytesAvailable = 0;
-        if (!PeekNamedPipe(stderrRead_, NULL, 0, NULL, &bytesAvailable, NULL)) {
+    while (!stopThreads_) {
+        DWORD bytesRead = 0;
+        if (!ReadFile(stderrRead_, buffer.data(), static_cast<DWORD>(buffer.size()),
+                      &bytesRead, NULL) || bytesRead == 0) {
             break;
         }
         
-        if (bytesAvailable == 0) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
-            continue;
-        }
-        
-        DWORD bytesRead;
-        if (!ReadFile(stderrRead_, buffer.data(), 
-                      std::min(bytesAvailable, static_cast<DWORD>(buffer.size() - 1)),
-                      &bytesRead, NULL) || bytesRead == 0) {
-            break;
+        if (onStderr) {
+            onStderr(std::string(buffer.data(), bytesRead));
         }
+    }
+}
+
 #else
-        struct pollfd pfd;
-        pfd.fd = stderrFd_;
-        pfd.events = POLLIN;
-        
-        int pollResult = poll(&pfd, 1, 100);
-        if (pollResult <= 0) {
-            continue;
+
+void UCGDBProcess::IoThreadFunc() {
+    FdPoller poller;
+    poller.Add(stdoutFd_);
+    poller.Add(stderrFd_);
+    poller.Add(wakeFd_);
+    poller.Add(pidFd_);
+    
+    LineRing ring(STDOUT_RING_SIZE);
+    std::vector<std::string> lines;
+    std::array<char, 4096> errorBuffer;
+    bool stdoutOpen = true;
+    bool stderrOpen = true;
+    bool processExited = false;
+    
+    // Read until the pipe is empty, then hand over every complete line
+    // in one batch (one lock, one wakeup)
+    auto drainStdout = [&]() {
+        while (stdoutOpen) {
+            char* spans[2];
+            size_t sizes[2];
+            int count = ring.FreeSpans(spans, sizes);
+            iovec iov[2];
+            for (int i = 0; i < count; i++) {
+                iov[i].iov_base = spans[i];
+                iov[i].iov_len = sizes[i];
+            }
+            
+            ssize_t bytesRead = readv(stdoutFd_, iov, count);
+            if (bytesRead > 0) {
+                ring.Commit(static_cast<size_t>(bytesRead));
+                std::string line;
+                while (ring.NextLine(line)) {
+                    if (!line.empty()) lines.push_back(std::move(line));
+                }
+                continue;
+            }
+            if (bytesRead < 0 && errno == EINTR) continue;
+            if (bytesRead < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            
+            // EOF: GDB closed stdout
+            std::string rest = ring.TakeRest();
+            if (!rest.empty()) lines.push_back(std::move(rest));
+            poller.Remove(stdoutFd_);
+            stdoutOpen = false;
         }
-        
-        ssize_t bytesRead = read(stderrFd_, buffer.data(), buffer.size() - 1);
-        if (bytesRead <= 0) {
-            if (bytesRead < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        if (!lines.empty()) {
+            QueueLines(lines);
+        }
+    };
+    
+    auto drainStderr = [&]() {
+        while (stderrOpen) {
+            ssize_t bytesRead = read(stderrFd_, errorBuffer.data(), errorBuffer.size());
+            if (bytesRead > 0) {
+                if (onStderr) {
+                    onStderr(std::string(errorBuffer.data(), static_cast<size_t>(bytesRead)));
+                }
                 continue;
             }
-            break;
+            if (bytesRead < 0 && errno == EINTR) continue;
+            if (bytesRead < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            poller.Remove(stderrFd_);
+            stderrOpen = false;
         }
-#endif
+    };
+    
+    while (!stopThreads_ && !processExited) {
+        int ready[4];
+        int count = poller.Wait(ready, 4);
+        if (count < 0) break;
         
-        buffer[bytesRead] = '\0';
-        std::string errOutput(buffer.data());
+        for (int i = 0; i < count; i++) {
+            if (ready[i] == stdoutFd_) {
+                drainStdout();
+            } else if (ready[i] == stderrFd_) {
+                drainStderr();
+            } else if (ready[i] == pidFd_) {
+                processExited = true;
+            }
+            // wakeFd_: Stop() set stopThreads_
+        }
         
-        if (onStderr) {
-            onStderr(errOutput);
+        // Without a pidfd, GDB closing stdout is the exit signal
+        if (!stdoutOpen && pidFd_ < 0) {
+            processExited = true;
         }
     }
+    
+    // Pick up output written just before the exit
+    drainStdout();
+    drainStderr();
+    
+    // Reap; if the process is still alive, Stop() is killing it
+    int status = 0;
+    pid_t result;
+    do {
+        result = waitpid(pid_, &status, 0);
+    } while (result < 0 && errno == EINTR);
+    MarkExited(result == pid_ ? status : 0);
 }
 
+#endif
+
 // ============================================================================
 // HELPER FUNCTIONS
 // ============================================================================
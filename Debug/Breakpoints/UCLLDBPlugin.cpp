@@ -12,6 +12,7 @@
 #include <thread>
 #include <algorithm>
 #include <cstring>
+#include <string_view>
 
 #ifndef _WIN32
 #include <unistd.h>
@@ -19,11 +20,19 @@
 #include <signal.h>
 #include <fcntl.h>
 #include <poll.h>
+#include <errno.h>
 #endif
 
 namespace UltraCanvas {
 namespace IDE {
 
+namespace {
+
+// Set as LLDB's prompt: it ends the output of every command
+constexpr const char* LLDB_PROMPT = "(ultracanvas-lldb) ";
+
+} // anonymous namespace
+
 // ============================================================================
 // CONFIGURATION
 // ============================================================================
@@ -98,59 +107,24 @@ bool UCLLDBPlugin::Launch(const DebugLaunchConfig& config) {
     
     SetState(DebugSessionState::Starting);
     
-#ifndef _WIN32
-    int stdinPipe[2], stdoutPipe[2];
-    if (pipe(stdinPipe) < 0 || pipe(stdoutPipe) < 0) {
-        SetState(DebugSessionState::ErrorState);
-        return false;
-    }
-    
-    pid_ = fork();
-    if (pid_ < 0) {
-        close(stdinPipe[0]); close(stdinPipe[1]);
-        close(stdoutPipe[0]); close(stdoutPipe[1]);
+    if (!StartLLDB({})) {
         SetState(DebugSessionState::ErrorState);
+        if (onError) onError("Failed to start LLDB");
         return false;
     }
     
-    if (pid_ == 0) {
-        close(stdinPipe[1]);
-        close(stdoutPipe[0]);
-        dup2(stdinPipe[0], STDIN_FILENO);
-        dup2(stdoutPipe[1], STDOUT_FILENO);
-        dup2(stdoutPipe[1], STDERR_FILENO);
-        close(stdinPipe[0]);
-        close(stdoutPipe[1]);
-        
-        execlp(lldbPath_.c_str(), lldbPath_.c_str(), nullptr);
-        _exit(127);
-    }
-    
-    close(stdinPipe[0]);
-    close(stdoutPipe[1]);
-    stdinFd_ = stdinPipe[1];
-    stdoutFd_ = stdoutPipe[0];
-    
-    fcntl(stdoutFd_, F_SETFL, fcntl(stdoutFd_, F_GETFL) | O_NONBLOCK);
-#endif
-    
-    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    // Setup commands don't depend on each other's output: write them in one go
+    std::vector<std::string> setup;
     
     // Load executable
     if (!config.executablePath.empty()) {
-        std::string cmd = "file \"" + config.executablePath + "\"";
-        std::string result = SendCommand(cmd);
-        if (result.find("error") != std::string::npos) {
-            Terminate();
-            if (onError) onError("Failed to load executable");
-            return false;
-        }
+        setup.push_back("file \"" + config.executablePath + "\"");
     }
     
     // Set working directory
     if (!config.workingDirectory.empty()) {
-        SendCommand("settings set target.process.working-directory \"" + 
-                    config.workingDirectory + "\"");
+        setup.push_back("settings set target.process.working-directory \"" +
+                        config.workingDirectory + "\"");
     }
     
     // Set arguments
@@ -160,35 +134,34 @@ bool UCLLDBPlugin::Launch(const DebugLaunchConfig& config) {
         for (const auto& arg : config.arguments) {
             args << " \"" << arg << "\"";
         }
-        SendCommand(args.str());
+        setup.push_back(args.str());
     }
     
     // Set stop on entry
     if (config.stopOnEntry) {
-        SendCommand("breakpoint set --name main");
+        setup.push_back("breakpoint set --name main");
     }
     
-    // Run
-    std::string runResult = SendCommand("run");
+    std::vector<std::future<std::string>> results = PostCommands(setup);
+    if (!config.executablePath.empty()) {
+        std::string result = WaitForResult(results.front());
+        if (result.find("error") != std::string::npos) {
+            Terminate();
+            if (onError) onError("Failed to load executable");
+            return false;
+        }
+    }
+    
+    // Run; the state changes first, as a stop may be reported with the result
+    SetState(DebugSessionState::Running);
+    std::future<std::string> run = PostCommand("run", true);
+    std::string runResult = WaitForResult(run);
     if (runResult.find("error") != std::string::npos) {
         if (onError) onError("Failed to run program");
         return false;
     }
     
-    SetState(DebugSessionState::Running);
     sessionActive = true;
-    
-    stopOutputThread_ = false;
-    outputThread_ = std::thread([this]() {
-        while (!stopOutputThread_) {
-            std::string output = SendCommand("");
-            if (!output.empty()) {
-                ProcessOutput(output);
-            }
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
-        }
-    });
-    
     return true;
 }
 
@@ -197,36 +170,11 @@ bool UCLLDBPlugin::Attach(int pid) {
     
     SetState(DebugSessionState::Starting);
     
-    // Start LLDB process (similar to Launch)
-#ifndef _WIN32
-    int stdinPipe[2], stdoutPipe[2];
-    if (pipe(stdinPipe) < 0 || pipe(stdoutPipe) < 0) {
+    if (!StartLLDB({})) {
         SetState(DebugSessionState::ErrorState);
         return false;
     }
     
-    pid_ = fork();
-    if (pid_ == 0) {
-        close(stdinPipe[1]);
-        close(stdoutPipe[0]);
-        dup2(stdinPipe[0], STDIN_FILENO);
-        dup2(stdoutPipe[1], STDOUT_FILENO);
-        dup2(stdoutPipe[1], STDERR_FILENO);
-        close(stdinPipe[0]);
-        close(stdoutPipe[1]);
-        execlp(lldbPath_.c_str(), lldbPath_.c_str(), nullptr);
-        _exit(127);
-    }
-    
-    close(stdinPipe[0]);
-    close(stdoutPipe[1]);
-    stdinFd_ = stdinPipe[1];
-    stdoutFd_ = stdoutPipe[0];
-    fcntl(stdoutFd_, F_SETFL, fcntl(stdoutFd_, F_GETFL) | O_NONBLOCK);
-#endif
-    
-    std::this_thread::sleep_for(std::chrono::milliseconds(200));
-    
     std::string result = SendCommand("attach -p " + std::to_string(pid));
     if (result.find("error") != std::string::npos) {
         Terminate();
@@ -242,37 +190,13 @@ bool UCLLDBPlugin::Attach(int pid) {
 bool UCLLDBPlugin::AttachByName(const std::string& processName) {
     if (state_ != DebugSessionState::Inactive) return false;
     
-    // Similar setup as Attach
     SetState(DebugSessionState::Starting);
     
-#ifndef _WIN32
-    int stdinPipe[2], stdoutPipe[2];
-    if (pipe(stdinPipe) < 0 || pipe(stdoutPipe) < 0) {
+    if (!StartLLDB({})) {
         SetState(DebugSessionState::ErrorState);
         return false;
     }
     
-    pid_ = fork();
-    if (pid_ == 0) {
-        close(stdinPipe[1]);
-        close(stdoutPipe[0]);
-        dup2(stdinPipe[0], STDIN_FILENO);
-        dup2(stdoutPipe[1], STDOUT_FILENO);
-        close(stdinPipe[0]);
-        close(stdoutPipe[1]);
-        execlp(lldbPath_.c_str(), lldbPath_.c_str(), nullptr);
-        _exit(127);
-    }
-    
-    close(stdinPipe[0]);
-    close(stdoutPipe[1]);
-    stdinFd_ = stdinPipe[1];
-    stdoutFd_ = stdoutPipe[0];
-    fcntl(stdoutFd_, F_SETFL, fcntl(stdoutFd_, F_GETFL) | O_NONBLOCK);
-#endif
-    
-    std::this_thread::sleep_for(std::chrono::milliseconds(200));
-    
     std::string result = SendCommand("attach -n \"" + processName + "\"");
     if (result.find("error") != std::string::npos) {
         Terminate();
@@ -296,30 +220,11 @@ bool UCLLDBPlugin::LoadCoreDump(const std::string& corePath, const std::string&
     SetState(DebugSessionState::Starting);
     
     // Start LLDB and load core
-#ifndef _WIN32
-    int stdinPipe[2], stdoutPipe[2];
-    pipe(stdinPipe);
-    pipe(stdoutPipe);
-    
-    pid_ = fork();
-    if (pid_ == 0) {
-        close(stdinPipe[1]);
-        close(stdoutPipe[0]);
-        dup2(stdinPipe[0], STDIN_FILENO);
-        dup2(stdoutPipe[1], STDOUT_FILENO);
-        close(stdinPipe[0]);
-        close(stdoutPipe[1]);
-        execlp(lldbPath_.c_str(), lldbPath_.c_str(), "-c", corePath.c_str(), 
-               executablePath.c_str(), nullptr);
-        _exit(127);
+    if (!StartLLDB({ "-c", corePath, executablePath })) {
+        SetState(DebugSessionState::ErrorState);
+        return false;
     }
     
-    close(stdinPipe[0]);
-    close(stdoutPipe[1]);
-    stdinFd_ = stdinPipe[1];
-    stdoutFd_ = stdoutPipe[0];
-#endif
-    
     SetState(DebugSessionState::Paused);
     sessionActive = true;
     return true;
@@ -337,7 +242,7 @@ bool UCLLDBPlugin::Terminate() {
     
     SetState(DebugSessionState::Stopping);
     SendCommand("kill");
-    SendCommand("quit");
+    PostCommand("quit");
     Cleanup();
     SetState(DebugSessionState::Terminated);
     return true;
@@ -356,8 +261,8 @@ bool UCLLDBPlugin::IsSessionActive() const { return sessionActive; }
 
 bool UCLLDBPlugin::Continue() {
     if (state_ != DebugSessionState::Paused) return false;
-    std::string result = SendCommand("continue");
     SetState(DebugSessionState::Running);
+    PostCommand("continue", true);
     return true;
 }
 
@@ -372,21 +277,21 @@ bool UCLLDBPlugin::Pause() {
 bool UCLLDBPlugin::StepOver() {
     if (state_ != DebugSessionState::Paused) return false;
     SetState(DebugSessionState::Stepping);
-    SendCommand("next");
+    PostCommand("next", true);
     return true;
 }
 
 bool UCLLDBPlugin::StepInto() {
     if (state_ != DebugSessionState::Paused) return false;
     SetState(DebugSessionState::Stepping);
-    SendCommand("step");
+    PostCommand("step", true);
     return true;
 }
 
 bool UCLLDBPlugin::StepOut() {
     if (state_ != DebugSessionState::Paused) return false;
     SetState(DebugSessionState::Stepping);
-    SendCommand("finish");
+    PostCommand("finish", true);
     return true;
 }
 
@@ -396,7 +301,7 @@ bool UCLLDBPlugin::StepTo(const std::string& file, int line) {
 
 bool UCLLDBPlugin::RunToCursor(const std::string& file, int line) {
     std::string location = file + ":" + std::to_string(line);
-    SendCommand("breakpoint set --one-shot true --file \"" + file + 
+    PostCommand("breakpoint set --one-shot true --file \"" + file +
                 "\" --line " + std::to_string(line));
     return Continue();
 }
@@ -410,7 +315,7 @@ bool UCLLDBPlugin::SetNextStatement(const std::string& file, int line) {
 bool UCLLDBPlugin::StepInstruction() {
     if (state_ != DebugSessionState::Paused) return false;
     SetState(DebugSessionState::Stepping);
-    SendCommand("si");
+    PostCommand("si", true);
     return true;
 }
 
@@ -467,7 +372,7 @@ Breakpoint UCLLDBPlugin::AddConditionalBreakpoint(const std::string& file, int l
                                                    const std::string& condition) {
     Breakpoint bp = AddBreakpoint(file, line);
     if (bp.debuggerId >= 0 && !condition.empty()) {
-        SendCommand("breakpoint modify -c \"" + condition + "\" " + 
+        PostCommand("breakpoint modify -c \"" + condition + "\" " + 
                     std::to_string(bp.debuggerId));
         bp.condition = condition;
         breakpoints_[bp.id] = bp;
@@ -523,7 +428,7 @@ bool UCLLDBPlugin::RemoveBreakpoint(int breakpointId) {
     auto it = breakpoints_.find(breakpointId);
     if (it == breakpoints_.end()) return false;
     
-    SendCommand("breakpoint delete " + std::to_string(it->second.debuggerId));
+    PostCommand("breakpoint delete " + std::to_string(it->second.debuggerId));
     breakpoints_.erase(it);
     return true;
 }
@@ -533,7 +438,7 @@ bool UCLLDBPlugin::SetBreakpointEnabled(int breakpointId, bool enabled) {
     if (it == breakpoints_.end()) return false;
     
     std::string cmd = enabled ? "breakpoint enable " : "breakpoint disable ";
-    SendCommand(cmd + std::to_string(it->second.debuggerId));
+    PostCommand(cmd + std::to_string(it->second.debuggerId));
     it->second.enabled = enabled;
     return true;
 }
@@ -542,7 +447,7 @@ bool UCLLDBPlugin::SetBreakpointCondition(int breakpointId, const std::string& c
     auto it = breakpoints_.find(breakpointId);
     if (it == breakpoints_.end()) return false;
     
-    SendCommand("breakpoint modify -c \"" + condition + "\" " + 
+    PostCommand("breakpoint modify -c \"" + condition + "\" " + 
                 std::to_string(it->second.debuggerId));
     it->second.condition = condition;
     return true;
@@ -552,7 +457,7 @@ bool UCLLDBPlugin::SetBreakpointIgnoreCount(int breakpointId, int count) {
     auto it = breakpoints_.find(breakpointId);
     if (it == breakpoints_.end()) return false;
     
-    SendCommand("breakpoint modify -i " + std::to_string(count) + " " + 
+    PostCommand("breakpoint modify -i " + std::to_string(count) + " " + 
                 std::to_string(it->second.debuggerId));
     it->second.ignoreCount = count;
     return true;
@@ -598,7 +503,7 @@ bool UCLLDBPlugin::RemoveWatchpoint(int watchpointId) {
     auto it = watchpoints_.find(watchpointId);
     if (it == watchpoints_.end()) return false;
     
-    SendCommand("watchpoint delete " + std::to_string(it->second.debuggerId));
+    PostCommand("watchpoint delete " + std::to_string(it->second.debuggerId));
     watchpoints_.erase(it);
     return true;
 }
@@ -737,12 +642,20 @@ MemoryRegion UCLLDBPlugin::ReadMemory(uint64_t address, size_t size) {
 }
 
 bool UCLLDBPlugin::WriteMemory(uint64_t address, const std::vector<uint8_t>& data) {
+    // One command per byte, all written before the first result is read
+    std::vector<std::string> commands;
+    commands.reserve(data.size());
     for (size_t i = 0; i < data.size(); i++) {
         std::ostringstream cmd;
         cmd << "memory write 0x" << std::hex << (address + i) << " " << static_cast<int>(data[i]);
-        SendCommand(cmd.str());
+        commands.push_back(cmd.str());
     }
-    return true;
+    
+    bool success = true;
+    for (auto& future : PostCommands(commands)) {
+        if (WaitForResult(future).find("error") != std::string::npos) success = false;
+    }
+    return success;
 }
 
 // ============================================================================
@@ -777,34 +690,270 @@ std::vector<DebugCompletionItem> UCLLDBPlugin::GetCompletions(const std::string&
 // PRIVATE HELPERS
 // ============================================================================
 
-std::string UCLLDBPlugin::SendCommand(const std::string& command) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
+bool UCLLDBPlugin::StartLLDB(const std::vector<std::string>& args) {
 #ifndef _WIN32
-    if (stdinFd_ < 0 || stdoutFd_ < 0) return "";
+    int stdinPipe[2], stdoutPipe[2], wakePipe[2];
+    if (pipe(stdinPipe) < 0) return false;
+    if (pipe(stdoutPipe) < 0) {
+        close(stdinPipe[0]); close(stdinPipe[1]);
+        return false;
+    }
+    if (pipe(wakePipe) < 0) {
+        close(stdinPipe[0]); close(stdinPipe[1]);
+        close(stdoutPipe[0]); close(stdoutPipe[1]);
+        return false;
+    }
+    
+    // Our ends must not leak into LLDB (or the programs it starts)
+    fcntl(stdinPipe[1], F_SETFD, FD_CLOEXEC);
+    fcntl(stdoutPipe[0], F_SETFD, FD_CLOEXEC);
+    fcntl(wakePipe[0], F_SETFD, FD_CLOEXEC);
+    fcntl(wakePipe[1], F_SETFD, FD_CLOEXEC);
     
-    if (!command.empty()) {
-        std::string cmd = command + "\n";
-        write(stdinFd_, cmd.c_str(), cmd.size());
+    pid_ = fork();
+    if (pid_ < 0) {
+        close(stdinPipe[0]); close(stdinPipe[1]);
+        close(stdoutPipe[0]); close(stdoutPipe[1]);
+        close(wakePipe[0]); close(wakePipe[1]);
+        return false;
     }
     
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    if (pid_ == 0) {
+        dup2(stdinPipe[0], STDIN_FILENO);
+        dup2(stdoutPipe[1], STDOUT_FILENO);
+        dup2(stdoutPipe[1], STDERR_FILENO);
+        close(stdinPipe[0]);
+        close(stdoutPipe[1]);
+        
+        // The prompt ends every command's output; colours would wrap it
+        // in escape sequences, and confirmation questions would block
+        std::vector<std::string> arguments = {
+            lldbPath_, "--no-use-colors", "--source-quietly",
+            "-O", "settings set prompt \"" + std::string(LLDB_PROMPT) + "\"",
+            "-O", "settings set auto-confirm true"
+        };
+        arguments.insert(arguments.end(), args.begin(), args.end());
+        
+        std::vector<char*> argv;
+        for (auto& argument : arguments) argv.push_back(argument.data());
+        argv.push_back(nullptr);
+        
+        execvp(lldbPath_.c_str(), argv.data());
+        _exit(127);
+    }
     
-    std::string result;
-    char buffer[4096];
-    ssize_t bytesRead;
+    close(stdinPipe[0]);
+    close(stdoutPipe[1]);
+    stdinFd_ = stdinPipe[1];
+    stdoutFd_ = stdoutPipe[0];
+    wakeReadFd_ = wakePipe[0];
+    wakeWriteFd_ = wakePipe[1];
+    fcntl(stdoutFd_, F_SETFL, fcntl(stdoutFd_, F_GETFL) | O_NONBLOCK);
+    
+    outputBuffer_.clear();
+    promptScan_ = 0;
     
-    while ((bytesRead = read(stdoutFd_, buffer, sizeof(buffer) - 1)) > 0) {
-        buffer[bytesRead] = '\0';
-        result += buffer;
+    // Whatever LLDB prints before its first prompt belongs to no command;
+    // that prompt is also the sign that it is ready
+    std::future<std::string> ready;
+    {
+        std::lock_guard<std::mutex> lock(commandMutex_);
+        PendingCommand startup;
+        ready = startup.result.get_future();
+        pendingCommands_.push_back(std::move(startup));
     }
     
-    return result;
+    stopOutputThread_ = false;
+    outputThread_ = std::thread([this]() {
+        while (!stopOutputThread_ && ReadOutput(-1)) {
+        }
+        FailPendingCommands();
+    });
+    
+    if (ready.wait_for(std::chrono::milliseconds(config_.commandTimeout)) !=
+        std::future_status::ready || stdinFd_ < 0) {
+        Cleanup();
+        return false;
+    }
+    return true;
 #else
-    return "";
+    return false;
 #endif
 }
 
+std::string UCLLDBPlugin::SendCommand(const std::string& command) {
+    std::future<std::string> future = PostCommand(command);
+    return WaitForResult(future);
+}
+
+std::future<std::string> UCLLDBPlugin::PostCommand(const std::string& command, bool runControl) {
+    return std::move(PostCommands({ command }, runControl).front());
+}
+
+std::vector<std::future<std::string>> UCLLDBPlugin::PostCommands(
+        const std::vector<std::string>& commands, bool runControl) {
+    std::vector<std::future<std::string>> futures;
+    futures.reserve(commands.size());
+    
+    std::lock_guard<std::mutex> lock(commandMutex_);
+    
+#ifndef _WIN32
+    if (stdinFd_ >= 0) {
+        std::string text;
+        for (const auto& command : commands) {
+            PendingCommand pending;
+            pending.command = command;
+            pending.runControl = runControl;
+            futures.push_back(pending.result.get_future());
+            pendingCommands_.push_back(std::move(pending));
+            text += command;
+            text += '\n';
+        }
+        
+        // Queued before writing, so the output thread always finds the
+        // command its output belongs to
+        size_t written = 0;
+        while (written < text.size()) {
+            ssize_t result = write(stdinFd_, text.data() + written, text.size() - written);
+            if (result < 0 && errno == EINTR) continue;
+            if (result <= 0) break;
+            written += static_cast<size_t>(result);
+        }
+        return futures;
+    }
+#endif
+    
+    // LLDB isn't running: every command fails at once with no output
+    for (size_t i = 0; i < commands.size(); i++) {
+        std::promise<std::string> failed;
+        failed.set_value("");
+        futures.push_back(failed.get_future());
+    }
+    return futures;
+}
+
+std::string UCLLDBPlugin::WaitForResult(std::future<std::string>& future) {
+    auto deadline = std::chrono::steady_clock::now() +
+                    std::chrono::milliseconds(config_.commandTimeout);
+    
+    if (std::this_thread::get_id() == outputThread_.get_id()) {
+        // Called from an event callback: nobody else is reading LLDB's
+        // output, so read it here until our result is in
+        while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+            if (remaining <= 0 || !ReadOutput(static_cast<int>(remaining))) break;
+        }
+    } else {
+        future.wait_until(deadline);
+    }
+    
+    if (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return "";
+    }
+    return future.get();
+}
+
+void UCLLDBPlugin::FailPendingCommands() {
+    std::deque<PendingCommand> failed;
+    {
+        std::lock_guard<std::mutex> lock(commandMutex_);
+        failed.swap(pendingCommands_);
+    }
+    for (auto& pending : failed) {
+        pending.result.set_value("");
+    }
+}
+
+// ============================================================================
+// OUTPUT PROCESSING
+// ============================================================================
+
+bool UCLLDBPlugin::ReadOutput(int timeoutMs) {
+#ifndef _WIN32
+    if (stdoutFd_ < 0) return false;
+    
+    pollfd fds[2] = { { stdoutFd_, POLLIN, 0 }, { wakeReadFd_, POLLIN, 0 } };
+    int ready = poll(fds, 2, timeoutMs);
+    if (ready < 0) return errno == EINTR;
+    if (ready == 0) return true;
+    if (fds[1].revents) return false;
+    
+    char buffer[16384];
+    for (;;) {
+        ssize_t bytesRead = read(stdoutFd_, buffer, sizeof(buffer));
+        if (bytesRead > 0) {
+            outputBuffer_.append(buffer, static_cast<size_t>(bytesRead));
+            continue;
+        }
+        if (bytesRead < 0 && errno == EINTR) continue;
+        if (bytesRead == 0) return false;       // LLDB exited
+        break;                                  // EAGAIN: drained
+    }
+    
+    // Split at each prompt; a prompt may arrive in pieces, so the scan
+    // resumes a prompt's length before where the last one stopped.
+    // Each piece leaves the buffer before it is dispatched: a stop
+    // callback may send a command and wait for it through WaitForResult,
+    // which reads and splits further output in a nested call
+    const std::string_view prompt = LLDB_PROMPT;
+    for (;;) {
+        size_t pos = outputBuffer_.find(prompt, promptScan_);
+        if (pos == std::string::npos) break;
+        std::string chunk = outputBuffer_.substr(0, pos);
+        outputBuffer_.erase(0, pos + prompt.size());
+        promptScan_ = 0;
+        DispatchChunk(std::move(chunk));
+    }
+    promptScan_ = outputBuffer_.size() >= prompt.size() ?
+                  outputBuffer_.size() - prompt.size() + 1 : 0;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void UCLLDBPlugin::DispatchChunk(std::string chunk) {
+    // A stop LLDB reports on its own (after "continue") ends with a prompt
+    // too; while the target runs, such a piece answers no ordinary command
+    bool targetRunning = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        targetRunning = state_ == DebugSessionState::Running ||
+                        state_ == DebugSessionState::Stepping;
+    }
+    bool stopReport = chunk.find("Process ") != std::string::npos &&
+                      (chunk.find(" stopped") != std::string::npos ||
+                       chunk.find(" exited") != std::string::npos);
+    
+    PendingCommand pending;
+    bool claimed = false;
+    {
+        std::lock_guard<std::mutex> lock(commandMutex_);
+        if (!pendingCommands_.empty() &&
+            (pendingCommands_.front().runControl || !(targetRunning && stopReport))) {
+            pending = std::move(pendingCommands_.front());
+            pendingCommands_.pop_front();
+            claimed = true;
+        }
+    }
+    
+    if (claimed && !pending.command.empty()) {
+        // Some LLDB builds echo the command line after the prompt
+        if (chunk.compare(0, pending.command.size(), pending.command) == 0 &&
+            chunk.size() > pending.command.size() && chunk[pending.command.size()] == '\n') {
+            chunk.erase(0, pending.command.size() + 1);
+        }
+    }
+    
+    if ((!claimed || pending.runControl) && !chunk.empty()) {
+        ProcessOutput(chunk);
+    }
+    if (claimed) {
+        pending.result.set_value(std::move(chunk));
+    }
+}
+
 void UCLLDBPlugin::ProcessOutput(const std::string& output) {
     if (output.find("Process") != std::string::npos && 
         output.find("stopped") != std::string::npos) {
@@ -838,6 +987,13 @@ void UCLLDBPlugin::SetState(DebugSessionState newState) {
 
 void UCLLDBPlugin::Cleanup() {
     stopOutputThread_ = true;
+#ifndef _WIN32
+    if (wakeWriteFd_ >= 0) {
+        char wake = 1;
+        ssize_t result = write(wakeWriteFd_, &wake, 1);
+        (void)result;
+    }
+#endif
     if (outputThread_.joinable()) outputThread_.join();
     
 #ifndef _WIN32
@@ -846,9 +1002,15 @@ void UCLLDBPlugin::Cleanup() {
         waitpid(pid_, nullptr, WNOHANG);
         pid_ = -1;
     }
-    if (stdinFd_ >= 0) { close(stdinFd_); stdinFd_ = -1; }
+    {
+        std::lock_guard<std::mutex> lock(commandMutex_);
+        if (stdinFd_ >= 0) { close(stdinFd_); stdinFd_ = -1; }
+    }
     if (stdoutFd_ >= 0) { close(stdoutFd_); stdoutFd_ = -1; }
+    if (wakeReadFd_ >= 0) { close(wakeReadFd_); wakeReadFd_ = -1; }
+    if (wakeWriteFd_ >= 0) { close(wakeWriteFd_); wakeWriteFd_ = -1; }
 #endif
+    FailPendingCommands();
     
     breakpoints_.clear();
     watchpoints_.clear();
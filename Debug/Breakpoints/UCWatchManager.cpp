@@ -105,6 +105,7 @@ bool UCWatchManager::UpdateWatchExpression(int id, const std::string& expression
     it->second.value = Variable();  // Clear value
     it->second.hasError = false;
     it->second.errorMessage.clear();
+    it->second.hasPreviousValue = false;
     
     NotifyUpdate(it->second);
     return true;
@@ -182,7 +183,7 @@ void UCWatchManager::RefreshWatch(int id, IUCDebuggerPlugin* debugger) {
         expression = it->second.expression;
     }
     
-    EvaluationResult result = debugger->Evaluate(expression);
+    EvaluationResult result = debugger->Evaluate(expression, EvaluationContext::Watch);
     
     {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -190,9 +191,7 @@ void UCWatchManager::RefreshWatch(int id, IUCDebuggerPlugin* debugger) {
         if (it == watches_.end()) return;
         
         if (result.success) {
-            it->second.value = result.variable;
-            it->second.hasError = false;
-            it->second.errorMessage.clear();
+            ApplyValue(it->second, result.variable);
         } else {
             it->second.hasError = true;
             it->second.errorMessage = result.errorMessage;
@@ -213,19 +212,35 @@ void UCWatchManager::ClearAllValues() {
     }
 }
 
+void UCWatchManager::BeginStop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    // Values evaluated from here on are compared with these
+    for (auto& pair : watches_) {
+        WatchEntry& entry = pair.second;
+        entry.hasPreviousValue = !entry.hasError && !entry.value.value.empty();
+        entry.previousValue = entry.hasPreviousValue ? entry.value.value : std::string();
+    }
+}
+
 void UCWatchManager::UpdateWatchValue(int id, const Variable& value) {
     std::lock_guard<std::mutex> lock(mutex_);
     
     auto it = watches_.find(id);
     if (it == watches_.end()) return;
     
-    it->second.value = value;
-    it->second.hasError = false;
-    it->second.errorMessage.clear();
+    ApplyValue(it->second, value);
     
     NotifyUpdate(it->second);
 }
 
+void UCWatchManager::ApplyValue(WatchEntry& entry, const Variable& value) {
+    entry.value = value;
+    entry.value.valueChanged = entry.hasPreviousValue && entry.previousValue != value.value;
+    entry.hasError = false;
+    entry.errorMessage.clear();
+}
+
 void UCWatchManager::SetWatchError(int id, const std::string& errorMessage) {
     std::lock_guard<std::mutex> lock(mutex_);
     
@@ -25,6 +25,8 @@ struct WatchEntry {
     bool isExpanded = false;
     bool hasError = false;
     std::string errorMessage;
+    std::string previousValue;          // Value at the previous stop
+    bool hasPreviousValue = false;
     
     bool IsValid() const { return id >= 0 && !expression.empty(); }
 };
@@ -55,6 +57,7 @@ public:
     void RefreshAll(IUCDebuggerPlugin* debugger);
     void RefreshWatch(int id, IUCDebuggerPlugin* debugger);
     void ClearAllValues();
+    void BeginStop();
     void UpdateWatchValue(int id, const Variable& value);
     void SetWatchError(int id, const std::string& errorMessage);
     
@@ -77,6 +80,7 @@ private:
     void NotifyAdd(const WatchEntry& entry);
     void NotifyRemove(int id);
     void NotifyUpdate(const WatchEntry& entry);
+    void ApplyValue(WatchEntry& entry, const Variable& value);
     
     std::map<int, WatchEntry> watches_;
     int nextId_ = 1;
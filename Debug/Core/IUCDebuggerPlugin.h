@@ -12,6 +12,7 @@
 #include <memory>
 #include <functional>
 #include <atomic>
+#include <algorithm>
 
 namespace UltraCanvas {
 namespace IDE {
@@ -391,6 +392,23 @@ public:
      */
     virtual std::vector<StackFrame> GetCallStack(int threadId, int maxFrames = 100) = 0;
     
+    /**
+     * @brief Get part of a thread's call stack
+     *
+     * Deep stacks are fetched a chunk at a time through this, so that the
+     * caller can show progress and stop early. The default fetches the
+     * stack down to the last frame asked for and drops the ones above.
+     * @param threadId Thread ID
+     * @param startFrame Level of the first frame
+     * @param count Number of frames
+     * @return Frames from startFrame on; fewer than count at the bottom
+     */
+    virtual std::vector<StackFrame> GetCallStackRange(int threadId, int startFrame, int count) {
+        std::vector<StackFrame> frames = GetCallStack(threadId, startFrame + count);
+        frames.erase(frames.begin(), frames.begin() + std::min(frames.size(), static_cast<size_t>(startFrame)));
+        return frames;
+    }
+    
     /**
      * @brief Switch to a different stack frame
      * @param frameLevel Frame level (0 = top)
@@ -457,6 +475,39 @@ public:
      */
     virtual std::vector<Variable> ExpandVariable(int variablesReference) = 0;
     
+    /**
+     * @brief Expand a range of a variable's children
+     *
+     * Views page through large containers with this instead of listing
+     * millions of children. The default lists them all and returns the
+     * slice; plugins that can fetch a range override it.
+     * @param variablesReference Reference from parent variable
+     * @param start Index of the first child
+     * @param count Number of children, 0 for all from start
+     * @return Vector of child variables
+     */
+    virtual std::vector<Variable> ExpandVariable(int variablesReference, int start, int count) {
+        std::vector<Variable> children = ExpandVariable(variablesReference);
+        size_t first = std::min(children.size(), static_cast<size_t>(std::max(start, 0)));
+        size_t last = count > 0 ? std::min(children.size(), first + count) : children.size();
+        return std::vector<Variable>(children.begin() + first, children.begin() + last);
+    }
+    
+    /**
+     * @brief Evaluate a variable again with a longer length limit
+     *
+     * Long strings and arrays come cut at the debugger's length limit
+     * (Variable::valueTruncated); views ask for the rest with this when
+     * the user opens the value. The default evaluates the variable's
+     * expression again.
+     * @param variable Variable from a listing or an evaluation
+     * @param maxLength Longest string or array in the result, 0 for no limit
+     * @return Evaluation result holding the longer value
+     */
+    virtual EvaluationResult EvaluateFullValue(const Variable& variable, int maxLength) {
+        return Evaluate(variable.evaluateName.empty() ? variable.name : variable.evaluateName);
+    }
+    
     // =========================================================================
     // REGISTERS
     // =========================================================================
@@ -502,6 +553,53 @@ public:
      */
     virtual bool WriteMemory(uint64_t address, const std::vector<uint8_t>& data) = 0;
     
+    /**
+     * @brief Search target memory
+     * 
+     * Matches are reported as they are found, not necessarily in address
+     * order. The default scans the query's range through ReadMemory a
+     * megabyte at a time, so it needs a bounded range; plugins that can
+     * enumerate the target's mappings override it.
+     * @param query What to look for, and where
+     * @param onMatch Called with each match address; returning false ends
+     *                the search. May be called from several threads, one at
+     *                a time.
+     * @param cancel Ends the search when set; may be null
+     * @return Number of matches reported, or why the search could not run
+     */
+    virtual MemorySearchResult SearchMemory(const MemorySearchQuery& query,
+                                            const std::function<bool(uint64_t address)>& onMatch,
+                                            const std::atomic<bool>* cancel) {
+        MemorySearchResult result;
+        if (query.endAddress == UINT64_MAX) {
+            result.errorMessage = "Searching all memory is not supported for this target; "
+                                  "give an address range";
+            return result;
+        }
+        
+        constexpr uint64_t kChunk = 1024 * 1024;
+        size_t overlap = query.MatchLength() - 1;
+        size_t found = 0;
+        auto report = [&](uint64_t address) {
+            found++;
+            return onMatch(address) && found < query.maxResults;
+        };
+        
+        for (uint64_t address = query.startAddress; address < query.endAddress; address += kChunk) {
+            if (cancel && *cancel) break;
+            
+            size_t starts = static_cast<size_t>(std::min(kChunk, query.endAddress - address));
+            size_t size = static_cast<size_t>(std::min<uint64_t>(starts + overlap, query.endAddress - address));
+            MemoryRegion region = ReadMemory(address, size);
+            if (!query.Scan(address, region.data.data(), region.data.size(), starts, report)) {
+                break;
+            }
+        }
+        result.success = true;
+        result.matchCount = found;
+        return result;
+    }
+    
     // =========================================================================
     // DISASSEMBLY
     // =========================================================================
@@ -546,6 +644,34 @@ public:
     virtual std::vector<DebugCompletionItem> GetCompletions(
         const std::string& text, int column) = 0;
     
+    // =========================================================================
+    // STOP STATE
+    // =========================================================================
+    
+    /**
+     * @brief Fetch the stopped thread's stack, top-frame variables and watches
+     *
+     * Called once per stop so the panels do not each query the debugger.
+     * The default makes the individual calls in turn; backends that can
+     * have several requests outstanding override it.
+     * @param maxFrames Stack depth to fetch
+     * @param watchExpressions Expressions to evaluate in the top frame
+     * @return The fetched state
+     */
+    virtual DebugStopState CaptureStopState(int maxFrames,
+                                            const std::vector<std::string>& watchExpressions) {
+        DebugStopState state;
+        state.threadId = GetCurrentThread().id;
+        state.maxFrames = maxFrames;
+        state.callStack = GetCallStack(state.threadId, maxFrames);
+        state.locals = GetLocals();
+        state.arguments = GetArguments();
+        for (const auto& expression : watchExpressions) {
+            state.watchValues[expression] = Evaluate(expression, EvaluationContext::Watch);
+        }
+        return state;
+    }
+    
     // =========================================================================
     // CALLBACKS
     // =========================================================================
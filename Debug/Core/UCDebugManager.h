@@ -49,11 +49,24 @@ struct DebugManagerConfig {
  * 
  * Orchestrates debug sessions, manages debugger plugins, breakpoints,
  * and provides the main interface for IDE debug operations.
+ *
+ * The IDE uses Instance(). A DAP session host serving several clients
+ * gives each one its own manager from CreateIsolated().
  */
 class UCDebugManager {
 public:
     static UCDebugManager& Instance();
     
+    /**
+     * @brief Create a manager independent of Instance()
+     *
+     * It has its own breakpoints and watches, and creates its own
+     * debugger plugin instances instead of sharing the registered ones.
+     */
+    static std::unique_ptr<UCDebugManager> CreateIsolated();
+    
+    ~UCDebugManager();
+    
     // Prevent copying
     UCDebugManager(const UCDebugManager&) = delete;
     UCDebugManager& operator=(const UCDebugManager&) = delete;
@@ -148,6 +161,8 @@ public:
     bool SwitchThread(int threadId);
     
     std::vector<StackFrame> GetCallStack(int maxFrames = 100);
+    std::vector<StackFrame> GetCallStack(int threadId, int maxFrames);  // Leaves the selected thread alone
+    std::vector<StackFrame> GetCallStackRange(int threadId, int startFrame, int count);
     StackFrame GetCurrentFrame();
     bool SwitchFrame(int frameLevel);
     
@@ -162,6 +177,8 @@ public:
     EvaluationResult Evaluate(const std::string& expression);
     bool SetVariable(const std::string& name, const std::string& value);
     std::vector<Variable> ExpandVariable(int variablesReference);
+    std::vector<Variable> ExpandVariable(int variablesReference, int start, int count);
+    EvaluationResult EvaluateFullValue(const Variable& variable, int maxLength);
     
     // =========================================================================
     // REGISTERS & MEMORY
@@ -172,6 +189,9 @@ public:
     
     MemoryRegion ReadMemory(uint64_t address, size_t size);
     bool WriteMemory(uint64_t address, const std::vector<uint8_t>& data);
+    MemorySearchResult SearchMemory(const MemorySearchQuery& query,
+                                    const std::function<bool(uint64_t address)>& onMatch,
+                                    const std::atomic<bool>* cancel = nullptr);
     
     // =========================================================================
     // DISASSEMBLY
@@ -186,11 +206,22 @@ public:
     
     std::vector<ModuleInfo> GetModules();
     
+    // =========================================================================
+    // STOP SNAPSHOT
+    // =========================================================================
+    
+    /**
+     * @brief Incremented on every stop and every resume
+     *
+     * Panels can compare it with the value they last drew to skip a refresh.
+     */
+    uint64_t GetStopGeneration() const { return stopGeneration_; }
+    
     // =========================================================================
     // DEBUGGER SELECTION
     // =========================================================================
     
-    std::shared_ptr<IUCDebuggerPlugin> GetActiveDebugger() const { return activeDebugger_; }
+    std::shared_ptr<IUCDebuggerPlugin> GetActiveDebugger() const;
     std::shared_ptr<IUCDebuggerPlugin> GetBestDebugger();
     std::vector<std::shared_ptr<IUCDebuggerPlugin>> GetAvailableDebuggers();
     bool SelectDebugger(DebuggerType type);
@@ -215,8 +246,33 @@ public:
     std::function<void(const std::string&)> onError;
     
 private:
+    /**
+     * @brief Debugger state for the current stop, shared by all panels
+     *
+     * HandleTargetStop prefetches the stack, top-frame variables and watch
+     * values in one batch; threads and registers are kept once a panel
+     * has asked for them. Getters answer from here while it is current.
+     * Selecting another thread or frame, or writing to the target, clears
+     * the affected parts; resuming drops all of it.
+     */
+    struct StopSnapshot {
+        uint64_t generation = 0;            // stopGeneration_ it belongs to
+        int frameLevel = 0;                 // Selected frame the variables are for
+        bool hasStack = false;
+        bool hasLocals = false;
+        bool hasArguments = false;
+        bool hasThreads = false;
+        bool hasRegisters = false;
+        DebugStopState state;
+        std::vector<ThreadInfo> threads;
+        std::vector<Register> registers;
+    };
+    
     UCDebugManager();
-    ~UCDebugManager();
+    explicit UCDebugManager(bool ownsPlugins);
+    
+    std::shared_ptr<IUCDebuggerPlugin> FindDebugger(DebuggerType type);
+    std::shared_ptr<IUCDebuggerPlugin> FindBestDebugger();
     
     void SetupDebuggerCallbacks();
     void HandleStateChange(DebugSessionState oldState, DebugSessionState newState);
@@ -225,12 +281,24 @@ private:
     void HandleOutput(const std::string& output);
     void HandleError(const std::string& error);
     
+    void CaptureStopSnapshot();
+    void DropStopSnapshot();
+    void ClearStopSnapshot(bool keepStack);
+    bool IsStopSnapshotCurrent() const;
+    
     DebugLaunchConfig CreateLaunchConfig(std::shared_ptr<UCIDEProject> project);
+    void SetActiveDebugger(std::shared_ptr<IUCDebuggerPlugin> debugger);
     
     bool initialized_ = false;
+    bool ownsPlugins_ = false;          // Creates plugins rather than sharing the registry's
     DebugManagerConfig config_;
     
+    // Assigned under mutex_ and debuggerMutex_ both, so either is enough
+    // to read it. Callers that must not wait for mutex_ (Pause, the stop
+    // handler on the output thread) copy it through GetActiveDebugger();
+    // debuggerMutex_ is never held across a debugger call
     std::shared_ptr<IUCDebuggerPlugin> activeDebugger_;
+    mutable std::mutex debuggerMutex_;
     std::shared_ptr<UCIDEProject> currentProject_;
     DebugLaunchConfig currentLaunchConfig_;
     
@@ -239,6 +307,12 @@ private:
     
     DebugSessionState lastState_ = DebugSessionState::Inactive;
     
+    // Separate from mutex_, which is held across debugger calls: the stop
+    // handler runs on the debugger's output thread and must not wait on it
+    StopSnapshot stopSnapshot_;
+    std::atomic<uint64_t> stopGeneration_{0};
+    mutable std::mutex snapshotMutex_;
+    
     mutable std::mutex mutex_;
 };
 
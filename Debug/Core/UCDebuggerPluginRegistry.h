@@ -9,6 +9,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <functional>
 
 namespace UltraCanvas {
 namespace IDE {
@@ -25,6 +26,8 @@ namespace IDE {
  */
 class UCDebuggerPluginRegistry {
 public:
+    using PluginFactory = std::function<std::shared_ptr<IUCDebuggerPlugin>()>;
+    
     /**
      * @brief Get the singleton instance
      * @return Reference to the registry instance
@@ -69,6 +72,21 @@ public:
     void ClearPlugins() {
         std::lock_guard<std::mutex> lock(mutex_);
         plugins_.clear();
+        factories_.clear();
+    }
+    
+    /**
+     * @brief Register how to make new instances of a debugger plugin
+     * @param type Debugger type the factory creates
+     * @param factory Returns a fresh plugin with its own debugger process
+     *
+     * Registered plugins are shared by everyone who looks them up; a
+     * debug manager that must not share its debugger (one per DAP
+     * session) creates its own through CreatePlugin.
+     */
+    void RegisterPluginFactory(DebuggerType type, PluginFactory factory) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        factories_[type] = std::move(factory);
     }
     
     // =========================================================================
@@ -86,6 +104,22 @@ public:
         return (it != plugins_.end()) ? it->second : nullptr;
     }
     
+    /**
+     * @brief Create a new, unshared instance of a plugin
+     * @param type Debugger type
+     * @return New plugin, or nullptr if no factory is registered for it
+     */
+    std::shared_ptr<IUCDebuggerPlugin> CreatePlugin(DebuggerType type) {
+        PluginFactory factory;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = factories_.find(type);
+            if (it == factories_.end()) return nullptr;
+            factory = it->second;
+        }
+        return factory();
+    }
+    
     /**
      * @brief Get all registered plugins
      * @return Vector of all plugins
@@ -173,6 +207,15 @@ public:
         return nullptr;
     }
     
+    /**
+     * @brief Create a new instance of the best debugger for this platform
+     * @return New plugin, or nullptr if none is available or has a factory
+     */
+    std::shared_ptr<IUCDebuggerPlugin> CreateBestDebugger() {
+        auto best = GetBestDebugger();
+        return best ? CreatePlugin(best->GetDebuggerType()) : nullptr;
+    }
+    
     /**
      * @brief Get the best debugger for a specific executable
      * @param executablePath Path to executable
@@ -239,6 +282,7 @@ private:
     }
     
     std::map<DebuggerType, std::shared_ptr<IUCDebuggerPlugin>> plugins_;
+    std::map<DebuggerType, PluginFactory> factories_;
     mutable std::mutex mutex_;
 };
 
@@ -6,9 +6,11 @@
 
 #include "UCDAPClient.h"
 #include <iostream>
-#include <sstream>
 #include <cstring>
+#include <cstdio>
 #include <chrono>
+#include <charconv>
+#include <algorithm>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -16,16 +18,203 @@
 #include <unistd.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <arpa/inet.h>
 #include <signal.h>
 #include <sys/wait.h>
 #include <fcntl.h>
+#include <poll.h>
+#include <errno.h>
 #endif
 
 namespace UltraCanvas {
 namespace IDE {
 namespace DAP {
 
+namespace {
+
+// Bytes asked for per read; a pipelined refresh brings many responses at once
+const size_t READ_CHUNK_SIZE = 64 * 1024;
+
+#ifndef _WIN32
+// The adapter's stdout is non-blocking; the reader waits on it in slices
+// this long so Disconnect() never waits for a silent adapter
+const int READ_POLL_INTERVAL_MS = 100;
+#endif
+
+#ifdef MSG_NOSIGNAL
+const int SEND_FLAGS = MSG_NOSIGNAL;    // A dead adapter is a failed send, not SIGPIPE
+#else
+const int SEND_FLAGS = 0;
+#endif
+
+/**
+ * @brief Elements of an array in a response body
+ */
+template<typename T>
+std::vector<T> ParseItems(const JsonObject& body, const std::string& key) {
+    std::vector<T> items;
+    for (const JsonValue& value : body.GetArray(key)) {
+        items.push_back(T::FromJson(JsonObject::AsObject(value)));
+    }
+    return items;
+}
+
+} // anonymous namespace
+
+/**
+ * @brief One FetchStopState pipeline
+ *
+ * Every request it sends holds a reference to it, so it lives until the
+ * last response. Follow-up requests are counted before the response that
+ * caused them is, so the state is complete when the count reaches zero.
+ */
+class UCDAPClient::StopStateFetch : public std::enable_shared_from_this<StopStateFetch> {
+public:
+    StopStateFetch(UCDAPClient& client, const DAPStopStateRequest& request)
+        : client_(client), request_(request) {
+    }
+    
+    std::future<DAPStopState> Start() {
+        std::future<DAPStopState> future = promise_.get_future();
+        
+        std::vector<DAPBatchRequest> first;
+        if (request_.threadIds.empty()) {
+            first.push_back(ThreadsRequest());
+        } else {
+            selectedThreadId_ = request_.selectedThreadId > 0 ? request_.selectedThreadId
+                                                              : request_.threadIds.front();
+            AddStackTraceRequests(request_.threadIds, 1, first);
+        }
+        
+        if (first.empty()) {
+            promise_.set_value(std::move(state_));
+            return future;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            outstanding_ = first.size();
+        }
+        client_.SendBatch(std::move(first));
+        return future;
+    }
+    
+private:
+    using Batch = std::vector<DAPBatchRequest>;
+    
+    template<typename Next>
+    DAPBatchRequest MakeRequest(const std::string& command, JsonObject arguments, int depth,
+                                Next next) {
+        DAPBatchRequest item;
+        item.command = command;
+        item.arguments = std::move(arguments);
+        item.onResponse = [self = shared_from_this(), depth, next](const Response& response) {
+            self->Complete(response, depth, next);
+        };
+        return item;
+    }
+    
+    /**
+     * @brief Record a response and send what it makes possible
+     */
+    template<typename Next>
+    void Complete(const Response& response, int depth, const Next& next) {
+        Batch followUps;
+        bool done;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            state_.roundTrips = std::max(state_.roundTrips, depth);
+            if (response.success) {
+                next(*this, response, followUps);
+            } else {
+                state_.errors.push_back(response.command + ": " + response.message);
+            }
+            outstanding_ += followUps.size();
+            done = --outstanding_ == 0;
+        }
+        
+        if (!followUps.empty()) {
+            client_.SendBatch(std::move(followUps));
+        }
+        if (done) {
+            promise_.set_value(std::move(state_));
+        }
+    }
+    
+    DAPBatchRequest ThreadsRequest() {
+        return MakeRequest("threads", {}, 1,
+            [](StopStateFetch& fetch, const Response& response, Batch& followUps) {
+                fetch.state_.threads = ParseItems<Thread>(response.body, "threads");
+                
+                // The selected thread first, then the others up to maxThreads
+                std::vector<int> ids;
+                for (const Thread& thread : fetch.state_.threads) ids.push_back(thread.id);
+                auto selected = std::find(ids.begin(), ids.end(), fetch.request_.selectedThreadId);
+                if (selected != ids.end()) std::rotate(ids.begin(), selected, selected + 1);
+                if (!ids.empty()) fetch.selectedThreadId_ = ids.front();
+                
+                fetch.AddStackTraceRequests(ids, 2, followUps);
+            });
+    }
+    
+    void AddStackTraceRequests(const std::vector<int>& threadIds, int depth, Batch& batch) {
+        size_t count = std::min(threadIds.size(), static_cast<size_t>(std::max(0, request_.maxThreads)));
+        for (size_t i = 0; i < count; i++) {
+            int threadId = threadIds[i];
+            JsonObject args;
+            args.Set("threadId", static_cast<int64_t>(threadId));
+            args.Set("startFrame", static_cast<int64_t>(0));
+            args.Set("levels", static_cast<int64_t>(request_.levels));
+            batch.push_back(MakeRequest("stackTrace", std::move(args), depth,
+                [threadId, depth](StopStateFetch& fetch, const Response& response, Batch& followUps) {
+                    auto& frames = fetch.state_.stackFrames[threadId];
+                    frames = ParseItems<StackFrame>(response.body, "stackFrames");
+                    if (threadId != fetch.selectedThreadId_) return;
+                    
+                    size_t expand = std::min(frames.size(),
+                                             static_cast<size_t>(std::max(0, fetch.request_.selectedFrames)));
+                    for (size_t f = 0; f < expand; f++) {
+                        followUps.push_back(fetch.ScopesRequest(frames[f].id, depth + 1));
+                    }
+                }));
+        }
+    }
+    
+    DAPBatchRequest ScopesRequest(int frameId, int depth) {
+        JsonObject args;
+        args.Set("frameId", static_cast<int64_t>(frameId));
+        return MakeRequest("scopes", std::move(args), depth,
+            [frameId, depth](StopStateFetch& fetch, const Response& response, Batch& followUps) {
+                auto& scopes = fetch.state_.scopes[frameId];
+                scopes = ParseItems<Scope>(response.body, "scopes");
+                for (const Scope& scope : scopes) {
+                    if (scope.variablesReference <= 0) continue;
+                    if (scope.expensive && !fetch.request_.includeExpensiveScopes) continue;
+                    followUps.push_back(fetch.VariablesRequest(scope.variablesReference, depth + 1));
+                }
+            });
+    }
+    
+    DAPBatchRequest VariablesRequest(int variablesReference, int depth) {
+        JsonObject args;
+        args.Set("variablesReference", static_cast<int64_t>(variablesReference));
+        return MakeRequest("variables", std::move(args), depth,
+            [variablesReference](StopStateFetch& fetch, const Response& response, Batch&) {
+                fetch.state_.variables[variablesReference] =
+                    ParseItems<Variable>(response.body, "variables");
+            });
+    }
+    
+    UCDAPClient& client_;
+    DAPStopStateRequest request_;
+    int selectedThreadId_ = 0;
+    
+    std::mutex mutex_;                  // Guards state_ and outstanding_
+    DAPStopState state_;
+    size_t outstanding_ = 0;
+    std::promise<DAPStopState> promise_;
+};
+
 UCDAPClient::UCDAPClient() = default;
 
 UCDAPClient::~UCDAPClient() {
@@ -131,8 +320,7 @@ bool UCDAPClient::ConnectStdio(const std::string& adapterPath,
 #endif
     
     state_ = DAPClientState::Connected;
-    running_ = true;
-    readerThread_ = std::thread(&UCDAPClient::ReaderThread, this);
+    StartReader();
     
     return true;
 }
@@ -163,9 +351,13 @@ bool UCDAPClient::ConnectSocket(const std::string& host, int port) {
         return false;
     }
     
+    // Follow-up requests are small writes sent while earlier ones are
+    // unacknowledged; Nagle would hold them for the adapter's delayed ACK
+    int noDelay = 1;
+    setsockopt(socket_, IPPROTO_TCP, TCP_NODELAY, (const char*)&noDelay, sizeof(noDelay));
+    
     state_ = DAPClientState::Connected;
-    running_ = true;
-    readerThread_ = std::thread(&UCDAPClient::ReaderThread, this);
+    StartReader();
     
     return true;
 }
@@ -173,6 +365,15 @@ bool UCDAPClient::ConnectSocket(const std::string& host, int port) {
 void UCDAPClient::Disconnect() {
     running_ = false;
     
+    // Wakes the reader if it is blocked receiving
+    if (socket_ >= 0) {
+#ifdef _WIN32
+        shutdown(socket_, SD_BOTH);
+#else
+        shutdown(socket_, SHUT_RDWR);
+#endif
+    }
+    
     if (readerThread_.joinable()) {
         readerThread_.join();
     }
@@ -223,6 +424,15 @@ void UCDAPClient::Disconnect() {
     }
 }
 
+void UCDAPClient::StartReader() {
+    running_ = true;
+    {
+        std::lock_guard<std::mutex> lock(requestMutex_);
+        acceptingRequests_ = true;
+    }
+    readerThread_ = std::thread(&UCDAPClient::ReaderThread, this);
+}
+
 void UCDAPClient::ReaderThread() {
     while (running_) {
         std::string message;
@@ -234,180 +444,275 @@ void UCDAPClient::ReaderThread() {
             break;
         }
         
-        // Parse message type
-        size_t typePos = message.find("\"type\":\"");
-        if (typePos == std::string::npos) continue;
-        
-        size_t typeStart = typePos + 8;
-        size_t typeEnd = message.find("\"", typeStart);
-        std::string msgType = message.substr(typeStart, typeEnd - typeStart);
+        JsonObject json;
+        if (!JsonObject::Parse(message, json)) continue;
+        std::string msgType = json.Get<std::string>("type").value_or("");
         
         if (msgType == "response") {
             Response response;
-            
-            // Parse seq
-            size_t seqPos = message.find("\"request_seq\":");
-            if (seqPos != std::string::npos) {
-                size_t start = seqPos + 14;
-                size_t end = message.find_first_of(",}", start);
-                response.request_seq = std::stoi(message.substr(start, end - start));
-            }
-            
-            // Parse success
-            response.success = message.find("\"success\":true") != std::string::npos;
-            
-            // Parse command
-            size_t cmdPos = message.find("\"command\":\"");
-            if (cmdPos != std::string::npos) {
-                size_t start = cmdPos + 11;
-                size_t end = message.find("\"", start);
-                response.command = message.substr(start, end - start);
-            }
+            response.seq = static_cast<int>(json.Get<int64_t>("seq").value_or(0));
+            response.request_seq = static_cast<int>(json.Get<int64_t>("request_seq").value_or(0));
+            response.success = json.Get<bool>("success").value_or(false);
+            response.command = json.Get<std::string>("command").value_or("");
+            response.message = json.Get<std::string>("message").value_or("");
+            response.body = json.GetObject("body");
             
             ProcessResponse(response);
             
         } else if (msgType == "event") {
             Event event;
-            
-            // Parse event name
-            size_t eventPos = message.find("\"event\":\"");
-            if (eventPos != std::string::npos) {
-                size_t start = eventPos + 9;
-                size_t end = message.find("\"", start);
-                event.event = message.substr(start, end - start);
-            }
+            event.seq = static_cast<int>(json.Get<int64_t>("seq").value_or(0));
+            event.event = json.Get<std::string>("event").value_or("");
+            event.body = json.GetObject("body");
             
             ProcessEvent(event);
         }
     }
+    
+    // Nothing more will be answered; callers waiting on a request get a failure
+    FailPendingRequests(running_ ? "Connection lost" : "Disconnected");
 }
 
 bool UCDAPClient::ReadMessage(std::string& message) {
-    // Read Content-Length header
-    std::string header;
-    int contentLength = 0;
-    
-    while (true) {
-        char c;
-        bool readOk = false;
+    for (;;) {
+        // Frame the next message straight out of the buffer once its
+        // headers and body are in; one read often brings several
+        size_t headerEnd = readBuffer_.find("\r\n\r\n", readOffset_);
+        if (headerEnd != std::string::npos) {
+            std::string_view headers(readBuffer_.data() + readOffset_, headerEnd - readOffset_);
+            size_t clPos = headers.find("Content-Length:");
+            if (clPos == std::string_view::npos) return false;
+            
+            size_t start = clPos + 15;
+            while (start < headers.size() && headers[start] == ' ') start++;
+            size_t contentLength = 0;
+            auto result = std::from_chars(headers.data() + start, headers.data() + headers.size(),
+                                          contentLength);
+            if (result.ec != std::errc() || contentLength == 0) return false;
+            
+            size_t bodyStart = headerEnd + 4;
+            if (readBuffer_.size() - bodyStart >= contentLength) {
+                message.assign(readBuffer_, bodyStart, contentLength);
+                readOffset_ = bodyStart + contentLength;
+                return true;
+            }
+        }
         
-        if (socket_ >= 0) {
-            readOk = recv(socket_, &c, 1, 0) == 1;
+        if (!FillReadBuffer()) {
+            return false;
         }
+    }
+}
+
+bool UCDAPClient::FillReadBuffer() {
+    // Drop consumed messages once they are most of the buffer
+    if (readOffset_ > 0 && readOffset_ * 2 >= readBuffer_.size()) {
+        readBuffer_.erase(0, readOffset_);
+        readOffset_ = 0;
+    }
+    
+    char chunk[READ_CHUNK_SIZE];
+    long received = -1;
+    
+    if (socket_ >= 0) {
 #ifdef _WIN32
-        else if (stdoutRead_) {
-            DWORD bytesRead;
-            readOk = ReadFile(stdoutRead_, &c, 1, &bytesRead, nullptr) && bytesRead == 1;
-        }
+        received = recv(socket_, chunk, static_cast<int>(sizeof(chunk)), 0);
 #else
-        else if (stdoutFd_ >= 0) {
-            readOk = read(stdoutFd_, &c, 1) == 1;
-        }
+        do {
+            received = recv(socket_, chunk, sizeof(chunk), 0);
+        } while (received < 0 && errno == EINTR);
 #endif
-        
-        if (!readOk) return false;
-        
-        header += c;
-        
-        if (header.length() >= 4 && header.substr(header.length() - 4) == "\r\n\r\n") {
-            break;
+    }
+#ifdef _WIN32
+    else if (stdoutRead_) {
+        DWORD bytesRead = 0;
+        if (ReadFile(stdoutRead_, chunk, static_cast<DWORD>(sizeof(chunk)), &bytesRead, nullptr)) {
+            received = static_cast<long>(bytesRead);
         }
     }
-    
-    // Parse Content-Length
-    size_t clPos = header.find("Content-Length:");
-    if (clPos != std::string::npos) {
-        size_t start = clPos + 15;
-        while (start < header.length() && header[start] == ' ') start++;
-        size_t end = header.find("\r\n", start);
-        contentLength = std::stoi(header.substr(start, end - start));
+#else
+    else if (stdoutFd_ >= 0) {
+        for (;;) {
+            received = read(stdoutFd_, chunk, sizeof(chunk));
+            if (received >= 0 || (errno != EAGAIN && errno != EINTR)) break;
+            if (!running_) return false;
+            
+            pollfd pfd{stdoutFd_, POLLIN, 0};
+            poll(&pfd, 1, READ_POLL_INTERVAL_MS);
+        }
     }
+#endif
     
-    if (contentLength <= 0) return false;
-    
-    // Read body
-    message.resize(contentLength);
-    int totalRead = 0;
-    
-    while (totalRead < contentLength) {
-        int bytesRead = 0;
+    if (received <= 0) {
+        return false;
+    }
+    readBuffer_.append(chunk, static_cast<size_t>(received));
+    return true;
+}
+
+bool UCDAPClient::WriteAll(const char* data, size_t size) {
+    while (size > 0) {
+        long written = -1;
         
         if (socket_ >= 0) {
-            bytesRead = recv(socket_, &message[totalRead], contentLength - totalRead, 0);
+#ifdef _WIN32
+            written = send(socket_, data, static_cast<int>(size), 0);
+#else
+            written = send(socket_, data, size, SEND_FLAGS);
+#endif
         }
 #ifdef _WIN32
-        else if (stdoutRead_) {
-            DWORD br;
-            if (ReadFile(stdoutRead_, &message[totalRead], contentLength - totalRead, &br, nullptr)) {
-                bytesRead = br;
+        else if (stdinWrite_) {
+            DWORD count = 0;
+            if (WriteFile(stdinWrite_, data, static_cast<DWORD>(size), &count, nullptr)) {
+                written = static_cast<long>(count);
             }
         }
 #else
-        else if (stdoutFd_ >= 0) {
-            bytesRead = read(stdoutFd_, &message[totalRead], contentLength - totalRead);
+        else if (stdinFd_ >= 0) {
+            written = write(stdinFd_, data, size);
         }
+        if (written < 0 && errno == EINTR) continue;
 #endif
         
-        if (bytesRead <= 0) return false;
-        totalRead += bytesRead;
+        if (written <= 0) return false;
+        data += written;
+        size -= static_cast<size_t>(written);
     }
-    
     return true;
 }
 
-void UCDAPClient::SendMessage(const std::string& json) {
-    std::lock_guard<std::mutex> lock(sendMutex_);
-    
-    std::ostringstream header;
-    header << "Content-Length: " << json.length() << "\r\n\r\n";
+std::future<Response> UCDAPClient::SendRequest(const std::string& command, const JsonObject& args) {
+    std::vector<DAPBatchRequest> requests(1);
+    requests[0].command = command;
+    requests[0].arguments = args;
     
-    std::string message = header.str() + json;
+    std::future<Response> future;
+    SendRequests(requests, &future);
+    return future;
+}
+
+void UCDAPClient::SendBatch(std::vector<DAPBatchRequest> requests) {
+    if (requests.empty()) return;
+    SendRequests(requests, nullptr);
+}
+
+void UCDAPClient::SendRequests(std::vector<DAPBatchRequest>& requests, std::future<Response>* future) {
+    // Requests that will never be answered. Failed once sendMutex_ is
+    // released: their handlers may send again
+    std::map<int, PendingRequest> failed;
+    std::unique_lock<std::mutex> lock(sendMutex_);
     
-    if (socket_ >= 0) {
-        send(socket_, message.c_str(), message.length(), 0);
-    }
-#ifdef _WIN32
-    else if (stdinWrite_) {
-        DWORD written;
-        WriteFile(stdinWrite_, message.c_str(), message.length(), &written, nullptr);
+    // Registered before the write: an answer can come back before it returns
+    sendBuffer_.clear();
+    std::vector<int> sent;
+    auto now = std::chrono::steady_clock::now();
+    for (DAPBatchRequest& item : requests) {
+        Request request;
+        request.seq = nextSeq_++;
+        request.command = std::move(item.command);
+        request.arguments = std::move(item.arguments);
+        
+        PendingRequest pending;
+        pending.seq = request.seq;
+        pending.command = request.command;
+        pending.handler = std::move(item.onResponse);
+        pending.timestamp = now;
+        if (future && !pending.handler) {
+            *future = pending.promise.get_future();
+        }
+        {
+            // Once the reader is gone nothing would answer it
+            std::lock_guard<std::mutex> requestLock(requestMutex_);
+            if (!acceptingRequests_) {
+                failed[request.seq] = std::move(pending);
+                continue;
+            }
+            pendingRequests_[request.seq] = std::move(pending);
+        }
+        sent.push_back(request.seq);
+        
+        bodyBuffer_.clear();
+        {
+            JsonWriter writer(bodyBuffer_);
+            request.WriteJson(writer);
+        }
+        char header[48];
+        int headerLength = std::snprintf(header, sizeof(header), "Content-Length: %zu\r\n\r\n",
+                                         bodyBuffer_.size());
+        sendBuffer_.append(header, static_cast<size_t>(headerLength));
+        sendBuffer_.append(bodyBuffer_);
     }
-#else
-    else if (stdinFd_ >= 0) {
-        write(stdinFd_, message.c_str(), message.length());
+    
+    // On failure the connection is gone. The reader may not have seen it
+    // yet, so take back whatever it has not failed already
+    if (!sent.empty() && !WriteAll(sendBuffer_.data(), sendBuffer_.size())) {
+        std::lock_guard<std::mutex> requestLock(requestMutex_);
+        for (int seq : sent) {
+            auto it = pendingRequests_.find(seq);
+            if (it == pendingRequests_.end()) continue;
+            failed[seq] = std::move(it->second);
+            pendingRequests_.erase(it);
+        }
     }
-#endif
+    lock.unlock();
+    
+    FailRequests(failed, "Not connected");
 }
 
-std::future<Response> UCDAPClient::SendRequest(const std::string& command, const JsonObject& args) {
-    Request request;
-    request.seq = nextSeq_++;
-    request.command = command;
-    request.arguments = args;
-    
+void UCDAPClient::ProcessResponse(const Response& response) {
     PendingRequest pending;
-    pending.seq = request.seq;
-    pending.command = command;
-    pending.timestamp = std::chrono::steady_clock::now();
-    
-    std::future<Response> future = pending.promise.get_future();
-    
     {
         std::lock_guard<std::mutex> lock(requestMutex_);
-        pendingRequests_[request.seq] = std::move(pending);
+        auto it = pendingRequests_.find(response.request_seq);
+        if (it == pendingRequests_.end()) return;
+        pending = std::move(it->second);
+        pendingRequests_.erase(it);
     }
     
-    SendMessage(request.ToJson());
+    double ms = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - pending.timestamp).count();
+    {
+        std::lock_guard<std::mutex> lock(latencyMutex_);
+        DAPRequestLatency& latency = latencies_[pending.command];
+        latency.minMs = latency.count == 0 ? ms : std::min(latency.minMs, ms);
+        latency.maxMs = std::max(latency.maxMs, ms);
+        latency.totalMs += ms;
+        latency.lastMs = ms;
+        latency.count++;
+        if (!response.success) latency.failures++;
+    }
     
-    return future;
+    // Outside the locks: a handler may send the next requests
+    if (pending.handler) {
+        pending.handler(response);
+    } else {
+        pending.promise.set_value(response);
+    }
 }
 
-void UCDAPClient::ProcessResponse(const Response& response) {
-    std::lock_guard<std::mutex> lock(requestMutex_);
-    
-    auto it = pendingRequests_.find(response.request_seq);
-    if (it != pendingRequests_.end()) {
-        it->second.promise.set_value(response);
-        pendingRequests_.erase(it);
+void UCDAPClient::FailPendingRequests(const std::string& message) {
+    std::map<int, PendingRequest> pending;
+    {
+        std::lock_guard<std::mutex> lock(requestMutex_);
+        acceptingRequests_ = false;
+        pending.swap(pendingRequests_);
+    }
+    FailRequests(pending, message);
+}
+
+void UCDAPClient::FailRequests(std::map<int, PendingRequest>& requests, const std::string& message) {
+    for (auto& entry : requests) {
+        Response response;
+        response.request_seq = entry.first;
+        response.command = entry.second.command;
+        response.success = false;
+        response.message = message;
+        if (entry.second.handler) {
+            entry.second.handler(response);
+        } else {
+            entry.second.promise.set_value(response);
+        }
     }
 }
 
@@ -418,9 +723,12 @@ void UCDAPClient::ProcessEvent(const Event& event) {
     }
     else if (event.event == "stopped") {
         if (onStopped) {
-            DAPStopReason reason = DAPStopReason::Pause;
-            int threadId = 1;
-            onStopped(reason, threadId, "");
+            DAPStopReason reason = StringToDAPStopReason(
+                event.body.Get<std::string>("reason").value_or(""));
+            int threadId = static_cast<int>(event.body.Get<int64_t>("threadId").value_or(1));
+            std::string text = event.body.Get<std::string>("text").value_or(
+                event.body.Get<std::string>("description").value_or(""));
+            onStopped(reason, threadId, text);
         }
     }
     else if (event.event == "continued") {
@@ -527,7 +835,7 @@ std::future<Response> UCDAPClient::DisconnectRequest(bool terminateDebuggee, boo
 std::future<Response> UCDAPClient::SetBreakpoints(const Source& source,
                                                    const std::vector<SourceBreakpoint>& breakpoints) {
     JsonObject args;
-    args.Set("source", source.ToJson().ToJson());
+    args.Set("source", source.ToJson().ToValue());
     return SendRequest("setBreakpoints", args);
 }
 
@@ -793,6 +1101,29 @@ std::future<Response> UCDAPClient::Completions(int frameId, const std::string& t
     return SendRequest("completions", args);
 }
 
+// ============================================================================
+// PIPELINING
+// ============================================================================
+
+std::future<DAPStopState> UCDAPClient::FetchStopState(const DAPStopStateRequest& request) {
+    auto fetch = std::make_shared<StopStateFetch>(*this, request);
+    return fetch->Start();
+}
+
+// ============================================================================
+// INSTRUMENTATION
+// ============================================================================
+
+std::map<std::string, DAPRequestLatency> UCDAPClient::GetRequestLatencies() const {
+    std::lock_guard<std::mutex> lock(latencyMutex_);
+    return latencies_;
+}
+
+void UCDAPClient::ResetRequestLatencies() {
+    std::lock_guard<std::mutex> lock(latencyMutex_);
+    latencies_.clear();
+}
+
 } // namespace DAP
 } // namespace IDE
 } // namespace UltraCanvas
@@ -41,9 +41,57 @@ struct PendingRequest {
     int seq;
     std::string command;
     std::promise<Response> promise;
+    std::function<void(const Response&)> handler;   // Called instead of the promise if set
     std::chrono::steady_clock::time_point timestamp;
 };
 
+/**
+ * @brief One request of a batch (UCDAPClient::SendBatch)
+ */
+struct DAPBatchRequest {
+    std::string command;
+    JsonObject arguments;
+    std::function<void(const Response&)> onResponse;
+};
+
+/**
+ * @brief Round-trip times of one command, as seen by the client
+ */
+struct DAPRequestLatency {
+    uint64_t count = 0;
+    uint64_t failures = 0;              // Responses with success == false
+    double totalMs = 0.0;
+    double minMs = 0.0;
+    double maxMs = 0.0;
+    double lastMs = 0.0;
+    
+    double AverageMs() const { return count > 0 ? totalMs / count : 0.0; }
+};
+
+/**
+ * @brief What FetchStopState asks the adapter for
+ */
+struct DAPStopStateRequest {
+    std::vector<int> threadIds;         // Known threads; if empty, asks for threads first
+    int selectedThreadId = 0;           // Whose frames are expanded; 0 for the first thread
+    int maxThreads = 8;                 // Threads whose stacks are fetched
+    int levels = 20;                    // Frames per stackTrace
+    int selectedFrames = 1;             // Top frames of the selected thread to expand
+    bool includeExpensiveScopes = false;
+};
+
+/**
+ * @brief Everything FetchStopState fetched for one stop
+ */
+struct DAPStopState {
+    std::vector<Thread> threads;
+    std::map<int, std::vector<StackFrame>> stackFrames;     // threadId -> frames
+    std::map<int, std::vector<Scope>> scopes;               // frameId -> scopes
+    std::map<int, std::vector<Variable>> variables;         // variablesReference -> variables
+    std::vector<std::string> errors;                        // "command: message" per failure
+    int roundTrips = 0;                 // Longest chain of dependent requests
+};
+
 /**
  * @brief DAP Client
  * 
@@ -341,6 +389,40 @@ public:
      */
     std::future<Response> Completions(int frameId, const std::string& text, int column, int line = 0);
     
+    // =========================================================================
+    // PIPELINING
+    // =========================================================================
+    
+    /**
+     * @brief Send several requests in one write
+     *
+     * Each onResponse runs on the reader thread as its response arrives,
+     * in whatever order the adapter answers, and may send follow-up
+     * requests. If the connection is lost, pending requests are answered
+     * with success == false.
+     */
+    void SendBatch(std::vector<DAPBatchRequest> requests);
+    
+    /**
+     * @brief Fetch threads, stacks, scopes and variables for a stop
+     *
+     * Issued as a pipeline rather than one request at a time: the stacks
+     * of all threads are asked for together, and scopes and variables go
+     * out as soon as the frames and scopes they need arrive. A refresh
+     * takes as many round trips as the chain is deep, not one per request.
+     */
+    std::future<DAPStopState> FetchStopState(const DAPStopStateRequest& request = {});
+    
+    // =========================================================================
+    // INSTRUMENTATION
+    // =========================================================================
+    
+    /**
+     * @brief Round-trip times per command since connecting (or the last reset)
+     */
+    std::map<std::string, DAPRequestLatency> GetRequestLatencies() const;
+    void ResetRequestLatencies();
+    
     // =========================================================================
     // EVENTS
     // =========================================================================
@@ -365,14 +447,21 @@ public:
     std::function<void()> onDisconnected;
     
 private:
+    class StopStateFetch;
+    
     // Message handling
+    void StartReader();
     void ReaderThread();
     void ProcessEvent(const Event& event);
     void ProcessResponse(const Response& response);
+    void FailPendingRequests(const std::string& message);
+    void FailRequests(std::map<int, PendingRequest>& requests, const std::string& message);
     
     std::future<Response> SendRequest(const std::string& command, const JsonObject& args = {});
-    void SendMessage(const std::string& json);
+    void SendRequests(std::vector<DAPBatchRequest>& requests, std::future<Response>* future);
+    bool WriteAll(const char* data, size_t size);
     bool ReadMessage(std::string& message);
+    bool FillReadBuffer();
     
     // State
     std::atomic<DAPClientState> state_{DAPClientState::Disconnected};
@@ -382,12 +471,23 @@ private:
     // Pending requests
     std::map<int, PendingRequest> pendingRequests_;
     std::mutex requestMutex_;
+    bool acceptingRequests_ = false;    // The reader runs and will answer or fail them
     int requestTimeout_ = 30000;  // 30 seconds
     
+    // Round trips per command
+    std::map<std::string, DAPRequestLatency> latencies_;
+    mutable std::mutex latencyMutex_;
+    
     // Threading
     std::thread readerThread_;
     std::atomic<bool> running_{false};
-    std::mutex sendMutex_;
+    std::mutex sendMutex_;              // Guards nextSeq_ and sendBuffer_; taken before requestMutex_
+    std::string sendBuffer_;            // Framed requests of one write
+    std::string bodyBuffer_;
+    
+    // Bytes read from the adapter; the next message starts at readOffset_
+    std::string readBuffer_;
+    size_t readOffset_ = 0;
     
     // Process handles (for stdio transport)
 #ifdef _WIN32
@@ -6,25 +6,216 @@
 
 #include "UCDAPServer.h"
 #include <iostream>
-#include <sstream>
 #include <cstring>
+#include <cstdio>
+#include <charconv>
 #include <algorithm>
+#include <limits>
+#include <chrono>
+#include <optional>
+#include <iterator>
 
 #ifdef _WIN32
 #include <winsock2.h>
 #include <ws2tcpip.h>
+#include <io.h>
 #pragma comment(lib, "ws2_32.lib")
 #else
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <unistd.h>
 #include <arpa/inet.h>
+#include <errno.h>
 #endif
 
 namespace UltraCanvas {
 namespace IDE {
 namespace DAP {
 
+namespace {
+
+int GetIntArgument(const Request& request, const std::string& key, int def = 0) {
+    auto it = request.arguments.properties.find(key);
+    if (it == request.arguments.properties.end()) return def;
+    const int64_t* value = std::get_if<int64_t>(&it->second);
+    return value ? static_cast<int>(*value) : def;
+}
+
+// Bytes asked for per read; clients send bursts of small requests
+const size_t READ_CHUNK_SIZE = 64 * 1024;
+
+// Headers of a DAP message are one short line; more than this without
+// the blank line ending them is not a DAP client
+const size_t MAX_HEADER_SIZE = 8 * 1024;
+
+// Frame ids encode (threadId, level): stable across requests, and a deep
+// stack needs no id bookkeeping
+const int MAX_FRAMES_PER_THREAD = 100000;
+
+// Highest thread id whose frame ids still fit in an int
+const int MAX_FRAME_THREAD_ID = std::numeric_limits<int>::max() / MAX_FRAMES_PER_THREAD - 1;
+
+// stackTrace requests for more frames than this (or for all) show progress
+const int PROGRESS_FRAME_THRESHOLD = 1000;
+
+// Minimum time between progressUpdate events of one request
+const auto PROGRESS_UPDATE_INTERVAL = std::chrono::milliseconds(100);
+
+// Progress ids are this plus the request's seq, so cancel can find it
+const std::string PROGRESS_ID_PREFIX = "request-";
+
+// stackTrace fetches deep stacks this many frames per debugger call
+const int STACK_FETCH_FRAMES = 500;
+
+/**
+ * @brief Send each response as soon as it is written
+ *
+ * Pipelining clients get several responses back to back; with Nagle on,
+ * all but the first wait for the client's delayed ACK.
+ */
+void DisableNagle(int socket) {
+    int noDelay = 1;
+    setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, (const char*)&noDelay, sizeof(noDelay));
+}
+
+#ifdef MSG_NOSIGNAL
+const int SEND_FLAGS = MSG_NOSIGNAL;    // A vanished client is a failed send, not SIGPIPE
+#else
+const int SEND_FLAGS = 0;
+#endif
+
+/**
+ * @brief Where MSG_NOSIGNAL is missing, keep SIGPIPE off the socket itself
+ *
+ * The process may be hosting other sessions; the signal's disposition is
+ * the application's to choose, not ours.
+ */
+void DisableSigpipe(int socket) {
+#ifdef SO_NOSIGPIPE
+    int noSigpipe = 1;
+    setsockopt(socket, SOL_SOCKET, SO_NOSIGPIPE, &noSigpipe, sizeof(noSigpipe));
+#else
+    (void)socket;
+#endif
+}
+
+/**
+ * @brief Requests answered on the message thread as soon as they arrive
+ */
+bool IsImmediateCommand(const std::string& command) {
+    return command == "cancel" || command == "pause";
+}
+
+/**
+ * @brief Requests that end the debuggee; run on the shutdown thread
+ *
+ * Terminating waits for the debug manager, which may be busy with a slow
+ * request, so these must not block the message thread.
+ */
+bool IsShutdownCommand(const std::string& command) {
+    return command == "disconnect" || command == "terminate";
+}
+
+/**
+ * @brief Read-only requests that may run alongside each other
+ */
+bool IsConcurrentRequest(const Request& request) {
+    static const char* const commands[] = {
+        "threads", "stackTrace", "scopes", "variables", "source",
+        "completions", "modules", "loadedSources", "readMemory",
+        "disassemble", "exceptionInfo", "dataBreakpointInfo",
+        "breakpointLocations"
+    };
+    for (const char* command : commands) {
+        if (request.command == command) return true;
+    }
+    
+    // REPL input may have side effects; hovers and watches only look
+    if (request.command == "evaluate") {
+        return request.arguments.Get<std::string>("context").value_or("") != "repl";
+    }
+    return false;
+}
+
+/**
+ * @brief Content-Length from a header block, or -1 if there is none
+ */
+long ParseContentLength(std::string_view headers) {
+    static constexpr std::string_view name = "content-length:";
+    size_t line = 0;
+    while (line < headers.size()) {
+        size_t lineEnd = headers.find("\r\n", line);
+        if (lineEnd == std::string_view::npos) lineEnd = headers.size();
+        std::string_view header = headers.substr(line, lineEnd - line);
+        line = lineEnd + 2;
+        
+        if (header.size() <= name.size()) continue;
+        bool matches = true;
+        for (size_t i = 0; i < name.size() && matches; i++) {
+            char c = header[i];
+            if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+            matches = c == name[i];
+        }
+        if (!matches) continue;
+        
+        size_t start = name.size();
+        while (start < header.size() && (header[start] == ' ' || header[start] == '\t')) start++;
+        long length = -1;
+        auto result = std::from_chars(header.data() + start, header.data() + header.size(), length);
+        return result.ec == std::errc() ? length : -1;
+    }
+    return -1;
+}
+
+} // anonymous namespace
+
+/**
+ * @brief progressStart/progressUpdate/progressEnd for one request
+ *
+ * Sends nothing unless the client asked for progress reporting. Updates
+ * are throttled and progressEnd goes out when the object is destroyed.
+ * The progress is cancellable: its id leads cancel back to the request.
+ */
+class UCDAPServer::Progress {
+public:
+    Progress(UCDAPServer& server, const Request& request, const std::string& title)
+        : server_(server), enabled_(server.clientSupportsProgress_) {
+        if (!enabled_) return;
+        id_ = PROGRESS_ID_PREFIX + std::to_string(request.seq);
+        server_.SendProgressEvent(id_, title, "", 0, request.seq);
+        lastUpdate_ = std::chrono::steady_clock::now();
+    }
+    
+    ~Progress() {
+        if (enabled_) server_.SendProgressEndEvent(id_);
+    }
+    
+    Progress(const Progress&) = delete;
+    Progress& operator=(const Progress&) = delete;
+    
+    // total is 0 when not known: the count is reported without a percentage
+    void Update(size_t done, size_t total) {
+        if (!enabled_) return;
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastUpdate_ < PROGRESS_UPDATE_INTERVAL) return;
+        lastUpdate_ = now;
+        if (total == 0) {
+            server_.SendProgressUpdateEvent(id_, std::to_string(done) + " so far", -1);
+            return;
+        }
+        server_.SendProgressUpdateEvent(id_, std::to_string(done) + " of " + std::to_string(total),
+                                        static_cast<int>(done * 100 / total));
+    }
+    
+private:
+    UCDAPServer& server_;
+    bool enabled_;
+    std::string id_;
+    std::chrono::steady_clock::time_point lastUpdate_;
+};
+
 UCDAPServer::UCDAPServer() = default;
 
 UCDAPServer::~UCDAPServer() {
@@ -46,6 +237,17 @@ bool UCDAPServer::Initialize(const DAPServerConfig& config) {
     return false;
 }
 
+bool UCDAPServer::InitializeConnected(const DAPServerConfig& config, int clientSocket) {
+    if (clientSocket < 0) return false;
+    
+    config_ = config;
+    config_.transport = DAPTransport::Socket;
+    clientSocket_ = clientSocket;
+    DisableNagle(clientSocket_);
+    DisableSigpipe(clientSocket_);
+    return true;
+}
+
 bool UCDAPServer::InitializeStdio() {
     // Stdio requires no special initialization
     return true;
@@ -93,12 +295,19 @@ bool UCDAPServer::Start() {
     if (running_) return true;
     
     running_ = true;
+    stopping_ = false;
     
     if (config_.transport == DAPTransport::Socket) {
-        // Wait for client connection
-        struct sockaddr_in clientAddr;
-        socklen_t clientLen = sizeof(clientAddr);
-        clientSocket_ = accept(serverSocket_, (struct sockaddr*)&clientAddr, &clientLen);
+        // Wait for client connection, unless it was handed over connected
+        if (clientSocket_ < 0) {
+            struct sockaddr_in clientAddr;
+            socklen_t clientLen = sizeof(clientAddr);
+            clientSocket_ = accept(serverSocket_, (struct sockaddr*)&clientAddr, &clientLen);
+            if (clientSocket_ >= 0) {
+                DisableNagle(clientSocket_);
+                DisableSigpipe(clientSocket_);
+            }
+        }
         
         if (clientSocket_ < 0) {
             running_ = false;
@@ -110,16 +319,48 @@ bool UCDAPServer::Start() {
         }
     }
     
+    StartWorkers();
+    StartShutdownThread();
     messageThread_ = std::thread(&UCDAPServer::MessageLoop, this);
     return true;
 }
 
+bool UCDAPServer::StartWithExternalInput() {
+    if (running_) return true;
+    if (clientSocket_ < 0) return false;
+    
+    running_ = true;
+    stopping_ = false;
+    if (onClientConnected) {
+        onClientConnected();
+    }
+    
+    StartWorkers();
+    StartShutdownThread();
+    return true;
+}
+
 void UCDAPServer::Stop() {
+    stopping_ = true;
     running_ = false;
     
+    // Lets a disconnect in progress send its response before the socket
+    // goes; anything the message thread submits after this runs inline
+    StopShutdownThread();
+    
+    // Wakes a message thread blocked reading the client
+    if (clientSocket_ >= 0) {
+#ifdef _WIN32
+        shutdown(clientSocket_, SD_BOTH);
+#else
+        shutdown(clientSocket_, SHUT_RDWR);
+#endif
+    }
+    
     if (messageThread_.joinable()) {
         messageThread_.join();
     }
+    StopWorkers();
     
     if (clientSocket_ >= 0) {
 #ifdef _WIN32
@@ -180,40 +421,73 @@ void UCDAPServer::MessageLoop() {
         if (!ReadMessage(message)) {
             break;
         }
-        
-        if (onMessageReceived) {
-            onMessageReceived(message);
+        HandleMessage(message);
+    }
+    
+    // Ended by the client (or its disconnect request) rather than by Stop()
+    if (!stopping_ && onSessionEnded) {
+        onSessionEnded();
+    }
+}
+
+void UCDAPServer::HandleMessage(const std::string& message) {
+    if (onMessageReceived) {
+        onMessageReceived(message);
+    }
+    
+    Request request;
+    if (!ParseRequest(message, request)) {
+        SendResponse(CreateErrorResponse(request, "Malformed request"));
+        return;
+    }
+    SubmitRequest(std::move(request));
+}
+
+bool UCDAPServer::FeedInput(const char* data, size_t size) {
+    CompactReadBuffer();
+    readBuffer_.append(data, size);
+    
+    std::string message;
+    for (;;) {
+        switch (FrameMessage(message)) {
+            case FrameResult::Complete:
+                HandleMessage(message);
+                if (!running_) return false;    // disconnect
+                break;
+            case FrameResult::Incomplete:
+                return true;
+            case FrameResult::Invalid:
+                return false;
         }
-        
-        // Parse and process
-        Response response = ProcessMessage(message);
-        SendResponse(response);
     }
 }
 
 Response UCDAPServer::ProcessMessage(const std::string& messageJson) {
-    // Simple JSON parsing for command extraction
     Request request;
-    
-    // Extract seq
-    size_t seqPos = messageJson.find("\"seq\":");
-    if (seqPos != std::string::npos) {
-        size_t start = seqPos + 6;
-        size_t end = messageJson.find_first_of(",}", start);
-        request.seq = std::stoi(messageJson.substr(start, end - start));
+    if (!ParseRequest(messageJson, request)) {
+        return CreateErrorResponse(request, "Malformed request");
     }
-    
-    // Extract command
-    size_t cmdPos = messageJson.find("\"command\":\"");
-    if (cmdPos != std::string::npos) {
-        size_t start = cmdPos + 11;
-        size_t end = messageJson.find("\"", start);
-        request.command = messageJson.substr(start, end - start);
+    return DispatchRequest(request);
+}
+
+bool UCDAPServer::ParseRequest(const std::string& messageJson, Request& request) {
+    JsonObject message;
+    if (!JsonObject::Parse(messageJson, message)) {
+        if (onError) onError("Malformed DAP message");
+        return false;
     }
     
+    request.seq = static_cast<int>(message.Get<int64_t>("seq").value_or(0));
+    request.command = message.Get<std::string>("command").value_or(std::string());
+    request.arguments = message.GetObject("arguments");
+    return true;
+}
+
+Response UCDAPServer::DispatchRequest(const Request& request) {
     ProcessRequest(request);
     
     // Dispatch to handler
+    if (request.command == "cancel") return HandleCancel(request);
     if (request.command == "initialize") return HandleInitialize(request);
     if (request.command == "launch") return HandleLaunch(request);
     if (request.command == "attach") return HandleAttach(request);
@@ -253,7 +527,6 @@ Response UCDAPServer::ProcessMessage(const std::string& messageJson) {
 
 Response UCDAPServer::CreateErrorResponse(const Request& request, const std::string& message) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = request.command;
     response.success = false;
@@ -261,102 +534,215 @@ Response UCDAPServer::CreateErrorResponse(const Request& request, const std::str
     return response;
 }
 
+Response UCDAPServer::CreateCancelledResponse(const Request& request) {
+    // The protocol reserves this exact message for cancelled requests
+    return CreateErrorResponse(request, "cancelled");
+}
+
 void UCDAPServer::SendResponse(const Response& response) {
-    SendMessage(response.ToJson());
+    std::lock_guard<std::mutex> lock(sendMutex_);
+    sendBuffer_.clear();
+    JsonWriter writer(sendBuffer_);
+    response.WriteJson(writer, nextSeq_++);
+    SendMessage();
 }
 
-void UCDAPServer::SendEvent(const Event& event) {
-    Event e = event;
-    e.seq = nextSeq_++;
-    SendMessage(e.ToJson());
+void UCDAPServer::LendBodyBuffer(Response& response) {
+    std::lock_guard<std::mutex> lock(sendMutex_);
+    response.rawBody.swap(bodyBuffer_);
+    response.rawBody.clear();
 }
 
-void UCDAPServer::SendMessage(const std::string& json) {
+void UCDAPServer::ReclaimBodyBuffer(Response& response) {
+    // Keep whichever buffer has grown larger for the next big body
     std::lock_guard<std::mutex> lock(sendMutex_);
-    
-    std::ostringstream header;
-    header << "Content-Length: " << json.length() << "\r\n\r\n";
-    
-    std::string message = header.str() + json;
-    
+    if (response.rawBody.capacity() > bodyBuffer_.capacity()) {
+        bodyBuffer_.swap(response.rawBody);
+    }
+}
+
+void UCDAPServer::SendEvent(const Event& event) {
+    std::lock_guard<std::mutex> lock(sendMutex_);
+    sendBuffer_.clear();
+    JsonWriter writer(sendBuffer_);
+    event.WriteJson(writer, nextSeq_++);
+    SendMessage();
+}
+
+void UCDAPServer::SendMessage() {
     if (onMessageSent) {
-        onMessageSent(json);
+        onMessageSent(sendBuffer_);
     }
     
-    WriteMessage(message);
+    // A failed or partial write leaves the stream unusable; shutting the
+    // socket makes the reader see the end of the session
+    if (!WriteMessage(sendBuffer_) && config_.transport == DAPTransport::Socket &&
+        clientSocket_ >= 0) {
+#ifdef _WIN32
+        shutdown(clientSocket_, SD_BOTH);
+#else
+        shutdown(clientSocket_, SHUT_RDWR);
+#endif
+    }
 }
 
 bool UCDAPServer::ReadMessage(std::string& message) {
-    // Read headers
-    std::string line;
-    int contentLength = 0;
-    
-    while (true) {
-        line = ReadLine();
-        if (line.empty() || line == "\r\n" || line == "\n") {
-            break;
+    for (;;) {
+        switch (FrameMessage(message)) {
+            case FrameResult::Complete:
+                return true;
+            case FrameResult::Invalid:
+                return false;
+            case FrameResult::Incomplete:
+                break;
         }
         
-        if (line.find("Content-Length:") == 0) {
-            contentLength = std::stoi(line.substr(15));
+        if (!FillReadBuffer()) {
+            return false;
+        }
+    }
+}
+
+UCDAPServer::FrameResult UCDAPServer::FrameMessage(std::string& message) {
+    // Frame the next message straight out of the buffer when both its
+    // headers and its body are in; one read often brings several
+    size_t headerEnd = readBuffer_.find("\r\n\r\n", readOffset_);
+    if (headerEnd == std::string::npos) {
+        if (readBuffer_.size() - readOffset_ > MAX_HEADER_SIZE) {
+            if (onError) onError("DAP message headers too long");
+            return FrameResult::Invalid;
         }
+        return FrameResult::Incomplete;
     }
     
+    long contentLength = ParseContentLength(
+        std::string_view(readBuffer_).substr(readOffset_, headerEnd - readOffset_));
     if (contentLength <= 0) {
-        return false;
+        if (onError) onError("DAP message without Content-Length");
+        return FrameResult::Invalid;
     }
     
-    // Read body
-    message.resize(contentLength);
+    size_t length = static_cast<size_t>(contentLength);
+    if (length > config_.maxMessageSize) {
+        if (onError) onError("DAP message larger than maxMessageSize");
+        return FrameResult::Invalid;
+    }
+    
+    size_t bodyStart = headerEnd + 4;
+    if (readBuffer_.size() - bodyStart < length) {
+        return FrameResult::Incomplete;
+    }
+    message.assign(readBuffer_, bodyStart, length);
+    readOffset_ = bodyStart + length;
+    return FrameResult::Complete;
+}
+
+void UCDAPServer::CompactReadBuffer() {
+    // Drop consumed messages once they are most of the buffer, so the
+    // move is paid for by the reads that filled it
+    if (readOffset_ > 0 && readOffset_ * 2 >= readBuffer_.size()) {
+        readBuffer_.erase(0, readOffset_);
+        readOffset_ = 0;
+    }
+}
+
+bool UCDAPServer::FillReadBuffer() {
+    CompactReadBuffer();
+    
+    char chunk[READ_CHUNK_SIZE];
+    long received = -1;
     
     if (config_.transport == DAPTransport::Stdio) {
-        std::cin.read(&message[0], contentLength);
-        return std::cin.good();
+#ifdef _WIN32
+        received = _read(_fileno(stdin), chunk, static_cast<unsigned>(sizeof(chunk)));
+#else
+        do {
+            received = read(STDIN_FILENO, chunk, sizeof(chunk));
+        } while (received < 0 && errno == EINTR);
+#endif
     } else if (config_.transport == DAPTransport::Socket && clientSocket_ >= 0) {
-        int received = 0;
-        while (received < contentLength) {
-            int n = recv(clientSocket_, &message[received], contentLength - received, 0);
-            if (n <= 0) return false;
-            received += n;
-        }
-        return true;
+#ifdef _WIN32
+        received = recv(clientSocket_, chunk, static_cast<int>(sizeof(chunk)), 0);
+#else
+        do {
+            received = recv(clientSocket_, chunk, sizeof(chunk), 0);
+        } while (received < 0 && errno == EINTR);
+#endif
     }
     
-    return false;
+    if (received <= 0) {
+        return false;
+    }
+    readBuffer_.append(chunk, static_cast<size_t>(received));
+    return true;
 }
 
 bool UCDAPServer::WriteMessage(const std::string& message) {
+    char header[48];
+    int headerLength = std::snprintf(header, sizeof(header), "Content-Length: %zu\r\n\r\n",
+                                     message.size());
+    
+#ifdef _WIN32
     if (config_.transport == DAPTransport::Stdio) {
-        std::cout << message;
-        std::cout.flush();
-        return true;
+        std::fwrite(header, 1, headerLength, stdout);
+        std::fwrite(message.data(), 1, message.size(), stdout);
+        return std::fflush(stdout) == 0;
     } else if (config_.transport == DAPTransport::Socket && clientSocket_ >= 0) {
-        int sent = 0;
-        while (sent < static_cast<int>(message.length())) {
-            int n = send(clientSocket_, message.c_str() + sent, message.length() - sent, 0);
-            if (n <= 0) return false;
-            sent += n;
-        }
-        return true;
+        WSABUF parts[2] = {
+            { static_cast<ULONG>(headerLength), header },
+            { static_cast<ULONG>(message.size()), const_cast<char*>(message.data()) }
+        };
+        DWORD sent = 0;
+        return WSASend(clientSocket_, parts, 2, &sent, 0, nullptr, nullptr) == 0;
     }
     return false;
-}
-
-std::string UCDAPServer::ReadLine() {
-    std::string line;
-    
+#else
+    int fd = -1;
+    bool isSocket = false;
     if (config_.transport == DAPTransport::Stdio) {
-        std::getline(std::cin, line);
-        line += "\n";
-    } else if (config_.transport == DAPTransport::Socket && clientSocket_ >= 0) {
-        char c;
-        while (recv(clientSocket_, &c, 1, 0) == 1) {
-            line += c;
-            if (c == '\n') break;
-        }
+        std::cout.flush();
+        fd = STDOUT_FILENO;
+    } else if (config_.transport == DAPTransport::Socket) {
+        fd = clientSocket_;
+        isSocket = true;
     }
+    if (fd < 0) return false;
     
-    return line;
+    // Header and body leave in one write, without joining them first;
+    // sockets use sendmsg for the no-SIGPIPE flag
+    iovec parts[2] = {
+        { header, static_cast<size_t>(headerLength) },
+        { const_cast<char*>(message.data()), message.size() }
+    };
+    iovec* remaining = parts;
+    int count = 2;
+    while (count > 0) {
+        ssize_t written;
+        if (isSocket) {
+            msghdr msg;
+            memset(&msg, 0, sizeof(msg));
+            msg.msg_iov = remaining;
+            msg.msg_iovlen = count;
+            written = sendmsg(fd, &msg, SEND_FLAGS);
+        } else {
+            written = writev(fd, remaining, count);
+        }
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) return false;
+        
+        size_t done = static_cast<size_t>(written);
+        while (count > 0 && done >= remaining->iov_len) {
+            done -= remaining->iov_len;
+            remaining++;
+            count--;
+        }
+        if (count > 0) {
+            remaining->iov_base = static_cast<char*>(remaining->iov_base) + done;
+            remaining->iov_len -= done;
+        }
+    }
+    return true;
+#endif
 }
 
 void UCDAPServer::ProcessRequest(const Request& request) {
@@ -366,18 +752,241 @@ void UCDAPServer::ProcessRequest(const Request& request) {
     }
 }
 
+// ============================================================================
+// REQUEST EXECUTION
+// ============================================================================
+
+void UCDAPServer::SubmitRequest(Request request) {
+    if (IsImmediateCommand(request.command)) {
+        SendResponse(DispatchRequest(request));
+        return;
+    }
+    
+    if (IsShutdownCommand(request.command)) {
+        // The session is over for the client as of now: stop reading and
+        // drop queued work without waiting for the debugger to go
+        if (request.command == "disconnect") {
+            CancelAllRequests();
+            running_ = false;
+        }
+        
+        {
+            std::lock_guard<std::mutex> lock(shutdownMutex_);
+            if (shutdownThreadRunning_) {
+                shutdownRequests_.push_back(std::move(request));
+                shutdownCv_.notify_one();
+                return;
+            }
+        }
+        
+        // Stop() is already under way and may block; it waits for us anyway
+        SendResponse(DispatchRequest(request));
+        return;
+    }
+    
+    auto pending = std::make_shared<PendingRequest>();
+    pending->ordered = !IsConcurrentRequest(request);
+    pending->request = std::move(request);
+    {
+        std::lock_guard<std::mutex> lock(requestMutex_);
+        activeRequests_[pending->request.seq] = pending;
+        pendingRequests_.push_back(std::move(pending));
+    }
+    requestCv_.notify_one();
+}
+
+std::shared_ptr<UCDAPServer::PendingRequest> UCDAPServer::TakeRunnableRequest() {
+    // Called with requestMutex_ held. Ordered requests queue behind the
+    // one running; anything concurrent may overtake them
+    for (auto it = pendingRequests_.begin(); it != pendingRequests_.end(); ++it) {
+        if ((*it)->ordered) {
+            if (orderedRequestRunning_) continue;
+            orderedRequestRunning_ = true;
+        }
+        std::shared_ptr<PendingRequest> pending = std::move(*it);
+        pendingRequests_.erase(it);
+        return pending;
+    }
+    return nullptr;
+}
+
+void UCDAPServer::WorkerLoop() {
+    for (;;) {
+        std::shared_ptr<PendingRequest> pending;
+        {
+            std::unique_lock<std::mutex> lock(requestMutex_);
+            while (!stopWorkers_ && !(pending = TakeRunnableRequest())) {
+                requestCv_.wait(lock);
+            }
+            if (!pending) return;
+        }
+        
+        const Request& request = pending->request;
+        Response response;
+        if (!pending->cancelled) {
+            response = DispatchRequest(request);
+        }
+        
+        // Cancelled while it ran: the result is dropped, the request
+        // still gets its answer
+        if (pending->cancelled) {
+            SendResponse(CreateCancelledResponse(request));
+        } else {
+            SendResponse(response);
+        }
+        ReclaimBodyBuffer(response);
+        
+        {
+            std::lock_guard<std::mutex> lock(requestMutex_);
+            activeRequests_.erase(request.seq);
+            if (pending->ordered) orderedRequestRunning_ = false;
+        }
+        requestCv_.notify_all();
+    }
+}
+
+void UCDAPServer::CancelAllRequests() {
+    std::deque<std::shared_ptr<PendingRequest>> queued;
+    {
+        std::lock_guard<std::mutex> lock(requestMutex_);
+        for (auto& active : activeRequests_) {
+            active.second->cancelled = true;
+        }
+        queued.swap(pendingRequests_);
+        for (const auto& pending : queued) {
+            activeRequests_.erase(pending->request.seq);
+        }
+    }
+    
+    for (const auto& pending : queued) {
+        SendResponse(CreateCancelledResponse(pending->request));
+    }
+}
+
+bool UCDAPServer::IsCancelled(const Request& request) {
+    std::lock_guard<std::mutex> lock(requestMutex_);
+    auto it = activeRequests_.find(request.seq);
+    return it != activeRequests_.end() && it->second->cancelled;
+}
+
+void UCDAPServer::StartWorkers() {
+    std::lock_guard<std::mutex> lock(requestMutex_);
+    stopWorkers_ = false;
+    int count = std::max(1, config_.workerCount);
+    for (int i = 0; i < count; i++) {
+        workers_.emplace_back(&UCDAPServer::WorkerLoop, this);
+    }
+}
+
+void UCDAPServer::StopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(requestMutex_);
+        stopWorkers_ = true;
+        for (auto& active : activeRequests_) {
+            active.second->cancelled = true;
+        }
+    }
+    requestCv_.notify_all();
+    
+    for (auto& worker : workers_) {
+        if (worker.joinable()) worker.join();
+    }
+    workers_.clear();
+    
+    std::lock_guard<std::mutex> lock(requestMutex_);
+    pendingRequests_.clear();
+    activeRequests_.clear();
+    orderedRequestRunning_ = false;
+}
+
+void UCDAPServer::ShutdownLoop() {
+    std::unique_lock<std::mutex> lock(shutdownMutex_);
+    for (;;) {
+        while (shutdownThreadRunning_ && shutdownRequests_.empty()) {
+            shutdownCv_.wait(lock);
+        }
+        // Queued requests are answered before the thread exits
+        if (shutdownRequests_.empty()) return;
+        
+        Request request = std::move(shutdownRequests_.front());
+        shutdownRequests_.pop_front();
+        lock.unlock();
+        
+        SendResponse(DispatchRequest(request));
+        
+        lock.lock();
+    }
+}
+
+void UCDAPServer::StartShutdownThread() {
+    std::lock_guard<std::mutex> lock(shutdownMutex_);
+    shutdownThreadRunning_ = true;
+    shutdownThread_ = std::thread(&UCDAPServer::ShutdownLoop, this);
+}
+
+void UCDAPServer::StopShutdownThread() {
+    {
+        std::lock_guard<std::mutex> lock(shutdownMutex_);
+        shutdownThreadRunning_ = false;
+    }
+    shutdownCv_.notify_all();
+    
+    if (shutdownThread_.joinable()) {
+        shutdownThread_.join();
+    }
+}
+
 // ============================================================================
 // REQUEST HANDLERS
 // ============================================================================
 
+Response UCDAPServer::HandleCancel(const Request& request) {
+    Response response;
+    response.request_seq = request.seq;
+    response.command = "cancel";
+    response.success = true;
+    
+    // A progress id names its request (PROGRESS_ID_PREFIX + seq)
+    int requestId = GetIntArgument(request, "requestId");
+    std::string progressId = request.arguments.Get<std::string>("progressId").value_or("");
+    if (requestId == 0 && progressId.compare(0, PROGRESS_ID_PREFIX.size(), PROGRESS_ID_PREFIX) == 0) {
+        std::from_chars(progressId.data() + PROGRESS_ID_PREFIX.size(),
+                        progressId.data() + progressId.size(), requestId);
+    }
+    
+    std::shared_ptr<PendingRequest> dequeued;
+    {
+        std::lock_guard<std::mutex> lock(requestMutex_);
+        auto it = activeRequests_.find(requestId);
+        if (it != activeRequests_.end()) {
+            it->second->cancelled = true;
+            auto queued = std::find(pendingRequests_.begin(), pendingRequests_.end(), it->second);
+            if (queued != pendingRequests_.end()) {
+                dequeued = it->second;
+                pendingRequests_.erase(queued);
+                activeRequests_.erase(it);
+            }
+        }
+    }
+    
+    // A request that had not started is answered here; a running one
+    // answers when its handler returns
+    if (dequeued) {
+        SendResponse(CreateCancelledResponse(dequeued->request));
+    }
+    
+    return response;
+}
+
 Response UCDAPServer::HandleInitialize(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "initialize";
     response.success = true;
     response.body = capabilities_.ToJson();
     
+    clientSupportsProgress_ = request.arguments.Get<bool>("supportsProgressReporting").value_or(false);
+    
     initialized_ = true;
     
     // Send initialized event after response
@@ -388,7 +997,6 @@ Response UCDAPServer::HandleInitialize(const Request& request) {
 
 Response UCDAPServer::HandleLaunch(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "launch";
     
@@ -417,7 +1025,6 @@ Response UCDAPServer::HandleLaunch(const Request& request) {
 
 Response UCDAPServer::HandleAttach(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "attach";
     
@@ -442,11 +1049,12 @@ Response UCDAPServer::HandleAttach(const Request& request) {
 
 Response UCDAPServer::HandleDisconnect(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "disconnect";
     response.success = true;
     
+    CancelAllRequests();
+    
     if (debugManager_) {
         debugManager_->Terminate();
     }
@@ -457,7 +1065,6 @@ Response UCDAPServer::HandleDisconnect(const Request& request) {
 
 Response UCDAPServer::HandleConfigurationDone(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "configurationDone";
     response.success = true;
@@ -474,7 +1081,6 @@ Response UCDAPServer::HandleConfigurationDone(const Request& request) {
 
 Response UCDAPServer::HandleSetBreakpoints(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "setBreakpoints";
     
@@ -496,7 +1102,6 @@ Response UCDAPServer::HandleSetBreakpoints(const Request& request) {
 
 Response UCDAPServer::HandleSetFunctionBreakpoints(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "setFunctionBreakpoints";
     response.success = true;
@@ -505,7 +1110,6 @@ Response UCDAPServer::HandleSetFunctionBreakpoints(const Request& request) {
 
 Response UCDAPServer::HandleSetExceptionBreakpoints(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "setExceptionBreakpoints";
     response.success = true;
@@ -514,7 +1118,6 @@ Response UCDAPServer::HandleSetExceptionBreakpoints(const Request& request) {
 
 Response UCDAPServer::HandleContinue(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "continue";
     
@@ -531,7 +1134,6 @@ Response UCDAPServer::HandleContinue(const Request& request) {
 
 Response UCDAPServer::HandleNext(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "next";
     
@@ -547,7 +1149,6 @@ Response UCDAPServer::HandleNext(const Request& request) {
 
 Response UCDAPServer::HandleStepIn(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "stepIn";
     
@@ -563,7 +1164,6 @@ Response UCDAPServer::HandleStepIn(const Request& request) {
 
 Response UCDAPServer::HandleStepOut(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "stepOut";
     
@@ -579,7 +1179,6 @@ Response UCDAPServer::HandleStepOut(const Request& request) {
 
 Response UCDAPServer::HandlePause(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "pause";
     
@@ -595,7 +1194,6 @@ Response UCDAPServer::HandlePause(const Request& request) {
 
 Response UCDAPServer::HandleTerminate(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "terminate";
     
@@ -611,7 +1209,6 @@ Response UCDAPServer::HandleTerminate(const Request& request) {
 
 Response UCDAPServer::HandleRestart(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "restart";
     
@@ -627,7 +1224,6 @@ Response UCDAPServer::HandleRestart(const Request& request) {
 
 Response UCDAPServer::HandleThreads(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "threads";
     
@@ -638,26 +1234,27 @@ Response UCDAPServer::HandleThreads(const Request& request) {
     
     auto threads = debugManager_->GetThreads();
     
-    std::ostringstream threadsJson;
-    threadsJson << "[";
-    for (size_t i = 0; i < threads.size(); i++) {
-        if (i > 0) threadsJson << ",";
-        Thread t;
-        t.id = threads[i].id;
-        t.name = threads[i].name.empty() ? "Thread " + std::to_string(threads[i].id) : threads[i].name;
-        threadsJson << t.ToJson().ToJson();
+    LendBodyBuffer(response);
+    JsonWriter writer(response.rawBody);
+    writer.BeginObject();
+    writer.Key("threads");
+    writer.BeginArray();
+    Thread t;
+    for (const auto& thread : threads) {
+        t.id = thread.id;
+        t.name = thread.name.empty() ? "Thread " + std::to_string(thread.id) : thread.name;
+        t.WriteJson(writer);
     }
-    threadsJson << "]";
+    writer.EndArray();
+    writer.EndObject();
     
     response.success = true;
-    response.body.Set("threads", threadsJson.str());
     
     return response;
 }
 
 Response UCDAPServer::HandleStackTrace(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "stackTrace";
     
@@ -666,21 +1263,74 @@ Response UCDAPServer::HandleStackTrace(const Request& request) {
         return response;
     }
     
-    // Parse threadId from arguments
-    int threadId = 0;  // Default
+    int threadId = GetIntArgument(request, "threadId");
+    if (threadId < 1 || threadId > MAX_FRAME_THREAD_ID) {
+        return CreateErrorResponse(request, "threadId out of range");
+    }
+    
+    // levels == 0 asks for every frame from startFrame on; deeper frames
+    // than one thread's id range are not reported
+    int startFrame = std::max(0, GetIntArgument(request, "startFrame"));
+    int levels = GetIntArgument(request, "levels");
+    int depth = levels > 0 && levels < MAX_FRAMES_PER_THREAD - startFrame
+        ? startFrame + levels : MAX_FRAMES_PER_THREAD - 1;
+    
+    // A deep stack can take a while to fetch; show it and let it be cancelled
+    std::optional<Progress> progress;
+    if (levels <= 0 || levels > PROGRESS_FRAME_THRESHOLD) {
+        progress.emplace(*this, request, "Loading call stack");
+    }
+    
+    // The requested thread's stack, not the selected one's, a chunk at a
+    // time: cancellation and progress are looked at between chunks
+    std::vector<IDE::StackFrame> frames;
+    for (int next = startFrame; next < depth; ) {
+        int count = std::min(STACK_FETCH_FRAMES, depth - next);
+        auto chunk = debugManager_->GetCallStackRange(threadId, next, count);
+        if (IsCancelled(request)) return CreateCancelledResponse(request);
+        
+        frames.insert(frames.end(), std::make_move_iterator(chunk.begin()),
+                      std::make_move_iterator(chunk.end()));
+        if (static_cast<int>(chunk.size()) < count) break;  // Bottom of the stack
+        next += count;
+        if (progress) progress->Update(frames.size(), levels > 0 ? levels : 0);
+    }
     
-    auto frames = debugManager_->GetCallStack(threadId);
+    // Frames are streamed straight into the body; one StackFrame is
+    // reused so a deep stack costs no per-frame allocations once its
+    // strings have grown
+    LendBodyBuffer(response);
+    JsonWriter writer(response.rawBody);
+    writer.BeginObject();
+    writer.Key("stackFrames");
+    writer.BeginArray();
+    StackFrame frame;
+    char address[24] = "0x";
+    for (const auto& source : frames) {
+        frame.id = threadId * MAX_FRAMES_PER_THREAD + source.level + 1;
+        if (source.functionName.empty()) frame.name = "??";
+        else frame.name = source.functionName;
+        frame.source.path = source.location.filePath;
+        frame.source.name = source.location.fileName;
+        frame.line = source.location.line;
+        frame.column = source.location.column;
+        char* end = std::to_chars(address + 2, address + sizeof(address), source.address, 16).ptr;
+        frame.instructionPointerReference.assign(address, source.address ? end - address : 0);
+        frame.presentationHint = source.isArtificial ? "subtle" : "";
+        frame.WriteJson(writer);
+    }
+    writer.EndArray();
+    writer.Key("totalFrames");
+    writer.Int(static_cast<int64_t>(startFrame + frames.size()));
+    writer.EndObject();
     
-    // Build stack frames array
     response.success = true;
-    response.body.Set("totalFrames", static_cast<int64_t>(frames.size()));
     
     return response;
 }
 
 Response UCDAPServer::HandleScopes(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "scopes";
     response.success = true;
@@ -692,19 +1342,50 @@ Response UCDAPServer::HandleScopes(const Request& request) {
 
 Response UCDAPServer::HandleVariables(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "variables";
-    response.success = true;
     
-    // Look up variable reference and return children
+    if (!debugManager_) {
+        response.success = false;
+        return response;
+    }
+    
+    // Clients that support paging ask for one slice of a large container
+    // at a time (start/count); only that slice is fetched from the debugger
+    int variablesReference = GetIntArgument(request, "variablesReference");
+    int start = GetIntArgument(request, "start");
+    int count = GetIntArgument(request, "count");
+    
+    auto children = debugManager_->ExpandVariable(variablesReference, start, count);
+    if (IsCancelled(request)) return CreateCancelledResponse(request);
+    
+    LendBodyBuffer(response);
+    JsonWriter writer(response.rawBody);
+    writer.BeginObject();
+    writer.Key("variables");
+    writer.BeginArray();
+    Variable v;
+    for (const auto& child : children) {
+        v.name = child.name;
+        v.value = child.value;
+        v.type = child.type;
+        v.evaluateName = child.evaluateName;
+        v.variablesReference = child.variablesReference;
+        v.namedVariables = child.namedVariables;
+        v.indexedVariables = child.indexedVariables;
+        v.memoryReference = child.memoryReference;
+        v.WriteJson(writer);
+    }
+    writer.EndArray();
+    writer.EndObject();
+    
+    response.success = true;
     
     return response;
 }
 
 Response UCDAPServer::HandleSetVariable(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "setVariable";
     
@@ -720,7 +1401,6 @@ Response UCDAPServer::HandleSetVariable(const Request& request) {
 
 Response UCDAPServer::HandleSource(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "source";
     response.success = true;
@@ -732,7 +1412,6 @@ Response UCDAPServer::HandleSource(const Request& request) {
 
 Response UCDAPServer::HandleEvaluate(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "evaluate";
     
@@ -750,7 +1429,16 @@ Response UCDAPServer::HandleEvaluate(const Request& request) {
         response.success = true;
         response.body.Set("result", result.variable.value);
         response.body.Set("type", result.variable.type);
-        response.body.Set("variablesReference", static_cast<int64_t>(0));
+        response.body.Set("variablesReference",
+                          static_cast<int64_t>(result.variable.variablesReference));
+        if (result.variable.indexedVariables > 0) {
+            response.body.Set("indexedVariables",
+                              static_cast<int64_t>(result.variable.indexedVariables));
+        }
+        if (result.variable.namedVariables > 0) {
+            response.body.Set("namedVariables",
+                              static_cast<int64_t>(result.variable.namedVariables));
+        }
     } else {
         response.success = false;
         response.message = result.error;
@@ -761,7 +1449,6 @@ Response UCDAPServer::HandleEvaluate(const Request& request) {
 
 Response UCDAPServer::HandleCompletions(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "completions";
     response.success = true;
@@ -773,7 +1460,6 @@ Response UCDAPServer::HandleCompletions(const Request& request) {
 
 Response UCDAPServer::HandleModules(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "modules";
     response.success = true;
@@ -785,7 +1471,6 @@ Response UCDAPServer::HandleModules(const Request& request) {
 
 Response UCDAPServer::HandleLoadedSources(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "loadedSources";
     response.success = true;
@@ -794,7 +1479,6 @@ Response UCDAPServer::HandleLoadedSources(const Request& request) {
 
 Response UCDAPServer::HandleReadMemory(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "readMemory";
     
@@ -811,7 +1495,6 @@ Response UCDAPServer::HandleReadMemory(const Request& request) {
 
 Response UCDAPServer::HandleWriteMemory(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "writeMemory";
     response.success = true;
@@ -820,7 +1503,6 @@ Response UCDAPServer::HandleWriteMemory(const Request& request) {
 
 Response UCDAPServer::HandleDisassemble(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "disassemble";
     
@@ -835,7 +1517,6 @@ Response UCDAPServer::HandleDisassemble(const Request& request) {
 
 Response UCDAPServer::HandleExceptionInfo(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "exceptionInfo";
     response.success = true;
@@ -844,7 +1525,6 @@ Response UCDAPServer::HandleExceptionInfo(const Request& request) {
 
 Response UCDAPServer::HandleDataBreakpointInfo(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "dataBreakpointInfo";
     response.success = true;
@@ -853,7 +1533,6 @@ Response UCDAPServer::HandleDataBreakpointInfo(const Request& request) {
 
 Response UCDAPServer::HandleSetDataBreakpoints(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "setDataBreakpoints";
     response.success = true;
@@ -862,7 +1541,6 @@ Response UCDAPServer::HandleSetDataBreakpoints(const Request& request) {
 
 Response UCDAPServer::HandleSetInstructionBreakpoints(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "setInstructionBreakpoints";
     response.success = true;
@@ -871,7 +1549,6 @@ Response UCDAPServer::HandleSetInstructionBreakpoints(const Request& request) {
 
 Response UCDAPServer::HandleBreakpointLocations(const Request& request) {
     Response response;
-    response.seq = nextSeq_++;
     response.request_seq = request.seq;
     response.command = "breakpointLocations";
     response.success = true;
@@ -968,15 +1645,36 @@ void UCDAPServer::SendCapabilitiesEvent() {
 }
 
 void UCDAPServer::SendProgressEvent(const std::string& progressId, const std::string& title,
-                                     const std::string& message, int percentage) {
+                                     const std::string& message, int percentage,
+                                     int requestId) {
     Event event("progressStart");
     event.body.Set("progressId", progressId);
     event.body.Set("title", title);
+    if (requestId > 0) {
+        event.body.Set("requestId", static_cast<int64_t>(requestId));
+        event.body.Set("cancellable", true);
+    }
     if (!message.empty()) event.body.Set("message", message);
     if (percentage >= 0) event.body.Set("percentage", static_cast<int64_t>(percentage));
     SendEvent(event);
 }
 
+void UCDAPServer::SendProgressUpdateEvent(const std::string& progressId, const std::string& message,
+                                           int percentage) {
+    Event event("progressUpdate");
+    event.body.Set("progressId", progressId);
+    if (!message.empty()) event.body.Set("message", message);
+    if (percentage >= 0) event.body.Set("percentage", static_cast<int64_t>(percentage));
+    SendEvent(event);
+}
+
+void UCDAPServer::SendProgressEndEvent(const std::string& progressId, const std::string& message) {
+    Event event("progressEnd");
+    event.body.Set("progressId", progressId);
+    if (!message.empty()) event.body.Set("message", message);
+    SendEvent(event);
+}
+
 void UCDAPServer::SendInvalidatedEvent(InvalidatedAreas areas, int threadId) {
     Event event("invalidated");
     event.body.Set("areas", InvalidatedAreasToString(areas));
@@ -16,6 +16,8 @@
 #include <mutex>
 #include <atomic>
 #include <queue>
+#include <deque>
+#include <condition_variable>
 
 namespace UltraCanvas {
 namespace IDE {
@@ -39,6 +41,8 @@ struct DAPServerConfig {
     std::string pipeName;               // For pipe transport
     bool logMessages = false;
     std::string logFile;
+    int workerCount = 4;                // Threads running requests concurrently
+    size_t maxMessageSize = 64 * 1024 * 1024;  // A larger message ends the session
 };
 
 /**
@@ -47,6 +51,14 @@ struct DAPServerConfig {
  * Implements the Debug Adapter Protocol server that can communicate
  * with VS Code and other DAP clients. Bridges between DAP messages
  * and the UCDebugManager.
+ *
+ * The message thread only reads and routes requests. pause, disconnect,
+ * terminate and cancel are answered there at once, so a slow request
+ * never holds them up. Requests that change debugger state (launch,
+ * breakpoints, stepping, ...) run on the worker pool one at a time in
+ * arrival order; inspection requests (stackTrace, variables, evaluate
+ * for hovers and watches, ...) run concurrently. Each response is sent
+ * as soon as its request finishes, so responses may arrive out of order.
  */
 class UCDAPServer {
 public:
@@ -62,11 +74,32 @@ public:
      */
     bool Initialize(const DAPServerConfig& config);
     
+    /**
+     * @brief Serve a client that is already connected
+     *
+     * For a listener that accepts clients itself (UCDAPSessionHost);
+     * the server owns the socket from here on.
+     */
+    bool InitializeConnected(const DAPServerConfig& config, int clientSocket);
+    
     /**
      * @brief Start the server
      */
     bool Start();
     
+    /**
+     * @brief Start without a message thread; input arrives through FeedInput
+     *
+     * Lets one event loop read many clients.
+     */
+    bool StartWithExternalInput();
+    
+    /**
+     * @brief Hand the server bytes read from its client
+     * @return false if the stream is broken and the session should end
+     */
+    bool FeedInput(const char* data, size_t size);
+    
     /**
      * @brief Stop the server
      */
@@ -119,16 +152,49 @@ public:
     std::function<void(const std::string&)> onError;
     std::function<void()> onClientConnected;
     std::function<void()> onClientDisconnected;
+    std::function<void()> onSessionEnded;       // Client left or disconnected; Stop() is still needed
     
 private:
+    /**
+     * @brief A request waiting for or running on a worker
+     */
+    struct PendingRequest {
+        Request request;
+        bool ordered = false;           // Runs after earlier ordered requests, alone
+        std::atomic<bool> cancelled{false};
+    };
+    
+    class Progress;
+    
+    enum class FrameResult { Complete, Incomplete, Invalid };
+    
     // Message processing
     void MessageLoop();
+    void HandleMessage(const std::string& message);
+    bool ParseRequest(const std::string& messageJson, Request& request);
+    Response DispatchRequest(const Request& request);
     void ProcessRequest(const Request& request);
     Response CreateErrorResponse(const Request& request, const std::string& message);
+    Response CreateCancelledResponse(const Request& request);
     void SendResponse(const Response& response);
-    void SendMessage(const std::string& json);
+    void LendBodyBuffer(Response& response);
+    void ReclaimBodyBuffer(Response& response);
+    void SendMessage();                 // Sends sendBuffer_; sendMutex_ must be held
+    
+    // Request execution
+    void SubmitRequest(Request request);
+    void WorkerLoop();
+    std::shared_ptr<PendingRequest> TakeRunnableRequest();
+    void CancelAllRequests();
+    bool IsCancelled(const Request& request);
+    void StartWorkers();
+    void StopWorkers();
+    void ShutdownLoop();
+    void StartShutdownThread();
+    void StopShutdownThread();
     
     // Request handlers
+    Response HandleCancel(const Request& request);
     Response HandleInitialize(const Request& request);
     Response HandleLaunch(const Request& request);
     Response HandleAttach(const Request& request);
@@ -177,7 +243,11 @@ private:
     void SendProcessEvent(const std::string& name, int processId, bool isLocalProcess = true);
     void SendCapabilitiesEvent();
     void SendProgressEvent(const std::string& progressId, const std::string& title, 
-                           const std::string& message = "", int percentage = -1);
+                           const std::string& message = "", int percentage = -1,
+                           int requestId = 0);
+    void SendProgressUpdateEvent(const std::string& progressId, const std::string& message,
+                                 int percentage = -1);
+    void SendProgressEndEvent(const std::string& progressId, const std::string& message = "");
     void SendInvalidatedEvent(InvalidatedAreas areas = InvalidatedAreas::All, int threadId = 0);
     void SendMemoryEvent(const std::string& memoryReference, int offset, int count);
     
@@ -188,10 +258,13 @@ private:
     void OnBreakpointHit(int breakpointId);
     void OnOutput(const std::string& text, bool isError);
     
-    // I/O
+    // I/O: messages are framed in place out of readBuffer_, which is
+    // refilled with large reads; a write sends header and body together
     bool ReadMessage(std::string& message);
+    FrameResult FrameMessage(std::string& message);
     bool WriteMessage(const std::string& message);
-    std::string ReadLine();
+    bool FillReadBuffer();
+    void CompactReadBuffer();
     
     // Transport-specific
     bool InitializeStdio();
@@ -205,16 +278,37 @@ private:
     
     // State
     std::atomic<bool> running_{false};
+    std::atomic<bool> stopping_{false};     // Stop() called, as opposed to the client leaving
     std::atomic<bool> initialized_{false};
     std::atomic<bool> configurationDone_{false};
-    int nextSeq_ = 1;
+    std::atomic<bool> clientSupportsProgress_{false};
+    int nextSeq_ = 1;                   // Stamped on each message as it is sent
     
     // Threading
     std::thread messageThread_;
     std::mutex sendMutex_;
+    std::string sendBuffer_;            // Reused for every outgoing message
+    std::string bodyBuffer_;            // Lent to handlers that stream a rawBody
     std::queue<std::string> messageQueue_;
     std::mutex queueMutex_;
     
+    // Worker pool; requestMutex_ guards everything below it
+    std::vector<std::thread> workers_;
+    std::mutex requestMutex_;
+    std::condition_variable requestCv_;
+    std::deque<std::shared_ptr<PendingRequest>> pendingRequests_;
+    std::map<int, std::shared_ptr<PendingRequest>> activeRequests_;  // seq -> queued or running
+    bool orderedRequestRunning_ = false;
+    bool stopWorkers_ = false;
+    
+    // disconnect/terminate run here, one at a time, so a debugger that is
+    // slow to die never holds up the message thread
+    std::thread shutdownThread_;
+    std::mutex shutdownMutex_;
+    std::condition_variable shutdownCv_;
+    std::deque<Request> shutdownRequests_;
+    bool shutdownThreadRunning_ = false;
+    
     // Variable references (for scopes/variables)
     struct VariableReference {
         enum Type { Scope, Variable, Register };
@@ -230,6 +324,10 @@ private:
     std::map<int, std::pair<int, int>> frameIdToThreadFrame_;  // frameId -> (threadId, frameIndex)
     int nextFrameId_ = 1;
     
+    // Bytes read from the client; the next message starts at readOffset_
+    std::string readBuffer_;
+    size_t readOffset_ = 0;
+    
     // Socket (if using socket transport)
     int serverSocket_ = -1;
     int clientSocket_ = -1;
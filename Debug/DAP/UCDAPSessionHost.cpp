@@ -0,0 +1,389 @@
+// Apps/IDE/Debug/DAP/UCDAPSessionHost.cpp
+// Multi-client Debug Adapter Protocol listener Implementation for ULTRA IDE
+// Version: 1.0.0
+// Last Modified: 2025-12-28
+// Author: UltraCanvas Framework / ULTRA IDE
+
+#include "UCDAPSessionHost.h"
+#include <cstring>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+#else
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+namespace UltraCanvas {
+namespace IDE {
+namespace DAP {
+
+namespace {
+
+// Bytes read from a client per readiness event
+const size_t READ_CHUNK_SIZE = 64 * 1024;
+
+#ifdef _WIN32
+// Without a self-pipe, the host looks for ended sessions and Stop() this often
+const int HOST_POLL_INTERVAL_MS = 100;
+#endif
+
+void CloseSocket(int socket) {
+#ifdef _WIN32
+    closesocket(socket);
+#else
+    close(socket);
+#endif
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// HOST LIFECYCLE
+// ============================================================================
+
+UCDAPSessionHost::UCDAPSessionHost() {
+}
+
+UCDAPSessionHost::~UCDAPSessionHost() {
+    Stop();
+}
+
+bool UCDAPSessionHost::Initialize(const DAPSessionHostConfig& config) {
+    config_ = config;
+    
+#ifdef _WIN32
+    WSADATA wsaData;
+    if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
+        return false;
+    }
+#else
+    // A client that vanishes mid-write ends its session, not the adapter:
+    // the servers send with MSG_NOSIGNAL (SO_NOSIGPIPE where it is missing)
+    if (pipe(wakeFds_) < 0) {
+        return false;
+    }
+    for (int fd : wakeFds_) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+#endif
+    
+    listenSocket_ = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (listenSocket_ < 0) {
+        return false;
+    }
+    
+    int opt = 1;
+    setsockopt(listenSocket_, SOL_SOCKET, SO_REUSEADDR, (const char*)&opt, sizeof(opt));
+    
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = INADDR_ANY;
+    addr.sin_port = htons(config_.port);
+    
+    if (bind(listenSocket_, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        return false;
+    }
+    
+    if (listen(listenSocket_, config_.listenBacklog) < 0) {
+        return false;
+    }
+    
+    return true;
+}
+
+bool UCDAPSessionHost::Start() {
+    if (running_) return true;
+    if (listenSocket_ < 0) return false;
+    
+    running_ = true;
+    {
+        std::lock_guard<std::mutex> lock(reaperMutex_);
+        reaperRunning_ = true;
+    }
+    reaperThread_ = std::thread(&UCDAPSessionHost::ReaperLoop, this);
+    hostThread_ = std::thread(&UCDAPSessionHost::HostLoop, this);
+    return true;
+}
+
+void UCDAPSessionHost::Stop() {
+    running_ = false;
+    Wake();
+    
+    if (hostThread_.joinable()) {
+        hostThread_.join();
+    }
+    
+    std::vector<int> ids;
+    {
+        std::lock_guard<std::mutex> lock(sessionsMutex_);
+        for (const auto& entry : sessions_) {
+            ids.push_back(entry.first);
+        }
+    }
+    for (int id : ids) {
+        EndSession(id);
+    }
+    
+    // Ends the sessions still queued before the reaper exits
+    {
+        std::lock_guard<std::mutex> lock(reaperMutex_);
+        reaperRunning_ = false;
+    }
+    reaperCv_.notify_all();
+    if (reaperThread_.joinable()) {
+        reaperThread_.join();
+    }
+    
+    if (listenSocket_ >= 0) {
+        CloseSocket(listenSocket_);
+        listenSocket_ = -1;
+#ifdef _WIN32
+        WSACleanup();
+#endif
+    }
+    
+#ifndef _WIN32
+    for (int& fd : wakeFds_) {
+        if (fd >= 0) close(fd);
+        fd = -1;
+    }
+#endif
+}
+
+size_t UCDAPSessionHost::GetSessionCount() const {
+    std::lock_guard<std::mutex> lock(sessionsMutex_);
+    return sessions_.size();
+}
+
+// ============================================================================
+// HOST LOOP
+// ============================================================================
+
+void UCDAPSessionHost::HostLoop() {
+    std::vector<pollfd> fds;
+    std::vector<Session*> polled;
+    std::vector<int> broken;
+    
+    while (running_) {
+        // The listener, the wake pipe and, in EventLoop mode, every client.
+        // Rebuilt each round: sessions only change on this thread
+        fds.clear();
+        polled.clear();
+        fds.push_back({ listenSocket_, POLLIN, 0 });
+        if (wakeFds_[0] >= 0) {
+            fds.push_back({ wakeFds_[0], POLLIN, 0 });
+        }
+        size_t firstClient = fds.size();
+        if (config_.mode == DAPSessionMode::EventLoop) {
+            for (const auto& entry : sessions_) {
+                fds.push_back({ entry.second->socket, POLLIN, 0 });
+                polled.push_back(entry.second.get());
+            }
+        }
+        
+#ifdef _WIN32
+        int ready = WSAPoll(fds.data(), static_cast<ULONG>(fds.size()), HOST_POLL_INTERVAL_MS);
+#else
+        int ready = poll(fds.data(), fds.size(), -1);
+        if (ready < 0 && errno == EINTR) continue;
+#endif
+        if (ready < 0) {
+            if (onError) onError("DAP session host: poll failed");
+            break;
+        }
+        
+#ifndef _WIN32
+        if (firstClient > 1 && (fds[1].revents & POLLIN)) {
+            char drain[64];
+            while (read(wakeFds_[0], drain, sizeof(drain)) > 0) {}
+        }
+#endif
+        
+        broken.clear();
+        for (size_t i = 0; i < polled.size(); i++) {
+            if (fds[firstClient + i].revents & (POLLIN | POLLHUP | POLLERR)) {
+                if (!ReadClient(*polled[i])) broken.push_back(polled[i]->id);
+            }
+        }
+        for (int id : broken) {
+            EndSession(id);
+        }
+        
+        if (fds[0].revents & POLLIN) {
+            AcceptClient();
+        }
+        EndFinishedSessions();
+    }
+}
+
+void UCDAPSessionHost::AcceptClient() {
+    int client = static_cast<int>(accept(listenSocket_, nullptr, nullptr));
+    if (client < 0) return;
+    
+    if (static_cast<int>(sessions_.size()) >= config_.maxSessions) {
+        CloseSocket(client);
+        if (onError) onError("DAP session host: client refused, maxSessions reached");
+        return;
+    }
+    
+    // A blocked write stalls the session's workers (and, in EventLoop
+    // mode, this thread answering its pause); give up on the client instead
+#ifdef _WIN32
+    DWORD timeout = static_cast<DWORD>(config_.sendTimeoutMs);
+    setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, (const char*)&timeout, sizeof(timeout));
+#else
+    struct timeval timeout;
+    timeout.tv_sec = config_.sendTimeoutMs / 1000;
+    timeout.tv_usec = (config_.sendTimeoutMs % 1000) * 1000;
+    setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+#endif
+    
+    auto session = std::make_unique<Session>();
+    session->id = nextSessionId_++;
+    session->socket = client;
+    session->debugManager = UCDebugManager::CreateIsolated();
+    session->debugManager->Initialize(config_.debugConfig);
+    
+    DAPServerConfig serverConfig;
+    serverConfig.transport = DAPTransport::Socket;
+    serverConfig.workerCount = config_.workersPerSession;
+    serverConfig.maxMessageSize = config_.maxMessageSize;
+    serverConfig.logMessages = config_.logMessages;
+    
+    session->server = std::make_unique<UCDAPServer>();
+    session->server->InitializeConnected(serverConfig, client);
+    session->server->SetDebugManager(session->debugManager.get());
+    
+    // A session's own reader cannot stop it (Stop joins the reader), so
+    // it flags the session and this thread ends it
+    Session* added = session.get();
+    if (config_.mode == DAPSessionMode::ThreadPerSession) {
+        session->server->onSessionEnded = [this, added] {
+            added->ended = true;
+            Wake();
+        };
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(sessionsMutex_);
+        sessions_[added->id] = std::move(session);
+    }
+    
+    if (onSessionStarted) {
+        onSessionStarted(added->id, *added->server);
+    }
+    
+    bool started = config_.mode == DAPSessionMode::EventLoop
+        ? added->server->StartWithExternalInput()
+        : added->server->Start();
+    if (!started) {
+        EndSession(added->id);
+    }
+}
+
+bool UCDAPSessionHost::ReadClient(Session& session) {
+    char chunk[READ_CHUNK_SIZE];
+    long received;
+#ifdef _WIN32
+    received = recv(session.socket, chunk, static_cast<int>(sizeof(chunk)), 0);
+#else
+    do {
+        received = recv(session.socket, chunk, sizeof(chunk), 0);
+    } while (received < 0 && errno == EINTR);
+    if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;
+#endif
+    
+    if (received <= 0) {
+        return false;
+    }
+    return session.server->FeedInput(chunk, static_cast<size_t>(received));
+}
+
+void UCDAPSessionHost::EndSession(int sessionId) {
+    std::unique_ptr<Session> session;
+    {
+        std::lock_guard<std::mutex> lock(sessionsMutex_);
+        auto it = sessions_.find(sessionId);
+        if (it == sessions_.end()) return;
+        session = std::move(it->second);
+        sessions_.erase(it);
+    }
+    
+    // Stopping waits for the session's workers and its debugger, which
+    // may take seconds; the host thread serves every other session
+    {
+        std::lock_guard<std::mutex> lock(reaperMutex_);
+        if (reaperRunning_) {
+            endedSessions_.push_back(std::move(session));
+            reaperCv_.notify_one();
+            return;
+        }
+    }
+    ReapSession(*session);
+}
+
+void UCDAPSessionHost::ReapSession(Session& session) {
+    // Server first: its workers may still be calling into the manager.
+    // The manager's shutdown terminates the debugger, whose last events
+    // reach a stopped server and go nowhere
+    session.server->Stop();
+    session.debugManager.reset();
+    session.server.reset();
+    
+    if (onSessionEnded) {
+        onSessionEnded(session.id);
+    }
+}
+
+void UCDAPSessionHost::ReaperLoop() {
+    std::unique_lock<std::mutex> lock(reaperMutex_);
+    for (;;) {
+        while (reaperRunning_ && endedSessions_.empty()) {
+            reaperCv_.wait(lock);
+        }
+        if (endedSessions_.empty()) return;
+        
+        std::unique_ptr<Session> session = std::move(endedSessions_.front());
+        endedSessions_.pop_front();
+        lock.unlock();
+        
+        ReapSession(*session);
+        session.reset();
+        
+        lock.lock();
+    }
+}
+
+void UCDAPSessionHost::EndFinishedSessions() {
+    std::vector<int> finished;
+    for (const auto& entry : sessions_) {
+        if (entry.second->ended) finished.push_back(entry.first);
+    }
+    for (int id : finished) {
+        EndSession(id);
+    }
+}
+
+void UCDAPSessionHost::Wake() {
+#ifndef _WIN32
+    if (wakeFds_[1] >= 0) {
+        char byte = 1;
+        ssize_t written = write(wakeFds_[1], &byte, 1);
+        (void)written;                  // Full pipe: a wake-up is already pending
+    }
+#endif
+}
+
+} // namespace DAP
+} // namespace IDE
+} // namespace UltraCanvas
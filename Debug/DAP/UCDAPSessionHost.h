@@ -0,0 +1,149 @@
+// Apps/IDE/Debug/DAP/UCDAPSessionHost.h
+// Multi-client Debug Adapter Protocol listener for ULTRA IDE
+// Version: 1.0.0
+// Last Modified: 2025-12-28
+// Author: UltraCanvas Framework / ULTRA IDE
+#pragma once
+
+#include "UCDAPServer.h"
+#include <string>
+#include <vector>
+#include <map>
+#include <deque>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+namespace UltraCanvas {
+namespace IDE {
+namespace DAP {
+
+/**
+ * @brief How a session host reads its clients
+ */
+enum class DAPSessionMode {
+    EventLoop,          // One thread polls every client and feeds its session
+    ThreadPerSession    // Each session reads its client on its own thread
+};
+
+/**
+ * @brief Session host configuration
+ */
+struct DAPSessionHostConfig {
+    int port = 4711;
+    DAPSessionMode mode = DAPSessionMode::EventLoop;
+    int maxSessions = 64;               // Further clients are disconnected at once
+    int workersPerSession = 2;          // Request workers of each session
+    size_t maxMessageSize = 16 * 1024 * 1024;  // A larger message ends its session
+    int sendTimeoutMs = 10000;          // A client not reading this long is dropped
+    int listenBacklog = 16;
+    bool logMessages = false;
+    DebugManagerConfig debugConfig = DebugManagerConfig::Default();
+};
+
+/**
+ * @brief Serves many DAP clients over one listening socket
+ *
+ * Every accepted client gets a session of its own: a UCDAPServer with its
+ * own debug manager, and with it its own breakpoints, frame ids, variable
+ * references and debugger process. Sessions share nothing but the
+ * listener, so one adapter process can debug a fleet of processes at once.
+ *
+ * In EventLoop mode the host thread reads all clients and hands the bytes
+ * to their sessions, so an idle session costs no thread beyond its
+ * workers. ThreadPerSession gives each session a blocking reader instead.
+ */
+class UCDAPSessionHost {
+public:
+    UCDAPSessionHost();
+    ~UCDAPSessionHost();
+    
+    // =========================================================================
+    // HOST LIFECYCLE
+    // =========================================================================
+    
+    /**
+     * @brief Bind the listening socket
+     */
+    bool Initialize(const DAPSessionHostConfig& config);
+    
+    /**
+     * @brief Start accepting clients
+     */
+    bool Start();
+    
+    /**
+     * @brief Stop accepting and end every session
+     */
+    void Stop();
+    
+    /**
+     * @brief Check if the host is running
+     */
+    bool IsRunning() const { return running_; }
+    
+    /**
+     * @brief Number of connected clients
+     */
+    size_t GetSessionCount() const;
+    
+    // =========================================================================
+    // CALLBACKS
+    // =========================================================================
+    
+    // Called on the host thread before the session starts serving. The
+    // server's callbacks are free to set, except onSessionEnded
+    // (the host's own)
+    std::function<void(int sessionId, UCDAPServer& server)> onSessionStarted;
+    // Called on the reaper thread once the session's debugger is gone
+    std::function<void(int sessionId)> onSessionEnded;
+    std::function<void(const std::string&)> onError;
+    
+private:
+    /**
+     * @brief One connected client
+     */
+    struct Session {
+        int id = 0;
+        int socket = -1;
+        std::unique_ptr<UCDAPServer> server;
+        std::unique_ptr<UCDebugManager> debugManager;   // Destroyed before server
+        std::atomic<bool> ended{false};                 // Set by the session's reader
+    };
+    
+    void HostLoop();
+    void AcceptClient();
+    bool ReadClient(Session& session);
+    void EndSession(int sessionId);
+    void EndFinishedSessions();
+    void ReapSession(Session& session);
+    void ReaperLoop();
+    void Wake();
+    
+    DAPSessionHostConfig config_;
+    std::atomic<bool> running_{false};
+    std::thread hostThread_;
+    
+    int listenSocket_ = -1;
+    int wakeFds_[2] = { -1, -1 };       // Self-pipe that interrupts the host's poll
+    
+    // Added and removed on the host thread only; the mutex is for readers
+    std::map<int, std::unique_ptr<Session>> sessions_;
+    mutable std::mutex sessionsMutex_;
+    int nextSessionId_ = 1;
+    
+    // Ended sessions are stopped here, off the host thread: stopping one
+    // waits for its workers and its debugger
+    std::thread reaperThread_;
+    std::mutex reaperMutex_;
+    std::condition_variable reaperCv_;
+    std::deque<std::unique_ptr<Session>> endedSessions_;
+    bool reaperRunning_ = false;
+};
+
+} // namespace DAP
+} // namespace IDE
+} // namespace UltraCanvas
@@ -5,8 +5,11 @@
 // Author: UltraCanvas Framework / ULTRA IDE
 
 #include "UCDAPTypes.h"
-#include <sstream>
-#include <iomanip>
+#include <array>
+#include <tuple>
+#include <cmath>
+#include <charconv>
+#include <cstring>
 
 namespace UltraCanvas {
 namespace IDE {
@@ -16,74 +19,594 @@ namespace DAP {
 // JSON HELPERS
 // ============================================================================
 
-static std::string EscapeJsonString(const std::string& s) {
-    std::ostringstream o;
-    for (char c : s) {
-        switch (c) {
-            case '"': o << "\\\""; break;
-            case '\\': o << "\\\\"; break;
-            case '\b': o << "\\b"; break;
-            case '\f': o << "\\f"; break;
-            case '\n': o << "\\n"; break;
-            case '\r': o << "\\r"; break;
-            case '\t': o << "\\t"; break;
+static int GetInt(const JsonObject& obj, const std::string& key, int def = 0) {
+    if (auto value = obj.Get<int64_t>(key)) return static_cast<int>(*value);
+    return def;
+}
+
+static std::string GetString(const JsonObject& obj, const std::string& key) {
+    return obj.Get<std::string>(key).value_or(std::string());
+}
+
+// ============================================================================
+// JSON WRITER
+// ============================================================================
+
+namespace {
+
+/**
+ * @brief Escape for each byte: the character that follows the backslash,
+ * 'u' for a \u00XX escape, or 0 if the byte is copied as is
+ */
+constexpr std::array<char, 256> MakeEscapeTable() {
+    std::array<char, 256> table{};
+    for (int c = 0; c < 0x20; c++) table[c] = 'u';
+    table['"'] = '"';
+    table['\\'] = '\\';
+    table['\b'] = 'b';
+    table['\f'] = 'f';
+    table['\n'] = 'n';
+    table['\r'] = 'r';
+    table['\t'] = 't';
+    return table;
+}
+
+constexpr std::array<char, 256> ESCAPES = MakeEscapeTable();
+
+/**
+ * @brief Whether any of eight bytes is a quote, a backslash or a control
+ * character (bytes of multi-byte UTF-8 sequences never are)
+ */
+inline bool NeedsEscape(uint64_t word) {
+    constexpr uint64_t ones = 0x0101010101010101ULL;
+    constexpr uint64_t highs = 0x8080808080808080ULL;
+    uint64_t quote = word ^ (ones * '"');
+    uint64_t backslash = word ^ (ones * '\\');
+    uint64_t found = ((quote - ones) & ~quote) |
+                     ((backslash - ones) & ~backslash) |
+                     ((word - ones * 0x20) & ~word);
+    return (found & highs) != 0;
+}
+
+/**
+ * @brief memcpy for the short copies that dominate, without a library call
+ */
+inline void CopyBytes(char* to, const char* from, size_t size) {
+    if (size >= 8 && size <= 16) {
+        uint64_t head, tail;
+        std::memcpy(&head, from, 8);
+        std::memcpy(&tail, from + size - 8, 8);
+        std::memcpy(to, &head, 8);
+        std::memcpy(to + size - 8, &tail, 8);
+    } else if (size >= 4 && size < 8) {
+        uint32_t head, tail;
+        std::memcpy(&head, from, 4);
+        std::memcpy(&tail, from + size - 4, 4);
+        std::memcpy(to, &head, 4);
+        std::memcpy(to + size - 4, &tail, 4);
+    } else if (size < 4) {
+        for (size_t i = 0; i < size; i++) to[i] = from[i];
+    } else {
+        std::memcpy(to, from, size);
+    }
+}
+
+} // namespace
+
+void JsonWriter::Flush() {
+    out_.append(stage_, staged_);
+    staged_ = 0;
+}
+
+char* JsonWriter::Reserve(size_t size) {
+    if (staged_ + size > sizeof(stage_)) Flush();
+    return stage_ + staged_;
+}
+
+void JsonWriter::Put(char c) {
+    *Reserve(1) = c;
+    staged_++;
+}
+
+void JsonWriter::Put(const char* data, size_t size) {
+    if (size > sizeof(stage_) / 2) {
+        Flush();
+        out_.append(data, size);
+        return;
+    }
+    CopyBytes(Reserve(size), data, size);
+    staged_ += size;
+}
+
+void JsonWriter::Open(char c) {
+    char* p = Reserve(2);
+    if (needComma_) *p++ = ',';
+    *p++ = c;
+    staged_ = p - stage_;
+}
+
+void JsonWriter::Close(char c) {
+    Put(c);
+    EndValue();
+}
+
+void JsonWriter::EndValue() {
+    needComma_ = true;
+    if (depth_ == 0) Flush();
+}
+
+void JsonWriter::BeginObject() {
+    Open('{');
+    depth_++;
+    needComma_ = false;
+}
+
+void JsonWriter::EndObject() {
+    depth_--;
+    Close('}');
+}
+
+void JsonWriter::BeginArray() {
+    Open('[');
+    depth_++;
+    needComma_ = false;
+}
+
+void JsonWriter::EndArray() {
+    depth_--;
+    Close(']');
+}
+
+void JsonWriter::Key(std::string_view key) {
+    // Keys are short names that rarely need escaping: emit ,"key": at once
+    if (key.size() <= 64 && CleanPrefix(key) == key.size()) {
+        char* p = Reserve(key.size() + 4);
+        if (needComma_) *p++ = ',';
+        *p++ = '"';
+        CopyBytes(p, key.data(), key.size());
+        p += key.size();
+        *p++ = '"';
+        *p++ = ':';
+        staged_ = p - stage_;
+    } else {
+        Open('"');
+        AppendEscaped(key);
+        Put("\":", 2);
+    }
+    needComma_ = false;
+}
+
+void JsonWriter::String(std::string_view value) {
+    Open('"');
+    AppendEscaped(value);
+    Close('"');
+}
+
+void JsonWriter::Int(int64_t value) {
+    char* p = Reserve(24);
+    if (needComma_) *p++ = ',';
+    p = std::to_chars(p, p + 21, value).ptr;
+    staged_ = p - stage_;
+    EndValue();
+}
+
+void JsonWriter::Double(double value) {
+    if (!std::isfinite(value)) {
+        Null();
+        return;
+    }
+    char* p = Reserve(40);
+    if (needComma_) *p++ = ',';
+    p = std::to_chars(p, p + 38, value).ptr;
+    staged_ = p - stage_;
+    EndValue();
+}
+
+void JsonWriter::Bool(bool value) {
+    if (needComma_) Put(',');
+    if (value) Put("true", 4);
+    else Put("false", 5);
+    EndValue();
+}
+
+void JsonWriter::Null() {
+    if (needComma_) Put(',');
+    Put("null", 4);
+    EndValue();
+}
+
+void JsonWriter::Raw(std::string_view json) {
+    if (needComma_) Put(',');
+    Put(json.data(), json.size());
+    EndValue();
+}
+
+void JsonWriter::Value(const JsonValue& value) {
+    std::visit([this](auto&& arg) {
+        using T = std::decay_t<decltype(arg)>;
+        if constexpr (std::is_same_v<T, std::nullptr_t>) {
+            Null();
+        } else if constexpr (std::is_same_v<T, bool>) {
+            Bool(arg);
+        } else if constexpr (std::is_same_v<T, int64_t>) {
+            Int(arg);
+        } else if constexpr (std::is_same_v<T, double>) {
+            Double(arg);
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            String(arg);
+        } else if constexpr (std::is_same_v<T, std::vector<JsonObject>>) {
+            BeginArray();
+            for (const auto& element : arg) {
+                const JsonValue* inner = element.Unbox();
+                if (inner) Value(*inner);
+                else Null();
+            }
+            EndArray();
+        } else {
+            BeginObject();
+            for (const auto& member : arg) {
+                Key(member.first);
+                const JsonValue* inner = member.second.Unbox();
+                if (inner) Value(*inner);
+                else Null();
+            }
+            EndObject();
+        }
+    }, value);
+}
+
+void JsonWriter::Object(const JsonObject& object) {
+    BeginObject();
+    for (const auto& prop : object.properties) {
+        Key(prop.first);
+        Value(prop.second);
+    }
+    EndObject();
+}
+
+size_t JsonWriter::CleanPrefix(std::string_view text) {
+    const char* data = text.data();
+    size_t size = text.size();
+    size_t i = 0;
+    
+    // Eight bytes at a time; the tail is covered by one overlapping word
+    uint64_t word;
+    for (; i + 8 <= size; i += 8) {
+        std::memcpy(&word, data + i, sizeof(word));
+        if (NeedsEscape(word)) break;
+    }
+    if (i + 8 > size && size >= 8) {
+        std::memcpy(&word, data + size - 8, sizeof(word));
+        if (!NeedsEscape(word)) return size;
+    }
+    
+    while (i < size && !ESCAPES[static_cast<unsigned char>(data[i])]) i++;
+    return i;
+}
+
+void JsonWriter::AppendEscaped(std::string_view text) {
+    size_t clean = CleanPrefix(text);
+    Put(text.data(), clean);
+    
+    // Something needs escaping; the rest goes byte by byte
+    static const char hex[] = "0123456789abcdef";
+    size_t run = clean;
+    for (size_t i = clean; i < text.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        char escape = ESCAPES[c];
+        if (!escape) continue;
+        
+        Put(text.data() + run, i - run);
+        char sequence[6] = {'\\', escape, '0', '0', hex[c >> 4], hex[c & 0x0F]};
+        Put(sequence, escape == 'u' ? 6 : 2);
+        run = i + 1;
+    }
+    Put(text.data() + run, text.size() - run);
+}
+
+namespace {
+
+/**
+ * @brief Recursive-descent JSON reader over a string_view
+ *
+ * Strict RFC 8259 syntax; nesting is capped so hostile input cannot
+ * exhaust the stack. Integers without fraction or exponent that fit in
+ * 64 bits become int64_t, other numbers double.
+ */
+class JsonReader {
+public:
+    explicit JsonReader(std::string_view text) : text_(text) {}
+    
+    bool ReadDocument(JsonObject& result) {
+        SkipWhitespace();
+        if (!ReadObject(result.properties, 0)) return false;
+        SkipWhitespace();
+        return pos_ == text_.size();
+    }
+    
+private:
+    static constexpr int kMaxDepth = 64;
+    
+    void SkipWhitespace() {
+        while (pos_ < text_.size()) {
+            char c = text_[pos_];
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') break;
+            pos_++;
+        }
+    }
+    
+    bool Consume(char expected) {
+        SkipWhitespace();
+        if (pos_ < text_.size() && text_[pos_] == expected) {
+            pos_++;
+            return true;
+        }
+        return false;
+    }
+    
+    bool ReadLiteral(std::string_view literal) {
+        if (text_.compare(pos_, literal.size(), literal) != 0) return false;
+        pos_ += literal.size();
+        return true;
+    }
+    
+    bool ReadObject(std::map<std::string, JsonValue>& properties, int depth) {
+        if (depth > kMaxDepth || !Consume('{')) return false;
+        if (Consume('}')) return true;
+        
+        for (;;) {
+            std::string key;
+            SkipWhitespace();
+            if (!ReadString(key) || !Consume(':')) return false;
+            
+            JsonValue value;
+            if (!ReadValue(value, depth + 1)) return false;
+            properties[std::move(key)] = std::move(value);
+            
+            if (Consume(',')) continue;
+            return Consume('}');
+        }
+    }
+    
+    bool ReadValue(JsonValue& value, int depth) {
+        SkipWhitespace();
+        if (pos_ >= text_.size()) return false;
+        
+        switch (text_[pos_]) {
+            case '{': {
+                std::map<std::string, JsonValue> properties;
+                if (!ReadObject(properties, depth)) return false;
+                std::map<std::string, JsonObject> members;
+                for (auto& prop : properties) {
+                    members.emplace(prop.first, JsonObject::Box(std::move(prop.second)));
+                }
+                value = std::move(members);
+                return true;
+            }
+            case '[': {
+                if (depth > kMaxDepth) return false;
+                pos_++;
+                std::vector<JsonObject> elements;
+                if (!Consume(']')) {
+                    for (;;) {
+                        JsonValue element;
+                        if (!ReadValue(element, depth + 1)) return false;
+                        elements.push_back(JsonObject::Box(std::move(element)));
+                        if (Consume(',')) continue;
+                        if (!Consume(']')) return false;
+                        break;
+                    }
+                }
+                value = std::move(elements);
+                return true;
+            }
+            case '"': {
+                std::string text;
+                if (!ReadString(text)) return false;
+                value = std::move(text);
+                return true;
+            }
+            case 't':
+                value = true;
+                return ReadLiteral("true");
+            case 'f':
+                value = false;
+                return ReadLiteral("false");
+            case 'n':
+                value = nullptr;
+                return ReadLiteral("null");
             default:
-                if ('\x00' <= c && c <= '\x1f') {
-                    o << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c);
-                } else {
-                    o << c;
+                return ReadNumber(value);
+        }
+    }
+    
+    bool ReadNumber(JsonValue& value) {
+        size_t start = pos_;
+        if (pos_ < text_.size() && text_[pos_] == '-') pos_++;
+        size_t digits = pos_;
+        while (pos_ < text_.size() && text_[pos_] >= '0' && text_[pos_] <= '9') pos_++;
+        if (pos_ == digits || (text_[digits] == '0' && pos_ - digits > 1)) return false;
+        
+        bool integral = true;
+        if (pos_ < text_.size() && text_[pos_] == '.') {
+            integral = false;
+            size_t fraction = ++pos_;
+            while (pos_ < text_.size() && text_[pos_] >= '0' && text_[pos_] <= '9') pos_++;
+            if (pos_ == fraction) return false;
+        }
+        if (pos_ < text_.size() && (text_[pos_] == 'e' || text_[pos_] == 'E')) {
+            integral = false;
+            pos_++;
+            if (pos_ < text_.size() && (text_[pos_] == '+' || text_[pos_] == '-')) pos_++;
+            size_t exponent = pos_;
+            while (pos_ < text_.size() && text_[pos_] >= '0' && text_[pos_] <= '9') pos_++;
+            if (pos_ == exponent) return false;
+        }
+        
+        const char* first = text_.data() + start;
+        const char* last = text_.data() + pos_;
+        if (integral) {
+            int64_t number = 0;
+            auto result = std::from_chars(first, last, number);
+            if (result.ec == std::errc() && result.ptr == last) {
+                value = number;
+                return true;
+            }
+        }
+        
+        // strtod wants a terminated string; numbers are short
+        std::string number(first, last);
+        value = std::strtod(number.c_str(), nullptr);
+        return true;
+    }
+    
+    static void AppendUtf8(std::string& out, uint32_t codePoint) {
+        if (codePoint < 0x80) {
+            out += static_cast<char>(codePoint);
+        } else if (codePoint < 0x800) {
+            out += static_cast<char>(0xC0 | (codePoint >> 6));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else if (codePoint < 0x10000) {
+            out += static_cast<char>(0xE0 | (codePoint >> 12));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (codePoint >> 18));
+            out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+    }
+    
+    bool ReadHex4(uint32_t& result) {
+        if (pos_ + 4 > text_.size()) return false;
+        auto parsed = std::from_chars(text_.data() + pos_, text_.data() + pos_ + 4, result, 16);
+        if (parsed.ptr != text_.data() + pos_ + 4) return false;
+        pos_ += 4;
+        return true;
+    }
+    
+    bool ReadString(std::string& out) {
+        if (pos_ >= text_.size() || text_[pos_] != '"') return false;
+        pos_++;
+        
+        for (;;) {
+            // Copy the run up to the next quote or escape in one go
+            size_t run = pos_;
+            while (pos_ < text_.size() && text_[pos_] != '"' && text_[pos_] != '\\') {
+                if (static_cast<unsigned char>(text_[pos_]) < 0x20) return false;
+                pos_++;
+            }
+            out.append(text_.data() + run, pos_ - run);
+            if (pos_ >= text_.size()) return false;
+            
+            if (text_[pos_++] == '"') return true;
+            if (pos_ >= text_.size()) return false;
+            
+            char escape = text_[pos_++];
+            switch (escape) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    uint32_t codePoint;
+                    if (!ReadHex4(codePoint)) return false;
+                    if (codePoint >= 0xD800 && codePoint < 0xDC00 &&
+                        text_.compare(pos_, 2, "\\u") == 0) {
+                        // Surrogate pair
+                        size_t mark = pos_;
+                        uint32_t low;
+                        pos_ += 2;
+                        if (ReadHex4(low) && low >= 0xDC00 && low < 0xE000) {
+                            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                        } else {
+                            pos_ = mark;
+                        }
+                    }
+                    AppendUtf8(out, codePoint);
+                    break;
                 }
+                default:
+                    return false;
+            }
         }
     }
-    return o.str();
-}
+    
+    std::string_view text_;
+    size_t pos_ = 0;
+};
+
+} // namespace
 
 // ============================================================================
 // PROTOCOL MESSAGES
 // ============================================================================
 
 std::string ProtocolMessage::ToJson() const {
-    std::ostringstream ss;
-    ss << "{\"seq\":" << seq << ",\"type\":\"" << type << "\"";
-    return ss.str();
+    std::string json;
+    JsonWriter writer(json);
+    WriteJson(writer);
+    return json;
+}
+
+static void WriteMessageHeader(JsonWriter& writer, int sequence, const std::string& type) {
+    writer.BeginObject();
+    writer.Key("seq");
+    writer.Int(sequence);
+    writer.Key("type");
+    writer.String(type);
 }
 
-std::string Request::ToJson() const {
-    std::ostringstream ss;
-    ss << ProtocolMessage::ToJson();
-    ss << ",\"command\":\"" << command << "\"";
+void Request::WriteJson(JsonWriter& writer, int sequence) const {
+    WriteMessageHeader(writer, sequence, type);
+    writer.Key("command");
+    writer.String(command);
     if (!arguments.properties.empty()) {
-        ss << ",\"arguments\":" << arguments.ToJson();
+        writer.Key("arguments");
+        writer.Object(arguments);
     }
-    ss << "}";
-    return ss.str();
+    writer.EndObject();
 }
 
-std::string Response::ToJson() const {
-    std::ostringstream ss;
-    ss << ProtocolMessage::ToJson();
-    ss << ",\"request_seq\":" << request_seq;
-    ss << ",\"success\":" << (success ? "true" : "false");
-    ss << ",\"command\":\"" << command << "\"";
+void Response::WriteJson(JsonWriter& writer, int sequence) const {
+    WriteMessageHeader(writer, sequence, type);
+    writer.Key("request_seq");
+    writer.Int(request_seq);
+    writer.Key("success");
+    writer.Bool(success);
+    writer.Key("command");
+    writer.String(command);
     if (!success && !message.empty()) {
-        ss << ",\"message\":\"" << EscapeJsonString(message) << "\"";
+        writer.Key("message");
+        writer.String(message);
     }
-    if (!body.properties.empty()) {
-        ss << ",\"body\":" << body.ToJson();
+    if (!rawBody.empty()) {
+        writer.Key("body");
+        writer.Raw(rawBody);
+    } else if (!body.properties.empty()) {
+        writer.Key("body");
+        writer.Object(body);
     }
-    ss << "}";
-    return ss.str();
+    writer.EndObject();
 }
 
-std::string Event::ToJson() const {
-    std::ostringstream ss;
-    ss << ProtocolMessage::ToJson();
-    ss << ",\"event\":\"" << event << "\"";
-    if (!body.properties.empty()) {
-        ss << ",\"body\":" << body.ToJson();
+void Event::WriteJson(JsonWriter& writer, int sequence) const {
+    WriteMessageHeader(writer, sequence, type);
+    writer.Key("event");
+    writer.String(event);
+    if (!rawBody.empty()) {
+        writer.Key("body");
+        writer.Raw(rawBody);
+    } else if (!body.properties.empty()) {
+        writer.Key("body");
+        writer.Object(body);
     }
-    ss << "}";
-    return ss.str();
+    writer.EndObject();
 }
 
 // ============================================================================
@@ -91,31 +614,76 @@ std::string Event::ToJson() const {
 // ============================================================================
 
 std::string JsonObject::ToJson() const {
-    std::ostringstream ss;
-    ss << "{";
-    bool first = true;
+    std::string json;
+    JsonWriter writer(json);
+    writer.Object(*this);
+    return json;
+}
+
+JsonObject JsonObject::FromJson(const std::string& json) {
+    JsonObject result;
+    Parse(json, result);
+    return result;
+}
+
+bool JsonObject::Parse(std::string_view json, JsonObject& result) {
+    result.properties.clear();
+    JsonReader reader(json);
+    if (!reader.ReadDocument(result)) {
+        result.properties.clear();
+        return false;
+    }
+    return true;
+}
+
+JsonObject JsonObject::Box(JsonValue value) {
+    JsonObject box;
+    box.properties.emplace(std::string(), std::move(value));
+    return box;
+}
+
+const JsonValue* JsonObject::Unbox() const {
+    auto it = properties.find(std::string());
+    return it != properties.end() ? &it->second : nullptr;
+}
+
+JsonValue JsonObject::ToValue() const {
+    std::map<std::string, JsonObject> members;
     for (const auto& prop : properties) {
-        if (!first) ss << ",";
-        first = false;
-        ss << "\"" << prop.first << "\":";
-        
-        std::visit([&ss](auto&& arg) {
-            using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, std::nullptr_t>) {
-                ss << "null";
-            } else if constexpr (std::is_same_v<T, bool>) {
-                ss << (arg ? "true" : "false");
-            } else if constexpr (std::is_same_v<T, int64_t>) {
-                ss << arg;
-            } else if constexpr (std::is_same_v<T, double>) {
-                ss << arg;
-            } else if constexpr (std::is_same_v<T, std::string>) {
-                ss << "\"" << EscapeJsonString(arg) << "\"";
+        members.emplace(prop.first, Box(prop.second));
+    }
+    return members;
+}
+
+JsonObject JsonObject::AsObject(const JsonValue& value) {
+    JsonObject object;
+    if (const auto* members = std::get_if<std::map<std::string, JsonObject>>(&value)) {
+        for (const auto& member : *members) {
+            if (const JsonValue* inner = member.second.Unbox()) {
+                object.properties.emplace(member.first, *inner);
             }
-        }, prop.second);
+        }
+    }
+    return object;
+}
+
+JsonObject JsonObject::GetObject(const std::string& key) const {
+    auto it = properties.find(key);
+    return it != properties.end() ? AsObject(it->second) : JsonObject();
+}
+
+std::vector<JsonValue> JsonObject::GetArray(const std::string& key) const {
+    std::vector<JsonValue> values;
+    auto it = properties.find(key);
+    if (it == properties.end()) return values;
+    if (const auto* elements = std::get_if<std::vector<JsonObject>>(&it->second)) {
+        values.reserve(elements->size());
+        for (const auto& element : *elements) {
+            const JsonValue* inner = element.Unbox();
+            values.push_back(inner ? *inner : JsonValue(nullptr));
+        }
     }
-    ss << "}";
-    return ss.str();
+    return values;
 }
 
 void JsonObject::Set(const std::string& key, JsonValue value) {
@@ -161,22 +729,296 @@ JsonObject Capabilities::ToJson() const {
 }
 
 // ============================================================================
-// SOURCE
+// FIELD TABLES
 // ============================================================================
 
-JsonObject Source::ToJson() const {
+namespace {
+
+/**
+ * @brief Whether a field is written when it holds its empty value
+ */
+enum class FieldMode {
+    Always,
+    OmitEmpty                           // Skip "", 0 (or less), false, empty lists
+};
+
+/**
+ * @brief One JSON property of a DAP struct: its name and the member holding it
+ *
+ * Each type lists its fields once; WriteJson() streams them, ToJson()
+ * builds a JsonObject and FromJson() reads one back from the same list,
+ * so they never disagree.
+ */
+template<typename T, typename M>
+struct Field {
+    std::string_view name;
+    M T::* member;
+    FieldMode mode;
+};
+
+template<typename T, typename M>
+constexpr Field<T, M> MakeField(std::string_view name, M T::* member,
+                                FieldMode mode = FieldMode::Always) {
+    return Field<T, M>{name, member, mode};
+}
+
+bool IsEmptyField(const std::string& value) { return value.empty(); }
+bool IsEmptyField(int value) { return value <= 0; }
+bool IsEmptyField(bool value) { return !value; }
+bool IsEmptyField(const std::vector<std::string>& value) { return value.empty(); }
+bool IsEmptyField(const Source& value) {
+    return value.name.empty() && value.path.empty() && value.sourceReference <= 0;
+}
+
+void WriteFieldValue(JsonWriter& writer, const std::string& value) { writer.String(value); }
+void WriteFieldValue(JsonWriter& writer, int value) { writer.Int(value); }
+void WriteFieldValue(JsonWriter& writer, bool value) { writer.Bool(value); }
+void WriteFieldValue(JsonWriter& writer, const Source& value) { value.WriteJson(writer); }
+void WriteFieldValue(JsonWriter& writer, const std::vector<std::string>& value) {
+    writer.BeginArray();
+    for (const auto& item : value) writer.String(item);
+    writer.EndArray();
+}
+
+JsonValue FieldValue(const std::string& value) { return value; }
+JsonValue FieldValue(int value) { return static_cast<int64_t>(value); }
+JsonValue FieldValue(bool value) { return value; }
+JsonValue FieldValue(const Source& value) { return value.ToJson().ToValue(); }
+JsonValue FieldValue(const std::vector<std::string>& value) {
+    std::vector<JsonObject> items;
+    items.reserve(value.size());
+    for (const auto& item : value) items.push_back(JsonObject::Box(item));
+    return items;
+}
+
+// A value of the wrong type leaves the member as it was
+void ReadFieldValue(const JsonValue& value, std::string& out) {
+    if (const auto* text = std::get_if<std::string>(&value)) out = *text;
+}
+void ReadFieldValue(const JsonValue& value, int& out) {
+    if (const auto* number = std::get_if<int64_t>(&value)) out = static_cast<int>(*number);
+    else if (const auto* real = std::get_if<double>(&value)) out = static_cast<int>(*real);
+}
+void ReadFieldValue(const JsonValue& value, bool& out) {
+    if (const auto* flag = std::get_if<bool>(&value)) out = *flag;
+}
+void ReadFieldValue(const JsonValue& value, Source& out) {
+    out = Source::FromJson(JsonObject::AsObject(value));
+}
+void ReadFieldValue(const JsonValue& value, std::vector<std::string>& out) {
+    const auto* items = std::get_if<std::vector<JsonObject>>(&value);
+    if (!items) return;
+    out.clear();
+    for (const auto& item : *items) {
+        const JsonValue* inner = item.Unbox();
+        if (const auto* text = inner ? std::get_if<std::string>(inner) : nullptr) {
+            out.push_back(*text);
+        }
+    }
+}
+
+template<typename T, typename Fields>
+void WriteFields(JsonWriter& writer, const T& object, const Fields& fields) {
+    writer.BeginObject();
+    std::apply([&](const auto&... field) {
+        auto write = [&](const auto& f) {
+            const auto& value = object.*(f.member);
+            if (f.mode == FieldMode::OmitEmpty && IsEmptyField(value)) return;
+            writer.Key(f.name);
+            WriteFieldValue(writer, value);
+        };
+        (write(field), ...);
+    }, fields);
+    writer.EndObject();
+}
+
+template<typename T, typename Fields>
+JsonObject FieldsToObject(const T& object, const Fields& fields) {
     JsonObject obj;
-    if (!name.empty()) obj.Set("name", name);
-    if (!path.empty()) obj.Set("path", path);
-    if (sourceReference > 0) obj.Set("sourceReference", static_cast<int64_t>(sourceReference));
-    if (!presentationHint.empty()) obj.Set("presentationHint", presentationHint);
-    if (!origin.empty()) obj.Set("origin", origin);
+    std::apply([&](const auto&... field) {
+        auto set = [&](const auto& f) {
+            const auto& value = object.*(f.member);
+            if (f.mode == FieldMode::OmitEmpty && IsEmptyField(value)) return;
+            obj.properties.emplace(std::string(f.name), FieldValue(value));
+        };
+        (set(field), ...);
+    }, fields);
     return obj;
 }
 
+template<typename T, typename Fields>
+T FieldsFromObject(const JsonObject& obj, const Fields& fields) {
+    T object;
+    std::apply([&](const auto&... field) {
+        auto read = [&](const auto& f) {
+            auto it = obj.properties.find(std::string(f.name));
+            if (it != obj.properties.end()) ReadFieldValue(it->second, object.*(f.member));
+        };
+        (read(field), ...);
+    }, fields);
+    return object;
+}
+
+constexpr auto SOURCE_FIELDS = std::make_tuple(
+    MakeField("name", &Source::name, FieldMode::OmitEmpty),
+    MakeField("path", &Source::path, FieldMode::OmitEmpty),
+    MakeField("sourceReference", &Source::sourceReference, FieldMode::OmitEmpty),
+    MakeField("presentationHint", &Source::presentationHint, FieldMode::OmitEmpty),
+    MakeField("origin", &Source::origin, FieldMode::OmitEmpty)
+);
+
+constexpr auto BREAKPOINT_LOCATION_FIELDS = std::make_tuple(
+    MakeField("line", &BreakpointLocation::line),
+    MakeField("column", &BreakpointLocation::column, FieldMode::OmitEmpty),
+    MakeField("endLine", &BreakpointLocation::endLine, FieldMode::OmitEmpty),
+    MakeField("endColumn", &BreakpointLocation::endColumn, FieldMode::OmitEmpty)
+);
+
+constexpr auto BREAKPOINT_FIELDS = std::make_tuple(
+    MakeField("id", &Breakpoint::id),
+    MakeField("verified", &Breakpoint::verified),
+    MakeField("message", &Breakpoint::message, FieldMode::OmitEmpty),
+    MakeField("source", &Breakpoint::source, FieldMode::OmitEmpty),
+    MakeField("line", &Breakpoint::line, FieldMode::OmitEmpty),
+    MakeField("column", &Breakpoint::column, FieldMode::OmitEmpty),
+    MakeField("endLine", &Breakpoint::endLine, FieldMode::OmitEmpty),
+    MakeField("endColumn", &Breakpoint::endColumn, FieldMode::OmitEmpty),
+    MakeField("instructionReference", &Breakpoint::instructionReference, FieldMode::OmitEmpty)
+);
+
+constexpr auto STACK_FRAME_FIELDS = std::make_tuple(
+    MakeField("id", &StackFrame::id),
+    MakeField("name", &StackFrame::name),
+    MakeField("source", &StackFrame::source, FieldMode::OmitEmpty),
+    MakeField("line", &StackFrame::line),
+    MakeField("column", &StackFrame::column),
+    MakeField("endLine", &StackFrame::endLine, FieldMode::OmitEmpty),
+    MakeField("endColumn", &StackFrame::endColumn, FieldMode::OmitEmpty),
+    MakeField("canRestart", &StackFrame::canRestart, FieldMode::OmitEmpty),
+    MakeField("instructionPointerReference", &StackFrame::instructionPointerReference, FieldMode::OmitEmpty),
+    MakeField("moduleId", &StackFrame::moduleId, FieldMode::OmitEmpty),
+    MakeField("presentationHint", &StackFrame::presentationHint, FieldMode::OmitEmpty)
+);
+
+constexpr auto THREAD_FIELDS = std::make_tuple(
+    MakeField("id", &Thread::id),
+    MakeField("name", &Thread::name)
+);
+
+constexpr auto SCOPE_FIELDS = std::make_tuple(
+    MakeField("name", &Scope::name),
+    MakeField("presentationHint", &Scope::presentationHint, FieldMode::OmitEmpty),
+    MakeField("variablesReference", &Scope::variablesReference),
+    MakeField("namedVariables", &Scope::namedVariables, FieldMode::OmitEmpty),
+    MakeField("indexedVariables", &Scope::indexedVariables, FieldMode::OmitEmpty),
+    MakeField("expensive", &Scope::expensive),
+    MakeField("source", &Scope::source, FieldMode::OmitEmpty),
+    MakeField("line", &Scope::line, FieldMode::OmitEmpty),
+    MakeField("column", &Scope::column, FieldMode::OmitEmpty),
+    MakeField("endLine", &Scope::endLine, FieldMode::OmitEmpty),
+    MakeField("endColumn", &Scope::endColumn, FieldMode::OmitEmpty)
+);
+
+constexpr auto VARIABLE_FIELDS = std::make_tuple(
+    MakeField("name", &Variable::name),
+    MakeField("value", &Variable::value),
+    MakeField("type", &Variable::type, FieldMode::OmitEmpty),
+    MakeField("evaluateName", &Variable::evaluateName, FieldMode::OmitEmpty),
+    MakeField("variablesReference", &Variable::variablesReference),
+    MakeField("namedVariables", &Variable::namedVariables, FieldMode::OmitEmpty),
+    MakeField("indexedVariables", &Variable::indexedVariables, FieldMode::OmitEmpty),
+    MakeField("memoryReference", &Variable::memoryReference, FieldMode::OmitEmpty)
+);
+
+constexpr auto VARIABLE_PRESENTATION_HINT_FIELDS = std::make_tuple(
+    MakeField("kind", &VariablePresentationHint::kind, FieldMode::OmitEmpty),
+    MakeField("attributes", &VariablePresentationHint::attributes, FieldMode::OmitEmpty),
+    MakeField("visibility", &VariablePresentationHint::visibility, FieldMode::OmitEmpty),
+    MakeField("lazy", &VariablePresentationHint::lazy, FieldMode::OmitEmpty)
+);
+
+constexpr auto MODULE_FIELDS = std::make_tuple(
+    MakeField("id", &Module::id),
+    MakeField("name", &Module::name),
+    MakeField("path", &Module::path, FieldMode::OmitEmpty),
+    MakeField("isOptimized", &Module::isOptimized),
+    MakeField("isUserCode", &Module::isUserCode),
+    MakeField("version", &Module::version, FieldMode::OmitEmpty),
+    MakeField("symbolStatus", &Module::symbolStatus, FieldMode::OmitEmpty),
+    MakeField("symbolFilePath", &Module::symbolFilePath, FieldMode::OmitEmpty),
+    MakeField("dateTimeStamp", &Module::dateTimeStamp, FieldMode::OmitEmpty),
+    MakeField("addressRange", &Module::addressRange, FieldMode::OmitEmpty)
+);
+
+constexpr auto EXCEPTION_BREAKPOINTS_FILTER_FIELDS = std::make_tuple(
+    MakeField("filter", &ExceptionBreakpointsFilter::filter),
+    MakeField("label", &ExceptionBreakpointsFilter::label),
+    MakeField("description", &ExceptionBreakpointsFilter::description, FieldMode::OmitEmpty),
+    MakeField("default", &ExceptionBreakpointsFilter::defaultValue),
+    MakeField("supportsCondition", &ExceptionBreakpointsFilter::supportsCondition, FieldMode::OmitEmpty),
+    MakeField("conditionDescription", &ExceptionBreakpointsFilter::conditionDescription, FieldMode::OmitEmpty)
+);
+
+constexpr auto EXCEPTION_DETAILS_FIELDS = std::make_tuple(
+    MakeField("message", &ExceptionDetails::message, FieldMode::OmitEmpty),
+    MakeField("typeName", &ExceptionDetails::typeName, FieldMode::OmitEmpty),
+    MakeField("fullTypeName", &ExceptionDetails::fullTypeName, FieldMode::OmitEmpty),
+    MakeField("evaluateName", &ExceptionDetails::evaluateName, FieldMode::OmitEmpty),
+    MakeField("stackTrace", &ExceptionDetails::stackTrace, FieldMode::OmitEmpty)
+);
+
+constexpr auto MEMORY_CONTENTS_FIELDS = std::make_tuple(
+    MakeField("address", &MemoryContents::address),
+    MakeField("unreadableBytes", &MemoryContents::unreadableBytes, FieldMode::OmitEmpty),
+    MakeField("data", &MemoryContents::data, FieldMode::OmitEmpty)
+);
+
+constexpr auto DISASSEMBLED_INSTRUCTION_FIELDS = std::make_tuple(
+    MakeField("address", &DisassembledInstruction::address),
+    MakeField("instructionBytes", &DisassembledInstruction::instructionBytes, FieldMode::OmitEmpty),
+    MakeField("instruction", &DisassembledInstruction::instruction),
+    MakeField("symbol", &DisassembledInstruction::symbol, FieldMode::OmitEmpty),
+    MakeField("location", &DisassembledInstruction::location, FieldMode::OmitEmpty),
+    MakeField("line", &DisassembledInstruction::line, FieldMode::OmitEmpty),
+    MakeField("column", &DisassembledInstruction::column, FieldMode::OmitEmpty),
+    MakeField("endLine", &DisassembledInstruction::endLine, FieldMode::OmitEmpty),
+    MakeField("endColumn", &DisassembledInstruction::endColumn, FieldMode::OmitEmpty)
+);
+
+constexpr auto COMPLETION_ITEM_FIELDS = std::make_tuple(
+    MakeField("label", &CompletionItem::label),
+    MakeField("text", &CompletionItem::text, FieldMode::OmitEmpty),
+    MakeField("sortText", &CompletionItem::sortText, FieldMode::OmitEmpty),
+    MakeField("detail", &CompletionItem::detail, FieldMode::OmitEmpty),
+    MakeField("type", &CompletionItem::type, FieldMode::OmitEmpty),
+    MakeField("start", &CompletionItem::start, FieldMode::OmitEmpty),
+    MakeField("length", &CompletionItem::length, FieldMode::OmitEmpty),
+    MakeField("selectionStart", &CompletionItem::selectionStart, FieldMode::OmitEmpty),
+    MakeField("selectionLength", &CompletionItem::selectionLength, FieldMode::OmitEmpty)
+);
+
+} // namespace
+
+// ============================================================================
+// SOURCE
+// ============================================================================
+
+JsonObject Source::ToJson() const {
+    return FieldsToObject(*this, SOURCE_FIELDS);
+}
+
+void Source::WriteJson(JsonWriter& writer) const {
+    WriteFields(writer, *this, SOURCE_FIELDS);
+}
+
 Source Source::FromJson(const JsonObject& obj) {
     Source s;
-    // Simplified parsing
+    s.name = GetString(obj, "name");
+    s.path = GetString(obj, "path");
+    s.sourceReference = GetInt(obj, "sourceReference");
+    s.presentationHint = GetString(obj, "presentationHint");
+    s.origin = GetString(obj, "origin");
+    s.adapterData = obj.GetObject("adapterData");
     return s;
 }
 
@@ -185,47 +1027,55 @@ Source Source::FromJson(const JsonObject& obj) {
 // ============================================================================
 
 JsonObject BreakpointLocation::ToJson() const {
-    JsonObject obj;
-    obj.Set("line", static_cast<int64_t>(line));
-    if (column > 0) obj.Set("column", static_cast<int64_t>(column));
-    if (endLine > 0) obj.Set("endLine", static_cast<int64_t>(endLine));
-    if (endColumn > 0) obj.Set("endColumn", static_cast<int64_t>(endColumn));
-    return obj;
+    return FieldsToObject(*this, BREAKPOINT_LOCATION_FIELDS);
+}
+
+void BreakpointLocation::WriteJson(JsonWriter& writer) const {
+    WriteFields(writer, *this, BREAKPOINT_LOCATION_FIELDS);
 }
 
 SourceBreakpoint SourceBreakpoint::FromJson(const JsonObject& obj) {
     SourceBreakpoint bp;
-    // Simplified parsing
+    bp.line = GetInt(obj, "line");
+    bp.column = GetInt(obj, "column");
+    bp.condition = GetString(obj, "condition");
+    bp.hitCondition = GetString(obj, "hitCondition");
+    bp.logMessage = GetString(obj, "logMessage");
     return bp;
 }
 
 FunctionBreakpoint FunctionBreakpoint::FromJson(const JsonObject& obj) {
     FunctionBreakpoint bp;
+    bp.name = GetString(obj, "name");
+    bp.condition = GetString(obj, "condition");
+    bp.hitCondition = GetString(obj, "hitCondition");
     return bp;
 }
 
 DataBreakpoint DataBreakpoint::FromJson(const JsonObject& obj) {
     DataBreakpoint bp;
+    bp.dataId = GetString(obj, "dataId");
+    bp.accessType = GetString(obj, "accessType");
+    bp.condition = GetString(obj, "condition");
+    bp.hitCondition = GetString(obj, "hitCondition");
     return bp;
 }
 
 InstructionBreakpoint InstructionBreakpoint::FromJson(const JsonObject& obj) {
     InstructionBreakpoint bp;
+    bp.instructionReference = GetString(obj, "instructionReference");
+    bp.offset = GetInt(obj, "offset");
+    bp.condition = GetString(obj, "condition");
+    bp.hitCondition = GetString(obj, "hitCondition");
     return bp;
 }
 
 JsonObject Breakpoint::ToJson() const {
-    JsonObject obj;
-    obj.Set("id", static_cast<int64_t>(id));
-    obj.Set("verified", verified);
-    if (!message.empty()) obj.Set("message", message);
-    if (!source.path.empty()) obj.Set("source", std::string(source.ToJson().ToJson()));
-    if (line > 0) obj.Set("line", static_cast<int64_t>(line));
-    if (column > 0) obj.Set("column", static_cast<int64_t>(column));
-    if (endLine > 0) obj.Set("endLine", static_cast<int64_t>(endLine));
-    if (endColumn > 0) obj.Set("endColumn", static_cast<int64_t>(endColumn));
-    if (!instructionReference.empty()) obj.Set("instructionReference", instructionReference);
-    return obj;
+    return FieldsToObject(*this, BREAKPOINT_FIELDS);
+}
+
+void Breakpoint::WriteJson(JsonWriter& writer) const {
+    WriteFields(writer, *this, BREAKPOINT_FIELDS);
 }
 
 // ============================================================================
@@ -233,29 +1083,27 @@ JsonObject Breakpoint::ToJson() const {
 // ============================================================================
 
 JsonObject StackFrame::ToJson() const {
-    JsonObject obj;
-    obj.Set("id", static_cast<int64_t>(id));
-    obj.Set("name", name);
-    if (!source.path.empty() || !source.name.empty()) {
-        // Nested object would require proper JSON building
-    }
-    obj.Set("line", static_cast<int64_t>(line));
-    obj.Set("column", static_cast<int64_t>(column));
-    if (endLine > 0) obj.Set("endLine", static_cast<int64_t>(endLine));
-    if (endColumn > 0) obj.Set("endColumn", static_cast<int64_t>(endColumn));
-    if (canRestart) obj.Set("canRestart", true);
-    if (!instructionPointerReference.empty()) {
-        obj.Set("instructionPointerReference", instructionPointerReference);
-    }
-    if (!presentationHint.empty()) obj.Set("presentationHint", presentationHint);
-    return obj;
+    return FieldsToObject(*this, STACK_FRAME_FIELDS);
+}
+
+void StackFrame::WriteJson(JsonWriter& writer) const {
+    WriteFields(writer, *this, STACK_FRAME_FIELDS);
+}
+
+StackFrame StackFrame::FromJson(const JsonObject& obj) {
+    return FieldsFromObject<StackFrame>(obj, STACK_FRAME_FIELDS);
 }
 
 JsonObject Thread::ToJson() const {
-    JsonObject obj;
-    obj.Set("id", static_cast<int64_t>(id));
-    obj.Set("name", name);
-    return obj;
+    return FieldsToObject(*this, THREAD_FIELDS);
+}
+
+void Thread::WriteJson(JsonWriter& writer) const {
+    WriteFields(writer, *this, THREAD_FIELDS);
+}
+
+Thread Thread::FromJson(const JsonObject& obj) {
+    return FieldsFromObject<Thread>(obj, THREAD_FIELDS);
 }
 
 // ============================================================================
@@ -263,35 +1111,35 @@ JsonObject Thread::ToJson() const {
 // ============================================================================
 
 JsonObject Scope::ToJson() const {
-    JsonObject obj;
-    obj.Set("name", name);
-    if (!presentationHint.empty()) obj.Set("presentationHint", presentationHint);
-    obj.Set("variablesReference", static_cast<int64_t>(variablesReference));
-    if (namedVariables > 0) obj.Set("namedVariables", static_cast<int64_t>(namedVariables));
-    if (indexedVariables > 0) obj.Set("indexedVariables", static_cast<int64_t>(indexedVariables));
-    obj.Set("expensive", expensive);
-    return obj;
+    return FieldsToObject(*this, SCOPE_FIELDS);
+}
+
+void Scope::WriteJson(JsonWriter& writer) const {
+    WriteFields(writer, *this, SCOPE_FIELDS);
+}
+
+Scope Scope::FromJson(const JsonObject& obj) {
+    return FieldsFromObject<Scope>(obj, SCOPE_FIELDS);
 }
 
 JsonObject Variable::ToJson() const {
-    JsonObject obj;
-    obj.Set("name", name);
-    obj.Set("value", value);
-    if (!type.empty()) obj.Set("type", type);
-    if (!evaluateName.empty()) obj.Set("evaluateName", evaluateName);
-    obj.Set("variablesReference", static_cast<int64_t>(variablesReference));
-    if (namedVariables > 0) obj.Set("namedVariables", static_cast<int64_t>(namedVariables));
-    if (indexedVariables > 0) obj.Set("indexedVariables", static_cast<int64_t>(indexedVariables));
-    if (!memoryReference.empty()) obj.Set("memoryReference", memoryReference);
-    return obj;
+    return FieldsToObject(*this, VARIABLE_FIELDS);
+}
+
+void Variable::WriteJson(JsonWriter& writer) const {
+    WriteFields(writer, *this, VARIABLE_FIELDS);
+}
+
+Variable Variable::FromJson(const JsonObject& obj) {
+    return FieldsFromObject<Variable>(obj, VARIABLE_FIELDS);
 }
 
 JsonObject VariablePresentationHint::ToJson() const {
-    JsonObject obj;
-    if (!kind.empty()) obj.Set("kind", kind);
-    if (!visibility.empty()) obj.Set("visibility", visibility);
-    if (lazy) obj.Set("lazy", true);
-    return obj;
+    return FieldsToObject(*this, VARIABLE_PRESENTATION_HINT_FIELDS);
+}
+
+void VariablePresentationHint::WriteJson(JsonWriter& writer) const {
+    WriteFields(writer, *this, VARIABLE_PRESENTATION_HINT_FIELDS);
 }
 
 // ============================================================================
@@ -299,18 +1147,11 @@ JsonObject VariablePresentationHint::ToJson() const {
 // ============================================================================
 
 JsonObject Module::ToJson() const {
-    JsonObject obj;
-    obj.Set("id", static_cast<int64_t>(id));
-    obj.Set("name", name);
-    if (!path.empty()) obj.Set("path", path);
-    obj.Set("isOptimized", isOptimized);
-    obj.Set("isUserCode", isUserCode);
-    if (!version.empty()) obj.Set("version", version);
-    if (!symbolStatus.empty()) obj.Set("symbolStatus", symbolStatus);
-    if (!symbolFilePath.empty()) obj.Set("symbolFilePath", symbolFilePath);
-    if (!dateTimeStamp.empty()) obj.Set("dateTimeStamp", dateTimeStamp);
-    if (!addressRange.empty()) obj.Set("addressRange", addressRange);
-    return obj;
+    return FieldsToObject(*this, MODULE_FIELDS);
+}
+
+void Module::WriteJson(JsonWriter& writer) const {
+    WriteFields(writer, *this, MODULE_FIELDS);
 }
 
 // ============================================================================
@@ -318,18 +1159,17 @@ JsonObject Module::ToJson() const {
 // ============================================================================
 
 JsonObject ExceptionBreakpointsFilter::ToJson() const {
-    JsonObject obj;
-    obj.Set("filter", filter);
-    obj.Set("label", label);
-    if (!description.empty()) obj.Set("description", description);
-    obj.Set("default", defaultValue);
-    if (supportsCondition) obj.Set("supportsCondition", true);
-    if (!conditionDescription.empty()) obj.Set("conditionDescription", conditionDescription);
-    return obj;
+    return FieldsToObject(*this, EXCEPTION_BREAKPOINTS_FILTER_FIELDS);
+}
+
+void ExceptionBreakpointsFilter::WriteJson(JsonWriter& writer) const {
+    WriteFields(writer, *this, EXCEPTION_BREAKPOINTS_FILTER_FIELDS);
 }
 
 ExceptionFilterOptions ExceptionFilterOptions::FromJson(const JsonObject& obj) {
     ExceptionFilterOptions opt;
+    opt.filterId = GetString(obj, "filterId");
+    opt.condition = GetString(obj, "condition");
     return opt;
 }
 
@@ -344,13 +1184,11 @@ ExceptionOptions ExceptionOptions::FromJson(const JsonObject& obj) {
 }
 
 JsonObject ExceptionDetails::ToJson() const {
-    JsonObject obj;
-    if (!message.empty()) obj.Set("message", message);
-    if (!typeName.empty()) obj.Set("typeName", typeName);
-    if (!fullTypeName.empty()) obj.Set("fullTypeName", fullTypeName);
-    if (!evaluateName.empty()) obj.Set("evaluateName", evaluateName);
-    if (!stackTrace.empty()) obj.Set("stackTrace", stackTrace);
-    return obj;
+    return FieldsToObject(*this, EXCEPTION_DETAILS_FIELDS);
+}
+
+void ExceptionDetails::WriteJson(JsonWriter& writer) const {
+    WriteFields(writer, *this, EXCEPTION_DETAILS_FIELDS);
 }
 
 // ============================================================================
@@ -358,22 +1196,19 @@ JsonObject ExceptionDetails::ToJson() const {
 // ============================================================================
 
 JsonObject MemoryContents::ToJson() const {
-    JsonObject obj;
-    obj.Set("address", address);
-    if (unreadableBytes > 0) obj.Set("unreadableBytes", static_cast<int64_t>(unreadableBytes));
-    if (!data.empty()) obj.Set("data", data);
-    return obj;
+    return FieldsToObject(*this, MEMORY_CONTENTS_FIELDS);
+}
+
+void MemoryContents::WriteJson(JsonWriter& writer) const {
+    WriteFields(writer, *this, MEMORY_CONTENTS_FIELDS);
 }
 
 JsonObject DisassembledInstruction::ToJson() const {
-    JsonObject obj;
-    obj.Set("address", address);
-    if (!instructionBytes.empty()) obj.Set("instructionBytes", instructionBytes);
-    obj.Set("instruction", instruction);
-    if (!symbol.empty()) obj.Set("symbol", symbol);
-    if (line > 0) obj.Set("line", static_cast<int64_t>(line));
-    if (column > 0) obj.Set("column", static_cast<int64_t>(column));
-    return obj;
+    return FieldsToObject(*this, DISASSEMBLED_INSTRUCTION_FIELDS);
+}
+
+void DisassembledInstruction::WriteJson(JsonWriter& writer) const {
+    WriteFields(writer, *this, DISASSEMBLED_INSTRUCTION_FIELDS);
 }
 
 // ============================================================================
@@ -381,19 +1216,16 @@ JsonObject DisassembledInstruction::ToJson() const {
 // ============================================================================
 
 JsonObject CompletionItem::ToJson() const {
-    JsonObject obj;
-    obj.Set("label", label);
-    if (!text.empty()) obj.Set("text", text);
-    if (!sortText.empty()) obj.Set("sortText", sortText);
-    if (!detail.empty()) obj.Set("detail", detail);
-    if (!type.empty()) obj.Set("type", type);
-    if (start > 0) obj.Set("start", static_cast<int64_t>(start));
-    if (length > 0) obj.Set("length", static_cast<int64_t>(length));
-    return obj;
+    return FieldsToObject(*this, COMPLETION_ITEM_FIELDS);
+}
+
+void CompletionItem::WriteJson(JsonWriter& writer) const {
+    WriteFields(writer, *this, COMPLETION_ITEM_FIELDS);
 }
 
 ValueFormat ValueFormat::FromJson(const JsonObject& obj) {
     ValueFormat fmt;
+    fmt.hex = obj.Get<bool>("hex").value_or(false);
     return fmt;
 }
 
@@ -431,6 +1263,18 @@ std::string DAPStopReasonToString(DAPStopReason reason) {
     return "breakpoint";
 }
 
+DAPStopReason StringToDAPStopReason(const std::string& str) {
+    if (str == "step") return DAPStopReason::Step;
+    if (str == "exception") return DAPStopReason::Exception;
+    if (str == "pause") return DAPStopReason::Pause;
+    if (str == "entry") return DAPStopReason::Entry;
+    if (str == "goto") return DAPStopReason::Goto;
+    if (str == "function breakpoint") return DAPStopReason::FunctionBreakpoint;
+    if (str == "data breakpoint") return DAPStopReason::DataBreakpoint;
+    if (str == "instruction breakpoint") return DAPStopReason::InstructionBreakpoint;
+    return DAPStopReason::Breakpoint;
+}
+
 std::string OutputCategoryToString(OutputCategory category) {
     switch (category) {
         case OutputCategory::Console: return "console";
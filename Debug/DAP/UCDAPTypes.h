@@ -11,6 +11,7 @@
 #include <map>
 #include <optional>
 #include <variant>
+#include <string_view>
 #include <cstdint>
 
 namespace UltraCanvas {
@@ -21,6 +22,13 @@ namespace DAP {
 // BASE TYPES
 // ============================================================================
 
+/**
+ * @brief A JSON value
+ *
+ * Arrays and nested objects hold their values boxed: each element (or
+ * member) is a JsonObject with the value under the empty key "". Use
+ * Box() to build them and GetArray()/GetObject() to read them.
+ */
 using JsonValue = std::variant<
     std::nullptr_t,
     bool,
@@ -37,10 +45,118 @@ struct JsonObject {
     template<typename T>
     std::optional<T> Get(const std::string& key) const;
     
+    /**
+     * @brief A nested object member, unboxed; empty if absent or not an object
+     */
+    JsonObject GetObject(const std::string& key) const;
+    
+    /**
+     * @brief An array member's elements, unboxed; empty if absent or not an array
+     */
+    std::vector<JsonValue> GetArray(const std::string& key) const;
+    
     void Set(const std::string& key, JsonValue value);
     bool Has(const std::string& key) const;
     std::string ToJson() const;
+    
+    /**
+     * @brief Parse a JSON object; an empty object if the text is not one
+     */
     static JsonObject FromJson(const std::string& json);
+    
+    /**
+     * @brief Parse a JSON object (the whole text, surrounding whitespace allowed)
+     * @return false if the text is not well-formed JSON or not an object
+     */
+    static bool Parse(std::string_view json, JsonObject& result);
+    
+    /**
+     * @brief Wrap a value for storage in an array or nested object
+     */
+    static JsonObject Box(JsonValue value);
+    
+    /**
+     * @brief A nested object value as a JsonObject (empty if it is not one)
+     */
+    static JsonObject AsObject(const JsonValue& value);
+    
+    /**
+     * @brief The value held by a box
+     */
+    const JsonValue* Unbox() const;
+    
+    /**
+     * @brief This object as a value, boxed for nesting inside another
+     */
+    JsonValue ToValue() const;
+};
+
+template<typename T>
+std::optional<T> JsonObject::Get(const std::string& key) const {
+    auto it = properties.find(key);
+    if (it == properties.end()) return std::nullopt;
+    if (const T* value = std::get_if<T>(&it->second)) return *value;
+    return std::nullopt;
+}
+
+/**
+ * @brief Streaming JSON writer
+ *
+ * Appends to a caller-owned string, so a buffer that is cleared and
+ * reused keeps its capacity and a large message costs no allocations
+ * once it has grown. Output is staged in a small inline buffer and moved
+ * to the string in large chunks; the string is complete whenever a
+ * top-level value has been finished (and when the writer is destroyed).
+ * Commas are inserted automatically; a Key() must be followed by exactly
+ * one value.
+ */
+class JsonWriter {
+public:
+    explicit JsonWriter(std::string& out) : out_(out) {}
+    ~JsonWriter() { Flush(); }
+    
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+    
+    void BeginObject();
+    void EndObject();
+    void BeginArray();
+    void EndArray();
+    void Key(std::string_view key);
+    
+    void String(std::string_view value);
+    void Int(int64_t value);
+    void Double(double value);          // NaN and infinities are written as null
+    void Bool(bool value);
+    void Null();
+    void Value(const JsonValue& value);
+    void Object(const JsonObject& object);
+    
+    /**
+     * @brief Insert already serialized JSON as the next value
+     */
+    void Raw(std::string_view json);
+    
+    /**
+     * @brief Move staged output to the string
+     */
+    void Flush();
+    
+private:
+    char* Reserve(size_t size);         // Room for size bytes (at most half the stage)
+    void Put(char c);
+    void Put(const char* data, size_t size);
+    void Open(char c);                  // c, after a comma if one is due
+    void Close(char c);
+    void EndValue();
+    void AppendEscaped(std::string_view text);
+    static size_t CleanPrefix(std::string_view text);  // Bytes before the first to escape
+    
+    std::string& out_;
+    char stage_[1024];
+    size_t staged_ = 0;
+    int depth_ = 0;
+    bool needComma_ = false;
 };
 
 // ============================================================================
@@ -55,7 +171,13 @@ struct ProtocolMessage {
     std::string type;                   // "request", "response", "event"
     
     virtual ~ProtocolMessage() = default;
-    virtual std::string ToJson() const;
+    std::string ToJson() const;
+    void WriteJson(JsonWriter& writer) const { WriteJson(writer, seq); }
+    
+    /**
+     * @brief Serialize with the given sequence number in place of seq
+     */
+    virtual void WriteJson(JsonWriter& writer, int sequence) const = 0;
 };
 
 /**
@@ -66,7 +188,8 @@ struct Request : ProtocolMessage {
     JsonObject arguments;               // Command arguments
     
     Request() { type = "request"; }
-    std::string ToJson() const override;
+    using ProtocolMessage::WriteJson;
+    void WriteJson(JsonWriter& writer, int sequence) const override;
 };
 
 /**
@@ -78,9 +201,11 @@ struct Response : ProtocolMessage {
     std::string command;                // Command being responded to
     std::string message;                // Error message if !success
     JsonObject body;                    // Response body
+    std::string rawBody;                // Serialized body; sent instead of body if set
     
     Response() { type = "response"; }
-    std::string ToJson() const override;
+    using ProtocolMessage::WriteJson;
+    void WriteJson(JsonWriter& writer, int sequence) const override;
 };
 
 /**
@@ -89,10 +214,12 @@ struct Response : ProtocolMessage {
 struct Event : ProtocolMessage {
     std::string event;                  // Event type
     JsonObject body;                    // Event body
+    std::string rawBody;                // Serialized body; sent instead of body if set
     
     Event() { type = "event"; }
     Event(const std::string& eventName) : event(eventName) { type = "event"; }
-    std::string ToJson() const override;
+    using ProtocolMessage::WriteJson;
+    void WriteJson(JsonWriter& writer, int sequence) const override;
 };
 
 // ============================================================================
@@ -163,6 +290,7 @@ struct Source {
     std::vector<std::string> checksums;
     
     JsonObject ToJson() const;
+    void WriteJson(JsonWriter& writer) const;
     static Source FromJson(const JsonObject& obj);
 };
 
@@ -176,6 +304,7 @@ struct BreakpointLocation {
     int endColumn = 0;
     
     JsonObject ToJson() const;
+    void WriteJson(JsonWriter& writer) const;
 };
 
 /**
@@ -242,6 +371,7 @@ struct Breakpoint {
     int offset = 0;
     
     JsonObject ToJson() const;
+    void WriteJson(JsonWriter& writer) const;
 };
 
 // ============================================================================
@@ -265,6 +395,8 @@ struct StackFrame {
     std::string presentationHint;       // "normal", "label", "subtle"
     
     JsonObject ToJson() const;
+    void WriteJson(JsonWriter& writer) const;
+    static StackFrame FromJson(const JsonObject& obj);
 };
 
 /**
@@ -275,6 +407,8 @@ struct Thread {
     std::string name;
     
     JsonObject ToJson() const;
+    void WriteJson(JsonWriter& writer) const;
+    static Thread FromJson(const JsonObject& obj);
 };
 
 // ============================================================================
@@ -298,6 +432,8 @@ struct Scope {
     int endColumn = 0;
     
     JsonObject ToJson() const;
+    void WriteJson(JsonWriter& writer) const;
+    static Scope FromJson(const JsonObject& obj);
 };
 
 /**
@@ -315,6 +451,8 @@ struct Variable {
     std::string memoryReference;
     
     JsonObject ToJson() const;
+    void WriteJson(JsonWriter& writer) const;
+    static Variable FromJson(const JsonObject& obj);
 };
 
 /**
@@ -327,6 +465,7 @@ struct VariablePresentationHint {
     bool lazy = false;
     
     JsonObject ToJson() const;
+    void WriteJson(JsonWriter& writer) const;
 };
 
 // ============================================================================
@@ -349,6 +488,7 @@ struct Module {
     std::string addressRange;
     
     JsonObject ToJson() const;
+    void WriteJson(JsonWriter& writer) const;
 };
 
 // ============================================================================
@@ -367,6 +507,7 @@ struct ExceptionBreakpointsFilter {
     std::string conditionDescription;
     
     JsonObject ToJson() const;
+    void WriteJson(JsonWriter& writer) const;
 };
 
 /**
@@ -411,6 +552,7 @@ struct ExceptionDetails {
     std::vector<ExceptionDetails> innerException;
     
     JsonObject ToJson() const;
+    void WriteJson(JsonWriter& writer) const;
 };
 
 // ============================================================================
@@ -426,6 +568,7 @@ struct MemoryContents {
     std::string data;                   // Base64 encoded
     
     JsonObject ToJson() const;
+    void WriteJson(JsonWriter& writer) const;
 };
 
 /**
@@ -443,6 +586,7 @@ struct DisassembledInstruction {
     int endColumn = 0;
     
     JsonObject ToJson() const;
+    void WriteJson(JsonWriter& writer) const;
 };
 
 // ============================================================================
@@ -484,6 +628,7 @@ struct CompletionItem {
     int selectionLength = 0;
     
     JsonObject ToJson() const;
+    void WriteJson(JsonWriter& writer) const;
 };
 
 // ============================================================================
@@ -522,6 +667,7 @@ enum class DAPStopReason {
 };
 
 std::string DAPStopReasonToString(DAPStopReason reason);
+DAPStopReason StringToDAPStopReason(const std::string& str);
 
 /**
  * @brief Output category
@@ -103,7 +103,9 @@ void UCHoverTooltip::Hide() {
 void UCHoverTooltip::ExpandVariable(int variableRef) {
     if (!debugManager_ || variableRef <= 0) return;
     
-    auto children = debugManager_->ExpandVariable(variableRef);
+    // A tooltip shows the head of a large container, not all of it
+    const int maxChildren = 100;
+    auto children = debugManager_->ExpandVariable(variableRef, 0, maxChildren);
     
     // Find the node and add children
     for (const auto& pair : nodeToVarRef_) {
@@ -6,37 +6,97 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
-#include <map>
 #include <memory>
+#include <cstdint>
 
 namespace UltraCanvas {
 namespace IDE {
 
-// GDB/MI Value (string, list, or tuple)
-struct GDBMIValue;
-using GDBMIList = std::vector<GDBMIValue>;
-using GDBMITuple = std::map<std::string, GDBMIValue>;
+struct GDBMIDocument;
 
+// GDB/MI Value (string, list, or tuple)
+//
+// A lightweight handle onto a node of a parsed record's document; copying it
+// copies two words. Handles stay valid as long as the GDBMIRecord (or a copy
+// of it) they came from is alive. A default-constructed handle, or the result
+// of looking up a missing key, is "invalid": it is not a string, list or
+// tuple and has no children.
 struct GDBMIValue {
-    enum class Type { String, List, Tuple };
-    Type type = Type::String;
-    std::string stringValue;
-    GDBMIList listValue;
-    GDBMITuple tupleValue;
+    enum class Type : uint8_t { String, List, Tuple };
+    
+    class Iterator;
     
     GDBMIValue() = default;
-    explicit GDBMIValue(const std::string& s) : type(Type::String), stringValue(s) {}
     
-    bool IsString() const { return type == Type::String; }
-    bool IsList() const { return type == Type::List; }
-    bool IsTuple() const { return type == Type::Tuple; }
+    bool IsValid() const { return document_ != nullptr; }
+    Type GetType() const;
+    bool IsString() const { return IsValid() && GetType() == Type::String; }
+    bool IsList() const { return IsValid() && GetType() == Type::List; }
+    bool IsTuple() const { return IsValid() && GetType() == Type::Tuple; }
+    
+    // String contents; escapes are decoded on first access
+    std::string_view AsString() const;
+    
+    // Children of a list or tuple (tuple members keep their order)
+    size_t Size() const;
+    GDBMIValue At(size_t index) const;
+    std::string_view KeyAt(size_t index) const;
+    Iterator begin() const;
+    Iterator end() const;
+    
+    // Tuple member lookup (first member with the key)
+    GDBMIValue Get(std::string_view key) const;
+    bool Has(std::string_view key) const { return Get(key).IsValid(); }
+    std::string GetString(std::string_view key, std::string_view def = {}) const;
+    int GetInt(std::string_view key, int def = 0) const;
+    uint64_t GetUInt64(std::string_view key, uint64_t def = 0) const;
+    
+private:
+    friend class UCGDBMIParser;
+    friend struct GDBMIRecord;
+    
+    GDBMIValue(GDBMIDocument* document, uint32_t node) : document_(document), node_(node) {}
+    
+    GDBMIDocument* document_ = nullptr;
+    uint32_t node_ = 0;
+};
+
+class GDBMIValue::Iterator {
+public:
+    Iterator(GDBMIValue parent, size_t index) : parent_(parent), index_(index) {}
+    
+    GDBMIValue operator*() const { return parent_.At(index_); }
+    Iterator& operator++() { ++index_; return *this; }
+    bool operator!=(const Iterator& other) const { return index_ != other.index_; }
     
-    std::string GetString(const std::string& key, const std::string& def = "") const;
-    int GetInt(const std::string& key, int def = 0) const;
-    uint64_t GetUInt64(const std::string& key, uint64_t def = 0) const;
-    const GDBMIValue* Get(const std::string& key) const;
-    bool Has(const std::string& key) const;
+private:
+    GDBMIValue parent_;
+    size_t index_;
+};
+
+// One node of a parsed record. Strings are byte ranges of the record line;
+// a list or tuple's children are a contiguous run of nodes.
+struct GDBMINode {
+    uint32_t keyOffset = 0;         // Tuple members: key bytes in the buffer
+    uint32_t keyLength = 0;
+    uint32_t offset = 0;            // String: first byte; List/Tuple: first child
+    uint32_t length = 0;            // String: byte count; List/Tuple: child count
+    GDBMIValue::Type type = GDBMIValue::Type::String;
+    bool escaped = false;           // String contains backslash escapes
+    bool decoded = false;           // offset/length now refer to decoded
+};
+
+// Per-record arena: the record line plus every node parsed from it.
+// Escaped strings are decoded on demand into `decoded`, which is sized
+// once to the line length (decoding never grows a string), so views
+// handed out earlier stay valid and the line itself stays intact.
+struct GDBMIDocument {
+    std::string buffer;
+    std::vector<GDBMINode> nodes;
+    std::string decoded;
+    size_t decodedUsed = 0;
 };
 
 // GDB/MI Record Types
@@ -54,15 +114,18 @@ enum class GDBMIAsyncClass {
 };
 
 // Parsed GDB/MI Record
+//
+// Copies share the document. Strings are decoded in place on first access,
+// so one record must not be read from two threads at the same time.
 struct GDBMIRecord {
     GDBMIRecordType type = GDBMIRecordType::Prompt;
     int token = -1;
     GDBMIResultClass resultClass = GDBMIResultClass::Done;
     GDBMIAsyncClass asyncClass = GDBMIAsyncClass::Other;
-    std::string asyncClassName;
+    std::string_view asyncClassName;    // View into the document
     std::string streamContent;
-    GDBMITuple results;
-    std::string rawLine;
+    GDBMIValue results;                 // Top-level result tuple
+    std::shared_ptr<GDBMIDocument> document;
     
     bool IsResult() const { return type == GDBMIRecordType::Result; }
     bool IsAsync() const;
@@ -70,31 +133,47 @@ struct GDBMIRecord {
     bool IsSuccess() const { return IsResult() && resultClass == GDBMIResultClass::Done; }
     bool IsError() const { return IsResult() && resultClass == GDBMIResultClass::Error; }
     std::string GetError() const;
+    std::string_view GetRawLine() const;
+    
+    // ^error record carrying msg=<message>, for failures raised on our side
+    static GDBMIRecord MakeError(const std::string& message);
 };
 
 // GDB/MI Parser
+//
+// Parses each line into a GDBMIDocument with a handful of allocations no
+// matter how large the record is. Not thread-safe: the parser keeps scratch
+// space between calls.
 class UCGDBMIParser {
 public:
     UCGDBMIParser();
     ~UCGDBMIParser();
     
-    GDBMIRecord ParseLine(const std::string& line);
-    std::vector<GDBMIRecord> ParseOutput(const std::string& output);
+    GDBMIRecord ParseLine(std::string line);
+    std::vector<GDBMIRecord> ParseOutput(std::string_view output);
     
     static std::string Escape(const std::string& str);
-    static std::string Unescape(const std::string& str);
+    static std::string Unescape(std::string_view str);
     
-private:
-    GDBMIValue ParseValue(const std::string& str, size_t& pos);
-    GDBMITuple ParseTuple(const std::string& str, size_t& pos);
-    GDBMIList ParseList(const std::string& str, size_t& pos);
-    std::string ParseString(const std::string& str, size_t& pos);
-    std::string ParseCString(const std::string& str, size_t& pos);
+    // Decodes the hex digit pairs of a -data-read-memory-bytes "contents"
+    // field into out (hex.size() / 2 bytes). Eight digits at a time, with no
+    // branches or table lookups; the input is trusted to be hex.
+    static size_t DecodeHex(std::string_view hex, uint8_t* out);
     
-    GDBMIResultClass ParseResultClass(const std::string& cls);
-    GDBMIAsyncClass ParseAsyncClass(const std::string& cls);
-    
-    void SkipWhitespace(const std::string& str, size_t& pos);
+private:
+    // Each Parse* appends the parsed node to scratch_; containers move
+    // their children from scratch_ into the document when they close
+    bool ParseValue(GDBMIDocument& doc, size_t& pos);
+    void ParseResults(GDBMIDocument& doc, size_t& pos, char close);
+    void ParseList(GDBMIDocument& doc, size_t& pos);
+    void ParseCString(GDBMIDocument& doc, size_t& pos);
+    void ParseBareString(GDBMIDocument& doc, size_t& pos);
+    void CloseContainer(GDBMIDocument& doc, GDBMIValue::Type type, size_t mark);
+    
+    GDBMIResultClass ParseResultClass(std::string_view cls);
+    GDBMIAsyncClass ParseAsyncClass(std::string_view cls);
+    
+    std::vector<GDBMINode> scratch_;
 };
 
 // GDB/MI Command Builder
@@ -124,6 +203,10 @@ public:
     static std::string ExecInterrupt(int token = -1);
     
     static std::string StackListFrames(int maxDepth = -1, int token = -1);
+    // Frames lowFrame..highFrame (all if highFrame < 0) of a thread, which
+    // stays unselected
+    static std::string StackListThreadFrames(int threadId, int lowFrame, int highFrame,
+                                             int token = -1);
     static std::string StackListVariables(int printValues = 1, int token = -1);
     static std::string StackListLocals(int printValues = 1, int token = -1);
     static std::string StackListArguments(int printValues = 1, int token = -1);
@@ -134,12 +217,16 @@ public:
     static std::string DataEvaluateExpression(const std::string& expr, int token = -1);
     static std::string DataReadMemory(uint64_t addr, size_t count, int token = -1);
     static std::string DataDisassemble(uint64_t start, uint64_t end, int token = -1);
+    static std::string DataDisassembleFunction(uint64_t addr, int token = -1);
     
     static std::string VarCreate(const std::string& name, const std::string& expr, int token = -1);
+    static std::string VarCreateInFrame(const std::string& name, const std::string& expr, int token = -1);
     static std::string VarDelete(const std::string& name, int token = -1);
     static std::string VarListChildren(const std::string& name, int token = -1);
+    static std::string VarListChildren(const std::string& name, int from, int to, int token = -1);
     static std::string VarEvaluate(const std::string& name, int token = -1);
     static std::string VarAssign(const std::string& name, const std::string& value, int token = -1);
+    static std::string VarUpdate(const std::string& name = "*", int token = -1);
     
 private:
     int token_ = -1;
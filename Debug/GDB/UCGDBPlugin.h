@@ -10,6 +10,11 @@
 #include "UCGDBProcess.h"
 #include <thread>
 #include <queue>
+#include <deque>
+#include <array>
+#include <future>
+#include <unordered_map>
+#include <set>
 #include <condition_variable>
 
 namespace UltraCanvas {
@@ -25,10 +30,27 @@ struct GDBPluginConfig {
     bool prettyPrinting = true;             // Enable pretty printing
     bool asyncMode = true;                  // Use async/non-stop mode
     int commandTimeout = 5000;              // Command timeout (ms)
+    int maxCommandsInFlight = 4;            // Commands written ahead of their results
+    int printElements = 200;                // Longest string or array shown in a value
+    bool directMemoryAccess = true;         // Read local inferiors without GDB
     
     static GDBPluginConfig Default();
 };
 
+/**
+ * @brief Dispatch order of queued asynchronous commands
+ */
+enum class GDBCommandPriority {
+    High,           // Execution control, synchronous callers, visible panels
+    Normal,
+    Low             // Prefetch for panels that are not shown
+};
+
+/**
+ * @brief Receives the result record of an asynchronous command
+ */
+using GDBCommandCallback = std::function<void(const GDBMIRecord&)>;
+
 /**
  * @brief GDB debugger plugin implementation
  * 
@@ -131,6 +153,7 @@ public:
     
     std::vector<StackFrame> GetCallStack(int maxFrames = 100) override;
     std::vector<StackFrame> GetCallStack(int threadId, int maxFrames = 100) override;
+    std::vector<StackFrame> GetCallStackRange(int threadId, int startFrame, int count) override;
     bool SwitchFrame(int frameLevel) override;
     StackFrame GetCurrentFrame() override;
     
@@ -145,6 +168,8 @@ public:
     EvaluationResult Evaluate(const std::string& expression, EvaluationContext context) override;
     bool SetVariable(const std::string& name, const std::string& value) override;
     std::vector<Variable> ExpandVariable(int variablesReference) override;
+    std::vector<Variable> ExpandVariable(int variablesReference, int start, int count) override;
+    EvaluationResult EvaluateFullValue(const Variable& variable, int maxLength) override;
     
     // =========================================================================
     // REGISTERS
@@ -160,6 +185,9 @@ public:
     
     MemoryRegion ReadMemory(uint64_t address, size_t size) override;
     bool WriteMemory(uint64_t address, const std::vector<uint8_t>& data) override;
+    MemorySearchResult SearchMemory(const MemorySearchQuery& query,
+                                    const std::function<bool(uint64_t address)>& onMatch,
+                                    const std::atomic<bool>* cancel) override;
     
     // =========================================================================
     // DISASSEMBLY
@@ -180,27 +208,156 @@ public:
     
     std::vector<DebugCompletionItem> GetCompletions(const std::string& text, int column) override;
     
+    // =========================================================================
+    // STOP STATE
+    // =========================================================================
+    
+    DebugStopState CaptureStopState(int maxFrames,
+                                    const std::vector<std::string>& watchExpressions) override;
+    
+    // =========================================================================
+    // ASYNCHRONOUS MI COMMANDS
+    // =========================================================================
+    
+    /**
+     * @brief Queue an MI command and return without waiting for its result
+     *
+     * Up to GDBPluginConfig::maxCommandsInFlight commands are written to GDB
+     * back to back; the rest wait, highest priority first. A stop-scoped
+     * command belongs to the current stop: if the target resumes before its
+     * result arrives, it is not sent (or its result is dropped) and the
+     * callback receives a "Cancelled" error record instead.
+     *
+     * The callback runs on the output thread and may queue further commands.
+     * @return The command's token, or -1 if GDB is not running
+     */
+    int SendCommandAsync(const std::string& command, GDBCommandCallback callback,
+                         GDBCommandPriority priority = GDBCommandPriority::Normal,
+                         bool stopScoped = false);
+    
+    /**
+     * @brief Future-returning form of SendCommandAsync
+     */
+    std::future<GDBMIRecord> SendCommandAsync(const std::string& command,
+                                              GDBCommandPriority priority = GDBCommandPriority::Normal,
+                                              bool stopScoped = false);
+    
+    /**
+     * @brief Withdraw a queued or sent command; its callback gets "Cancelled"
+     * @return false if the command already completed
+     */
+    bool CancelCommand(int token);
+    
+    /**
+     * @brief Number of times the target has resumed; tags stop-scoped commands
+     */
+    uint64_t GetStopGeneration() const { return stopGeneration_; }
+
 private:
+    /**
+     * @brief A command waiting to be sent or waiting for its result
+     */
+    struct PendingCommand {
+        int token = 0;
+        std::string command;                // Without the token
+        GDBCommandCallback callback;
+        uint64_t generation = 0;            // Stop generation, 0 if not stop-scoped
+    };
+    
+    /**
+     * @brief A GDB variable object kept across stops
+     *
+     * Watches are floating objects, re-evaluated in the selected frame;
+     * aggregate locals and arguments are bound to their frame. One
+     * "-var-update --all-values *" per stop reports which of them changed,
+     * so unchanged values and children that were already listed cost no
+     * further traffic.
+     */
+    struct VarObject {
+        std::string expression;             // Watch expression, local name or child "exp"
+        std::string type;
+        std::string value;
+        std::string displayHint;            // Pretty printer's hint: "array", "map", "string"
+        int numChildren = 0;                // Known so far, for pretty-printed containers
+        int reference = 0;                  // variablesReference handed out, 0 if none
+        bool changed = false;               // Reported by the last -var-update
+        bool dynamic = false;               // Children come from a pretty printer
+        bool hasMore = false;               // A pretty printer has children past numChildren
+        std::map<int, std::string> children;  // GDB names of the fetched children, by index
+    };
+    
+    /**
+     * @brief Code mapped from a file: a module's text at its load address
+     */
+    struct CodeModule {
+        uint64_t start = 0;
+        uint64_t end = 0;
+        std::string key;                    // Build ID (or path and inode) and load base
+    };
+    
+    // Process startup (also starts the output thread)
+    bool StartGDB(const std::vector<std::string>& args);
+    
     // Command execution
     GDBMIRecord SendCommand(const std::string& command);
-    GDBMIRecord SendCommandAsync(const std::string& command);
+    GDBMIRecord WaitForResult(std::future<GDBMIRecord>& future);
     bool SendCommandNoWait(const std::string& command);
     int GetNextToken();
+    void SendQueuedCommands();
+    void AdvanceStopGeneration();
+    void FailPendingCommands(const std::string& error);
     
     // Response handling
     void ProcessOutput();
+    void DispatchLine(std::string line);
     void HandleAsyncRecord(const GDBMIRecord& record);
     void HandleStopEvent(const GDBMIRecord& record);
     void HandleRunningEvent(const GDBMIRecord& record);
     void HandleBreakpointEvent(const GDBMIRecord& record);
     void HandleThreadEvent(const GDBMIRecord& record);
+    void HandleThreadGroupEvent(const GDBMIRecord& record);
     void HandleLibraryEvent(const GDBMIRecord& record);
     
     // Parsing helpers
     Breakpoint ParseBreakpointResult(const GDBMIRecord& record);
-    StackFrame ParseFrameResult(const std::map<std::string, GDBMIValue>& frame);
-    Variable ParseVariableResult(const std::map<std::string, GDBMIValue>& var);
-    ThreadInfo ParseThreadResult(const std::map<std::string, GDBMIValue>& thread);
+    StackFrame ParseFrameResult(const GDBMIValue& frame);
+    std::vector<StackFrame> ParseStackResult(const GDBMIRecord& record);
+    Variable ParseVariableResult(const GDBMIValue& var);
+    std::vector<Variable> ParseLocalsResult(const GDBMIRecord& record);
+    std::vector<Variable> ParseArgumentsResult(const GDBMIRecord& record);
+    EvaluationResult ParseEvaluateResult(const std::string& expression, const GDBMIRecord& response);
+    ThreadInfo ParseThreadResult(const GDBMIValue& thread);
+    
+    // Variable objects
+    void UpdateVarObjects();
+    void ApplyVarUpdate(const GDBMIRecord& record, uint64_t generation);
+    VarObject& AddVarObject(const std::string& name, const std::string& expression,
+                            const GDBMIRecord& created);
+    void ReadVarObject(VarObject& object, const GDBMIValue& fields);
+    void DeleteVarObject(const std::string& name);
+    void ForgetVarObject(const std::string& name);
+    Variable MakeVarObjectVariable(const std::string& name, VarObject& object);
+    EvaluationResult EvaluateWatch(const std::string& expression);
+    void SetLocalScope(const std::vector<StackFrame>& callStack, uint64_t generation);
+    void TrackLocals(std::vector<Variable>& variables);
+    std::string NextVarObjectName(char prefix);
+    
+    // Memory pages
+    void FetchMemoryPages(uint64_t firstPage, size_t pageCount);
+    size_t ReadPagesDirect(uint64_t firstPage, size_t pageCount);
+    void ReadPagesMI(uint64_t firstPage, size_t pageCount);
+    void OpenDirectMemory(int pid);
+    void CloseDirectMemory();
+    void InvalidateMemoryCache();
+    int LocalInferiorPid();
+    
+    // Disassembly cache
+    const CodeModule* FindCodeModule(uint64_t address, int pid);
+    void CollectDisassembly(const std::string& module, uint64_t address, int count,
+                            std::vector<DisassemblyLine>& lines);
+    void CacheDisassembly(const CodeModule& module, const std::vector<DisassemblyLine>& lines);
+    void PrefetchDisassembly(const std::vector<StackFrame>& callStack);
+    std::vector<DisassemblyLine> ParseDisassembly(const GDBMIRecord& record);
     
     // State management
     void SetState(DebugSessionState newState);
@@ -221,9 +378,12 @@ private:
     int currentThreadId_ = 1;
     int currentFrameLevel_ = 0;
     
-    // Command handling
+    // Command handling: sent commands by token, and per-priority FIFOs of
+    // commands held back by maxCommandsInFlight
     std::atomic<int> nextToken_{1};
-    std::map<int, std::promise<GDBMIRecord>> pendingCommands_;
+    std::map<int, PendingCommand> pendingCommands_;
+    std::array<std::deque<PendingCommand>, 3> queuedCommands_;
+    std::atomic<uint64_t> stopGeneration_{1};
     std::mutex commandMutex_;
     
     // Breakpoints
@@ -232,12 +392,51 @@ private:
     int nextBreakpointId_ = 1;
     int nextWatchpointId_ = 1;
     
-    // Variable objects (for expansion)
+    // Variable objects: by GDB name, by variablesReference, by watch
+    // expression, and aggregate locals of localScope_ by name. Used from
+    // the output thread's stop capture and from callers' threads alike;
+    // varObjectMutex_ is never held across a command, so look an object
+    // up again by name once one returns
+    std::unordered_map<std::string, VarObject> varObjects_;
     std::map<int, std::string> variableObjects_;
+    std::unordered_map<std::string, std::string> watchVarObjects_;
+    std::unordered_map<std::string, std::string> localVarObjects_;
+    std::unordered_map<std::string, std::string> localValues_;  // Simple locals at the previous stop
+    std::string localScope_;                // Thread, stack depth and function
+    uint64_t localScopeGeneration_ = 0;
+    uint64_t varUpdateGeneration_ = 0;
     int nextVariableRef_ = 1;
+    int nextVarObject_ = 1;
+    std::mutex varObjectMutex_;
+    
+    // Memory: pages of the paused target by address, empty if unreadable,
+    // until it resumes. Pages of a local inferior traced by our GDB are read
+    // with process_vm_readv; code pages in non-stop mode (where breakpoints
+    // stay inserted), remote targets and core files go through GDB.
+    std::unordered_map<uint64_t, std::vector<uint8_t>> memoryPages_;
+    std::vector<std::pair<uint64_t, uint64_t>> codeRanges_;  // Executable mappings
+    uint64_t memoryGeneration_ = 0;
+    std::atomic<int> inferiorPid_{0};       // From =thread-group-started
+    int directPid_ = 0;                     // Last pid checked for direct access
+    bool directMemory_ = false;             // directPid_ is traced by our GDB
+    int memFd_ = -1;                        // /proc/<pid>/mem of directPid_
+    std::mutex memoryMutex_;
+    
+    // Disassembly by module key, then address. Instructions of a module
+    // decode the same at every stop and in every session that loads the
+    // same build at the same address, so the cache outlives both. Code
+    // outside file mappings (JIT) and on remote targets is not cached.
+    std::unordered_map<std::string, std::map<uint64_t, DisassemblyLine>> disassemblyCache_;
+    std::unordered_map<std::string, std::string> buildIds_;  // By path and inode
+    std::vector<CodeModule> codeModules_;   // Of the local inferior, by address
+    std::set<uint64_t> disassemblyPrefetches_;  // Addresses in flight
+    size_t disassemblyLines_ = 0;
+    bool codeModulesStale_ = true;          // Libraries loaded or unloaded since
+    std::mutex disassemblyMutex_;
     
     // Output processing thread
     std::thread outputThread_;
+    std::atomic<std::thread::id> outputThreadId_{};  // Set by the thread itself
     std::atomic<bool> stopOutputThread_{false};
     
     mutable std::mutex stateMutex_;
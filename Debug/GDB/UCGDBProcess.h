@@ -21,6 +21,14 @@ namespace IDE {
  * @brief Cross-platform GDB process wrapper
  * 
  * Manages the GDB subprocess, handling stdin/stdout/stderr communication.
+ * 
+ * On POSIX one I/O thread per session waits in epoll on stdout, stderr,
+ * a shutdown eventfd and (where available) a pidfd for the process exit.
+ * stdout is read into a ring buffer and split into lines in place; each
+ * line is copied out of the ring exactly once, into the string ReadLine
+ * hands over (and the MI parser then adopts as its record buffer).
+ * Queued output is signalled on an eventfd, so blocked readers and event
+ * loops polling GetOutputEventFd() wake as soon as a line is complete.
  */
 class UCGDBProcess {
 public:
@@ -36,10 +44,15 @@ public:
     // Communication
     bool SendCommand(const std::string& command);
     bool SendLine(const std::string& line);
+    // Returns "" on timeout, or once the process has exited and all of
+    // its output has been read
     std::string ReadLine(int timeoutMs = -1);
     std::string ReadAll();
     bool HasOutput() const;
     
+    // Readable while output is queued or the process has exited (-1 on Windows)
+    int GetOutputEventFd() const;
+    
     // Callbacks
     std::function<void(const std::string&)> onStdout;
     std::function<void(const std::string&)> onStderr;
@@ -49,8 +62,16 @@ public:
     int GetPid() const { return pid_; }
     
 private:
+    void QueueLines(std::vector<std::string>& lines);
+    void MarkExited(int status);
+    void SignalOutput();
+    
+#ifdef _WIN32
     void ReadThreadFunc();
     void ErrorThreadFunc();
+#else
+    void IoThreadFunc();
+#endif
     
 #ifdef _WIN32
     // Windows handles
@@ -64,20 +85,32 @@ private:
     int stdinFd_ = -1;
     int stdoutFd_ = -1;
     int stderrFd_ = -1;
+    int pidFd_ = -1;                    // Readable when the process exits
+    
+    // eventfd on Linux (the write fd is the same fd), a pipe elsewhere
+    int wakeFd_ = -1;                   // Stops the I/O thread
+    int wakeWriteFd_ = -1;
+    int outputEventFd_ = -1;            // Readable while output is queued
+    int outputEventWriteFd_ = -1;
 #endif
     
     int pid_ = -1;
     std::atomic<bool> running_{false};
+    std::atomic<bool> exited_{false};   // Process reaped by the I/O thread
     std::atomic<int> exitCode_{-1};
     
     // Output buffering
     std::queue<std::string> outputQueue_;
-    std::mutex outputMutex_;
-    std::condition_variable outputCv_;
+    mutable std::mutex outputMutex_;
+    std::condition_variable outputCv_;  // Line queued (Windows) or process exited
     
     // Threads
+#ifdef _WIN32
     std::thread readThread_;
     std::thread errorThread_;
+#else
+    std::thread ioThread_;
+#endif
     std::atomic<bool> stopThreads_{false};
 };
 
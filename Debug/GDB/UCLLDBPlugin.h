@@ -9,6 +9,8 @@
 #include <thread>
 #include <mutex>
 #include <atomic>
+#include <deque>
+#include <future>
 
 namespace UltraCanvas {
 namespace IDE {
@@ -29,6 +31,13 @@ struct LLDBPluginConfig {
  * 
  * Implements IUCDebuggerPlugin for LLVM Debugger (LLDB).
  * Uses LLDB's command-line interface for debugging operations.
+ *
+ * LLDB is started with a private prompt, and the output thread splits its
+ * output at that prompt: each piece is the complete output of the oldest
+ * command still waiting, or an asynchronous report (a stop, program
+ * output) when no command claims it. Commands are written as soon as they
+ * are issued, so several can be in flight; callers wait only for the
+ * results they use.
  */
 class UCLLDBPlugin : public IUCDebuggerPlugin {
 public:
@@ -133,7 +142,29 @@ public:
     std::vector<DebugCompletionItem> GetCompletions(const std::string& text, int column) override;
     
 private:
+    /**
+     * @brief A command written to LLDB, waiting for the prompt that ends its output
+     */
+    struct PendingCommand {
+        std::string command;
+        bool runControl = false;            // Its output may report a stop
+        std::promise<std::string> result;
+    };
+    
+    // Process startup (also starts the output thread)
+    bool StartLLDB(const std::vector<std::string>& args);
+    
+    // Command execution
     std::string SendCommand(const std::string& command);
+    std::future<std::string> PostCommand(const std::string& command, bool runControl = false);
+    std::vector<std::future<std::string>> PostCommands(const std::vector<std::string>& commands,
+                                                       bool runControl = false);
+    std::string WaitForResult(std::future<std::string>& future);
+    void FailPendingCommands();
+    
+    // Output processing
+    bool ReadOutput(int timeoutMs);
+    void DispatchChunk(std::string chunk);
     void ProcessOutput(const std::string& output);
     void SetState(DebugSessionState newState);
     void Cleanup();
@@ -158,9 +189,18 @@ private:
 #else
     int pid_ = -1;
     int stdinFd_ = -1;
-    int stdoutFd_ = -1;
+    int stdoutFd_ = -1;                 // stdout and stderr, non-blocking
+    int wakeReadFd_ = -1;               // Stops the output thread
+    int wakeWriteFd_ = -1;
 #endif
     
+    // Output read so far; searched for the prompt from promptScan_ on
+    std::string outputBuffer_;
+    size_t promptScan_ = 0;
+    
+    std::deque<PendingCommand> pendingCommands_;
+    std::mutex commandMutex_;           // pendingCommands_ and writes to LLDB
+    
     std::thread outputThread_;
     std::atomic<bool> stopOutputThread_{false};
     mutable std::mutex mutex_;
@@ -346,6 +346,15 @@ enum class MemoryUnitSize {
     QuadWord        // 16 bytes
 };
 
+/**
+ * @brief What a memory search compares
+ */
+enum class MemorySearchKind {
+    Bytes,          // Literal byte patterns (bytes, text, integers)
+    Float,          // 4-byte floats within a tolerance
+    Double          // 8-byte doubles within a tolerance
+};
+
 // ============================================================================
 // REGISTER CATEGORY
 // ============================================================================
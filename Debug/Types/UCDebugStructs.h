@@ -313,6 +313,9 @@ struct Variable {
     bool isPointer = false;                 // Is a pointer type
     bool isReference = false;               // Is a reference type
     bool isDereferenced = false;            // Has been dereferenced
+    bool valueChanged = false;              // Changed since the previous stop
+    bool valueTruncated = false;            // Cut at the debugger's length limit
+    int valueReference = 0;                 // Reference for loading the whole value
     
     std::string errorMessage;               // Error if evaluation failed
     
@@ -398,6 +401,60 @@ struct MemoryRegion {
     }
 };
 
+// ============================================================================
+// MEMORY SEARCH
+// ============================================================================
+
+/**
+ * @brief Memory search: literal byte patterns, or floats within a tolerance
+ * 
+ * Values are encoded little-endian. A text search carries one pattern per
+ * encoding and matches any of them.
+ */
+struct MemorySearchQuery {
+    MemorySearchKind kind = MemorySearchKind::Bytes;
+    std::vector<std::vector<uint8_t>> patterns;  // Bytes searches
+    double value = 0.0;                     // Float and Double searches
+    double tolerance = 0.0;
+    size_t alignment = 1;                   // Matches start at multiples of this
+    uint64_t startAddress = 0;
+    uint64_t endAddress = UINT64_MAX;       // Exclusive; UINT64_MAX for all memory
+    size_t maxResults = 100000;
+    
+    static MemorySearchQuery ForBytes(std::vector<uint8_t> pattern);
+    
+    // UTF-8 text, and with wide also its UTF-16LE and UTF-32LE encodings
+    static MemorySearchQuery ForText(const std::string& text, bool wide = true);
+    
+    // A size-byte integer at its natural alignment
+    static MemorySearchQuery ForInteger(int64_t value, size_t size);
+    
+    static MemorySearchQuery ForFloat(double value, double tolerance, bool isDouble);
+    
+    // Bytes a match spans at most
+    size_t MatchLength() const;
+    
+    /**
+     * @brief Report matches in a block of memory
+     * @param address Address of data[0]
+     * @param starts Only matches starting in the first starts bytes count;
+     *               the rest of the block lets them run past it
+     * @param onMatch Called per match; returning false ends the scan
+     * @return false if onMatch ended the scan
+     */
+    bool Scan(uint64_t address, const uint8_t* data, size_t size, size_t starts,
+              const std::function<bool(uint64_t)>& onMatch) const;
+};
+
+/**
+ * @brief Outcome of a memory search
+ */
+struct MemorySearchResult {
+    bool success = false;
+    size_t matchCount = 0;                  // Matches reported
+    std::string errorMessage;               // Why the search could not run
+};
+
 // ============================================================================
 // DISASSEMBLY LINE
 // ============================================================================
@@ -623,6 +680,22 @@ struct EvaluationResult {
     }
 };
 
+// ============================================================================
+// STOP STATE
+// ============================================================================
+
+/**
+ * @brief What the debug panels show after a stop, fetched as one batch
+ */
+struct DebugStopState {
+    int threadId = -1;                      // Thread the stack belongs to
+    int maxFrames = 0;                      // Depth requested for callStack
+    std::vector<StackFrame> callStack;
+    std::vector<Variable> locals;           // Top frame
+    std::vector<Variable> arguments;        // Top frame
+    std::map<std::string, EvaluationResult> watchValues;
+};
+
 // ============================================================================
 // COMPLETION ITEM
 // ============================================================================
@@ -0,0 +1,145 @@
+// Apps/IDE/Debug/Types/UCMemorySearch.cpp
+// Memory Search Query Implementation for ULTRA IDE
+// Version: 1.0.0
+// Last Modified: 2025-12-28
+// Author: UltraCanvas Framework / ULTRA IDE
+
+#include "UCDebugStructs.h"
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+
+namespace UltraCanvas {
+namespace IDE {
+
+// ============================================================================
+// MEMORY SEARCH QUERY
+// ============================================================================
+
+MemorySearchQuery MemorySearchQuery::ForBytes(std::vector<uint8_t> pattern) {
+    MemorySearchQuery query;
+    query.patterns.push_back(std::move(pattern));
+    return query;
+}
+
+MemorySearchQuery MemorySearchQuery::ForText(const std::string& text, bool wide) {
+    MemorySearchQuery query;
+    query.patterns.emplace_back(text.begin(), text.end());
+    if (!wide) return query;
+    
+    std::vector<uint8_t> utf16;
+    std::vector<uint8_t> utf32;
+    for (size_t i = 0; i < text.size(); ) {
+        uint8_t lead = static_cast<uint8_t>(text[i]);
+        size_t length = lead < 0x80 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+        uint32_t cp = length == 1 ? lead : lead & (0x7F >> length);
+        for (size_t k = 1; k < length && i + k < text.size(); k++) {
+            cp = (cp << 6) | (static_cast<uint8_t>(text[i + k]) & 0x3F);
+        }
+        i += length;
+        
+        for (int shift = 0; shift < 32; shift += 8) {
+            utf32.push_back(static_cast<uint8_t>(cp >> shift));
+        }
+        uint32_t units[2] = {cp, 0};
+        if (cp >= 0x10000) {
+            units[0] = 0xD800 + ((cp - 0x10000) >> 10);
+            units[1] = 0xDC00 + ((cp - 0x10000) & 0x3FF);
+        }
+        for (uint32_t unit : units) {
+            if (unit == 0) break;
+            utf16.push_back(static_cast<uint8_t>(unit));
+            utf16.push_back(static_cast<uint8_t>(unit >> 8));
+        }
+    }
+    query.patterns.push_back(std::move(utf16));
+    query.patterns.push_back(std::move(utf32));
+    return query;
+}
+
+MemorySearchQuery MemorySearchQuery::ForInteger(int64_t value, size_t size) {
+    MemorySearchQuery query;
+    std::vector<uint8_t> pattern(size);
+    for (size_t i = 0; i < size && i < 8; i++) {
+        pattern[i] = static_cast<uint8_t>(static_cast<uint64_t>(value) >> (i * 8));
+    }
+    query.patterns.push_back(std::move(pattern));
+    query.alignment = size;
+    return query;
+}
+
+MemorySearchQuery MemorySearchQuery::ForFloat(double value, double tolerance, bool isDouble) {
+    MemorySearchQuery query;
+    query.kind = isDouble ? MemorySearchKind::Double : MemorySearchKind::Float;
+    query.value = value;
+    query.tolerance = tolerance;
+    query.alignment = isDouble ? 8 : 4;
+    return query;
+}
+
+size_t MemorySearchQuery::MatchLength() const {
+    if (kind == MemorySearchKind::Float) return 4;
+    if (kind == MemorySearchKind::Double) return 8;
+    size_t length = 1;
+    for (const auto& pattern : patterns) {
+        length = std::max(length, pattern.size());
+    }
+    return length;
+}
+
+bool MemorySearchQuery::Scan(uint64_t address, const uint8_t* data, size_t size, size_t starts,
+                             const std::function<bool(uint64_t)>& onMatch) const {
+    size_t align = std::max<size_t>(alignment, 1);
+    
+    if (kind != MemorySearchKind::Bytes) {
+        size_t width = kind == MemorySearchKind::Float ? 4 : 8;
+        size_t offset = (align - address % align) % align;
+        for (; offset < starts && offset + width <= size; offset += align) {
+            double v;
+            if (width == 4) {
+                float f;
+                std::memcpy(&f, data + offset, sizeof(f));
+                v = f;
+            } else {
+                std::memcpy(&v, data + offset, sizeof(v));
+            }
+            if (std::fabs(v - value) <= tolerance && !onMatch(address + offset)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    
+    for (const auto& pattern : patterns) {
+        if (pattern.empty() || pattern.size() > size) continue;
+        
+        // memchr for the first byte that is not 0x00 or 0xFF, the most
+        // common values in memory, then compare the whole pattern
+        size_t anchor = 0;
+        while (anchor + 1 < pattern.size() &&
+               (pattern[anchor] == 0x00 || pattern[anchor] == 0xFF)) {
+            anchor++;
+        }
+        
+        size_t limit = std::min(starts, size - pattern.size() + 1);
+        const uint8_t* p = data + anchor;
+        const uint8_t* last = data + anchor + limit;
+        while (p < last) {
+            p = static_cast<const uint8_t*>(std::memchr(p, pattern[anchor], last - p));
+            if (!p) break;
+            
+            const uint8_t* match = p - anchor;
+            uint64_t matchAddress = address + (match - data);
+            if (matchAddress % align == 0 &&
+                std::memcmp(match, pattern.data(), pattern.size()) == 0 &&
+                !onMatch(matchAddress)) {
+                return false;
+            }
+            p++;
+        }
+    }
+    return true;
+}
+
+} // namespace IDE
+} // namespace UltraCanvas
@@ -131,9 +131,8 @@ void UCDisassemblyPanel::Disassemble(uint64_t address, int count) {
     auto result = debugManager_->Disassemble(address, count);
     
     instructions_.clear();
-    addressToIndex_.clear();
+    instructions_.reserve(result.size());
     
-    int index = 0;
     for (const auto& inst : result) {
         DisassemblyInstruction di;
         di.address = inst.address;
@@ -159,7 +158,6 @@ void UCDisassemblyPanel::Disassemble(uint64_t address, int count) {
         di.hasBreakpoint = (breakpointAddresses_.find(inst.address) != breakpointAddresses_.end());
         
         instructions_.push_back(di);
-        addressToIndex_[inst.address] = index++;
     }
     
     // Update address input
@@ -193,10 +191,11 @@ void UCDisassemblyPanel::RefreshDisassembly() {
 
 void UCDisassemblyPanel::SetInstructions(const std::vector<DisassemblyInstruction>& instructions) {
     instructions_ = instructions;
-    addressToIndex_.clear();
     
-    for (size_t i = 0; i < instructions_.size(); i++) {
-        addressToIndex_[instructions_[i].address] = static_cast<int>(i);
+    if (!std::is_sorted(instructions_.begin(), instructions_.end(),
+                        [](const auto& a, const auto& b) { return a.address < b.address; })) {
+        std::stable_sort(instructions_.begin(), instructions_.end(),
+                         [](const auto& a, const auto& b) { return a.address < b.address; });
     }
     
     Invalidate();
@@ -242,10 +241,20 @@ void UCDisassemblyPanel::GoToCurrentInstruction() {
     if (!debugManager_ || !debugManager_->IsDebugging()) return;
     
     uint64_t pc = debugManager_->GetCurrentInstructionAddress();
-    if (pc != 0) {
+    if (pc == 0) return;
+    
+    // Stepping within the code on screen only moves the marker; the code
+    // itself does not change between stops
+    int index = FindInstruction(pc);
+    if (index >= 0 && index + GetVisibleInstructionCount() / 2 < static_cast<int>(instructions_.size())) {
+        for (auto& inst : instructions_) {
+            inst.isCurrentInstruction = false;
+        }
+        instructions_[index].isCurrentInstruction = true;
+    } else {
         GoToAddress(pc);
-        SetSelectedAddress(pc);
     }
+    SetSelectedAddress(pc);
 }
 
 void UCDisassemblyPanel::GoToFunction(const std::string& functionName) {
@@ -253,10 +262,10 @@ void UCDisassemblyPanel::GoToFunction(const std::string& functionName) {
 }
 
 void UCDisassemblyPanel::ScrollToAddress(uint64_t address) {
-    auto it = addressToIndex_.find(address);
-    if (it != addressToIndex_.end()) {
+    int index = FindInstruction(address);
+    if (index >= 0) {
         int visibleRows = GetVisibleInstructionCount();
-        scrollOffset_ = std::max(0, it->second - visibleRows / 2);
+        scrollOffset_ = std::max(0, index - visibleRows / 2);
         Invalidate();
     }
 }
@@ -267,13 +276,22 @@ void UCDisassemblyPanel::SetShowSourceMapping(bool show) {
 }
 
 int UCDisassemblyPanel::GetSourceLineForAddress(uint64_t address) const {
-    auto it = addressToIndex_.find(address);
-    if (it != addressToIndex_.end() && it->second < static_cast<int>(instructions_.size())) {
-        return instructions_[it->second].sourceLine;
+    int index = FindInstruction(address);
+    if (index >= 0) {
+        return instructions_[index].sourceLine;
     }
     return -1;
 }
 
+int UCDisassemblyPanel::FindInstruction(uint64_t address) const {
+    auto it = std::lower_bound(instructions_.begin(), instructions_.end(), address,
+        [](const DisassemblyInstruction& inst, uint64_t addr) { return inst.address < addr; });
+    if (it == instructions_.end() || it->address != address) {
+        return -1;
+    }
+    return static_cast<int>(it - instructions_.begin());
+}
+
 uint64_t UCDisassemblyPanel::GetAddressForSourceLine(const std::string& file, int line) const {
     for (const auto& inst : instructions_) {
         if (inst.sourceLine == line && inst.sourceFile == file) {
@@ -300,9 +318,9 @@ void UCDisassemblyPanel::SetBreakpoint(uint64_t address) {
     breakpointAddresses_.insert(address);
     
     // Update instruction
-    auto it = addressToIndex_.find(address);
-    if (it != addressToIndex_.end()) {
-        instructions_[it->second].hasBreakpoint = true;
+    int index = FindInstruction(address);
+    if (index >= 0) {
+        instructions_[index].hasBreakpoint = true;
     }
     
     if (onBreakpointToggled) {
@@ -315,9 +333,9 @@ void UCDisassemblyPanel::SetBreakpoint(uint64_t address) {
 void UCDisassemblyPanel::ClearBreakpoint(uint64_t address) {
     breakpointAddresses_.erase(address);
     
-    auto it = addressToIndex_.find(address);
-    if (it != addressToIndex_.end()) {
-        instructions_[it->second].hasBreakpoint = false;
+    int index = FindInstruction(address);
+    if (index >= 0) {
+        instructions_[index].hasBreakpoint = false;
     }
     
     if (onBreakpointToggled) {
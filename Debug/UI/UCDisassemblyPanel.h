@@ -14,7 +14,6 @@
 #include "../Core/UCDebugManager.h"
 #include <functional>
 #include <memory>
-#include <map>
 #include <set>
 
 namespace UltraCanvas {
@@ -119,6 +118,7 @@ private:
     Color GetInstructionColor(const DisassemblyInstruction& inst) const;
     Color GetOperandColor(const std::string& operand) const;
     int GetInstructionAtY(int y) const;
+    int FindInstruction(uint64_t address) const;
     int GetVisibleInstructionCount() const;
     std::string FormatAddress(uint64_t address) const;
     std::string FormatBytes(const std::string& bytes) const;
@@ -131,7 +131,7 @@ private:
     std::shared_ptr<UltraCanvasCheckbox> showSourceCheckbox_;
     std::shared_ptr<UltraCanvasCheckbox> showBytesCheckbox_;
     
-    std::vector<DisassemblyInstruction> instructions_;
+    std::vector<DisassemblyInstruction> instructions_;   // By address
     uint64_t currentAddress_ = 0;
     uint64_t selectedAddress_ = 0;
     int scrollOffset_ = 0;
@@ -145,7 +145,6 @@ private:
     int rowHeight_ = 18;
     int leftMargin_ = 8;
     
-    std::map<uint64_t, int> addressToIndex_;
     std::set<uint64_t> breakpointAddresses_;
     std::string lastSourceFile_;
     int lastSourceLine_ = -1;
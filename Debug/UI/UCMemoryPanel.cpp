@@ -18,6 +18,10 @@ UCMemoryPanel::UCMemoryPanel(const std::string& id, int x, int y, int width, int
     SetBackgroundColor(Color(255, 255, 255));
 }
 
+UCMemoryPanel::~UCMemoryPanel() {
+    CancelSearch();
+}
+
 void UCMemoryPanel::Initialize() {
     CreateUI();
 }
@@ -33,6 +37,7 @@ void UCMemoryPanel::SetDebugManager(UCDebugManager* manager) {
         debugManager_->onStateChange = [this](DebugSessionState oldState, DebugSessionState newState) {
             if (newState == DebugSessionState::Inactive || 
                 newState == DebugSessionState::Terminated) {
+                searchCancelled_ = true;
                 memoryData_.clear();
                 previousData_.clear();
                 changedBytes_.clear();
@@ -125,7 +130,7 @@ void UCMemoryPanel::CreateUI() {
         "memory_scroll", 0, GetWidth() - 16, headerHeight_, 16, GetHeight() - headerHeight_);
     scrollBar_->SetOrientation(ScrollBarOrientation::Vertical);
     scrollBar_->SetOnScroll([this](int position) {
-        currentAddress_ = position * bytesPerRow_;
+        currentAddress_ = scrollBase_ + static_cast<uint64_t>(position) * bytesPerRow_;
         RefreshMemory();
     });
     AddChild(scrollBar_);
@@ -134,6 +139,7 @@ void UCMemoryPanel::CreateUI() {
 void UCMemoryPanel::GoToAddress(uint64_t address) {
     // Align to row boundary
     currentAddress_ = (address / bytesPerRow_) * bytesPerRow_;
+    scrollBase_ = currentAddress_ - std::min(currentAddress_, scrollWindow_ / 2);
     
     std::ostringstream ss;
     ss << "0x" << std::hex << std::uppercase << address;
@@ -205,20 +211,27 @@ void UCMemoryPanel::RefreshMemory() {
     }
     
     // Save previous data for change detection
-    previousData_ = memoryData_;
+    previousData_ = std::move(memoryData_);
     
-    // Read memory
-    memoryData_ = debugManager_->ReadMemory(currentAddress_, memorySize_);
+    // Read memory; the plugin caches it by page while the target is
+    // paused, so scrolling costs a copy rather than a round trip
+    size_t size = std::max(memorySize_, GetVisibleRows() * bytesPerRow_);
+    memoryData_ = debugManager_->ReadMemory(currentAddress_, size).data;
     
-    // Detect changes
-    changedBytes_.clear();
-    if (previousData_.size() == memoryData_.size()) {
-        for (size_t i = 0; i < memoryData_.size(); i++) {
-            if (memoryData_[i] != previousData_[i]) {
-                changedBytes_.insert(currentAddress_ + i);
-            }
+    // Detect changes over the addresses both reads cover. A new stop at the
+    // same address replaces the highlights; scrolling keeps them.
+    if (currentAddress_ == previousAddress_) {
+        changedBytes_.clear();
+    }
+    uint64_t overlapStart = std::max(currentAddress_, previousAddress_);
+    uint64_t overlapEnd = std::min(currentAddress_ + memoryData_.size(),
+                                   previousAddress_ + previousData_.size());
+    for (uint64_t address = overlapStart; address < overlapEnd; address++) {
+        if (memoryData_[address - currentAddress_] != previousData_[address - previousAddress_]) {
+            changedBytes_.insert(address);
         }
     }
+    previousAddress_ = currentAddress_;
     
     UpdateScrollBar();
     Invalidate();
@@ -380,12 +393,16 @@ int UCMemoryPanel::GetVisibleRows() const {
 }
 
 void UCMemoryPanel::UpdateScrollBar() {
-    int totalRows = memorySize_ / bytesPerRow_;
+    int totalRows = static_cast<int>(scrollWindow_ / bytesPerRow_);
     int visibleRows = GetVisibleRows();
     
+    if (currentAddress_ < scrollBase_ || currentAddress_ >= scrollBase_ + scrollWindow_) {
+        scrollBase_ = currentAddress_ - std::min(currentAddress_, scrollWindow_ / 2);
+    }
+    
     scrollBar_->SetRange(0, totalRows);
     scrollBar_->SetPageSize(visibleRows);
-    scrollBar_->SetPosition(static_cast<int>(currentAddress_ / bytesPerRow_));
+    scrollBar_->SetPosition(static_cast<int>((currentAddress_ - scrollBase_) / bytesPerRow_));
 }
 
 void UCMemoryPanel::HandleRender(IRenderContext* ctx) {
@@ -559,8 +576,11 @@ Color UCMemoryPanel::GetByteColor(uint64_t address) const {
     }
     
     // Search highlight
-    for (uint64_t searchAddr : searchHighlights_) {
-        if (address == searchAddr) {
+    {
+        std::lock_guard<std::mutex> lock(searchMutex_);
+        auto next = searchHighlights_.upper_bound(address);
+        if (next != searchHighlights_.begin() &&
+            address - *std::prev(next) < searchMatchLength_) {
             return Color(255, 165, 0);  // Orange
         }
     }
@@ -675,22 +695,146 @@ uint64_t UCMemoryPanel::GetAddressAtPosition(int x, int y) const {
 }
 
 bool UCMemoryPanel::SearchBytes(const std::vector<uint8_t>& pattern, bool forward) {
-    // Search implementation
-    return false;
+    if (pattern.empty()) return false;
+    return StartSearch(MemorySearchQuery::ForBytes(pattern), forward);
 }
 
 bool UCMemoryPanel::SearchString(const std::string& text, bool forward) {
-    std::vector<uint8_t> pattern(text.begin(), text.end());
-    return SearchBytes(pattern, forward);
+    if (text.empty()) return false;
+    return StartSearch(MemorySearchQuery::ForText(text), forward);
+}
+
+bool UCMemoryPanel::StartSearch(const MemorySearchQuery& query, bool forward) {
+    if (!debugManager_ || !debugManager_->IsDebugging()) {
+        return false;
+    }
+    
+    CancelSearch();
+    {
+        std::lock_guard<std::mutex> lock(searchMutex_);
+        searchHighlights_.clear();
+        searchMatchLength_ = query.MatchLength();
+        searchHighlightsChanged_ = true;
+        searchFinished_ = false;
+        searchForward_ = forward;
+        searchError_.clear();
+    }
+    searchCancelled_ = false;
+    searching_ = true;
+    Invalidate();
+    
+    // The panel is only touched from the UI thread; this thread records
+    // matches and the result for Update() to apply
+    searchThread_ = std::thread([this, query]() {
+        MemorySearchResult result = debugManager_->SearchMemory(query, [this](uint64_t address) {
+            std::lock_guard<std::mutex> lock(searchMutex_);
+            searchHighlights_.insert(address);
+            searchHighlightsChanged_ = true;
+            return !searchCancelled_;
+        }, &searchCancelled_);
+        
+        std::lock_guard<std::mutex> lock(searchMutex_);
+        searchMatchCount_ = result.matchCount;
+        searchError_ = result.success ? std::string() : result.errorMessage;
+        searchFinished_ = true;
+        searching_ = false;
+    });
+    
+    return true;
+}
+
+void UCMemoryPanel::Update() {
+    bool changed = false;
+    bool finished = false;
+    bool forward = true;
+    size_t count = 0;
+    std::string error;
+    {
+        std::lock_guard<std::mutex> lock(searchMutex_);
+        changed = searchHighlightsChanged_;
+        finished = searchFinished_;
+        forward = searchForward_;
+        count = searchMatchCount_;
+        error = searchError_;
+        searchHighlightsChanged_ = false;
+        searchFinished_ = false;
+    }
+    
+    if (finished) {
+        // The thread has nothing left to do but return
+        if (searchThread_.joinable()) {
+            searchThread_.join();
+        }
+        if (!error.empty()) {
+            // Not "no matches": the target could not be searched at all
+            if (onSearchFailed) {
+                onSearchFailed(error);
+            }
+        } else {
+            if (!searchCancelled_) {
+                GoToNextSearchResult(forward);
+            }
+            if (onSearchFinished) {
+                onSearchFinished(count);
+            }
+        }
+    }
+    
+    if (changed || finished) {
+        Invalidate();
+    }
+}
+
+void UCMemoryPanel::CancelSearch() {
+    searchCancelled_ = true;
+    if (searchThread_.joinable()) {
+        searchThread_.join();
+    }
+}
+
+size_t UCMemoryPanel::GetSearchResultCount() const {
+    std::lock_guard<std::mutex> lock(searchMutex_);
+    return searchHighlights_.size();
+}
+
+std::string UCMemoryPanel::GetSearchError() const {
+    std::lock_guard<std::mutex> lock(searchMutex_);
+    return searchError_;
+}
+
+bool UCMemoryPanel::GoToNextSearchResult(bool forward) {
+    uint64_t target = 0;
+    {
+        std::lock_guard<std::mutex> lock(searchMutex_);
+        if (searchHighlights_.empty()) return false;
+        
+        // The nearest match past the top of the view, wrapping around
+        if (forward) {
+            auto next = searchHighlights_.upper_bound(currentAddress_);
+            target = next != searchHighlights_.end() ? *next : *searchHighlights_.begin();
+        } else {
+            auto next = searchHighlights_.lower_bound(currentAddress_);
+            target = next != searchHighlights_.begin() ? *std::prev(next) : *searchHighlights_.rbegin();
+        }
+    }
+    
+    GoToAddress(target);
+    return true;
 }
 
 void UCMemoryPanel::HighlightSearchResults(const std::vector<uint64_t>& addresses) {
-    searchHighlights_ = addresses;
+    {
+        std::lock_guard<std::mutex> lock(searchMutex_);
+        searchHighlights_ = std::set<uint64_t>(addresses.begin(), addresses.end());
+    }
     Invalidate();
 }
 
 void UCMemoryPanel::ClearSearchHighlights() {
-    searchHighlights_.clear();
+    {
+        std::lock_guard<std::mutex> lock(searchMutex_);
+        searchHighlights_.clear();
+    }
     Invalidate();
 }
 
@@ -16,6 +16,10 @@
 #include <memory>
 #include <vector>
 #include <cstdint>
+#include <set>
+#include <thread>
+#include <mutex>
+#include <atomic>
 
 namespace UltraCanvas {
 namespace IDE {
@@ -73,7 +77,7 @@ struct MemoryEdit {
 class UCMemoryPanel : public UltraCanvasContainer {
 public:
     UCMemoryPanel(const std::string& id, int x, int y, int width, int height);
-    ~UCMemoryPanel() override = default;
+    ~UCMemoryPanel() override;
     
     // =========================================================================
     // INITIALIZATION
@@ -151,11 +155,26 @@ public:
     // SEARCH
     // =========================================================================
     
+    // Searches run over the whole target in the background: matches are
+    // highlighted as they arrive, then the view moves to the nearest one.
+    // Matches and the end of a search are applied by Update(). A target
+    // that cannot be searched whole ends in onSearchFailed, not 0 matches
     bool SearchBytes(const std::vector<uint8_t>& pattern, bool forward = true);
     bool SearchString(const std::string& text, bool forward = true);
+    bool StartSearch(const MemorySearchQuery& query, bool forward = true);
+    void CancelSearch();
+    bool IsSearching() const { return searching_; }
+    size_t GetSearchResultCount() const;
+    std::string GetSearchError() const;
+    bool GoToNextSearchResult(bool forward = true);
     void HighlightSearchResults(const std::vector<uint64_t>& addresses);
     void ClearSearchHighlights();
     
+    /**
+     * @brief Apply search progress - call periodically from the UI loop
+     */
+    void Update();
+    
     // =========================================================================
     // WATCHPOINTS
     // =========================================================================
@@ -172,6 +191,8 @@ public:
     std::function<void(uint64_t address, const std::vector<uint8_t>& data)> onMemoryEdited;
     std::function<void(uint64_t address)> onSelectionChanged;
     std::function<void(uint64_t address)> onAddWatchpoint;
+    std::function<void(size_t matchCount)> onSearchFinished;
+    std::function<void(const std::string& error)> onSearchFailed;
     
 protected:
     void HandleRender(IRenderContext* ctx) override;
@@ -215,10 +236,16 @@ private:
     
     // Memory data
     uint64_t currentAddress_ = 0;
+    uint64_t previousAddress_ = 0;          // Address of previousData_
     std::vector<uint8_t> memoryData_;
     std::vector<uint8_t> previousData_;
     int memorySize_ = 1024;  // Bytes to read
     
+    // The scroll bar spans scrollWindow_ bytes from scrollBase_, recentred
+    // when scrolling leaves it
+    uint64_t scrollBase_ = 0;
+    uint64_t scrollWindow_ = 256ULL * 1024 * 1024;
+    
     // Display settings
     MemoryDisplayFormat displayFormat_ = MemoryDisplayFormat::Bytes;
     MemoryDataType dataType_ = MemoryDataType::Hexadecimal;
@@ -246,8 +273,20 @@ private:
     std::string editBuffer_;
     int editNibble_ = 0;
     
-    // Search highlights
-    std::vector<uint64_t> searchHighlights_;
+    // Search highlights: match addresses, filled in by the search thread.
+    // The thread only records its progress here; Update() repaints and,
+    // once searchFinished_ is set, moves to a match on the UI thread
+    std::set<uint64_t> searchHighlights_;
+    size_t searchMatchLength_ = 1;
+    bool searchHighlightsChanged_ = false;
+    bool searchFinished_ = false;
+    bool searchForward_ = true;
+    size_t searchMatchCount_ = 0;
+    std::string searchError_;               // Why the last search could not run
+    mutable std::mutex searchMutex_;
+    std::thread searchThread_;
+    std::atomic<bool> searching_{false};
+    std::atomic<bool> searchCancelled_{false};
     
     // Watched addresses
     std::set<uint64_t> watchedAddresses_;
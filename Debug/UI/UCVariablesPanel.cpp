@@ -7,6 +7,7 @@
 #include "UCVariablesPanel.h"
 #include "UltraCanvasButton.h"
 #include <sstream>
+#include <algorithm>
 
 namespace UltraCanvas {
 namespace IDE {
@@ -138,7 +139,8 @@ void UCVariablesPanel::Clear() {
     currentLocals_.clear();
     currentArgs_.clear();
     currentWatches_.clear();
-    nodeToVariableRef_.clear();
+    nodeToChildRange_.clear();
+    nodeToValueRange_.clear();
     nextNodeId_ = 1;
     
     if (variablesTree_) {
@@ -208,7 +210,8 @@ void UCVariablesPanel::PopulateTree(const std::vector<Variable>& variables, Tree
     
     if (parentId == 0) {
         variablesTree_->Clear();
-        nodeToVariableRef_.clear();
+        nodeToChildRange_.clear();
+        nodeToValueRange_.clear();
         nextNodeId_ = 1;
     }
     
@@ -251,12 +254,20 @@ void UCVariablesPanel::AddVariableNode(const Variable& var, TreeNodeId parentId)
     
     // Track variable reference for expansion
     if (var.hasChildren && var.variablesReference > 0) {
-        nodeToVariableRef_[nodeId] = var.variablesReference;
+        ChildRange range;
+        range.variablesReference = var.variablesReference;
+        range.total = var.indexedVariables > 0 ? var.indexedVariables : var.namedVariables;
+        nodeToChildRange_[nodeId] = range;
         
         // Add placeholder child so expand button shows
         TreeNodeData placeholder;
         placeholder.text = "Loading...";
         variablesTree_->AddNode(nextNodeId_++, placeholder, nodeId);
+    } else if (var.valueTruncated || var.value.length() > valueLineLength_) {
+        // The node shows the start of a long string; this lists all of it
+        ValueRange range;
+        range.variable = var;
+        AddValueNode("Show full value", range, nodeId);
     }
     
     // Add children if already loaded
@@ -268,26 +279,151 @@ void UCVariablesPanel::AddVariableNode(const Variable& var, TreeNodeId parentId)
 }
 
 void UCVariablesPanel::ExpandVariable(TreeNodeId nodeId) {
-    auto it = nodeToVariableRef_.find(nodeId);
-    if (it == nodeToVariableRef_.end()) return;
+    auto value = nodeToValueRange_.find(nodeId);
+    if (value != nodeToValueRange_.end()) {
+        ValueRange range = std::move(value->second);
+        nodeToValueRange_.erase(value);
+        ExpandValue(nodeId, range);
+        return;
+    }
+    
+    auto it = nodeToChildRange_.find(nodeId);
+    if (it == nodeToChildRange_.end()) return;
     
     if (!debugManager_ || !debugManager_->IsDebugging()) return;
     
-    int variablesRef = it->second;
-    auto children = debugManager_->ExpandVariable(variablesRef);
+    ChildRange range = it->second;
     
-    // Remove placeholder and add real children
+    // Don't expand again
+    nodeToChildRange_.erase(it);
+    
+    // Remove placeholder
     auto existingChildren = variablesTree_->GetChildren(nodeId);
     for (auto childId : existingChildren) {
         variablesTree_->RemoveNode(childId);
     }
     
+    // More children than a page: show buckets that load on expansion
+    int count = range.count > 0 ? range.count : range.total - range.start;
+    if (count > childPageSize_) {
+        AddBucketNodes(range, nodeId);
+        return;
+    }
+    
+    // Without a count (some pretty printers) read a page at a time
+    if (count <= 0) count = childPageSize_;
+    auto children = debugManager_->ExpandVariable(range.variablesReference, range.start, count);
     for (const auto& child : children) {
         AddVariableNode(child, nodeId);
     }
     
-    // Don't expand again
-    nodeToVariableRef_.erase(it);
+    if (range.total == 0 && static_cast<int>(children.size()) == count) {
+        ChildRange more;
+        more.variablesReference = range.variablesReference;
+        more.start = range.start + count;
+        AddRangeNode("[" + std::to_string(more.start) + "...]", more, nodeId);
+    }
+}
+
+void UCVariablesPanel::AddRangeNode(const std::string& text, const ChildRange& range,
+                                    TreeNodeId parentId) {
+    TreeNodeId nodeId = nextNodeId_++;
+    
+    TreeNodeData nodeData;
+    nodeData.text = text;
+    nodeData.textColor = Color(100, 100, 100);
+    variablesTree_->AddNode(nodeId, nodeData, parentId);
+    nodeToChildRange_[nodeId] = range;
+    
+    TreeNodeData placeholder;
+    placeholder.text = "Loading...";
+    variablesTree_->AddNode(nextNodeId_++, placeholder, nodeId);
+}
+
+void UCVariablesPanel::AddBucketNodes(const ChildRange& range, TreeNodeId parentId) {
+    int count = range.count > 0 ? range.count : range.total - range.start;
+    
+    // The smallest bucket size, in powers of the page size, that keeps the
+    // buckets to one page: 10 million elements give ten [0..999999]
+    // buckets of a thousand [0..999] buckets each
+    int64_t bucketSize = childPageSize_;
+    while ((count + bucketSize - 1) / bucketSize > childPageSize_) {
+        bucketSize *= childPageSize_;
+    }
+    
+    int end = range.start + count;
+    for (int64_t from = range.start; from < end; from += bucketSize) {
+        ChildRange bucket;
+        bucket.variablesReference = range.variablesReference;
+        bucket.start = static_cast<int>(from);
+        bucket.count = static_cast<int>(std::min<int64_t>(bucketSize, end - from));
+        bucket.total = range.total;
+        AddRangeNode("[" + std::to_string(bucket.start) + ".." +
+                     std::to_string(bucket.start + bucket.count - 1) + "]",
+                     bucket, parentId);
+    }
+}
+
+void UCVariablesPanel::AddValueNode(const std::string& text, const ValueRange& range,
+                                    TreeNodeId parentId) {
+    TreeNodeId nodeId = nextNodeId_++;
+    
+    TreeNodeData nodeData;
+    nodeData.text = text;
+    nodeData.textColor = Color(100, 100, 100);
+    variablesTree_->AddNode(nodeId, nodeData, parentId);
+    nodeToValueRange_[nodeId] = range;
+    
+    TreeNodeData placeholder;
+    placeholder.text = "Loading...";
+    variablesTree_->AddNode(nextNodeId_++, placeholder, nodeId);
+}
+
+void UCVariablesPanel::ExpandValue(TreeNodeId nodeId, const ValueRange& range) {
+    // Remove placeholder
+    auto existingChildren = variablesTree_->GetChildren(nodeId);
+    for (auto childId : existingChildren) {
+        variablesTree_->RemoveNode(childId);
+    }
+    
+    // Past what the debugger sent: ask again with a page more
+    Variable var = range.variable;
+    int maxLength = range.maxLength;
+    if (var.valueTruncated) {
+        if (!debugManager_ || !debugManager_->IsDebugging()) return;
+        
+        size_t page = static_cast<size_t>(childPageSize_) * valueLineLength_;
+        maxLength = static_cast<int>(std::max(static_cast<size_t>(range.maxLength), range.shown) + page);
+        EvaluationResult result = debugManager_->EvaluateFullValue(var, maxLength);
+        if (!result.success) {
+            TreeNodeData error;
+            error.text = result.errorMessage;
+            error.textColor = Color(200, 0, 0);
+            variablesTree_->AddNode(nextNodeId_++, error, nodeId);
+            return;
+        }
+        var = std::move(result.variable);
+    }
+    
+    // A cut value ends in "... and the closing quote or brace; the lines
+    // stop before them and the next page carries on from there
+    const std::string& text = var.value;
+    size_t end = var.valueTruncated ? text.size() - std::min<size_t>(text.size(), 4) : text.size();
+    size_t at = std::min(range.shown, end);
+    for (int lines = 0; at < end && lines < childPageSize_; lines++) {
+        TreeNodeData line;
+        line.text = text.substr(at, std::min(valueLineLength_, end - at));
+        variablesTree_->AddNode(nextNodeId_++, line, nodeId);
+        at += line.text.size();
+    }
+    
+    if (at < end || var.valueTruncated) {
+        ValueRange more;
+        more.variable = std::move(var);
+        more.shown = at;
+        more.maxLength = maxLength;
+        AddValueNode("Load more...", more, nodeId);
+    }
 }
 
 std::string UCVariablesPanel::GetVariableIcon(const Variable& var) const {
@@ -319,9 +455,8 @@ std::string UCVariablesPanel::FormatVariableValue(const Variable& var) const {
     std::string value = var.value;
     
     // Truncate very long values
-    const size_t maxLen = 100;
-    if (value.length() > maxLen) {
-        value = value.substr(0, maxLen) + "...";
+    if (value.length() > valueLineLength_) {
+        value = value.substr(0, valueLineLength_) + "...";
     }
     
     return value;
@@ -332,6 +467,10 @@ Color UCVariablesPanel::GetValueColor(const Variable& var) const {
         return Color(200, 0, 0);  // Red for errors
     }
     
+    if (var.valueChanged) {
+        return Color(230, 110, 0);  // Orange for values changed since the last stop
+    }
+    
     switch (var.category) {
         case VariableCategory::StringType:
             return Color(163, 21, 21);  // Brown for strings
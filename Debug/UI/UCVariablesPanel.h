@@ -79,10 +79,40 @@ protected:
     void HandleRender(IRenderContext* ctx) override;
     
 private:
+    /**
+     * @brief Children a collapsed node loads when it is expanded
+     *
+     * Either a variable's children or one "[0..999]" bucket of a large
+     * container, so that expanding a container fetches one page of it.
+     */
+    struct ChildRange {
+        int variablesReference = 0;
+        int start = 0;
+        int count = 0;                          // 0: all from start
+        int total = 0;                          // Child count, 0 if unknown
+    };
+    
+    /**
+     * @brief Part of a long value a collapsed node shows when it is expanded
+     *
+     * The value is listed a line at a time, one page per node. A value cut
+     * at the debugger's length limit is evaluated again with a limit one
+     * page longer than the last one.
+     */
+    struct ValueRange {
+        Variable variable;
+        size_t shown = 0;                       // Characters listed by earlier pages
+        int maxLength = 0;                      // Limit of the last evaluation, 0 if none
+    };
+    
     void CreateUI();
     void PopulateTree(const std::vector<Variable>& variables, TreeNodeId parentId = 0);
     void AddVariableNode(const Variable& var, TreeNodeId parentId);
     void ExpandVariable(TreeNodeId nodeId);
+    void AddRangeNode(const std::string& text, const ChildRange& range, TreeNodeId parentId);
+    void AddBucketNodes(const ChildRange& range, TreeNodeId parentId);
+    void AddValueNode(const std::string& text, const ValueRange& range, TreeNodeId parentId);
+    void ExpandValue(TreeNodeId nodeId, const ValueRange& range);
     std::string GetVariableIcon(const Variable& var) const;
     std::string FormatVariableValue(const Variable& var) const;
     Color GetValueColor(const Variable& var) const;
@@ -102,8 +132,11 @@ private:
     std::vector<Variable> currentArgs_;
     std::vector<WatchEntry> currentWatches_;
     
-    std::map<TreeNodeId, int> nodeToVariableRef_;  // For expansion
+    std::map<TreeNodeId, ChildRange> nodeToChildRange_;  // For expansion
+    std::map<TreeNodeId, ValueRange> nodeToValueRange_;
     TreeNodeId nextNodeId_ = 1;
+    int childPageSize_ = 1000;                  // Most children fetched or shown per level
+    size_t valueLineLength_ = 100;              // Characters of a value shown per line
 };
 
 } // namespace IDE
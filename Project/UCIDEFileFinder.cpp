@@ -0,0 +1,712 @@
+// Apps/IDE/Project/UCIDEFileFinder.cpp
+// "Go to File" engine implementation
+// Version: 1.0.0
+// Last Modified: 2026-10-17
+// Author: UltraCanvas Framework / ULTRA IDE
+
+#include "UCIDEFileFinder.h"
+#include <algorithm>
+#include <unordered_set>
+#include <cctype>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define UCIDE_FINDER_SSE2 1
+#endif
+
+namespace UltraCanvas {
+namespace IDE {
+
+// ============================================================================
+// CHARACTER HELPERS
+// ============================================================================
+
+namespace {
+
+constexpr int SCORE_MATCH = 16;
+constexpr int SCORE_GAP_START = -3;
+constexpr int SCORE_GAP_EXTENSION = -1;
+constexpr int BONUS_BOUNDARY = 8;
+constexpr int BONUS_BOUNDARY_DELIMITER = 9;
+constexpr int BONUS_CAMEL = 7;
+constexpr int BONUS_CONSECUTIVE = 4;
+constexpr int BONUS_FILE_NAME = 16;
+
+enum class CharClass { Lower, Upper, Digit, Delimiter, Other };
+
+inline CharClass ClassOf(char c) {
+    if (c >= 'a' && c <= 'z') return CharClass::Lower;
+    if (c >= 'A' && c <= 'Z') return CharClass::Upper;
+    if (c >= '0' && c <= '9') return CharClass::Digit;
+    if (c == '/' || c == '\\') return CharClass::Delimiter;
+    return CharClass::Other;
+}
+
+inline char Fold(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + 32) : c;
+}
+
+/**
+ * @brief Bit for a (case-folded) character in the 64-bit path mask
+ *
+ * a-z and 0-9 get their own bits, common path punctuation shares a few,
+ * everything else maps to bit 63.
+ */
+inline uint64_t CharBit(char c) {
+    c = Fold(c);
+    if (c >= 'a' && c <= 'z') return 1ULL << (c - 'a');
+    if (c >= '0' && c <= '9') return 1ULL << (26 + (c - '0'));
+    switch (c) {
+        case '/': case '\\': return 1ULL << 36;
+        case '.':            return 1ULL << 37;
+        case '_':            return 1ULL << 38;
+        case '-':            return 1ULL << 39;
+        case ' ':            return 1ULL << 40;
+        default:             return 1ULL << 63;
+    }
+}
+
+uint64_t ComputeMask(std::string_view s) {
+    uint64_t mask = 0;
+    for (char c : s) mask |= CharBit(c);
+    return mask;
+}
+
+inline uint32_t TrigramKey(char a, char b, char c) {
+    return (static_cast<uint32_t>(static_cast<unsigned char>(Fold(a))) << 16) |
+           (static_cast<uint32_t>(static_cast<unsigned char>(Fold(b))) << 8) |
+           static_cast<uint32_t>(static_cast<unsigned char>(Fold(c)));
+}
+
+std::vector<uint32_t> UniqueTrigrams(std::string_view s) {
+    std::vector<uint32_t> keys;
+    if (s.size() < 3) return keys;
+    keys.reserve(s.size() - 2);
+    for (size_t i = 0; i + 2 < s.size(); ++i) {
+        keys.push_back(TrigramKey(s[i], s[i + 1], s[i + 2]));
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    return keys;
+}
+
+inline int BonusFor(CharClass prev, CharClass cur) {
+    if (cur == CharClass::Delimiter || cur == CharClass::Other) return 0;
+    if (prev == CharClass::Delimiter) return BONUS_BOUNDARY_DELIMITER;
+    if (prev == CharClass::Other) return BONUS_BOUNDARY;
+    if (prev == CharClass::Lower && cur == CharClass::Upper) return BONUS_CAMEL;
+    if (prev != CharClass::Digit && cur == CharClass::Digit) return BONUS_CAMEL;
+    return 0;
+}
+
+inline bool CharsEqual(char textChar, char patternChar, bool caseSensitive) {
+    return (caseSensitive ? textChar : Fold(textChar)) == patternChar;
+}
+
+/**
+ * @brief fzf-style score for the matched window [start, end)
+ */
+int ScoreWindow(std::string_view text, std::string_view pattern, bool caseSensitive,
+                size_t start, size_t end, size_t nameOffset, std::vector<int>* positions) {
+    int score = 0;
+    int consecutive = 0;
+    int firstBonus = 0;
+    bool inGap = false;
+    size_t pidx = 0;
+    CharClass prevClass = start > 0 ? ClassOf(text[start - 1]) : CharClass::Delimiter;
+
+    for (size_t i = start; i < end; ++i) {
+        char c = text[i];
+        CharClass cls = ClassOf(c);
+
+        if (pidx < pattern.size() && CharsEqual(c, pattern[pidx], caseSensitive)) {
+            if (positions) positions->push_back(static_cast<int>(i));
+            score += SCORE_MATCH;
+
+            int bonus = BonusFor(prevClass, cls);
+            if (consecutive == 0) {
+                firstBonus = bonus;
+            } else {
+                if (bonus >= BONUS_BOUNDARY && bonus > firstBonus) firstBonus = bonus;
+                bonus = std::max({bonus, firstBonus, BONUS_CONSECUTIVE});
+            }
+            score += (pidx == 0) ? bonus * 2 : bonus;
+
+            inGap = false;
+            consecutive++;
+            pidx++;
+        } else {
+            score += inGap ? SCORE_GAP_EXTENSION : SCORE_GAP_START;
+            inGap = true;
+            consecutive = 0;
+            firstBonus = 0;
+        }
+        prevClass = cls;
+    }
+
+    if (start >= nameOffset) {
+        score += BONUS_FILE_NAME;
+    }
+    return score;
+}
+
+/**
+ * @brief Fuzzy subsequence match (fzf v1: forward scan, then backward
+ * scan to find the tightest window ending at the first full match)
+ */
+int FuzzyMatch(std::string_view text, std::string_view pattern, bool caseSensitive,
+               size_t nameOffset, std::vector<int>* positions) {
+    if (pattern.empty()) return 0;
+
+    size_t pidx = 0;
+    size_t end = std::string_view::npos;
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (CharsEqual(text[i], pattern[pidx], caseSensitive)) {
+            if (++pidx == pattern.size()) {
+                end = i + 1;
+                break;
+            }
+        }
+    }
+    if (end == std::string_view::npos) return -1;
+
+    size_t start = 0;
+    pidx = pattern.size() - 1;
+    for (size_t i = end; i-- > 0;) {
+        if (CharsEqual(text[i], pattern[pidx], caseSensitive)) {
+            if (pidx == 0) {
+                start = i;
+                break;
+            }
+            pidx--;
+        }
+    }
+
+    return ScoreWindow(text, pattern, caseSensitive, start, end, nameOffset, positions);
+}
+
+/**
+ * @brief Find an exact substring, honoring case folding
+ */
+size_t FindExact(std::string_view text, std::string_view pattern, bool caseSensitive, size_t from = 0) {
+    if (pattern.size() > text.size()) return std::string_view::npos;
+    for (size_t i = from; i + pattern.size() <= text.size(); ++i) {
+        size_t j = 0;
+        while (j < pattern.size() && CharsEqual(text[i + j], pattern[j], caseSensitive)) j++;
+        if (j == pattern.size()) return i;
+    }
+    return std::string_view::npos;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// QUERY PARSING
+// ============================================================================
+
+struct UCIDEFileFinder::QueryTerm {
+    enum class Kind { Fuzzy, Exact, Prefix, Suffix } kind = Kind::Fuzzy;
+    std::string text;                   // Folded unless caseSensitive
+    bool caseSensitive = false;
+    uint64_t mask = 0;
+
+    /**
+     * @brief Match against a path
+     * @return Score or -1
+     */
+    int Match(std::string_view path, size_t nameOffset, std::vector<int>* positions) const {
+        switch (kind) {
+            case Kind::Fuzzy:
+                return FuzzyMatch(path, text, caseSensitive, nameOffset, positions);
+            case Kind::Exact: {
+                size_t pos = FindExact(path, text, caseSensitive);
+                if (pos == std::string_view::npos) return -1;
+                // Prefer an occurrence inside the file name
+                if (pos < nameOffset) {
+                    size_t inName = FindExact(path, text, caseSensitive, nameOffset);
+                    if (inName != std::string_view::npos) pos = inName;
+                }
+                return ScoreWindow(path, text, caseSensitive, pos, pos + text.size(), nameOffset, positions);
+            }
+            case Kind::Prefix:
+                if (path.size() < text.size() ||
+                    FindExact(path.substr(0, text.size()), text, caseSensitive) != 0) return -1;
+                return ScoreWindow(path, text, caseSensitive, 0, text.size(), nameOffset, positions);
+            case Kind::Suffix: {
+                if (path.size() < text.size()) return -1;
+                size_t pos = path.size() - text.size();
+                if (FindExact(path.substr(pos), text, caseSensitive) != 0) return -1;
+                return ScoreWindow(path, text, caseSensitive, pos, path.size(), nameOffset, positions);
+            }
+        }
+        return -1;
+    }
+};
+
+namespace {
+
+template <typename Term>
+std::vector<Term> ParseQuery(const std::string& query) {
+    std::vector<Term> terms;
+    size_t i = 0;
+    while (i < query.size()) {
+        while (i < query.size() && query[i] == ' ') i++;
+        size_t start = i;
+        while (i < query.size() && query[i] != ' ') i++;
+        if (i == start) break;
+
+        std::string word = query.substr(start, i - start);
+        Term term;
+        if (word.size() > 1 && word[0] == '\'') {
+            term.kind = Term::Kind::Exact;
+            word.erase(0, 1);
+        } else if (word.size() > 1 && word[0] == '^') {
+            term.kind = Term::Kind::Prefix;
+            word.erase(0, 1);
+        } else if (word.size() > 1 && word.back() == '$') {
+            term.kind = Term::Kind::Suffix;
+            word.pop_back();
+        }
+
+        term.caseSensitive = std::any_of(word.begin(), word.end(),
+                                         [](char c) { return c >= 'A' && c <= 'Z'; });
+        if (!term.caseSensitive) {
+            for (char& c : word) c = Fold(c);
+        }
+        term.mask = ComputeMask(word);
+        term.text = std::move(word);
+        terms.push_back(std::move(term));
+    }
+    return terms;
+}
+
+struct ScoredId {
+    int score;
+    uint32_t length;                    // Tie-break: shorter paths first
+    uint32_t id;                        // then index order (scan order)
+};
+
+} // anonymous namespace
+
+// ============================================================================
+// CONSTRUCTION
+// ============================================================================
+
+UCIDEFileFinder::UCIDEFileFinder() {
+    worker = std::thread(&UCIDEFileFinder::WorkerLoop, this);
+}
+
+UCIDEFileFinder::~UCIDEFileFinder() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopWorker = true;
+        latestQueryId++;
+    }
+    queueCondition.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+// ============================================================================
+// INDEX MAINTENANCE
+// ============================================================================
+
+namespace {
+
+void CollectPaths(const ProjectFolder& folder, std::vector<std::string>& out) {
+    for (const auto& file : folder.files) {
+        out.push_back(file.GetRelativePath());
+    }
+    for (const auto& sub : folder.subfolders) {
+        CollectPaths(sub, out);
+    }
+}
+
+} // anonymous namespace
+
+void UCIDEFileFinder::Build(const UCIDEProject& project) {
+    std::vector<std::string> paths;
+    CollectPaths(project.rootFolder, paths);
+
+    std::unique_lock<std::shared_mutex> lock(indexMutex);
+    entries.clear();
+    masks.clear();
+    pathArena.clear();
+    pathToId.clear();
+    trigramPostings.clear();
+    deadCount = 0;
+
+    entries.reserve(paths.size());
+    masks.reserve(paths.size());
+    pathToId.reserve(paths.size());
+    for (const std::string& path : paths) {
+        InsertLocked(path);
+    }
+}
+
+void UCIDEFileFinder::Sync(const UCIDEProject& project) {
+    std::vector<std::string> paths;
+    CollectPaths(project.rootFolder, paths);
+
+    std::unique_lock<std::shared_mutex> lock(indexMutex);
+
+    std::unordered_set<std::string_view> current;
+    current.reserve(paths.size());
+    for (const std::string& path : paths) {
+        current.insert(path);
+        if (pathToId.find(path) == pathToId.end()) {
+            InsertLocked(path);
+        }
+    }
+
+    std::vector<std::string> removed;
+    for (const auto& pair : pathToId) {
+        if (current.find(pair.first) == current.end()) {
+            removed.push_back(pair.first);
+        }
+    }
+    for (const auto& path : removed) {
+        EraseLocked(path);
+    }
+
+    CompactLocked();
+}
+
+void UCIDEFileFinder::AddFile(const std::string& relativePath) {
+    std::unique_lock<std::shared_mutex> lock(indexMutex);
+    if (pathToId.find(relativePath) == pathToId.end()) {
+        InsertLocked(relativePath);
+    }
+}
+
+void UCIDEFileFinder::RemoveFile(const std::string& relativePath) {
+    std::unique_lock<std::shared_mutex> lock(indexMutex);
+    EraseLocked(relativePath);
+    CompactLocked();
+}
+
+void UCIDEFileFinder::RenameFile(const std::string& oldPath, const std::string& newPath) {
+    std::unique_lock<std::shared_mutex> lock(indexMutex);
+    EraseLocked(oldPath);
+    if (pathToId.find(newPath) == pathToId.end()) {
+        InsertLocked(newPath);
+    }
+    CompactLocked();
+}
+
+void UCIDEFileFinder::Clear() {
+    std::unique_lock<std::shared_mutex> lock(indexMutex);
+    entries.clear();
+    masks.clear();
+    pathArena.clear();
+    pathToId.clear();
+    trigramPostings.clear();
+    deadCount = 0;
+}
+
+size_t UCIDEFileFinder::GetFileCount() const {
+    std::shared_lock<std::shared_mutex> lock(indexMutex);
+    return entries.size() - deadCount;
+}
+
+uint32_t UCIDEFileFinder::InsertLocked(const std::string& relativePath) {
+    uint32_t id = static_cast<uint32_t>(entries.size());
+
+    Entry entry;
+    entry.offset = static_cast<uint32_t>(pathArena.size());
+    entry.length = static_cast<uint32_t>(relativePath.size());
+    pathArena.append(relativePath);
+    size_t slash = relativePath.find_last_of("/\\");
+    entry.nameOffset = (slash == std::string::npos) ? 0 : static_cast<uint32_t>(slash + 1);
+    entries.push_back(std::move(entry));
+    masks.push_back(ComputeMask(relativePath));
+    pathToId.emplace(relativePath, id);
+
+    // Ids only grow, so posting lists stay sorted by appending
+    for (uint32_t key : UniqueTrigrams(relativePath)) {
+        trigramPostings[key].push_back(id);
+    }
+    return id;
+}
+
+void UCIDEFileFinder::EraseLocked(const std::string& relativePath) {
+    auto it = pathToId.find(relativePath);
+    if (it == pathToId.end()) return;
+
+    // Tombstone; postings are purged lazily by CompactLocked
+    uint32_t id = it->second;
+    entries[id].alive = false;
+    masks[id] = 0;
+    pathToId.erase(it);
+    deadCount++;
+}
+
+void UCIDEFileFinder::CompactLocked() {
+    if (deadCount == 0 || deadCount * 2 < entries.size()) return;
+
+    std::vector<std::string> live;
+    live.reserve(entries.size() - deadCount);
+    for (const auto& entry : entries) {
+        if (entry.alive) live.emplace_back(PathOf(entry));
+    }
+
+    entries.clear();
+    masks.clear();
+    pathArena.clear();
+    pathToId.clear();
+    trigramPostings.clear();
+    deadCount = 0;
+    for (const auto& path : live) {
+        InsertLocked(path);
+    }
+}
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+bool UCIDEFileFinder::IsCancelled(uint64_t queryId) const {
+    return queryId != 0 && latestQueryId.load(std::memory_order_relaxed) != queryId;
+}
+
+bool UCIDEFileFinder::CollectCandidates(const std::vector<QueryTerm>& terms, uint64_t queryId,
+                                        std::vector<uint32_t>& candidates) const {
+    // Exact terms of 3+ chars can use the trigram postings: intersect the
+    // lists, shortest first
+    const QueryTerm* indexed = nullptr;
+    for (const auto& term : terms) {
+        if (term.kind != QueryTerm::Kind::Fuzzy && term.text.size() >= 3) {
+            if (!indexed || term.text.size() > indexed->text.size()) indexed = &term;
+        }
+    }
+
+    uint64_t need = 0;
+    for (const auto& term : terms) {
+        need |= term.mask;
+    }
+
+    if (indexed) {
+        std::vector<const std::vector<uint32_t>*> lists;
+        for (uint32_t key : UniqueTrigrams(indexed->text)) {
+            auto it = trigramPostings.find(key);
+            if (it == trigramPostings.end()) return true; // No path contains it
+            lists.push_back(&it->second);
+        }
+        std::sort(lists.begin(), lists.end(),
+                  [](const auto* a, const auto* b) { return a->size() < b->size(); });
+
+        candidates = *lists[0];
+        std::vector<uint32_t> scratch;
+        for (size_t i = 1; i < lists.size() && !candidates.empty(); ++i) {
+            scratch.clear();
+            std::set_intersection(candidates.begin(), candidates.end(),
+                                  lists[i]->begin(), lists[i]->end(),
+                                  std::back_inserter(scratch));
+            candidates.swap(scratch);
+        }
+
+        candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                        [&](uint32_t id) { return (masks[id] & need) != need || masks[id] == 0; }),
+                         candidates.end());
+        return !IsCancelled(queryId);
+    }
+
+    // Mask scan over the contiguous mask array
+    const size_t count = masks.size();
+    candidates.reserve(std::min<size_t>(count, 65536));
+    size_t i = 0;
+
+#ifdef UCIDE_FINDER_SSE2
+    const __m128i needVec = _mm_set1_epi64x(static_cast<long long>(need));
+    for (; i + 2 <= count; i += 2) {
+        if ((i & (CANCEL_CHECK_INTERVAL * 16 - 1)) == 0 && IsCancelled(queryId)) return false;
+
+        __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&masks[i]));
+        __m128i hit = _mm_cmpeq_epi32(_mm_and_si128(m, needVec), needVec);
+        int bits = _mm_movemask_epi8(hit);
+        if (bits == 0) continue;
+        if ((bits & 0x00FF) == 0x00FF && masks[i] != 0) candidates.push_back(static_cast<uint32_t>(i));
+        if ((bits & 0xFF00) == 0xFF00 && masks[i + 1] != 0) candidates.push_back(static_cast<uint32_t>(i + 1));
+    }
+#endif
+    for (; i < count; ++i) {
+        if ((masks[i] & need) == need && masks[i] != 0) {
+            candidates.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    return !IsCancelled(queryId);
+}
+
+bool UCIDEFileFinder::Search(const std::string& query, size_t maxResults, uint64_t queryId,
+                             std::vector<FileMatch>& out) const {
+    out.clear();
+    auto terms = ParseQuery<QueryTerm>(query);
+    if (terms.empty() || maxResults == 0) return true;
+
+    std::shared_lock<std::shared_mutex> lock(indexMutex);
+
+    std::vector<uint32_t> candidates;
+    if (!CollectCandidates(terms, queryId, candidates)) return false;
+
+    auto better = [](const ScoredId& a, const ScoredId& b) {
+        if (a.score != b.score) return a.score > b.score;
+        if (a.length != b.length) return a.length < b.length;
+        return a.id < b.id;
+    };
+
+    // Each worker keeps its own bounded heap (worst result on top)
+    auto scoreRange = [&](size_t begin, size_t end, std::vector<ScoredId>& heap) -> bool {
+        for (size_t i = begin; i < end; ++i) {
+            if (((i - begin) % CANCEL_CHECK_INTERVAL) == 0 && IsCancelled(queryId)) return false;
+
+            uint32_t id = candidates[i];
+            const Entry& entry = entries[id];
+            int total = 0;
+            bool matched = true;
+            for (const auto& term : terms) {
+                int s = term.Match(PathOf(entry), entry.nameOffset, nullptr);
+                if (s < 0) {
+                    matched = false;
+                    break;
+                }
+                total += s;
+            }
+            if (!matched) continue;
+
+            ScoredId scored{total, entry.length, id};
+            if (heap.size() < maxResults) {
+                heap.push_back(scored);
+                std::push_heap(heap.begin(), heap.end(), better);
+            } else if (better(scored, heap.front())) {
+                std::pop_heap(heap.begin(), heap.end(), better);
+                heap.back() = scored;
+                std::push_heap(heap.begin(), heap.end(), better);
+            }
+        }
+        return true;
+    };
+
+    std::vector<ScoredId> merged;
+    size_t threadCount = 1;
+    if (candidates.size() >= PARALLEL_THRESHOLD) {
+        threadCount = std::clamp<size_t>(std::thread::hardware_concurrency(), 1, 8);
+    }
+
+    if (threadCount == 1) {
+        if (!scoreRange(0, candidates.size(), merged)) return false;
+    } else {
+        std::vector<std::vector<ScoredId>> heaps(threadCount);
+        std::vector<std::thread> threads;
+        std::atomic<bool> aborted{false};
+        size_t chunk = (candidates.size() + threadCount - 1) / threadCount;
+
+        for (size_t t = 0; t < threadCount; ++t) {
+            size_t begin = t * chunk;
+            size_t end = std::min(candidates.size(), begin + chunk);
+            if (begin >= end) break;
+            threads.emplace_back([&, t, begin, end]() {
+                if (!scoreRange(begin, end, heaps[t])) aborted = true;
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        if (aborted) return false;
+
+        for (auto& heap : heaps) {
+            merged.insert(merged.end(), heap.begin(), heap.end());
+        }
+    }
+
+    size_t keep = std::min(maxResults, merged.size());
+    std::partial_sort(merged.begin(), merged.begin() + keep, merged.end(), better);
+    merged.resize(keep);
+
+    // Highlight positions only for what is shown
+    out.reserve(merged.size());
+    for (const auto& scored : merged) {
+        const Entry& entry = entries[scored.id];
+        FileMatch match;
+        match.relativePath = std::string(PathOf(entry));
+        match.score = scored.score;
+        for (const auto& term : terms) {
+            term.Match(PathOf(entry), entry.nameOffset, &match.positions);
+        }
+        std::sort(match.positions.begin(), match.positions.end());
+        match.positions.erase(std::unique(match.positions.begin(), match.positions.end()),
+                              match.positions.end());
+        out.push_back(std::move(match));
+    }
+    return true;
+}
+
+std::vector<FileMatch> UCIDEFileFinder::Find(const std::string& query, size_t maxResults) const {
+    std::vector<FileMatch> results;
+    Search(query, maxResults, 0, results);
+    return results;
+}
+
+uint64_t UCIDEFileFinder::FindAsync(const std::string& query, size_t maxResults, ResultCallback onResults) {
+    uint64_t id;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        id = ++latestQueryId;  // Supersedes whatever is running
+        pendingQuery = query;
+        pendingMaxResults = maxResults;
+        pendingCallback = std::move(onResults);
+        hasPending = true;
+    }
+    queueCondition.notify_one();
+    return id;
+}
+
+void UCIDEFileFinder::CancelAsync() {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    latestQueryId++;
+    hasPending = false;
+    pendingCallback = nullptr;
+}
+
+void UCIDEFileFinder::WorkerLoop() {
+    while (true) {
+        std::string query;
+        size_t maxResults = 0;
+        ResultCallback callback;
+        uint64_t id = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this] { return hasPending || stopWorker; });
+            if (stopWorker) return;
+
+            query = std::move(pendingQuery);
+            maxResults = pendingMaxResults;
+            callback = std::move(pendingCallback);
+            id = latestQueryId.load();
+            hasPending = false;
+        }
+
+        std::vector<FileMatch> results;
+        if (Search(query, maxResults, id, results) && !IsCancelled(id) && callback) {
+            callback(id, std::move(results));
+        }
+    }
+}
+
+int UCIDEFileFinder::ScorePath(std::string_view path, const std::string& query, std::vector<int>* positions) {
+    auto terms = ParseQuery<QueryTerm>(query);
+    size_t slash = path.find_last_of("/\\");
+    size_t nameOffset = (slash == std::string_view::npos) ? 0 : slash + 1;
+
+    int total = 0;
+    for (const auto& term : terms) {
+        int s = term.Match(path, nameOffset, positions);
+        if (s < 0) return -1;
+        total += s;
+    }
+    return total;
+}
+
+} // namespace IDE
+} // namespace UltraCanvas
@@ -0,0 +1,784 @@
+// Apps/IDE/Project/UCIDEFindInFiles.cpp
+// Project-wide "Find in Files" search and replace preview engine implementation
+// Version: 1.0.0
+// Last Modified: 2026-10-17
+// Author: UltraCanvas Framework / ULTRA IDE
+
+#include "UCIDEFindInFiles.h"
+#include "UCMappedFile.h"
+#include <algorithm>
+#include <cctype>
+#include <regex>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #include <emmintrin.h>
+    #define UCIDE_SEARCH_SSE2 1
+#endif
+
+namespace UltraCanvas {
+namespace IDE {
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+namespace {
+
+inline char Fold(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + 32) : c;
+}
+
+inline char Upper(char c) {
+    return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 32) : c;
+}
+
+inline bool IsWordChar(char c) {
+    unsigned char u = static_cast<unsigned char>(c);
+    return (u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z') ||
+           (u >= '0' && u <= '9') || u == '_' || u >= 0x80;
+}
+
+inline int CountTrailingZeros(uint32_t value) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(value);
+#endif
+}
+
+bool EqualsFolded(const char* a, const char* folded, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        if (Fold(a[i]) != folded[i]) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Glob match used for the include/exclude filters
+ */
+bool MatchesGlob(std::string_view str, std::string_view pattern) {
+    size_t s = 0, p = 0;
+    size_t starIdx = std::string_view::npos;
+    size_t matchIdx = 0;
+
+    while (s < str.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == str[s])) {
+            s++;
+            p++;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            starIdx = p;
+            matchIdx = s;
+            p++;
+        } else if (starIdx != std::string_view::npos) {
+            p = starIdx + 1;
+            matchIdx++;
+            s = matchIdx;
+        } else {
+            return false;
+        }
+    }
+
+    while (p < pattern.size() && pattern[p] == '*') {
+        p++;
+    }
+    return p == pattern.size();
+}
+
+bool MatchesAnyGlob(std::string_view relativePath, const std::vector<std::string>& patterns) {
+    size_t slash = relativePath.find_last_of('/');
+    std::string_view fileName = slash == std::string_view::npos ?
+                                relativePath : relativePath.substr(slash + 1);
+    for (const auto& pattern : patterns) {
+        if (MatchesGlob(relativePath, pattern) || MatchesGlob(fileName, pattern)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Longest literal every match of an ECMAScript regex must contain
+ *
+ * Conservative: gives up on alternation, ignores everything inside groups
+ * and character classes, and drops characters made optional by a
+ * quantifier. Returns an empty string when nothing safe can be extracted.
+ */
+std::string ExtractRequiredLiteral(const std::string& pattern) {
+    if (pattern.find('|') != std::string::npos) return "";
+
+    std::string best;
+    std::string current;
+    int depth = 0;
+
+    auto flush = [&]() {
+        if (current.size() > best.size()) best = current;
+        current.clear();
+    };
+
+    size_t i = 0;
+    while (i < pattern.size()) {
+        char c = pattern[i];
+        char literal = 0;
+
+        if (c == '\\') {
+            if (i + 1 >= pattern.size()) break;
+            char escaped = pattern[i + 1];
+            i += 2;
+            if (std::isalnum(static_cast<unsigned char>(escaped))) {
+                // \d \w \b \1 \x41 ... are not plain characters
+                flush();
+                continue;
+            }
+            literal = escaped;
+        } else if (c == '[') {
+            flush();
+            ++i;
+            if (i < pattern.size() && pattern[i] == '^') ++i;
+            if (i < pattern.size() && pattern[i] == ']') ++i;
+            while (i < pattern.size() && pattern[i] != ']') {
+                if (pattern[i] == '\\') ++i;
+                ++i;
+            }
+            ++i;
+            continue;
+        } else if (c == '(') {
+            flush();
+            ++depth;
+            ++i;
+            continue;
+        } else if (c == ')') {
+            flush();
+            --depth;
+            ++i;
+            continue;
+        } else if (c == '.' || c == '^' || c == '$') {
+            flush();
+            ++i;
+            continue;
+        } else if (c == '*' || c == '?' || c == '{' || c == '+') {
+            // Quantifier on the previous atom: with a zero minimum the
+            // previous character is optional, with '+' it still occurs once
+            // but nothing after it is adjacent.
+            if (c != '+' && !current.empty()) current.pop_back();
+            flush();
+            if (c == '{') {
+                while (i < pattern.size() && pattern[i] != '}') ++i;
+            }
+            ++i;
+            if (i < pattern.size() && pattern[i] == '?') ++i; // lazy
+            continue;
+        } else {
+            literal = c;
+            ++i;
+        }
+
+        if (depth == 0) {
+            current += literal;
+        } else {
+            flush();
+        }
+    }
+    flush();
+    return best;
+}
+
+/**
+ * @brief Read a file into buffer if it is small, otherwise map it
+ * @return false if the file cannot be read
+ */
+bool LoadFile(const std::string& path, size_t bufferLimit, std::vector<char>& buffer,
+              UCMappedFile& mapped, std::string_view& content) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    buffer.resize(bufferLimit + 1);
+    size_t got = std::fread(buffer.data(), 1, buffer.size(), file);
+    std::fclose(file);
+
+    if (got <= bufferLimit) {
+        content = std::string_view(buffer.data(), got);
+        return true;
+    }
+
+    if (!mapped.Open(path)) return false;
+    content = mapped.View();
+    return true;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// MATCHER
+// ============================================================================
+
+/**
+ * @brief Compiled query: literal prefilter plus optional regex confirmation
+ */
+struct UCIDEFindInFiles::Matcher {
+    /**
+     * @brief A match located in a buffer
+     */
+    struct Hit {
+        size_t offset = 0;
+        size_t length = 0;
+        int line = 0;
+        size_t lineStart = 0;
+        size_t lineEnd = 0;             // Excludes '\n' (and a trailing '\r')
+        const std::cmatch* groups = nullptr; // Regex mode only
+    };
+
+    std::string literal;                // Prefilter needle (folded when case-insensitive)
+    bool foldLiteral = false;
+    bool useRegex = false;
+    bool wholeWord = false;
+    std::regex regex;
+
+    bool Compile(const SearchOptions& options, std::string* error) {
+        if (options.pattern.empty()) {
+            if (error) *error = "Empty search pattern";
+            return false;
+        }
+
+        useRegex = options.useRegex;
+        wholeWord = options.wholeWord;
+
+        if (useRegex) {
+            try {
+                std::string source = options.pattern;
+                if (wholeWord) source = "\\b(?:" + source + ")\\b";
+                auto flags = std::regex::ECMAScript | std::regex::optimize;
+                if (!options.caseSensitive) flags |= std::regex::icase;
+                regex = std::regex(source, flags);
+            } catch (const std::regex_error& e) {
+                if (error) *error = std::string("Invalid regular expression: ") + e.what();
+                return false;
+            }
+            literal = ExtractRequiredLiteral(options.pattern);
+        } else {
+            literal = options.pattern;
+        }
+
+        foldLiteral = !options.caseSensitive;
+        if (foldLiteral) {
+            for (char& c : literal) c = Fold(c);
+        }
+        return true;
+    }
+
+    /**
+     * @brief First occurrence of the literal in [from, to)
+     */
+    size_t FindLiteral(const char* data, size_t from, size_t to) const {
+        const size_t n = literal.size();
+        if (to < from || to - from < n) return std::string_view::npos;
+
+        const char* needle = literal.data();
+        const char first = needle[0];
+        const char last = needle[n - 1];
+        size_t i = from;
+        const size_t end = to - n + 1;  // One past the last valid start
+
+        if (!foldLiteral && n == 1) {
+            const void* found = std::memchr(data + from, first, to - from);
+            return found ? static_cast<size_t>(static_cast<const char*>(found) - data) :
+                           std::string_view::npos;
+        }
+
+#ifdef UCIDE_SEARCH_SSE2
+        // Compare the needle's first and last byte at 16 candidate positions
+        // at once; only positions where both agree get a full compare.
+        const __m128i firstLo = _mm_set1_epi8(first);
+        const __m128i lastLo = _mm_set1_epi8(last);
+        const __m128i firstHi = _mm_set1_epi8(foldLiteral ? Upper(first) : first);
+        const __m128i lastHi = _mm_set1_epi8(foldLiteral ? Upper(last) : last);
+
+        while (i + 16 <= end) {
+            __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + n - 1));
+            __m128i eqFirst = _mm_or_si128(_mm_cmpeq_epi8(blockFirst, firstLo),
+                                           _mm_cmpeq_epi8(blockFirst, firstHi));
+            __m128i eqLast = _mm_or_si128(_mm_cmpeq_epi8(blockLast, lastLo),
+                                          _mm_cmpeq_epi8(blockLast, lastHi));
+            uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(eqFirst, eqLast)));
+            while (mask != 0) {
+                size_t candidate = i + CountTrailingZeros(mask);
+                bool equal = foldLiteral ? EqualsFolded(data + candidate, needle, n) :
+                                           std::memcmp(data + candidate, needle, n) == 0;
+                if (equal) return candidate;
+                mask &= mask - 1;
+            }
+            i += 16;
+        }
+#endif
+
+        for (; i < end; ++i) {
+            char c = foldLiteral ? Fold(data[i]) : data[i];
+            if (c != first) continue;
+            bool equal = foldLiteral ? EqualsFolded(data + i, needle, n) :
+                                       std::memcmp(data + i, needle, n) == 0;
+            if (equal) return i;
+        }
+        return std::string_view::npos;
+    }
+
+    /**
+     * @brief Report every match in data
+     * @param onHit Returns false to stop
+     */
+    template <typename Callback>
+    void ForEachMatch(std::string_view content, Callback&& onHit) const {
+        const char* data = content.data();
+        const size_t size = content.size();
+
+        int line = 1;
+        size_t counted = 0;             // Newlines before this offset are in `line`
+        size_t pos = 0;                 // Always at a line start
+
+        auto lineEndAt = [&](size_t from) {
+            const void* nl = std::memchr(data + from, '\n', size - from);
+            return nl ? static_cast<size_t>(static_cast<const char*>(nl) - data) : size;
+        };
+
+        while (pos < size) {
+            size_t lineStart = pos;
+            if (!literal.empty()) {
+                size_t hit = FindLiteral(data, pos, size);
+                if (hit == std::string_view::npos) return;
+                lineStart = hit;
+                while (lineStart > pos && data[lineStart - 1] != '\n') --lineStart;
+            }
+
+            size_t lineEnd = lineEndAt(lineStart);
+            line += static_cast<int>(std::count(data + counted, data + lineStart, '\n'));
+            counted = lineStart;
+
+            size_t textEnd = lineEnd;
+            if (textEnd > lineStart && data[textEnd - 1] == '\r') --textEnd;
+
+            if (!MatchLine(data, line, lineStart, textEnd, onHit)) return;
+            pos = lineEnd + 1;
+        }
+    }
+
+private:
+    template <typename Callback>
+    bool MatchLine(const char* data, int line, size_t lineStart, size_t lineEnd,
+                   Callback& onHit) const {
+        Hit hit;
+        hit.line = line;
+        hit.lineStart = lineStart;
+        hit.lineEnd = lineEnd;
+
+        if (useRegex) {
+            std::cregex_iterator it(data + lineStart, data + lineEnd, regex);
+            for (; it != std::cregex_iterator(); ++it) {
+                const std::cmatch& match = *it;
+                if (match.length(0) == 0) continue;
+                hit.offset = lineStart + static_cast<size_t>(match.position(0));
+                hit.length = static_cast<size_t>(match.length(0));
+                hit.groups = &match;
+                if (!onHit(hit)) return false;
+            }
+            return true;
+        }
+
+        size_t from = lineStart;
+        while (true) {
+            size_t found = FindLiteral(data, from, lineEnd);
+            if (found == std::string_view::npos) break;
+            size_t after = found + literal.size();
+            bool boundaryOk = !wholeWord ||
+                ((found == lineStart || !IsWordChar(data[found - 1])) &&
+                 (after == lineEnd || !IsWordChar(data[after])));
+            if (boundaryOk) {
+                hit.offset = found;
+                hit.length = literal.size();
+                if (!onHit(hit)) return false;
+                from = after;
+            } else {
+                from = found + 1;
+            }
+        }
+        return true;
+    }
+};
+
+namespace {
+
+// The search whose coordinator or worker runs on this thread, so that a
+// callback calling back into it does not wait for itself
+thread_local const UCIDEFindInFiles* activeSearch = nullptr;
+
+/**
+ * @brief Build the UI record for a match, clipping long lines around it
+ */
+template <typename Hit>
+SearchMatch MakeMatch(const char* data, const Hit& hit, int maxLineLength) {
+    SearchMatch match;
+    match.line = hit.line;
+    match.column = static_cast<int>(hit.offset - hit.lineStart) + 1;
+    match.length = static_cast<int>(hit.length);
+
+    size_t lineLength = hit.lineEnd - hit.lineStart;
+    size_t limit = maxLineLength > 0 ? static_cast<size_t>(maxLineLength) : lineLength;
+    size_t start = 0;
+    if (lineLength > limit) {
+        size_t column = hit.offset - hit.lineStart;
+        if (column + hit.length > limit) start = column - std::min(column, limit / 4);
+        // Do not cut a UTF-8 sequence in half
+        while (start > 0 && (static_cast<unsigned char>(data[hit.lineStart + start]) & 0xC0) == 0x80) {
+            --start;
+        }
+    }
+    size_t length = std::min(limit, lineLength - start);
+    while (length > 0 && start + length < lineLength &&
+           (static_cast<unsigned char>(data[hit.lineStart + start + length]) & 0xC0) == 0x80) {
+        --length;
+    }
+
+    match.previewStart = static_cast<int>(start);
+    match.lineText.assign(data + hit.lineStart + start, length);
+    return match;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// SEARCH
+// ============================================================================
+
+UCIDEFindInFiles::~UCIDEFindInFiles() {
+    Cancel();
+}
+
+uint64_t UCIDEFindInFiles::Start(const UCIDEProject& project, const SearchOptions& options,
+                                 ResultCallback onResult, CompleteCallback onComplete) {
+    std::vector<std::string> paths;
+    std::vector<const ProjectFolder*> stack = { &project.rootFolder };
+    while (!stack.empty()) {
+        const ProjectFolder* folder = stack.back();
+        stack.pop_back();
+        for (const auto& file : folder->files) {
+            paths.push_back(file.GetAbsolutePath());
+        }
+        for (const auto& sub : folder->subfolders) {
+            stack.push_back(&sub);
+        }
+    }
+    return Start(paths, project.rootDirectory, options, std::move(onResult), std::move(onComplete));
+}
+
+uint64_t UCIDEFindInFiles::Start(const std::vector<std::string>& absolutePaths,
+                                 const std::string& rootDirectory, const SearchOptions& options,
+                                 ResultCallback onResult, CompleteCallback onComplete) {
+    uint64_t searchId;
+    std::vector<std::thread> finished;
+    {
+        std::lock_guard<std::mutex> lock(controlMutex);
+        searchId = ++currentSearchId;
+        finished = TakeCoordinators();
+    }
+    // Joined without controlMutex, so a callback of the old search can
+    // still call Start() or Cancel()
+    for (auto& thread : finished) thread.join();
+
+    std::lock_guard<std::mutex> lock(controlMutex);
+    if (IsCancelled(searchId)) {
+        return searchId;    // Superseded while waiting for the old search
+    }
+    runningSearchId = searchId;
+    coordinator = std::thread(&UCIDEFindInFiles::Run, this, searchId, absolutePaths, rootDirectory,
+                              options, std::move(onResult), std::move(onComplete));
+    return searchId;
+}
+
+void UCIDEFindInFiles::Cancel() {
+    std::vector<std::thread> finished;
+    {
+        std::lock_guard<std::mutex> lock(controlMutex);
+        ++currentSearchId;
+        finished = TakeCoordinators();
+    }
+    for (auto& thread : finished) thread.join();
+}
+
+void UCIDEFindInFiles::Wait() {
+    std::vector<std::thread> finished;
+    {
+        std::lock_guard<std::mutex> lock(controlMutex);
+        finished = TakeCoordinators();
+    }
+    for (auto& thread : finished) thread.join();
+}
+
+std::vector<std::thread> UCIDEFindInFiles::TakeCoordinators() {
+    if (coordinator.joinable()) {
+        retiredCoordinators.push_back(std::move(coordinator));
+    }
+    // A search thread cannot join itself; the next call from outside does
+    if (activeSearch == this) return {};
+    return std::move(retiredCoordinators);
+}
+
+bool UCIDEFindInFiles::IsCancelled(uint64_t searchId) const {
+    return currentSearchId.load(std::memory_order_relaxed) != searchId;
+}
+
+void UCIDEFindInFiles::FinishRunning(uint64_t searchId) {
+    // Leaves a search started from one of this one's callbacks running
+    runningSearchId.compare_exchange_strong(searchId, 0);
+}
+
+void UCIDEFindInFiles::Run(uint64_t searchId, std::vector<std::string> absolutePaths,
+                           std::string rootDirectory, SearchOptions options,
+                           ResultCallback onResult, CompleteCallback onComplete) {
+    auto startTime = std::chrono::steady_clock::now();
+    SearchSummary summary;
+    activeSearch = this;
+
+    Matcher matcher;
+    if (!matcher.Compile(options, &summary.error)) {
+        FinishRunning(searchId);
+        if (onComplete) onComplete(searchId, summary);
+        return;
+    }
+
+    std::string rootPrefix = rootDirectory;
+    if (!rootPrefix.empty() && rootPrefix.back() != '/') rootPrefix += '/';
+    auto relativeOf = [&](const std::string& path) {
+        if (!rootPrefix.empty() && path.compare(0, rootPrefix.size(), rootPrefix) == 0) {
+            return path.substr(rootPrefix.size());
+        }
+        return path;
+    };
+
+    if (!options.includePatterns.empty() || !options.excludePatterns.empty()) {
+        std::vector<std::string> filtered;
+        filtered.reserve(absolutePaths.size());
+        for (auto& path : absolutePaths) {
+            std::string relative = relativeOf(path);
+            if (!options.includePatterns.empty() && !MatchesAnyGlob(relative, options.includePatterns)) continue;
+            if (MatchesAnyGlob(relative, options.excludePatterns)) continue;
+            filtered.push_back(std::move(path));
+        }
+        absolutePaths.swap(filtered);
+    }
+
+    std::atomic<size_t> nextFile{0};
+    std::atomic<size_t> totalMatches{0};
+    std::atomic<size_t> filesSearched{0};
+    std::atomic<size_t> filesMatched{0};
+    std::atomic<size_t> filesSkipped{0};
+    std::atomic<uint64_t> bytesSearched{0};
+    std::atomic<bool> truncated{false};
+
+    auto worker = [&]() {
+        activeSearch = this;
+        std::vector<char> buffer;
+        while (!IsCancelled(searchId) && !truncated.load(std::memory_order_relaxed)) {
+            size_t index = nextFile.fetch_add(1, std::memory_order_relaxed);
+            if (index >= absolutePaths.size()) break;
+            const std::string& path = absolutePaths[index];
+
+            UCMappedFile mapped;
+            std::string_view content;
+            if (!LoadFile(path, READ_BUFFER_LIMIT, buffer, mapped, content) ||
+                content.size() > options.maxFileSize ||
+                std::memchr(content.data(), 0, std::min(content.size(), BINARY_PROBE_SIZE)) != nullptr) {
+                filesSkipped.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+            filesSearched.fetch_add(1, std::memory_order_relaxed);
+            bytesSearched.fetch_add(content.size(), std::memory_order_relaxed);
+
+            FileSearchResult result;
+            matcher.ForEachMatch(content, [&](const Matcher::Hit& hit) {
+                if (totalMatches.fetch_add(1, std::memory_order_relaxed) >= options.maxResults) {
+                    truncated = true;
+                    return false;
+                }
+                result.matches.push_back(MakeMatch(content.data(), hit, options.maxLineLength));
+                return !IsCancelled(searchId);
+            });
+
+            if (result.matches.empty()) continue;
+            filesMatched.fetch_add(1, std::memory_order_relaxed);
+
+            result.absolutePath = path;
+            result.relativePath = relativeOf(path);
+            std::lock_guard<std::mutex> lock(callbackMutex);
+            if (!IsCancelled(searchId) && onResult) {
+                onResult(searchId, std::move(result));
+            }
+        }
+    };
+
+    size_t threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+    threadCount = std::min(threadCount, std::max<size_t>(1, absolutePaths.size()));
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (size_t i = 1; i < threadCount; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    summary.filesSearched = filesSearched;
+    summary.filesMatched = filesMatched;
+    summary.filesSkipped = filesSkipped;
+    summary.totalMatches = std::min(totalMatches.load(), options.maxResults);
+    summary.bytesSearched = bytesSearched;
+    summary.truncated = truncated;
+    summary.cancelled = IsCancelled(searchId);
+    summary.elapsedMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - startTime).count();
+
+    FinishRunning(searchId);
+    std::lock_guard<std::mutex> lock(callbackMutex);
+    if (!summary.cancelled && onComplete) {
+        onComplete(searchId, summary);
+    }
+}
+
+bool UCIDEFindInFiles::SearchBuffer(std::string_view content, const SearchOptions& options,
+                                    std::vector<SearchMatch>& matches, std::string* error) {
+    Matcher matcher;
+    if (!matcher.Compile(options, error)) return false;
+
+    matcher.ForEachMatch(content, [&](const Matcher::Hit& hit) {
+        matches.push_back(MakeMatch(content.data(), hit, options.maxLineLength));
+        return matches.size() < options.maxResults;
+    });
+    return true;
+}
+
+// ============================================================================
+// REPLACE
+// ============================================================================
+
+bool UCIDEFindInFiles::PreviewReplace(const std::string& absolutePath, const SearchOptions& options,
+                                      const std::string& replacement, ReplacePreview& preview,
+                                      std::string* error) {
+    Matcher matcher;
+    if (!matcher.Compile(options, error)) return false;
+
+    // Taken before reading: a write in between makes ApplyReplace refuse
+    std::error_code ec;
+    uintmax_t originalSize = std::filesystem::file_size(absolutePath, ec);
+    std::filesystem::file_time_type originalWriteTime;
+    if (!ec) originalWriteTime = std::filesystem::last_write_time(absolutePath, ec);
+
+    UCMappedFile file;
+    if (ec || !file.Open(absolutePath)) {
+        if (error) *error = "Cannot open " + absolutePath;
+        return false;
+    }
+    std::string_view content = file.View();
+    const char* data = content.data();
+
+    preview = ReplacePreview();
+    preview.absolutePath = absolutePath;
+    preview.originalSize = originalSize;
+    preview.originalWriteTime = originalWriteTime;
+    preview.newContent.reserve(content.size());
+
+    size_t copied = 0;
+    matcher.ForEachMatch(content, [&](const Matcher::Hit& hit) {
+        std::string text = hit.groups ? hit.groups->format(replacement) : replacement;
+
+        ReplacePreviewItem item;
+        item.line = hit.line;
+        item.column = static_cast<int>(hit.offset - hit.lineStart) + 1;
+        item.length = static_cast<int>(hit.length);
+        item.originalLine.assign(data + hit.lineStart, hit.lineEnd - hit.lineStart);
+        item.replacedLine.reserve(item.originalLine.size() + text.size());
+        item.replacedLine.append(data + hit.lineStart, hit.offset - hit.lineStart);
+        item.replacedLine += text;
+        item.replacedLine.append(data + hit.offset + hit.length, hit.lineEnd - hit.offset - hit.length);
+        preview.items.push_back(std::move(item));
+
+        preview.newContent.append(data + copied, hit.offset - copied);
+        preview.newContent += text;
+        copied = hit.offset + hit.length;
+        return true;
+    });
+    preview.newContent.append(data + copied, content.size() - copied);
+    return true;
+}
+
+bool UCIDEFindInFiles::ApplyReplace(const ReplacePreview& preview, std::string* error) {
+    namespace fs = std::filesystem;
+    if (preview.items.empty()) return true;
+
+    // Rewrite what a symlink points to; replacing the link would turn it
+    // into a regular file
+    std::error_code ec;
+    fs::path target = fs::canonical(preview.absolutePath, ec);
+    if (ec) {
+        if (error) *error = "Cannot open " + preview.absolutePath;
+        return false;
+    }
+
+    uintmax_t size = fs::file_size(target, ec);
+    fs::file_time_type writeTime;
+    if (!ec) writeTime = fs::last_write_time(target, ec);
+    if (ec || size != preview.originalSize || writeTime != preview.originalWriteTime) {
+        if (error) *error = preview.absolutePath + " changed since the preview";
+        return false;
+    }
+
+    fs::perms mode = fs::status(target, ec).permissions();
+    if (ec) {
+        if (error) *error = "Cannot open " + preview.absolutePath;
+        return false;
+    }
+
+    // Renaming over a file with other hard links would detach it from
+    // them, so such a file is rewritten in place
+    if (fs::hard_link_count(target, ec) > 1) {
+        std::ofstream file(target, std::ios::binary | std::ios::trunc);
+        file.write(preview.newContent.data(), static_cast<std::streamsize>(preview.newContent.size()));
+        if (!file.good()) {
+            if (error) *error = "Cannot write " + preview.absolutePath;
+            return false;
+        }
+        return true;
+    }
+
+    // Otherwise write next to the original and rename, so a failed write
+    // never leaves a truncated source file behind
+    std::string tempPath = target.string() + ".ultraide-replace";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (file.is_open()) {
+            file.write(preview.newContent.data(), static_cast<std::streamsize>(preview.newContent.size()));
+        }
+        if (!file.is_open() || !file.good()) {
+            file.close();
+            std::remove(tempPath.c_str());
+            if (error) *error = "Cannot write " + preview.absolutePath;
+            return false;
+        }
+    }
+
+    fs::permissions(tempPath, mode, fs::perm_options::replace, ec);
+    if (!ec) fs::rename(tempPath, target, ec);
+    if (ec) {
+        std::remove(tempPath.c_str());
+        if (error) *error = "Cannot write " + preview.absolutePath;
+        return false;
+    }
+    return true;
+}
+
+} // namespace IDE
+} // namespace UltraCanvas
@@ -0,0 +1,217 @@
+// Apps/IDE/Project/UCIDEFindInFiles.h
+// Project-wide "Find in Files" search and replace preview engine
+// Version: 1.0.0
+// Last Modified: 2026-10-17
+// Author: UltraCanvas Framework / ULTRA IDE
+#pragma once
+
+#include "UCIDEProject.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+#include <filesystem>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace UltraCanvas {
+namespace IDE {
+
+// ============================================================================
+// SEARCH OPTIONS / RESULTS
+// ============================================================================
+
+/**
+ * @brief Find in Files query
+ */
+struct SearchOptions {
+    std::string pattern;                // Literal text or ECMAScript regex
+    bool useRegex = false;
+    bool caseSensitive = false;
+    bool wholeWord = false;
+    std::vector<std::string> includePatterns; // Glob filter on relative paths (empty = all)
+    std::vector<std::string> excludePatterns; // Extra globs on top of the project's
+    size_t maxFileSize = 64 * 1024 * 1024;    // Larger files are skipped
+    size_t maxResults = 100000;               // Stop after this many matches
+    int maxLineLength = 512;                  // Preview text is clipped to this
+};
+
+/**
+ * @brief A single match
+ */
+struct SearchMatch {
+    int line = 0;                       // 1-based line number
+    int column = 0;                     // 1-based byte column
+    int length = 0;                     // Match length in bytes
+    std::string lineText;               // Line containing the match (clipped)
+    int previewStart = 0;               // Byte offset of lineText within the line
+};
+
+/**
+ * @brief All matches found in one file
+ */
+struct FileSearchResult {
+    std::string relativePath;
+    std::string absolutePath;
+    std::vector<SearchMatch> matches;
+};
+
+/**
+ * @brief Summary of a finished search
+ */
+struct SearchSummary {
+    size_t filesSearched = 0;
+    size_t filesMatched = 0;
+    size_t filesSkipped = 0;            // Binary, too large or unreadable
+    size_t totalMatches = 0;
+    uint64_t bytesSearched = 0;
+    double elapsedMs = 0.0;
+    bool cancelled = false;
+    bool truncated = false;             // maxResults reached
+    std::string error;                  // e.g. invalid regex
+};
+
+/**
+ * @brief One replaced occurrence, for the replace preview
+ */
+struct ReplacePreviewItem {
+    int line = 0;
+    int column = 0;
+    int length = 0;
+    std::string originalLine;
+    std::string replacedLine;
+};
+
+/**
+ * @brief Replace preview for a single file
+ */
+struct ReplacePreview {
+    std::string absolutePath;
+    std::vector<ReplacePreviewItem> items;
+    std::string newContent;             // Whole file after replacement
+
+    // The file as the preview saw it; ApplyReplace skips it if it changed
+    uintmax_t originalSize = 0;
+    std::filesystem::file_time_type originalWriteTime;
+};
+
+// ============================================================================
+// FIND IN FILES
+// ============================================================================
+
+/**
+ * @brief Parallel project-wide text search
+ *
+ * Files come from the project's scanned file tree, so the project exclude
+ * patterns and hidden folders are already applied; binary files (NUL byte
+ * in the first block) are skipped. Worker threads pull files from a shared
+ * counter, read small files into a reusable buffer and memory-map large
+ * ones.
+ *
+ * Literal searches run an SSE2 first/last byte scan over the whole buffer
+ * and only look at lines around a hit. Regex searches extract a literal
+ * that every match must contain and use it the same way, so the regex
+ * engine only confirms candidate lines.
+ *
+ * Results are streamed per file through the callback as soon as a file is
+ * done. Starting a new search or calling Cancel() stops the running one.
+ * Callbacks may call Start() or Cancel(); from there they do not wait for
+ * the search they are called from.
+ */
+class UCIDEFindInFiles {
+public:
+    using ResultCallback = std::function<void(uint64_t searchId, FileSearchResult result)>;
+    using CompleteCallback = std::function<void(uint64_t searchId, const SearchSummary& summary)>;
+
+    UCIDEFindInFiles() = default;
+    ~UCIDEFindInFiles();
+
+    UCIDEFindInFiles(const UCIDEFindInFiles&) = delete;
+    UCIDEFindInFiles& operator=(const UCIDEFindInFiles&) = delete;
+
+    // ===== SEARCH =====
+
+    /**
+     * @brief Start a background search over the project files
+     *
+     * Callbacks run on worker threads; the UI is expected to marshal them.
+     * onResult is never called after Cancel() returns.
+     * @return Search id passed back to the callbacks
+     */
+    uint64_t Start(const UCIDEProject& project, const SearchOptions& options,
+                   ResultCallback onResult, CompleteCallback onComplete = nullptr);
+
+    /**
+     * @brief Search an explicit list of files (absolute paths)
+     */
+    uint64_t Start(const std::vector<std::string>& absolutePaths, const std::string& rootDirectory,
+                   const SearchOptions& options, ResultCallback onResult,
+                   CompleteCallback onComplete = nullptr);
+
+    /**
+     * @brief Stop the running search and wait for it
+     */
+    void Cancel();
+
+    /**
+     * @brief Block until the running search is finished
+     */
+    void Wait();
+
+    bool IsRunning() const { return runningSearchId.load() != 0; }
+
+    /**
+     * @brief Search a single in-memory buffer (editor contents)
+     * @return false if the pattern is invalid
+     */
+    static bool SearchBuffer(std::string_view content, const SearchOptions& options,
+                             std::vector<SearchMatch>& matches, std::string* error = nullptr);
+
+    // ===== REPLACE =====
+
+    /**
+     * @brief Compute the effect of replacing every match in a file
+     *
+     * In regex mode the replacement may use $1..$9 and $&.
+     * Nothing is written to disk.
+     */
+    static bool PreviewReplace(const std::string& absolutePath, const SearchOptions& options,
+                               const std::string& replacement, ReplacePreview& preview,
+                               std::string* error = nullptr);
+
+    /**
+     * @brief Write a previously computed preview back to disk
+     *
+     * Fails without writing if the file was modified since the preview.
+     * A symlink's target is rewritten, keeping the link; permissions and
+     * hard links are preserved.
+     */
+    static bool ApplyReplace(const ReplacePreview& preview, std::string* error = nullptr);
+
+private:
+    struct Matcher;
+
+    void Run(uint64_t searchId, std::vector<std::string> absolutePaths, std::string rootDirectory,
+             SearchOptions options, ResultCallback onResult, CompleteCallback onComplete);
+    bool IsCancelled(uint64_t searchId) const;
+    void FinishRunning(uint64_t searchId);
+    std::vector<std::thread> TakeCoordinators();    // Called with controlMutex held
+
+    std::thread coordinator;
+    std::vector<std::thread> retiredCoordinators;   // Left by calls from search threads
+    std::mutex controlMutex;
+    std::mutex callbackMutex;
+    std::atomic<uint64_t> currentSearchId{0};
+    std::atomic<uint64_t> runningSearchId{0};       // 0 when idle
+
+    // Files up to this size are read into a buffer, larger ones are mapped
+    static constexpr size_t READ_BUFFER_LIMIT = 256 * 1024;
+    // Leading bytes inspected for NUL to classify a file as binary
+    static constexpr size_t BINARY_PROBE_SIZE = 8192;
+};
+
+} // namespace IDE
+} // namespace UltraCanvas
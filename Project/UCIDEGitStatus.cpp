@@ -0,0 +1,732 @@
+// Apps/IDE/Project/UCIDEGitStatus.cpp
+// In-process git working tree status implementation
+// Version: 1.0.0
+// Last Modified: 2026-10-17
+// Author: UltraCanvas Framework / ULTRA IDE
+
+#include "UCIDEGitStatus.h"
+#include "UCIDEProject.h"
+#include "UCMappedFile.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#ifndef _WIN32
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace UltraCanvas {
+namespace IDE {
+
+namespace {
+
+// Index entry flags
+constexpr uint16_t FLAG_ASSUME_VALID = 0x8000;
+constexpr uint16_t FLAG_EXTENDED = 0x4000;
+constexpr uint16_t FLAG_NAME_MASK = 0x0FFF;
+constexpr uint16_t EXTENDED_SKIP_WORKTREE = 0x4000;
+constexpr uint16_t EXTENDED_INTENT_TO_ADD = 0x2000;
+
+// Index entry modes
+constexpr uint32_t MODE_TYPE_MASK = 0170000;
+constexpr uint32_t MODE_DIRECTORY = 0040000;   // Sparse index directory entry
+constexpr uint32_t MODE_SYMLINK = 0120000;
+constexpr uint32_t MODE_GITLINK = 0160000;     // Submodule
+constexpr uint32_t MODE_EXECUTABLE = 0000100;
+
+constexpr size_t INDEX_HEADER_SIZE = 12;
+constexpr size_t INDEX_ENTRY_FIXED_SIZE = 62;  // Stat data, hash and flags
+constexpr size_t INDEX_CHECKSUM_SIZE = 20;
+constexpr size_t STAT_CHUNK_SIZE = 1024;
+
+inline uint32_t ReadBE32(const uint8_t* p) {
+    return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) |
+           (static_cast<uint32_t>(p[2]) << 8) | p[3];
+}
+
+inline uint16_t ReadBE16(const uint8_t* p) {
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+// ============================================================================
+// SHA-1 (git object ids)
+// ============================================================================
+
+class Sha1 {
+public:
+    Sha1() {
+        state[0] = 0x67452301;
+        state[1] = 0xEFCDAB89;
+        state[2] = 0x98BADCFE;
+        state[3] = 0x10325476;
+        state[4] = 0xC3D2E1F0;
+    }
+
+    void Update(const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        totalBytes += size;
+        if (bufferUsed > 0) {
+            size_t take = std::min(size, sizeof(buffer) - bufferUsed);
+            std::memcpy(buffer + bufferUsed, bytes, take);
+            bufferUsed += take;
+            bytes += take;
+            size -= take;
+            if (bufferUsed < sizeof(buffer)) return;
+            Block(buffer);
+            bufferUsed = 0;
+        }
+        for (; size >= 64; bytes += 64, size -= 64) {
+            Block(bytes);
+        }
+        std::memcpy(buffer, bytes, size);
+        bufferUsed = size;
+    }
+
+    void Final(uint8_t out[20]) {
+        uint64_t bits = totalBytes * 8;
+        uint8_t pad = 0x80;
+        Update(&pad, 1);
+        uint8_t zero = 0;
+        while (bufferUsed != 56) {
+            Update(&zero, 1);
+        }
+        uint8_t length[8];
+        for (int i = 0; i < 8; ++i) {
+            length[i] = static_cast<uint8_t>(bits >> (56 - 8 * i));
+        }
+        Update(length, 8);
+        for (int i = 0; i < 5; ++i) {
+            out[4 * i] = static_cast<uint8_t>(state[i] >> 24);
+            out[4 * i + 1] = static_cast<uint8_t>(state[i] >> 16);
+            out[4 * i + 2] = static_cast<uint8_t>(state[i] >> 8);
+            out[4 * i + 3] = static_cast<uint8_t>(state[i]);
+        }
+    }
+
+private:
+    static uint32_t Rotate(uint32_t v, int n) { return (v << n) | (v >> (32 - n)); }
+
+    void Block(const uint8_t* block) {
+        uint32_t w[80];
+        for (int i = 0; i < 16; ++i) {
+            w[i] = ReadBE32(block + 4 * i);
+        }
+        for (int i = 16; i < 80; ++i) {
+            w[i] = Rotate(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        }
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+        for (int i = 0; i < 80; ++i) {
+            uint32_t f, k;
+            if (i < 20)      { f = (b & c) | (~b & d);           k = 0x5A827999; }
+            else if (i < 40) { f = b ^ c ^ d;                    k = 0x6ED9EBA1; }
+            else if (i < 60) { f = (b & c) | (b & d) | (c & d);  k = 0x8F1BBCDC; }
+            else             { f = b ^ c ^ d;                    k = 0xCA62C1D6; }
+            uint32_t t = Rotate(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = Rotate(b, 30);
+            b = a;
+            a = t;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+    }
+
+    uint32_t state[5];
+    uint8_t buffer[64];
+    size_t bufferUsed = 0;
+    uint64_t totalBytes = 0;
+};
+
+/**
+ * @brief Git blob id of a byte string: sha1("blob <size>\0" + content)
+ */
+void HashBlob(const void* data, size_t size, uint8_t out[20]) {
+    Sha1 sha;
+    std::string header = "blob " + std::to_string(size);
+    sha.Update(header.data(), header.size() + 1);   // Includes the terminating NUL
+    if (size > 0) {
+        sha.Update(data, size);
+    }
+    sha.Final(out);
+}
+
+std::string ReadTextFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return std::string();
+    return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// STAT DATA
+// ============================================================================
+
+bool UCIDEGitStatus::StatData::operator==(const StatData& other) const {
+    return mtimeSeconds == other.mtimeSeconds && mtimeNanoseconds == other.mtimeNanoseconds &&
+           ctimeSeconds == other.ctimeSeconds && ctimeNanoseconds == other.ctimeNanoseconds &&
+           inode == other.inode && uid == other.uid && gid == other.gid &&
+           size == other.size && mode == other.mode;
+}
+
+namespace {
+
+/**
+ * @brief lstat() truncated to the 32-bit fields git stores
+ * @return false if the path does not exist
+ */
+template<typename StatData>
+bool LstatPath(const std::string& path, StatData& out, bool& isSymlink, bool& isRegular) {
+#ifdef _WIN32
+    return false;
+#else
+    struct stat st;
+    if (lstat(path.c_str(), &st) != 0) {
+        return false;
+    }
+#if defined(__APPLE__)
+    out.ctimeSeconds = static_cast<uint32_t>(st.st_ctimespec.tv_sec);
+    out.ctimeNanoseconds = static_cast<uint32_t>(st.st_ctimespec.tv_nsec);
+    out.mtimeSeconds = static_cast<uint32_t>(st.st_mtimespec.tv_sec);
+    out.mtimeNanoseconds = static_cast<uint32_t>(st.st_mtimespec.tv_nsec);
+#else
+    out.ctimeSeconds = static_cast<uint32_t>(st.st_ctim.tv_sec);
+    out.ctimeNanoseconds = static_cast<uint32_t>(st.st_ctim.tv_nsec);
+    out.mtimeSeconds = static_cast<uint32_t>(st.st_mtim.tv_sec);
+    out.mtimeNanoseconds = static_cast<uint32_t>(st.st_mtim.tv_nsec);
+#endif
+    out.device = static_cast<uint32_t>(st.st_dev);
+    out.inode = static_cast<uint32_t>(st.st_ino);
+    out.uid = static_cast<uint32_t>(st.st_uid);
+    out.gid = static_cast<uint32_t>(st.st_gid);
+    out.size = static_cast<uint32_t>(st.st_size);
+    isSymlink = S_ISLNK(st.st_mode);
+    isRegular = S_ISREG(st.st_mode);
+
+    // Normalized the way git records modes
+    if (isSymlink) {
+        out.mode = MODE_SYMLINK;
+    } else if (isRegular) {
+        out.mode = (st.st_mode & S_IXUSR) ? 0100755 : 0100644;
+    } else {
+        out.mode = static_cast<uint32_t>(st.st_mode);
+    }
+    return true;
+#endif
+}
+
+/**
+ * @brief Blob id of a working tree file (link target for symlinks)
+ */
+bool HashWorkTreeFile(const std::string& path, bool isSymlink, uint8_t out[20]) {
+#ifndef _WIN32
+    if (isSymlink) {
+        char target[4096];
+        ssize_t length = readlink(path.c_str(), target, sizeof(target));
+        if (length < 0) return false;
+        HashBlob(target, static_cast<size_t>(length), out);
+        return true;
+    }
+#endif
+    UCMappedFile file;
+    if (!file.Open(path)) {
+        return false;
+    }
+    HashBlob(file.Data(), file.Size(), out);
+    return true;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// REPOSITORY
+// ============================================================================
+
+bool UCIDEGitStatus::Open(const std::string& projectRoot) {
+    Close();
+#ifdef _WIN32
+    // Index stat data mirrors POSIX lstat(); not implemented for Windows
+    return false;
+#else
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::path root = fs::absolute(projectRoot, ec).lexically_normal();
+    if (ec) return false;
+    std::string rootText = root.string();
+    while (rootText.size() > 1 && rootText.back() == '/') {
+        rootText.pop_back();
+    }
+
+    // Walk up to the directory holding .git (a directory, or a file with
+    // "gitdir: <path>" for worktrees and submodules)
+    for (fs::path dir = rootText; !dir.empty(); dir = dir.parent_path()) {
+        fs::path dotGit = dir / ".git";
+        if (fs::is_directory(dotGit, ec)) {
+            gitDirectory = dotGit.string();
+        } else if (fs::is_regular_file(dotGit, ec)) {
+            std::string text = ReadTextFile(dotGit.string());
+            if (text.compare(0, 8, "gitdir: ") != 0) return false;
+            text = text.substr(8);
+            while (!text.empty() && (text.back() == '\n' || text.back() == '\r')) text.pop_back();
+            fs::path target(text);
+            gitDirectory = (target.is_absolute() ? target : dir / target).lexically_normal().string();
+        }
+        if (!gitDirectory.empty()) {
+            workTree = dir.string();
+            break;
+        }
+        if (dir == dir.parent_path()) break;
+    }
+    if (gitDirectory.empty()) {
+        return false;
+    }
+
+    // Object ids are compared as SHA-1
+    std::string config = ReadTextFile(gitDirectory + "/config");
+    if (config.find("objectformat = sha256") != std::string::npos ||
+        config.find("objectFormat = sha256") != std::string::npos) {
+        Close();
+        return false;
+    }
+
+    if (rootText.size() > workTree.size()) {
+        projectPrefix = rootText.substr(workTree.size() + (workTree == "/" ? 0 : 1)) + "/";
+    }
+    isOpen = true;
+    return true;
+#endif
+}
+
+void UCIDEGitStatus::Close() {
+    isOpen = false;
+    workTree.clear();
+    gitDirectory.clear();
+    projectPrefix.clear();
+    entries.clear();
+    entryByPath.clear();
+    hashedStats.clear();
+    indexStat = StatData();
+    indexLoaded = false;
+    indexVersion = 0;
+    changes.clear();
+    statistics = Statistics();
+}
+
+std::string UCIDEGitStatus::ToGitPath(std::string_view relativePath) const {
+    std::string path = projectPrefix;
+    path.append(relativePath);
+    return path;
+}
+
+// ============================================================================
+// INDEX
+// ============================================================================
+
+bool UCIDEGitStatus::LoadIndex() {
+    std::string indexPath = gitDirectory + "/index";
+    StatData current;
+    bool isSymlink = false;
+    bool isRegular = false;
+    if (!LstatPath(indexPath, current, isSymlink, isRegular)) {
+        // A fresh repository has no index yet: everything is untracked
+        entries.clear();
+        entryByPath.clear();
+        hashedStats.clear();
+        indexStat = StatData();
+        indexLoaded = true;
+        return true;
+    }
+    if (indexLoaded && current == indexStat) {
+        return true;
+    }
+
+    UCMappedFile file;
+    if (!file.Open(indexPath)) {
+        return false;
+    }
+
+    // Keep content hashes of files that stay in the index
+    std::unordered_map<std::string, HashedStat> previousHashes;
+    for (size_t i = 0; i < entries.size() && i < hashedStats.size(); ++i) {
+        if (hashedStats[i].valid) {
+            previousHashes.emplace(std::move(entries[i].path), hashedStats[i]);
+        }
+    }
+
+    if (!ParseIndex(file.Data(), file.Size())) {
+        entries.clear();
+        entryByPath.clear();
+        hashedStats.clear();
+        indexLoaded = false;
+        return false;
+    }
+
+    hashedStats.assign(entries.size(), HashedStat());
+    entryByPath.clear();
+    entryByPath.reserve(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        entryByPath.emplace(entries[i].path, static_cast<uint32_t>(i));
+        auto it = previousHashes.find(entries[i].path);
+        if (it != previousHashes.end()) {
+            hashedStats[i] = it->second;
+        }
+    }
+
+    indexStat = current;
+    indexLoaded = true;
+    statistics.indexReloaded = true;
+    return true;
+}
+
+bool UCIDEGitStatus::ParseIndex(const uint8_t* data, size_t size) {
+    if (size < INDEX_HEADER_SIZE + INDEX_CHECKSUM_SIZE || std::memcmp(data, "DIRC", 4) != 0) {
+        return false;
+    }
+    uint32_t version = ReadBE32(data + 4);
+    uint32_t count = ReadBE32(data + 8);
+    if (version < 2 || version > 4) {
+        return false;
+    }
+
+    const size_t end = size - INDEX_CHECKSUM_SIZE;
+    size_t pos = INDEX_HEADER_SIZE;
+    std::vector<IndexEntry> parsed;
+    parsed.reserve(std::min<size_t>(count, end / INDEX_ENTRY_FIXED_SIZE));
+    std::string_view previousPath;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        size_t entryStart = pos;
+        if (end - pos < INDEX_ENTRY_FIXED_SIZE) return false;
+
+        IndexEntry entry;
+        const uint8_t* p = data + pos;
+        entry.stat.ctimeSeconds = ReadBE32(p);
+        entry.stat.ctimeNanoseconds = ReadBE32(p + 4);
+        entry.stat.mtimeSeconds = ReadBE32(p + 8);
+        entry.stat.mtimeNanoseconds = ReadBE32(p + 12);
+        entry.stat.device = ReadBE32(p + 16);
+        entry.stat.inode = ReadBE32(p + 20);
+        entry.stat.mode = ReadBE32(p + 24);
+        entry.stat.uid = ReadBE32(p + 28);
+        entry.stat.gid = ReadBE32(p + 32);
+        entry.stat.size = ReadBE32(p + 36);
+        std::memcpy(entry.hash, p + 40, 20);
+        entry.flags = ReadBE16(p + 60);
+        pos += INDEX_ENTRY_FIXED_SIZE;
+
+        if (entry.flags & FLAG_EXTENDED) {
+            if (version < 3 || end - pos < 2) return false;
+            entry.extendedFlags = ReadBE16(data + pos);
+            pos += 2;
+        }
+
+        if (version == 4) {
+            // Path = previous path minus N trailing bytes + NUL-terminated suffix
+            size_t strip = 0;
+            if (pos >= end) return false;
+            uint8_t c = data[pos++];
+            strip = c & 0x7F;
+            while (c & 0x80) {
+                if (pos >= end) return false;
+                c = data[pos++];
+                strip = ((strip + 1) << 7) | (c & 0x7F);
+            }
+            if (strip > previousPath.size()) return false;
+            const void* nul = std::memchr(data + pos, 0, end - pos);
+            if (!nul) return false;
+            size_t suffixLength = static_cast<const uint8_t*>(nul) - (data + pos);
+            entry.path.reserve(previousPath.size() - strip + suffixLength);
+            entry.path.assign(previousPath.substr(0, previousPath.size() - strip));
+            entry.path.append(reinterpret_cast<const char*>(data + pos), suffixLength);
+            pos += suffixLength + 1;
+        } else {
+            // NUL-terminated, padded with 1-8 NULs to a multiple of 8
+            size_t nameLength = entry.flags & FLAG_NAME_MASK;
+            if (nameLength == FLAG_NAME_MASK) {
+                const void* nul = std::memchr(data + pos, 0, end - pos);
+                if (!nul) return false;
+                nameLength = static_cast<const uint8_t*>(nul) - (data + pos);
+            }
+            size_t entrySize = ((pos - entryStart) + nameLength + 8) & ~static_cast<size_t>(7);
+            if (end - entryStart < entrySize) return false;
+            entry.path.assign(reinterpret_cast<const char*>(data + pos), nameLength);
+            pos = entryStart + entrySize;
+        }
+
+        parsed.push_back(std::move(entry));
+        previousPath = parsed.back().path;
+    }
+
+    // Extensions; a split index keeps most entries in a shared file
+    while (end - pos >= 8) {
+        uint32_t extensionSize = ReadBE32(data + pos + 4);
+        if (std::memcmp(data + pos, "link", 4) == 0) return false;
+        if (end - pos - 8 < extensionSize) return false;
+        pos += 8 + extensionSize;
+    }
+
+    entries = std::move(parsed);
+    indexVersion = version;
+    return true;
+}
+
+// ============================================================================
+// IGNORE RULES
+// ============================================================================
+
+void UCIDEGitStatus::LoadIgnorePatterns() {
+    std::vector<std::string> namePatterns;
+    std::vector<std::string> pathPatterns;
+    for (const std::string& source : { workTree + "/.gitignore", gitDirectory + "/info/exclude" }) {
+        std::string text = ReadTextFile(source);
+        size_t start = 0;
+        while (start < text.size()) {
+            size_t lineEnd = text.find('\n', start);
+            if (lineEnd == std::string::npos) lineEnd = text.size();
+            std::string line = text.substr(start, lineEnd - start);
+            start = lineEnd + 1;
+
+            while (!line.empty() && (line.back() == '\r' || line.back() == ' ')) line.pop_back();
+            if (line.empty() || line[0] == '#' || line[0] == '!') continue;
+            if (line.back() == '/') line.pop_back();     // Directory-only rule
+            if (line.empty()) continue;
+
+            // A slash anchors the rule at the root; otherwise it matches a
+            // name at any depth. Either way everything below a match is ignored.
+            if (line.find('/') != std::string::npos) {
+                if (line[0] == '/') line.erase(0, 1);
+                pathPatterns.push_back(line);
+                pathPatterns.push_back(line + "/*");
+            } else {
+                namePatterns.push_back(line);
+                pathPatterns.push_back(line + "/*");
+                pathPatterns.push_back("*/" + line + "/*");
+            }
+        }
+    }
+    ignoreNameMatcher.Compile(namePatterns);
+    ignorePathMatcher.Compile(pathPatterns);
+}
+
+bool UCIDEGitStatus::IsIgnored(std::string_view gitPath) const {
+    size_t slash = gitPath.rfind('/');
+    std::string_view name = (slash == std::string_view::npos) ? gitPath : gitPath.substr(slash + 1);
+    return ignoreNameMatcher.Matches(name) || ignorePathMatcher.Matches(gitPath);
+}
+
+// ============================================================================
+// STATUS
+// ============================================================================
+
+VcsFileStatus UCIDEGitStatus::CheckEntry(size_t index, bool& hashed, bool& statMismatch) {
+    const IndexEntry& entry = entries[index];
+    if (entry.Stage() != 0) {
+        return VcsFileStatus::Conflicted;
+    }
+    if (entry.extendedFlags & EXTENDED_INTENT_TO_ADD) {
+        return VcsFileStatus::Added;
+    }
+    if ((entry.flags & FLAG_ASSUME_VALID) || (entry.extendedFlags & EXTENDED_SKIP_WORKTREE)) {
+        return VcsFileStatus::Unmodified;
+    }
+    uint32_t type = entry.stat.mode & MODE_TYPE_MASK;
+    if (type == MODE_GITLINK || type == MODE_DIRECTORY) {
+        return VcsFileStatus::Unmodified;
+    }
+
+    std::string path = workTree + "/" + entry.path;
+    StatData current;
+    bool isSymlink = false;
+    bool isRegular = false;
+    if (!LstatPath(path, current, isSymlink, isRegular)) {
+        return VcsFileStatus::Deleted;
+    }
+
+    // Type or executable bit changed
+    if ((type == MODE_SYMLINK) ? !isSymlink : !isRegular) {
+        return VcsFileStatus::Modified;
+    }
+    if (isRegular && ((current.mode ^ entry.stat.mode) & MODE_EXECUTABLE)) {
+        return VcsFileStatus::Modified;
+    }
+
+    // Matching stat data means unchanged, unless the file was written in
+    // the same timestamp tick as the index ("racily clean")
+    bool racy = entry.stat.mtimeSeconds > indexStat.mtimeSeconds ||
+                (entry.stat.mtimeSeconds == indexStat.mtimeSeconds &&
+                 entry.stat.mtimeNanoseconds >= indexStat.mtimeNanoseconds);
+    StatData recorded = entry.stat;
+    recorded.mode = current.mode;
+    if (current == recorded && !racy) {
+        return VcsFileStatus::Unmodified;
+    }
+    statMismatch = !(current == recorded);
+    if (current.size != entry.stat.size) {
+        return VcsFileStatus::Modified;
+    }
+
+    HashedStat& cached = hashedStats[index];
+    if (!cached.valid || !(cached.stat == current)) {
+        if (!HashWorkTreeFile(path, isSymlink, cached.hash)) {
+            return VcsFileStatus::Modified;
+        }
+        cached.stat = current;
+        cached.valid = true;
+        hashed = true;
+    }
+    return std::memcmp(cached.hash, entry.hash, 20) == 0 ? VcsFileStatus::Unmodified :
+                                                           VcsFileStatus::Modified;
+}
+
+bool UCIDEGitStatus::Refresh(const UCIDEProject& project) {
+    std::vector<std::string> projectFiles;
+    std::vector<const ProjectFolder*> folders = { &project.rootFolder };
+    while (!folders.empty()) {
+        const ProjectFolder* folder = folders.back();
+        folders.pop_back();
+        for (const auto& file : folder->files) {
+            projectFiles.push_back(file.GetRelativePath());
+        }
+        for (const auto& subfolder : folder->subfolders) {
+            folders.push_back(&subfolder);
+        }
+    }
+    return Refresh(projectFiles);
+}
+
+bool UCIDEGitStatus::Refresh(const std::vector<std::string>& projectFiles) {
+    if (!isOpen) {
+        return false;
+    }
+    auto start = std::chrono::steady_clock::now();
+    statistics = Statistics();
+
+    if (!LoadIndex()) {
+        changes.clear();
+        return false;
+    }
+    LoadIgnorePatterns();
+
+    // Entries are sorted by path, so the project's are one contiguous range
+    auto first = std::lower_bound(entries.begin(), entries.end(), projectPrefix,
+        [](const IndexEntry& entry, const std::string& prefix) { return entry.path < prefix; });
+    size_t begin = static_cast<size_t>(first - entries.begin());
+    size_t end = begin;
+    while (end < entries.size() && entries[end].path.compare(0, projectPrefix.size(), projectPrefix) == 0) {
+        ++end;
+    }
+
+    // Parallel lstat sweep; each worker claims chunks of entries
+    std::vector<VcsFileStatus> results(end - begin, VcsFileStatus::Unmodified);
+    std::atomic<size_t> nextChunk{begin};
+    std::atomic<size_t> hashedCount{0};
+    std::atomic<size_t> mismatchCount{0};
+    auto sweep = [&]() {
+        size_t hashedLocal = 0;
+        size_t mismatchLocal = 0;
+        while (true) {
+            size_t chunk = nextChunk.fetch_add(STAT_CHUNK_SIZE);
+            if (chunk >= end) break;
+            size_t chunkEnd = std::min(chunk + STAT_CHUNK_SIZE, end);
+            for (size_t i = chunk; i < chunkEnd; ++i) {
+                bool hashed = false;
+                bool mismatch = false;
+                results[i - begin] = CheckEntry(i, hashed, mismatch);
+                hashedLocal += hashed;
+                mismatchLocal += mismatch;
+            }
+        }
+        hashedCount += hashedLocal;
+        mismatchCount += mismatchLocal;
+    };
+
+    size_t threadCount = std::max(1u, std::thread::hardware_concurrency());
+    threadCount = std::min(threadCount, (end - begin + STAT_CHUNK_SIZE - 1) / STAT_CHUNK_SIZE);
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < threadCount; ++i) {
+        workers.emplace_back(sweep);
+    }
+    sweep();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    changes.clear();
+    for (size_t i = begin; i < end; ++i) {
+        if (results[i - begin] != VcsFileStatus::Unmodified) {
+            SetChange(entries[i].path, results[i - begin]);
+        }
+    }
+
+    // Untracked: project files the index does not know
+    for (const auto& file : projectFiles) {
+        std::string gitPath = ToGitPath(file);
+        if (entryByPath.find(gitPath) == entryByPath.end() && !IsIgnored(gitPath)) {
+            SetChange(gitPath, VcsFileStatus::Untracked);
+        }
+    }
+
+    statistics.indexVersion = indexVersion;
+    statistics.indexEntries = entries.size();
+    statistics.statMismatches = mismatchCount;
+    statistics.hashedFiles = hashedCount;
+    statistics.changedFiles = changes.size();
+    statistics.milliseconds = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+bool UCIDEGitStatus::NotifyFileChanged(const std::string& relativePath) {
+    if (!isOpen || !indexLoaded) {
+        return false;
+    }
+
+    std::string gitPath = ToGitPath(relativePath);
+    VcsFileStatus status = VcsFileStatus::Unmodified;
+    auto it = entryByPath.find(gitPath);
+    if (it != entryByPath.end()) {
+        bool hashed = false;
+        bool mismatch = false;
+        status = CheckEntry(it->second, hashed, mismatch);
+    } else {
+        StatData current;
+        bool isSymlink = false;
+        bool isRegular = false;
+        if (LstatPath(workTree + "/" + gitPath, current, isSymlink, isRegular) &&
+            (isRegular || isSymlink) && !IsIgnored(gitPath)) {
+            status = VcsFileStatus::Untracked;
+        }
+    }
+    return SetChange(gitPath, status);
+}
+
+bool UCIDEGitStatus::SetChange(std::string_view gitPath, VcsFileStatus status) {
+    std::string key(gitPath.substr(projectPrefix.size()));
+    auto it = changes.find(key);
+    VcsFileStatus previous = (it != changes.end()) ? it->second : VcsFileStatus::Unmodified;
+    if (status == VcsFileStatus::Unmodified) {
+        if (it != changes.end()) changes.erase(it);
+    } else if (it != changes.end()) {
+        it->second = status;
+    } else {
+        changes.emplace(std::move(key), status);
+    }
+    return previous != status;
+}
+
+VcsFileStatus UCIDEGitStatus::GetStatus(std::string_view relativePath) const {
+    auto it = changes.find(std::string(relativePath));
+    return it != changes.end() ? it->second : VcsFileStatus::Unmodified;
+}
+
+} // namespace IDE
+} // namespace UltraCanvas
@@ -0,0 +1,191 @@
+// Apps/IDE/Project/UCIDEGitStatus.h
+// Working tree status from the .git index without spawning git
+// Version: 1.0.0
+// Last Modified: 2026-10-17
+// Author: UltraCanvas Framework / ULTRA IDE
+#pragma once
+
+#include "UCIDEGlobMatcher.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+namespace UltraCanvas {
+namespace IDE {
+
+class UCIDEProject;
+
+// ============================================================================
+// STATUS TYPES
+// ============================================================================
+
+/**
+ * @brief Version control state of one file in the working tree
+ */
+enum class VcsFileStatus : uint8_t {
+    Unmodified,         // Tracked, matches the index
+    Modified,           // Tracked, content or type differs from the index
+    Added,              // Intent-to-add entry (git add -N)
+    Deleted,            // Tracked, missing from the working tree
+    Untracked,          // Not in the index and not ignored
+    Conflicted          // Unmerged index entries (stage 1-3)
+};
+
+// ============================================================================
+// GIT STATUS READER
+// ============================================================================
+
+/**
+ * @brief Computes working tree status the way `git status` does, in-process
+ *
+ * The .git/index file is memory-mapped and parsed directly (formats v2, v3
+ * and v4); it is re-read only when its own stat changes. Every tracked file
+ * is then lstat()ed on a pool of threads and compared with the stat data
+ * cached in the index. Only files whose stat differs (or that are "racily
+ * clean", modified within the index timestamp) are read and hashed as git
+ * blobs; those hashes are remembered per stat, so an unchanged file is
+ * hashed at most once across refreshes.
+ *
+ * Untracked files are the project tree's files that are not in the index,
+ * filtered by the root .gitignore and .git/info/exclude.
+ *
+ * Limitations: SHA-1 repositories only; staged-vs-HEAD differences are not
+ * reported (that needs the object database); split indexes are rejected;
+ * nested .gitignore files and negated patterns are not applied.
+ */
+class UCIDEGitStatus {
+public:
+    /**
+     * @brief Counters of the last Refresh
+     */
+    struct Statistics {
+        uint32_t indexVersion = 0;
+        size_t indexEntries = 0;
+        bool indexReloaded = false;
+        size_t statMismatches = 0;      // Entries whose lstat differed from the index
+        size_t hashedFiles = 0;         // Files read and hashed
+        size_t changedFiles = 0;        // Entries in GetChanges()
+        double milliseconds = 0;
+    };
+
+    /**
+     * @brief Locate the repository containing a project directory
+     * @return false if the directory is not inside a git work tree
+     */
+    bool Open(const std::string& projectRoot);
+
+    /**
+     * @brief Forget the repository and all cached state
+     */
+    void Close();
+
+    bool IsOpen() const { return isOpen; }
+    const std::string& GetWorkTree() const { return workTree; }
+
+    /**
+     * @brief Re-check the working tree against the index
+     * @param project Supplies the file tree used for untracked detection
+     * @return false if the index could not be read
+     */
+    bool Refresh(const UCIDEProject& project);
+
+    /**
+     * @brief Same, with the project's files given as paths relative to the
+     *        project root (callers that cannot touch the project tree)
+     */
+    bool Refresh(const std::vector<std::string>& projectFiles);
+
+    /**
+     * @brief Re-check one file after a save or file-watch event
+     * @param relativePath Path relative to the project root
+     * @return true if the file's status changed
+     */
+    bool NotifyFileChanged(const std::string& relativePath);
+
+    /**
+     * @brief Status of a file (path relative to the project root)
+     */
+    VcsFileStatus GetStatus(std::string_view relativePath) const;
+
+    /**
+     * @brief Every file that is not Unmodified, keyed by project-relative path
+     */
+    const std::unordered_map<std::string, VcsFileStatus>& GetChanges() const { return changes; }
+
+    const Statistics& GetStatistics() const { return statistics; }
+
+private:
+    /**
+     * @brief Stat fields git caches per index entry (32-bit, as stored)
+     */
+    struct StatData {
+        uint32_t ctimeSeconds = 0;
+        uint32_t ctimeNanoseconds = 0;
+        uint32_t mtimeSeconds = 0;
+        uint32_t mtimeNanoseconds = 0;
+        uint32_t device = 0;
+        uint32_t inode = 0;
+        uint32_t mode = 0;
+        uint32_t uid = 0;
+        uint32_t gid = 0;
+        uint32_t size = 0;
+
+        bool operator==(const StatData& other) const;
+    };
+
+    struct IndexEntry {
+        std::string path;               // Relative to the work tree
+        StatData stat;
+        uint8_t hash[20];
+        uint16_t flags = 0;
+        uint16_t extendedFlags = 0;
+
+        int Stage() const { return (flags >> 12) & 3; }
+    };
+
+    /**
+     * @brief Last content hash computed for an entry and the stat it was taken at
+     */
+    struct HashedStat {
+        StatData stat;
+        uint8_t hash[20];
+        bool valid = false;
+    };
+
+    bool LoadIndex();
+    bool ParseIndex(const uint8_t* data, size_t size);
+    void LoadIgnorePatterns();
+    bool IsIgnored(std::string_view gitPath) const;
+    VcsFileStatus CheckEntry(size_t entry, bool& hashed, bool& statMismatch);
+    std::string ToGitPath(std::string_view relativePath) const;
+    bool SetChange(std::string_view gitPath, VcsFileStatus status);
+
+    bool isOpen = false;
+    std::string workTree;               // Absolute work tree root
+    std::string gitDirectory;           // Absolute .git directory
+    std::string projectPrefix;          // Project root relative to workTree ("" or "dir/")
+
+    // Parsed index and the index file's own stat when it was parsed
+    // (also the reference for the racy-clean check)
+    std::vector<IndexEntry> entries;
+    std::unordered_map<std::string_view, uint32_t> entryByPath;
+    StatData indexStat;
+    bool indexLoaded = false;
+
+    // Content hashes by entry; survives index reloads by path
+    std::vector<HashedStat> hashedStats;
+
+    // Ignore rules: unanchored ones match a name at any depth, the rest
+    // (and everything below an ignored directory) match the whole path
+    UCIDEGlobMatcher ignoreNameMatcher;
+    UCIDEGlobMatcher ignorePathMatcher;
+    uint32_t indexVersion = 0;
+
+    std::unordered_map<std::string, VcsFileStatus> changes;
+    Statistics statistics;
+};
+
+} // namespace IDE
+} // namespace UltraCanvas
@@ -0,0 +1,302 @@
+// Apps/IDE/Project/UCIDEGlobMatcher.cpp
+// Compiled glob pattern set implementation
+// Version: 1.0.0
+// Last Modified: 2026-10-17
+// Author: UltraCanvas Framework / ULTRA IDE
+
+#include "UCIDEGlobMatcher.h"
+#include <algorithm>
+#include <array>
+
+namespace UltraCanvas {
+namespace IDE {
+
+namespace {
+
+// NFA state sets up to this many words live on the stack while matching
+constexpr size_t STACK_WORDS = 16;
+
+/**
+ * @brief Scratch state buffers, on the stack for typical pattern lists
+ */
+class NfaScratch {
+public:
+    explicit NfaScratch(size_t words) {
+        if (words > STACK_WORDS) heap.resize(words * 2);
+        a = words > STACK_WORDS ? heap.data() : stack.data();
+        b = a + words;
+    }
+
+    uint64_t* a;
+    uint64_t* b;
+
+private:
+    std::array<uint64_t, STACK_WORDS * 2> stack{};
+    std::vector<uint64_t> heap;
+};
+
+inline void SetBit(std::vector<uint64_t>& bits, size_t offset, size_t index) {
+    bits[offset + index / 64] |= 1ULL << (index % 64);
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// COMPILATION
+// ============================================================================
+
+void UCIDEGlobMatcher::Compile(const std::vector<std::string>& patternList) {
+    patterns = patternList;
+    matchAll = false;
+    exact.clear();
+    suffixes.clear();
+    suffixLengths.clear();
+    trie.assign(1, TrieNode());
+    nfaStates = 0;
+
+    std::vector<std::string> nfaPatterns;
+    for (const auto& pattern : patterns) {
+        // Runs of '*' are equivalent to a single one
+        std::string collapsed;
+        for (char c : pattern) {
+            if (c == '*' && !collapsed.empty() && collapsed.back() == '*') continue;
+            collapsed += c;
+        }
+
+        size_t firstWild = collapsed.find_first_of("*?");
+        if (firstWild == std::string::npos) {
+            exact.insert(collapsed);
+        } else if (collapsed == "*") {
+            matchAll = true;
+        } else if (firstWild == 0 && collapsed[0] == '*' &&
+                   collapsed.find_first_of("*?/", 1) == std::string::npos) {
+            // "*.ext": a suffix without '/' matches the path iff it matches the name
+            suffixes.insert(collapsed.substr(1));
+            suffixLengths.push_back(collapsed.size() - 1);
+        } else if (firstWild == collapsed.size() - 1 && collapsed.back() == '*') {
+            AddPrefix(std::string_view(collapsed).substr(0, collapsed.size() - 1));
+        } else {
+            nfaPatterns.push_back(collapsed);
+        }
+    }
+    std::sort(suffixLengths.begin(), suffixLengths.end());
+    suffixLengths.erase(std::unique(suffixLengths.begin(), suffixLengths.end()), suffixLengths.end());
+
+    // Each pattern of n tokens takes n + 1 states
+    for (const auto& pattern : nfaPatterns) nfaStates += pattern.size() + 1;
+    nfaWords = (nfaStates + 63) / 64;
+    charMasks.assign(256 * nfaWords, 0);
+    starMask.assign(nfaWords, 0);
+    acceptMask.assign(nfaWords, 0);
+    tailMask.assign(nfaWords, 0);
+    initial.assign(nfaWords, 0);
+
+    nfaStates = 0;
+    for (const auto& pattern : nfaPatterns) {
+        AddNfaPattern(pattern);
+    }
+    NfaClosure(initial.data());
+}
+
+void UCIDEGlobMatcher::AddPrefix(std::string_view prefix) {
+    int32_t node = 0;
+    for (char c : prefix) {
+        int32_t child = TrieChild(node, c);
+        if (child < 0) {
+            child = static_cast<int32_t>(trie.size());
+            trie[node].children.emplace_back(c, child);
+            trie.emplace_back();
+        }
+        node = child;
+    }
+    trie[node].terminal = true;
+}
+
+void UCIDEGlobMatcher::AddNfaPattern(std::string_view pattern) {
+    const size_t start = nfaStates;
+    SetBit(initial, 0, start);
+
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        size_t state = start + i;
+        char token = pattern[i];
+        if (token == '*') {
+            SetBit(starMask, 0, state);
+            if (i + 1 == pattern.size()) SetBit(tailMask, 0, state);
+        } else if (token == '?') {
+            for (size_t c = 0; c < 256; ++c) SetBit(charMasks, c * nfaWords, state + 1);
+        } else {
+            SetBit(charMasks, static_cast<unsigned char>(token) * nfaWords, state + 1);
+        }
+    }
+    SetBit(acceptMask, 0, start + pattern.size());
+    nfaStates += pattern.size() + 1;
+}
+
+// ============================================================================
+// PRIMITIVES
+// ============================================================================
+
+bool UCIDEGlobMatcher::MatchesSuffix(std::string_view text) const {
+    for (size_t length : suffixLengths) {
+        if (length > text.size()) break;
+        if (suffixes.find(text.substr(text.size() - length)) != suffixes.end()) return true;
+    }
+    return false;
+}
+
+int32_t UCIDEGlobMatcher::TrieChild(int32_t node, char c) const {
+    for (const auto& child : trie[node].children) {
+        if (child.first == c) return child.second;
+    }
+    return -1;
+}
+
+bool UCIDEGlobMatcher::TrieWalk(int32_t& node, std::string_view text) const {
+    if (node < 0) return false;
+    if (trie[node].terminal) return true;
+    for (char c : text) {
+        node = TrieChild(node, c);
+        if (node < 0) return false;
+        if (trie[node].terminal) return true;
+    }
+    return false;
+}
+
+void UCIDEGlobMatcher::NfaStep(const uint64_t* in, uint64_t* out, unsigned char c) const {
+    // Advance every state by one token (shift-and), keep '*' states alive
+    const uint64_t* mask = charMasks.data() + c * nfaWords;
+    uint64_t carry = 0;
+    for (size_t w = 0; w < nfaWords; ++w) {
+        uint64_t shifted = (in[w] << 1) | carry;
+        carry = in[w] >> 63;
+        out[w] = (shifted & mask[w]) | (in[w] & starMask[w]);
+    }
+    NfaClosure(out);
+}
+
+void UCIDEGlobMatcher::NfaClosure(uint64_t* states) const {
+    // '*' may match nothing: an active '*' state also enables the next one.
+    // Stars are collapsed, so the next state is never another '*'.
+    uint64_t carry = 0;
+    for (size_t w = 0; w < nfaWords; ++w) {
+        uint64_t stars = states[w] & starMask[w];
+        uint64_t next = (stars << 1) | carry;
+        carry = stars >> 63;
+        states[w] |= next;
+    }
+}
+
+bool UCIDEGlobMatcher::NfaAny(const uint64_t* states) const {
+    for (size_t w = 0; w < nfaWords; ++w) {
+        if (states[w]) return true;
+    }
+    return false;
+}
+
+bool UCIDEGlobMatcher::NfaAccepts(const uint64_t* start, std::string_view text) const {
+    if (nfaWords == 0) return false;
+
+    NfaScratch scratch(nfaWords);
+    uint64_t* current = scratch.a;
+    uint64_t* next = scratch.b;
+    std::copy(start, start + nfaWords, current);
+
+    for (char c : text) {
+        NfaStep(current, next, static_cast<unsigned char>(c));
+        std::swap(current, next);
+        if (!NfaAny(current)) return false;
+    }
+    for (size_t w = 0; w < nfaWords; ++w) {
+        if (current[w] & acceptMask[w]) return true;
+    }
+    return false;
+}
+
+// ============================================================================
+// MATCHING
+// ============================================================================
+
+bool UCIDEGlobMatcher::Matches(std::string_view text) const {
+    if (matchAll) return true;
+    if (exact.find(text) != exact.end()) return true;
+    if (MatchesSuffix(text)) return true;
+    int32_t node = 0;
+    if (TrieWalk(node, text)) return true;
+    return NfaAccepts(initial.data(), text);
+}
+
+UCIDEGlobMatcher::PathState UCIDEGlobMatcher::Root() const {
+    PathState state;
+    state.nfa = initial;
+    state.trieNode = 0;
+    state.excludesAll = matchAll;
+    return state;
+}
+
+UCIDEGlobMatcher::PathState UCIDEGlobMatcher::Descend(const PathState& directory,
+                                                      std::string_view name) const {
+    PathState state;
+    state.excludesAll = directory.excludesAll;
+    if (state.excludesAll) return state;
+
+    // Prefix patterns: passing a terminal means "prefix*" covers everything below
+    state.trieNode = directory.trieNode;
+    if (TrieWalk(state.trieNode, name)) {
+        state.excludesAll = true;
+        return state;
+    }
+    if (state.trieNode >= 0) {
+        state.trieNode = TrieChild(state.trieNode, '/');
+        if (state.trieNode >= 0 && trie[state.trieNode].terminal) {
+            state.excludesAll = true;
+            return state;
+        }
+    }
+
+    // NFA: a live trailing '*' state accepts any continuation
+    state.nfa.assign(nfaWords, 0);
+    if (nfaWords > 0 && !directory.nfa.empty() && NfaAny(directory.nfa.data())) {
+        NfaScratch scratch(nfaWords);
+        uint64_t* current = scratch.a;
+        uint64_t* next = scratch.b;
+        std::copy(directory.nfa.begin(), directory.nfa.end(), current);
+        for (char c : name) {
+            NfaStep(current, next, static_cast<unsigned char>(c));
+            std::swap(current, next);
+        }
+        NfaStep(current, next, '/');
+        std::copy(next, next + nfaWords, state.nfa.begin());
+        for (size_t w = 0; w < nfaWords; ++w) {
+            if (next[w] & tailMask[w]) {
+                state.excludesAll = true;
+                break;
+            }
+        }
+    }
+    return state;
+}
+
+bool UCIDEGlobMatcher::MatchesEntry(const PathState& directory, std::string_view relativePath,
+                                    std::string_view name) const {
+    if (matchAll || directory.excludesAll) return true;
+
+    if (exact.find(name) != exact.end()) return true;
+    if (relativePath.size() != name.size() && exact.find(relativePath) != exact.end()) return true;
+
+    // The suffix set holds no '/', so the name decides for the path too
+    if (MatchesSuffix(name)) return true;
+
+    int32_t node = directory.trieNode;
+    if (TrieWalk(node, name)) return true;
+    if (relativePath.size() != name.size()) {
+        node = 0;
+        if (TrieWalk(node, name)) return true;
+    }
+
+    if (nfaWords == 0) return false;
+    if (!directory.nfa.empty() && NfaAccepts(directory.nfa.data(), name)) return true;
+    return relativePath.size() != name.size() && NfaAccepts(initial.data(), name);
+}
+
+} // namespace IDE
+} // namespace UltraCanvas
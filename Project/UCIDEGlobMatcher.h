@@ -0,0 +1,125 @@
+// Apps/IDE/Project/UCIDEGlobMatcher.h
+// Compiled matcher for a set of glob patterns (project exclude list)
+// Version: 1.0.0
+// Last Modified: 2026-10-17
+// Author: UltraCanvas Framework / ULTRA IDE
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_set>
+#include <cstdint>
+
+namespace UltraCanvas {
+namespace IDE {
+
+/**
+ * @brief All glob patterns of a list compiled into one matcher
+ *
+ * Same semantics as matching each pattern in turn: '*' matches any run of
+ * characters (including '/'), '?' any single character, the whole string
+ * must match. Patterns are split by shape:
+ * - no wildcard ("Makefile")       -> exact hash set
+ * - '*' + literal ("*.o")          -> hash set per suffix length
+ * - literal + '*' ("build/...*")   -> character trie of prefixes
+ * - anything else ("cmake-*-dir?") -> one bit-parallel NFA
+ *
+ * For tree scans the matcher is driven per path component: the state after
+ * a directory's relative path is kept and only each entry name is fed on
+ * top of it. A directory whose state already matches every possible
+ * continuation (a prefix pattern ending in '*' covers it) is skipped
+ * entirely.
+ */
+class UCIDEGlobMatcher {
+public:
+    /**
+     * @brief Matcher state after a directory prefix ("a/b/")
+     */
+    struct PathState {
+        std::vector<uint64_t> nfa;      // Active NFA states
+        int32_t trieNode = 0;           // Prefix trie position, -1 when no prefix can match
+        bool excludesAll = false;       // Every path below the directory matches
+    };
+
+    UCIDEGlobMatcher() { Compile({}); }
+
+    /**
+     * @brief Compile a pattern list (replaces the previous one)
+     */
+    void Compile(const std::vector<std::string>& patterns);
+
+    /**
+     * @brief Patterns the matcher was compiled from
+     */
+    const std::vector<std::string>& GetPatterns() const { return patterns; }
+
+    /**
+     * @brief Whether any pattern matches the whole text
+     */
+    bool Matches(std::string_view text) const;
+
+    /**
+     * @brief State for the project root (empty prefix)
+     */
+    PathState Root() const;
+
+    /**
+     * @brief State for a subdirectory: directory prefix + name + "/"
+     */
+    PathState Descend(const PathState& directory, std::string_view name) const;
+
+    /**
+     * @brief Whether an entry of a directory is matched
+     *
+     * Equivalent to Matches(relativePath) || Matches(name), with
+     * relativePath being the directory prefix followed by name.
+     */
+    bool MatchesEntry(const PathState& directory, std::string_view relativePath,
+                      std::string_view name) const;
+
+private:
+    struct StringHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view text) const { return std::hash<std::string_view>{}(text); }
+    };
+    using StringSet = std::unordered_set<std::string, StringHash, std::equal_to<>>;
+
+    struct TrieNode {
+        std::vector<std::pair<char, int32_t>> children;
+        bool terminal = false;          // A prefix pattern ends here
+    };
+
+    void AddPrefix(std::string_view prefix);
+    void AddNfaPattern(std::string_view pattern);
+
+    bool MatchesSuffix(std::string_view text) const;
+    int32_t TrieChild(int32_t node, char c) const;
+    // Walks text from node; true if a terminal is passed. node ends at -1 if the trie runs out.
+    bool TrieWalk(int32_t& node, std::string_view text) const;
+    void NfaStep(const uint64_t* in, uint64_t* out, unsigned char c) const;
+    void NfaClosure(uint64_t* states) const;
+    bool NfaAccepts(const uint64_t* start, std::string_view text) const;
+    bool NfaAny(const uint64_t* states) const;
+
+    std::vector<std::string> patterns;
+    bool matchAll = false;              // The list contains "*"
+
+    StringSet exact;
+    StringSet suffixes;
+    std::vector<size_t> suffixLengths;  // Distinct lengths present in suffixes
+
+    std::vector<TrieNode> trie;         // trie[0] is the root
+
+    // NFA: one bit per state, states of all patterns laid out back to back
+    size_t nfaStates = 0;
+    size_t nfaWords = 0;
+    std::vector<uint64_t> charMasks;    // 256 * nfaWords: states entered on a character
+    std::vector<uint64_t> starMask;     // States with a '*' self-loop
+    std::vector<uint64_t> acceptMask;   // Final states
+    std::vector<uint64_t> tailMask;     // '*' states followed directly by the final state
+    std::vector<uint64_t> initial;      // Start states after closure
+};
+
+} // namespace IDE
+} // namespace UltraCanvas
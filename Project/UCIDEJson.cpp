@@ -0,0 +1,530 @@
+// Apps/IDE/Project/UCIDEJson.cpp
+// Single-pass JSON reader implementation
+// Version: 1.0.0
+// Last Modified: 2026-10-17
+// Author: UltraCanvas Framework / ULTRA IDE
+
+#include "UCIDEJson.h"
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <cerrno>
+
+namespace UltraCanvas {
+namespace IDE {
+
+// ============================================================================
+// UCJSONVALUE
+// ============================================================================
+
+bool UCJsonValue::AsBool(bool defaultValue) const {
+    return type == JsonType::Bool ? boolValue : defaultValue;
+}
+
+int64_t UCJsonValue::AsInt(int64_t defaultValue) const {
+    if (type != JsonType::Number) return defaultValue;
+    return isInteger ? intValue : static_cast<int64_t>(numberValue);
+}
+
+double UCJsonValue::AsDouble(double defaultValue) const {
+    return type == JsonType::Number ? numberValue : defaultValue;
+}
+
+size_t UCJsonValue::Size() const {
+    if (type == JsonType::Array) return elements.size();
+    if (type == JsonType::Object) return members.size();
+    return 0;
+}
+
+const UCJsonValue* UCJsonValue::At(size_t index) const {
+    if (type != JsonType::Array || index >= elements.size()) return nullptr;
+    return &elements[index];
+}
+
+const UCJsonValue* UCJsonValue::Find(std::string_view key) const {
+    if (type != JsonType::Object) return nullptr;
+    for (const auto& member : members) {
+        if (member.first == key) {
+            return &member.second;
+        }
+    }
+    return nullptr;
+}
+
+std::string UCJsonValue::GetString(std::string_view key, const std::string& defaultValue) const {
+    const UCJsonValue* v = Find(key);
+    return (v && v->IsString()) ? v->stringValue : defaultValue;
+}
+
+int64_t UCJsonValue::GetInt(std::string_view key, int64_t defaultValue) const {
+    const UCJsonValue* v = Find(key);
+    return v ? v->AsInt(defaultValue) : defaultValue;
+}
+
+bool UCJsonValue::GetBool(std::string_view key, bool defaultValue) const {
+    const UCJsonValue* v = Find(key);
+    return v ? v->AsBool(defaultValue) : defaultValue;
+}
+
+std::vector<std::string> UCJsonValue::GetStringArray(std::string_view key) const {
+    std::vector<std::string> result;
+    const UCJsonValue* v = Find(key);
+    if (!v || !v->IsArray()) return result;
+
+    result.reserve(v->elements.size());
+    for (const auto& element : v->elements) {
+        if (element.IsString()) {
+            result.push_back(element.stringValue);
+        }
+    }
+    return result;
+}
+
+UCJsonValue UCJsonValue::MakeBool(bool value) {
+    UCJsonValue v(JsonType::Bool);
+    v.boolValue = value;
+    return v;
+}
+
+UCJsonValue UCJsonValue::MakeNumber(double value, int64_t intValue, bool isInteger) {
+    UCJsonValue v(JsonType::Number);
+    v.numberValue = value;
+    v.intValue = intValue;
+    v.isInteger = isInteger;
+    return v;
+}
+
+UCJsonValue UCJsonValue::MakeString(std::string value) {
+    UCJsonValue v(JsonType::String);
+    v.stringValue = std::move(value);
+    return v;
+}
+
+UCJsonValue& UCJsonValue::Append(UCJsonValue value) {
+    elements.push_back(std::move(value));
+    return elements.back();
+}
+
+UCJsonValue& UCJsonValue::AddMember(std::string key, UCJsonValue value) {
+    members.emplace_back(std::move(key), std::move(value));
+    return members.back().second;
+}
+
+// ============================================================================
+// DOM BUILDER
+// ============================================================================
+
+namespace {
+
+/**
+ * @brief SAX handler that assembles a UCJsonValue tree
+ */
+class DomBuilder : public IUCJsonHandler {
+public:
+    explicit DomBuilder(UCJsonValue& root) : root(root) {}
+
+    bool OnNull() override { return Insert(UCJsonValue()); }
+    bool OnBool(bool value) override { return Insert(UCJsonValue::MakeBool(value)); }
+    bool OnNumber(double value, int64_t intValue, bool isInteger) override {
+        return Insert(UCJsonValue::MakeNumber(value, intValue, isInteger));
+    }
+    bool OnString(std::string&& value) override {
+        return Insert(UCJsonValue::MakeString(std::move(value)));
+    }
+    bool OnKey(std::string&& key) override {
+        pendingKey = std::move(key);
+        return true;
+    }
+    bool OnStartObject() override {
+        UCJsonValue* v = Insert(UCJsonValue(JsonType::Object));
+        stack.push_back(v);
+        return true;
+    }
+    bool OnEndObject() override {
+        stack.pop_back();
+        return true;
+    }
+    bool OnStartArray() override {
+        UCJsonValue* v = Insert(UCJsonValue(JsonType::Array));
+        stack.push_back(v);
+        return true;
+    }
+    bool OnEndArray() override {
+        stack.pop_back();
+        return true;
+    }
+
+private:
+    UCJsonValue* Insert(UCJsonValue value) {
+        if (stack.empty()) {
+            root = std::move(value);
+            return &root;
+        }
+        UCJsonValue* parent = stack.back();
+        if (parent->IsArray()) {
+            return &parent->Append(std::move(value));
+        }
+        return &parent->AddMember(std::move(pendingKey), std::move(value));
+    }
+
+    UCJsonValue& root;
+    std::vector<UCJsonValue*> stack;
+    std::string pendingKey;
+};
+
+/**
+ * @brief Append a Unicode code point as UTF-8
+ */
+void AppendUtf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+int HexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// UCJSONREADER
+// ============================================================================
+
+bool UCJsonReader::Parse(std::string_view text, IUCJsonHandler& handler) {
+    input = text;
+    pos = 0;
+    error.clear();
+    errorOffset = 0;
+
+    // Skip UTF-8 BOM
+    if (input.size() >= 3 && input.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+        pos = 3;
+    }
+
+    SkipWhitespace();
+    if (!ParseValue(handler, 0)) {
+        return false;
+    }
+    SkipWhitespace();
+    if (pos != input.size()) {
+        return Fail("Trailing characters after JSON document");
+    }
+    return true;
+}
+
+bool UCJsonReader::Parse(std::string_view text, UCJsonValue& out) {
+    out = UCJsonValue();
+    DomBuilder builder(out);
+    return Parse(text, builder);
+}
+
+void UCJsonReader::SkipWhitespace() {
+    while (pos < input.size()) {
+        char c = input[pos];
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r') break;
+        pos++;
+    }
+}
+
+bool UCJsonReader::Fail(const char* message) {
+    if (error.empty()) {
+        error = message;
+        errorOffset = pos;
+    }
+    return false;
+}
+
+bool UCJsonReader::ParseValue(IUCJsonHandler& handler, int depth) {
+    if (depth > MAX_DEPTH) {
+        return Fail("JSON nesting too deep");
+    }
+    if (pos >= input.size()) {
+        return Fail("Unexpected end of input");
+    }
+
+    switch (input[pos]) {
+        case '{': return ParseObject(handler, depth);
+        case '[': return ParseArray(handler, depth);
+        case '"': {
+            std::string value;
+            if (!ParseString(value)) return false;
+            return handler.OnString(std::move(value)) || Fail("Aborted by handler");
+        }
+        case 't':
+            if (!ParseLiteral("true")) return false;
+            return handler.OnBool(true) || Fail("Aborted by handler");
+        case 'f':
+            if (!ParseLiteral("false")) return false;
+            return handler.OnBool(false) || Fail("Aborted by handler");
+        case 'n':
+            if (!ParseLiteral("null")) return false;
+            return handler.OnNull() || Fail("Aborted by handler");
+        default:
+            return ParseNumber(handler);
+    }
+}
+
+bool UCJsonReader::ParseObject(IUCJsonHandler& handler, int depth) {
+    pos++; // '{'
+    if (!handler.OnStartObject()) return Fail("Aborted by handler");
+
+    SkipWhitespace();
+    if (pos < input.size() && input[pos] == '}') {
+        pos++;
+        return handler.OnEndObject() || Fail("Aborted by handler");
+    }
+
+    while (true) {
+        SkipWhitespace();
+        if (pos >= input.size() || input[pos] != '"') {
+            return Fail("Expected object key");
+        }
+        std::string key;
+        if (!ParseString(key)) return false;
+        if (!handler.OnKey(std::move(key))) return Fail("Aborted by handler");
+
+        SkipWhitespace();
+        if (pos >= input.size() || input[pos] != ':') {
+            return Fail("Expected ':' after object key");
+        }
+        pos++;
+        SkipWhitespace();
+
+        if (!ParseValue(handler, depth + 1)) return false;
+
+        SkipWhitespace();
+        if (pos >= input.size()) return Fail("Unterminated object");
+        if (input[pos] == ',') {
+            pos++;
+            continue;
+        }
+        if (input[pos] == '}') {
+            pos++;
+            return handler.OnEndObject() || Fail("Aborted by handler");
+        }
+        return Fail("Expected ',' or '}' in object");
+    }
+}
+
+bool UCJsonReader::ParseArray(IUCJsonHandler& handler, int depth) {
+    pos++; // '['
+    if (!handler.OnStartArray()) return Fail("Aborted by handler");
+
+    SkipWhitespace();
+    if (pos < input.size() && input[pos] == ']') {
+        pos++;
+        return handler.OnEndArray() || Fail("Aborted by handler");
+    }
+
+    while (true) {
+        SkipWhitespace();
+        if (!ParseValue(handler, depth + 1)) return false;
+
+        SkipWhitespace();
+        if (pos >= input.size()) return Fail("Unterminated array");
+        if (input[pos] == ',') {
+            pos++;
+            continue;
+        }
+        if (input[pos] == ']') {
+            pos++;
+            return handler.OnEndArray() || Fail("Aborted by handler");
+        }
+        return Fail("Expected ',' or ']' in array");
+    }
+}
+
+bool UCJsonReader::ParseString(std::string& out) {
+    pos++; // opening quote
+    out.clear();
+
+    while (pos < input.size()) {
+        // Copy the run of plain characters in one go
+        size_t runStart = pos;
+        while (pos < input.size()) {
+            char c = input[pos];
+            if (c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20) break;
+            pos++;
+        }
+        out.append(input.data() + runStart, pos - runStart);
+
+        if (pos >= input.size()) break;
+
+        char c = input[pos];
+        if (c == '"') {
+            pos++;
+            return true;
+        }
+        if (c != '\\') {
+            return Fail("Control character in string");
+        }
+
+        pos++;
+        if (pos >= input.size()) break;
+
+        switch (input[pos++]) {
+            case '"':  out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/':  out += '/'; break;
+            case 'b':  out += '\b'; break;
+            case 'f':  out += '\f'; break;
+            case 'n':  out += '\n'; break;
+            case 'r':  out += '\r'; break;
+            case 't':  out += '\t'; break;
+            case 'u': {
+                auto readHex4 = [this](uint32_t& value) -> bool {
+                    if (pos + 4 > input.size()) return false;
+                    value = 0;
+                    for (int i = 0; i < 4; ++i) {
+                        int d = HexDigit(input[pos + i]);
+                        if (d < 0) return false;
+                        value = (value << 4) | static_cast<uint32_t>(d);
+                    }
+                    pos += 4;
+                    return true;
+                };
+
+                uint32_t cp = 0;
+                if (!readHex4(cp)) return Fail("Invalid \\u escape");
+
+                if (cp >= 0xD800 && cp <= 0xDBFF) {
+                    // High surrogate - expect a low surrogate to follow
+                    uint32_t low = 0;
+                    if (pos + 1 < input.size() && input[pos] == '\\' && input[pos + 1] == 'u') {
+                        pos += 2;
+                        if (!readHex4(low)) return Fail("Invalid \\u escape");
+                    }
+                    if (low >= 0xDC00 && low <= 0xDFFF) {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    } else {
+                        cp = 0xFFFD;
+                    }
+                } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                    cp = 0xFFFD; // Lone low surrogate
+                }
+                AppendUtf8(out, cp);
+                break;
+            }
+            default:
+                pos--;
+                return Fail("Invalid escape sequence");
+        }
+    }
+
+    return Fail("Unterminated string");
+}
+
+bool UCJsonReader::ParseNumber(IUCJsonHandler& handler) {
+    size_t start = pos;
+    bool isInteger = true;
+
+    if (pos < input.size() && input[pos] == '-') pos++;
+    if (pos >= input.size() || !std::isdigit(static_cast<unsigned char>(input[pos]))) {
+        return Fail("Unexpected character");
+    }
+    while (pos < input.size() && std::isdigit(static_cast<unsigned char>(input[pos]))) pos++;
+
+    if (pos < input.size() && input[pos] == '.') {
+        isInteger = false;
+        pos++;
+        if (pos >= input.size() || !std::isdigit(static_cast<unsigned char>(input[pos]))) {
+            return Fail("Invalid number");
+        }
+        while (pos < input.size() && std::isdigit(static_cast<unsigned char>(input[pos]))) pos++;
+    }
+
+    if (pos < input.size() && (input[pos] == 'e' || input[pos] == 'E')) {
+        isInteger = false;
+        pos++;
+        if (pos < input.size() && (input[pos] == '+' || input[pos] == '-')) pos++;
+        if (pos >= input.size() || !std::isdigit(static_cast<unsigned char>(input[pos]))) {
+            return Fail("Invalid number");
+        }
+        while (pos < input.size() && std::isdigit(static_cast<unsigned char>(input[pos]))) pos++;
+    }
+
+    // strtod/strtoll need a terminated buffer; numbers are short
+    char buf[64];
+    size_t len = pos - start;
+    if (len >= sizeof(buf)) return Fail("Number too long");
+    std::memcpy(buf, input.data() + start, len);
+    buf[len] = '\0';
+
+    int64_t intValue = 0;
+    double value = 0.0;
+    if (isInteger) {
+        errno = 0;
+        intValue = std::strtoll(buf, nullptr, 10);
+        if (errno == ERANGE) isInteger = false;
+        value = isInteger ? static_cast<double>(intValue) : std::strtod(buf, nullptr);
+    } else {
+        value = std::strtod(buf, nullptr);
+        intValue = static_cast<int64_t>(value);
+    }
+
+    return handler.OnNumber(value, intValue, isInteger) || Fail("Aborted by handler");
+}
+
+bool UCJsonReader::ParseLiteral(std::string_view literal) {
+    if (input.compare(pos, literal.size(), literal) != 0) {
+        return Fail("Invalid literal");
+    }
+    pos += literal.size();
+    return true;
+}
+
+// ============================================================================
+// WRITER HELPERS
+// ============================================================================
+
+void JsonAppendEscaped(std::string& out, std::string_view str) {
+    size_t runStart = 0;
+    for (size_t i = 0; i < str.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(str[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+        out.append(str.data() + runStart, i - runStart);
+        runStart = i + 1;
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default: {
+                static const char hex[] = "0123456789abcdef";
+                char buf[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF]};
+                out.append(buf, sizeof(buf));
+            }
+        }
+    }
+    out.append(str.data() + runStart, str.size() - runStart);
+}
+
+std::string JsonEscapeString(std::string_view str) {
+    std::string result;
+    result.reserve(str.size() + 8);
+    JsonAppendEscaped(result, str);
+    return result;
+}
+
+} // namespace IDE
+} // namespace UltraCanvas
@@ -0,0 +1,198 @@
+// Apps/IDE/Project/UCIDEJson.h
+// Single-pass JSON reader (SAX + DOM) shared across ULTRA IDE
+// Version: 1.0.0
+// Last Modified: 2026-10-17
+// Author: UltraCanvas Framework / ULTRA IDE
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+namespace UltraCanvas {
+namespace IDE {
+
+// ============================================================================
+// JSON VALUE (DOM)
+// ============================================================================
+
+/**
+ * @brief JSON value type
+ */
+enum class JsonType {
+    Null,
+    Bool,
+    Number,
+    String,
+    Array,
+    Object
+};
+
+/**
+ * @brief Parsed JSON value
+ *
+ * Objects keep their members in document order as a flat vector of
+ * key/value pairs. Project and protocol objects are small, so a linear
+ * key lookup beats building a map for every object.
+ */
+class UCJsonValue {
+public:
+    UCJsonValue() = default;
+    explicit UCJsonValue(JsonType t) : type(t) {}
+
+    // ===== TYPE QUERIES =====
+    JsonType GetType() const { return type; }
+    bool IsNull() const { return type == JsonType::Null; }
+    bool IsBool() const { return type == JsonType::Bool; }
+    bool IsNumber() const { return type == JsonType::Number; }
+    bool IsString() const { return type == JsonType::String; }
+    bool IsArray() const { return type == JsonType::Array; }
+    bool IsObject() const { return type == JsonType::Object; }
+
+    // ===== SCALAR ACCESS =====
+    bool AsBool(bool defaultValue = false) const;
+    int64_t AsInt(int64_t defaultValue = 0) const;
+    double AsDouble(double defaultValue = 0.0) const;
+    const std::string& AsString() const { return stringValue; }
+
+    // ===== CONTAINER ACCESS =====
+
+    /**
+     * @brief Number of array elements or object members
+     */
+    size_t Size() const;
+
+    /**
+     * @brief Array element by index (nullptr if out of range / not an array)
+     */
+    const UCJsonValue* At(size_t index) const;
+
+    /**
+     * @brief Object member by key (nullptr if missing / not an object)
+     */
+    const UCJsonValue* Find(std::string_view key) const;
+
+    const std::vector<UCJsonValue>& Elements() const { return elements; }
+    const std::vector<std::pair<std::string, UCJsonValue>>& Members() const { return members; }
+
+    // ===== TYPED MEMBER HELPERS =====
+    std::string GetString(std::string_view key, const std::string& defaultValue = "") const;
+    int64_t GetInt(std::string_view key, int64_t defaultValue = 0) const;
+    bool GetBool(std::string_view key, bool defaultValue = false) const;
+    std::vector<std::string> GetStringArray(std::string_view key) const;
+
+    // ===== CONSTRUCTION =====
+    static UCJsonValue MakeBool(bool value);
+    static UCJsonValue MakeNumber(double value, int64_t intValue, bool isInteger);
+    static UCJsonValue MakeString(std::string value);
+
+    UCJsonValue& Append(UCJsonValue value);
+    UCJsonValue& AddMember(std::string key, UCJsonValue value);
+
+private:
+    JsonType type = JsonType::Null;
+    bool boolValue = false;
+    bool isInteger = false;
+    int64_t intValue = 0;
+    double numberValue = 0.0;
+    std::string stringValue;
+    std::vector<UCJsonValue> elements;
+    std::vector<std::pair<std::string, UCJsonValue>> members;
+};
+
+// ============================================================================
+// SAX INTERFACE
+// ============================================================================
+
+/**
+ * @brief Event handler for the streaming reader
+ *
+ * Every callback returns false to abort parsing early.
+ */
+class IUCJsonHandler {
+public:
+    virtual ~IUCJsonHandler() = default;
+
+    virtual bool OnNull() = 0;
+    virtual bool OnBool(bool value) = 0;
+    virtual bool OnNumber(double value, int64_t intValue, bool isInteger) = 0;
+    virtual bool OnString(std::string&& value) = 0;
+    virtual bool OnKey(std::string&& key) = 0;
+    virtual bool OnStartObject() = 0;
+    virtual bool OnEndObject() = 0;
+    virtual bool OnStartArray() = 0;
+    virtual bool OnEndArray() = 0;
+};
+
+// ============================================================================
+// READER
+// ============================================================================
+
+/**
+ * @brief Single-pass JSON reader
+ *
+ * Walks the input exactly once, emitting SAX events or building a
+ * UCJsonValue tree. Handles full string escapes including \uXXXX and
+ * UTF-16 surrogate pairs (decoded to UTF-8).
+ */
+class UCJsonReader {
+public:
+    /**
+     * @brief Parse text and stream events to handler
+     * @return true if the whole document was valid
+     */
+    bool Parse(std::string_view text, IUCJsonHandler& handler);
+
+    /**
+     * @brief Parse text into a DOM tree
+     * @return true if the whole document was valid
+     */
+    bool Parse(std::string_view text, UCJsonValue& out);
+
+    /**
+     * @brief Error message of the last failed parse
+     */
+    const std::string& GetError() const { return error; }
+
+    /**
+     * @brief Byte offset of the last error
+     */
+    size_t GetErrorOffset() const { return errorOffset; }
+
+private:
+    bool ParseValue(IUCJsonHandler& handler, int depth);
+    bool ParseObject(IUCJsonHandler& handler, int depth);
+    bool ParseArray(IUCJsonHandler& handler, int depth);
+    bool ParseString(std::string& out);
+    bool ParseNumber(IUCJsonHandler& handler);
+    bool ParseLiteral(std::string_view literal);
+    void SkipWhitespace();
+    bool Fail(const char* message);
+
+    std::string_view input;
+    size_t pos = 0;
+    std::string error;
+    size_t errorOffset = 0;
+
+    // Guard against stack exhaustion on hostile input
+    static constexpr int MAX_DEPTH = 512;
+};
+
+// ============================================================================
+// WRITER HELPERS
+// ============================================================================
+
+/**
+ * @brief Escape a string for inclusion in a JSON document (no quotes)
+ */
+std::string JsonEscapeString(std::string_view str);
+
+/**
+ * @brief Append an escaped string to an output buffer (no quotes)
+ */
+void JsonAppendEscaped(std::string& out, std::string_view str);
+
+} // namespace IDE
+} // namespace UltraCanvas
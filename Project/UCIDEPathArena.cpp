@@ -0,0 +1,230 @@
+// Apps/IDE/Project/UCIDEPathArena.cpp
+// Interned path storage implementation
+// Version: 1.0.0
+// Last Modified: 2026-10-17
+// Author: UltraCanvas Framework / ULTRA IDE
+
+#include "UCIDEPathArena.h"
+#include "../Build/IUCCompilerPlugin.h"
+#include <algorithm>
+#include <cstring>
+
+namespace UltraCanvas {
+namespace IDE {
+
+namespace {
+
+constexpr size_t NAME_BLOCK_SIZE = 64 * 1024;
+
+// ProjectFolder defaults to the root without seeing this header
+static_assert(ProjectPathArena::ROOT_DIRECTORY == 0, "ProjectFolder::directoryId default");
+
+} // anonymous namespace
+
+// ============================================================================
+// BUILDING
+// ============================================================================
+
+ProjectPathArena::ProjectPathArena(const std::string& rootDirectory, const std::string& rootName)
+    : root(rootDirectory) {
+    directories.push_back({ INVALID_ID, InternName(rootName) });
+    directoryPaths.emplace_back();
+    directoryPathReady.push_back(true);
+}
+
+uint32_t ProjectPathArena::InternName(std::string_view name) {
+    auto it = nameIds.find(name);
+    if (it != nameIds.end()) {
+        return it->second;
+    }
+
+    if (blockUsed + name.size() > blockCapacity) {
+        blockCapacity = std::max(NAME_BLOCK_SIZE, name.size());
+        nameBlocks.emplace_back(new char[blockCapacity]);
+        blockUsed = 0;
+    }
+    char* stored = nameBlocks.back().get() + blockUsed;
+    if (!name.empty()) {
+        std::memcpy(stored, name.data(), name.size());
+    }
+    blockUsed += name.size();
+
+    uint32_t id = static_cast<uint32_t>(names.size());
+    names.emplace_back(stored, name.size());
+    nameIds.emplace(names.back(), id);
+    return id;
+}
+
+uint32_t ProjectPathArena::AddDirectory(uint32_t parent, std::string_view name) {
+    uint32_t nameId = InternName(name);
+    auto result = childDirectories.emplace(ChildKey(parent, nameId),
+                                           static_cast<uint32_t>(directories.size()));
+    if (result.second) {
+        directories.push_back({ parent, nameId });
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        directoryPaths.emplace_back();
+        directoryPathReady.push_back(false);
+    }
+    return result.first->second;
+}
+
+// ============================================================================
+// LOOKUP
+// ============================================================================
+
+uint32_t ProjectPathArena::FindName(std::string_view name) const {
+    auto it = nameIds.find(name);
+    return it != nameIds.end() ? it->second : INVALID_ID;
+}
+
+uint32_t ProjectPathArena::FindDirectory(uint32_t parent, uint32_t nameId) const {
+    auto it = childDirectories.find(ChildKey(parent, nameId));
+    return it != childDirectories.end() ? it->second : INVALID_ID;
+}
+
+bool ProjectPathArena::Resolve(std::string_view relativePath, uint32_t& directory,
+                               uint32_t& nameId) const {
+    directory = ROOT_DIRECTORY;
+    nameId = INVALID_ID;
+    if (relativePath.empty()) {
+        return true;
+    }
+
+    size_t start = 0;
+    while (true) {
+        size_t slash = relativePath.find('/', start);
+        std::string_view component = relativePath.substr(
+            start, slash == std::string_view::npos ? std::string_view::npos : slash - start);
+        uint32_t id = FindName(component);
+        if (id == INVALID_ID) {
+            return false;
+        }
+        if (slash == std::string_view::npos) {
+            nameId = id;
+            return true;
+        }
+        directory = FindDirectory(directory, id);
+        if (directory == INVALID_ID) {
+            return false;
+        }
+        start = slash + 1;
+    }
+}
+
+// ============================================================================
+// PATH MATERIALIZATION
+// ============================================================================
+
+const std::string& ProjectPathArena::GetDirectoryPath(uint32_t directory) const {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    if (directoryPathReady[directory]) {
+        return directoryPaths[directory];
+    }
+
+    // Walk up to the nearest cached ancestor, then fill downwards
+    std::vector<uint32_t> chain;
+    uint32_t current = directory;
+    while (!directoryPathReady[current]) {
+        chain.push_back(current);
+        current = directories[current].parent;
+    }
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        const std::string& parentPath = directoryPaths[directories[*it].parent];
+        std::string_view name = names[directories[*it].name];
+        std::string& path = directoryPaths[*it];
+        path.reserve(parentPath.size() + 1 + name.size());
+        path = parentPath;
+        if (!path.empty()) path += '/';
+        path.append(name);
+        directoryPathReady[*it] = true;
+    }
+    return directoryPaths[directory];
+}
+
+std::string ProjectPathArena::GetAbsoluteDirectoryPath(uint32_t directory) const {
+    const std::string& relative = GetDirectoryPath(directory);
+    if (relative.empty()) {
+        return root;
+    }
+    std::string path;
+    path.reserve(root.size() + 1 + relative.size());
+    path = root;
+    path += '/';
+    path += relative;
+    return path;
+}
+
+std::string ProjectPathArena::MakeRelativePath(uint32_t directory, uint32_t nameId) const {
+    const std::string& directoryPath = GetDirectoryPath(directory);
+    std::string_view name = names[nameId];
+    std::string path;
+    path.reserve(directoryPath.size() + 1 + name.size());
+    path = directoryPath;
+    if (!path.empty()) path += '/';
+    path.append(name);
+    return path;
+}
+
+std::string ProjectPathArena::MakeAbsolutePath(uint32_t directory, uint32_t nameId) const {
+    const std::string& directoryPath = GetDirectoryPath(directory);
+    std::string_view name = names[nameId];
+    std::string path;
+    path.reserve(root.size() + directoryPath.size() + 2 + name.size());
+    path = root;
+    if (!directoryPath.empty()) {
+        path += '/';
+        path += directoryPath;
+    }
+    path += '/';
+    path.append(name);
+    return path;
+}
+
+// ============================================================================
+// STATISTICS
+// ============================================================================
+
+size_t ProjectPathArena::GetMemoryUsage() const {
+    size_t bytes = nameBlocks.size() * NAME_BLOCK_SIZE;
+    bytes += names.capacity() * sizeof(std::string_view);
+    bytes += nameIds.size() * (sizeof(std::string_view) + sizeof(uint32_t) + 2 * sizeof(void*));
+    bytes += directories.capacity() * sizeof(Directory);
+    bytes += childDirectories.size() * (sizeof(uint64_t) + sizeof(uint32_t) + 2 * sizeof(void*));
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    for (const auto& path : directoryPaths) {
+        bytes += sizeof(std::string) + (path.capacity() > 15 ? path.capacity() : 0);
+    }
+    return bytes;
+}
+
+// ============================================================================
+// PROJECT FILE / FOLDER PATHS
+// ============================================================================
+
+std::string_view ProjectFile::GetFileName() const {
+    return paths ? paths->GetName(nameId) : std::string_view();
+}
+
+std::string ProjectFile::GetRelativePath() const {
+    return paths ? paths->MakeRelativePath(directoryId, nameId) : std::string();
+}
+
+std::string ProjectFile::GetAbsolutePath() const {
+    return paths ? paths->MakeAbsolutePath(directoryId, nameId) : std::string();
+}
+
+std::string_view ProjectFolder::GetName() const {
+    return paths ? paths->GetDirectoryName(directoryId) : std::string_view();
+}
+
+std::string ProjectFolder::GetRelativePath() const {
+    return paths ? paths->GetDirectoryPath(directoryId) : std::string();
+}
+
+std::string ProjectFolder::GetAbsolutePath() const {
+    return paths ? paths->GetAbsoluteDirectoryPath(directoryId) : std::string();
+}
+
+} // namespace IDE
+} // namespace UltraCanvas
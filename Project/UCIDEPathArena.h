@@ -0,0 +1,129 @@
+// Apps/IDE/Project/UCIDEPathArena.h
+// Interned path storage for the project file tree
+// Version: 1.0.0
+// Last Modified: 2026-10-17
+// Author: UltraCanvas Framework / ULTRA IDE
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
+
+namespace UltraCanvas {
+namespace IDE {
+
+/**
+ * @brief Interned storage for the paths of one project file tree
+ *
+ * Directories are {parent, name} records and files reference their
+ * directory plus an interned name, so a tree entry costs two 32-bit ids
+ * instead of three path strings. Each distinct name is stored once
+ * (CMakeLists.txt, README.md, ... repeat all over a tree).
+ *
+ * Directory paths are materialized on first request and cached; file
+ * paths are composed from the cached directory path on demand.
+ *
+ * The arena is filled while a tree is scanned and is read-only once the
+ * tree is published; only the directory path cache changes afterwards,
+ * under its own lock.
+ */
+class ProjectPathArena {
+public:
+    static constexpr uint32_t ROOT_DIRECTORY = 0;
+    static constexpr uint32_t INVALID_ID = UINT32_MAX;
+
+    /**
+     * @brief Create an arena with the root directory record
+     * @param rootDirectory Absolute project root (no trailing slash)
+     * @param rootName Display name of the root folder
+     */
+    ProjectPathArena(const std::string& rootDirectory, const std::string& rootName);
+
+    ProjectPathArena(const ProjectPathArena&) = delete;
+    ProjectPathArena& operator=(const ProjectPathArena&) = delete;
+
+    // ===== BUILDING =====
+
+    /**
+     * @brief Intern a name, returning the id of the stored copy
+     */
+    uint32_t InternName(std::string_view name);
+
+    /**
+     * @brief Add (or find) the subdirectory 'name' of 'parent'
+     */
+    uint32_t AddDirectory(uint32_t parent, std::string_view name);
+
+    // ===== LOOKUP =====
+
+    const std::string& GetRoot() const { return root; }
+    std::string_view GetName(uint32_t nameId) const { return names[nameId]; }
+    uint32_t FindName(std::string_view name) const;
+
+    uint32_t GetDirectoryParent(uint32_t directory) const { return directories[directory].parent; }
+    uint32_t GetDirectoryNameId(uint32_t directory) const { return directories[directory].name; }
+    std::string_view GetDirectoryName(uint32_t directory) const { return names[directories[directory].name]; }
+    uint32_t FindDirectory(uint32_t parent, uint32_t nameId) const;
+
+    /**
+     * @brief Resolve a relative path to (containing directory, name id)
+     *
+     * The final component may name a file or a directory; use
+     * FindDirectory(directory, nameId) to tell. "" resolves to the root
+     * with nameId INVALID_ID.
+     * @return false if any component is not in the arena
+     */
+    bool Resolve(std::string_view relativePath, uint32_t& directory, uint32_t& nameId) const;
+
+    // ===== PATH MATERIALIZATION =====
+
+    /**
+     * @brief Path of a directory relative to the root ("" for the root)
+     */
+    const std::string& GetDirectoryPath(uint32_t directory) const;
+    std::string GetAbsoluteDirectoryPath(uint32_t directory) const;
+
+    std::string MakeRelativePath(uint32_t directory, uint32_t nameId) const;
+    std::string MakeAbsolutePath(uint32_t directory, uint32_t nameId) const;
+
+    // ===== STATISTICS =====
+
+    size_t GetDirectoryCount() const { return directories.size(); }
+    size_t GetNameCount() const { return names.size(); }
+    size_t GetMemoryUsage() const;
+
+private:
+    struct Directory {
+        uint32_t parent;
+        uint32_t name;
+    };
+
+    static uint64_t ChildKey(uint32_t parent, uint32_t nameId) {
+        return (static_cast<uint64_t>(parent) << 32) | nameId;
+    }
+
+    std::string root;
+
+    // Name characters live in fixed blocks so the views never move
+    std::vector<std::unique_ptr<char[]>> nameBlocks;
+    size_t blockUsed = 0;
+    size_t blockCapacity = 0;
+    std::vector<std::string_view> names;
+    std::unordered_map<std::string_view, uint32_t> nameIds;
+
+    std::vector<Directory> directories;
+    std::unordered_map<uint64_t, uint32_t> childDirectories;
+
+    // Relative directory paths, filled lazily (deque keeps references stable)
+    mutable std::deque<std::string> directoryPaths;
+    mutable std::vector<bool> directoryPathReady;
+    mutable std::mutex cacheMutex;
+};
+
+} // namespace IDE
+} // namespace UltraCanvas
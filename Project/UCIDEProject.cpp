@@ -5,6 +5,9 @@
 // Author: UltraCanvas Framework / ULTRA IDE
 
 #include "UCIDEProject.h"
+#include "UCIDEJson.h"
+#include "UCIDEProjectSnapshot.h"
+#include "UCMappedFile.h"
 #include "../Build/UCBuildOutput.h"
 #include <fstream>
 #include <sstream>
@@ -13,6 +16,10 @@
 #include <iomanip>
 #include <regex>
 #include <cstring>
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <unordered_map>
 
 // Platform-specific includes for directory operations
 #ifdef _WIN32
@@ -46,69 +53,6 @@ std::string GetCurrentTimestamp() {
     return ss.str();
 }
 
-/**
- * @brief Escape string for JSON
- */
-std::string JsonEscape(const std::string& str) {
-    std::string result;
-    result.reserve(str.size() + 10);
-    
-    for (char c : str) {
-        switch (c) {
-            case '"':  result += "\\\""; break;
-            case '\\': result += "\\\\"; break;
-            case '\b': result += "\\b"; break;
-            case '\f': result += "\\f"; break;
-            case '\n': result += "\\n"; break;
-            case '\r': result += "\\r"; break;
-            case '\t': result += "\\t"; break;
-            default:
-                if (c < 0x20) {
-                    char buf[8];
-                    snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned char>(c));
-                    result += buf;
-                } else {
-                    result += c;
-                }
-        }
-    }
-    
-    return result;
-}
-
-/**
- * @brief Unescape JSON string
- */
-std::string JsonUnescape(const std::string& str) {
-    std::string result;
-    result.reserve(str.size());
-    
-    for (size_t i = 0; i < str.size(); ++i) {
-        if (str[i] == '\\' && i + 1 < str.size()) {
-            switch (str[i + 1]) {
-                case '"':  result += '"'; i++; break;
-                case '\\': result += '\\'; i++; break;
-                case 'b':  result += '\b'; i++; break;
-                case 'f':  result += '\f'; i++; break;
-                case 'n':  result += '\n'; i++; break;
-                case 'r':  result += '\r'; i++; break;
-                case 't':  result += '\t'; i++; break;
-                case 'u':
-                    if (i + 5 < str.size()) {
-                        i += 5;
-                    }
-                    break;
-                default:
-                    result += str[i];
-            }
-        } else {
-            result += str[i];
-        }
-    }
-    
-    return result;
-}
-
 /**
  * @brief Write indentation
  */
@@ -120,7 +64,7 @@ std::string Indent(int level) {
  * @brief Write JSON string value
  */
 std::string JsonString(const std::string& value) {
-    return "\"" + JsonEscape(value) + "\"";
+    return "\"" + JsonEscapeString(value) + "\"";
 }
 
 /**
@@ -140,153 +84,6 @@ std::string JsonStringArray(const std::vector<std::string>& arr, int indent) {
     return ss.str();
 }
 
-/**
- * @brief Simple JSON value extraction (string)
- */
-std::string ExtractJsonString(const std::string& json, const std::string& key) {
-    std::string searchKey = "\"" + key + "\"";
-    size_t keyPos = json.find(searchKey);
-    if (keyPos == std::string::npos) return "";
-    
-    size_t colonPos = json.find(':', keyPos);
-    if (colonPos == std::string::npos) return "";
-    
-    size_t startQuote = json.find('"', colonPos);
-    if (startQuote == std::string::npos) return "";
-    
-    size_t endQuote = startQuote + 1;
-    while (endQuote < json.size()) {
-        if (json[endQuote] == '"' && json[endQuote - 1] != '\\') {
-            break;
-        }
-        endQuote++;
-    }
-    
-    if (endQuote >= json.size()) return "";
-    
-    return JsonUnescape(json.substr(startQuote + 1, endQuote - startQuote - 1));
-}
-
-/**
- * @brief Simple JSON value extraction (int)
- */
-int ExtractJsonInt(const std::string& json, const std::string& key, int defaultValue = 0) {
-    std::string searchKey = "\"" + key + "\"";
-    size_t keyPos = json.find(searchKey);
-    if (keyPos == std::string::npos) return defaultValue;
-    
-    size_t colonPos = json.find(':', keyPos);
-    if (colonPos == std::string::npos) return defaultValue;
-    
-    size_t start = colonPos + 1;
-    while (start < json.size() && (json[start] == ' ' || json[start] == '\t' || json[start] == '\n')) {
-        start++;
-    }
-    
-    std::string numStr;
-    while (start < json.size() && (std::isdigit(json[start]) || json[start] == '-')) {
-        numStr += json[start++];
-    }
-    
-    if (numStr.empty()) return defaultValue;
-    
-    try {
-        return std::stoi(numStr);
-    } catch (...) {
-        return defaultValue;
-    }
-}
-
-/**
- * @brief Simple JSON value extraction (bool)
- */
-bool ExtractJsonBool(const std::string& json, const std::string& key, bool defaultValue = false) {
-    std::string searchKey = "\"" + key + "\"";
-    size_t keyPos = json.find(searchKey);
-    if (keyPos == std::string::npos) return defaultValue;
-    
-    size_t colonPos = json.find(':', keyPos);
-    if (colonPos == std::string::npos) return defaultValue;
-    
-    size_t start = colonPos + 1;
-    while (start < json.size() && (json[start] == ' ' || json[start] == '\t' || json[start] == '\n')) {
-        start++;
-    }
-    
-    if (start + 4 <= json.size() && json.substr(start, 4) == "true") return true;
-    if (start + 5 <= json.size() && json.substr(start, 5) == "false") return false;
-    
-    return defaultValue;
-}
-
-/**
- * @brief Extract JSON array of strings
- */
-std::vector<std::string> ExtractJsonStringArray(const std::string& json, const std::string& key) {
-    std::vector<std::string> result;
-    
-    std::string searchKey = "\"" + key + "\"";
-    size_t keyPos = json.find(searchKey);
-    if (keyPos == std::string::npos) return result;
-    
-    size_t bracketStart = json.find('[', keyPos);
-    if (bracketStart == std::string::npos) return result;
-    
-    size_t bracketEnd = bracketStart + 1;
-    int depth = 1;
-    while (bracketEnd < json.size() && depth > 0) {
-        if (json[bracketEnd] == '[') depth++;
-        else if (json[bracketEnd] == ']') depth--;
-        bracketEnd++;
-    }
-    
-    std::string arrayContent = json.substr(bracketStart + 1, bracketEnd - bracketStart - 2);
-    
-    size_t pos = 0;
-    while (pos < arrayContent.size()) {
-        size_t startQuote = arrayContent.find('"', pos);
-        if (startQuote == std::string::npos) break;
-        
-        size_t endQuote = startQuote + 1;
-        while (endQuote < arrayContent.size()) {
-            if (arrayContent[endQuote] == '"' && arrayContent[endQuote - 1] != '\\') {
-                break;
-            }
-            endQuote++;
-        }
-        
-        if (endQuote < arrayContent.size()) {
-            result.push_back(JsonUnescape(arrayContent.substr(startQuote + 1, endQuote - startQuote - 1)));
-        }
-        
-        pos = endQuote + 1;
-    }
-    
-    return result;
-}
-
-/**
- * @brief Extract JSON object section
- */
-std::string ExtractJsonObject(const std::string& json, const std::string& key) {
-    std::string searchKey = "\"" + key + "\"";
-    size_t keyPos = json.find(searchKey);
-    if (keyPos == std::string::npos) return "";
-    
-    size_t braceStart = json.find('{', keyPos);
-    if (braceStart == std::string::npos) return "";
-    
-    size_t braceEnd = braceStart + 1;
-    int depth = 1;
-    while (braceEnd < json.size() && depth > 0) {
-        if (json[braceEnd] == '{') depth++;
-        else if (json[braceEnd] == '}') depth--;
-        braceEnd++;
-    }
-    
-    return json.substr(braceStart, braceEnd - braceStart);
-}
-
 /**
  * @brief Check if file exists
  */
@@ -364,59 +161,170 @@ std::vector<std::pair<std::string, bool>> GetDirectoryEntries(const std::string&
 }
 
 /**
- * @brief Simple glob pattern matching
+ * @brief Extract targets (and the project() name) from CMakeLists.txt text
  */
-bool MatchesGlob(const std::string& str, const std::string& pattern) {
-    size_t s = 0, p = 0;
-    size_t starIdx = std::string::npos;
-    size_t matchIdx = 0;
-    
-    while (s < str.size()) {
-        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == str[s])) {
-            s++;
-            p++;
-        } else if (p < pattern.size() && pattern[p] == '*') {
-            starIdx = p;
-            matchIdx = s;
-            p++;
-        } else if (starIdx != std::string::npos) {
-            p = starIdx + 1;
-            matchIdx++;
-            s = matchIdx;
+void ParseCMakeTargets(const std::string& content, std::vector<CMakeTarget>& targets,
+                       std::string& projectName) {
+    // Simple regex to find add_executable and add_library
+    std::regex executableRegex(R"(add_executable\s*\(\s*(\w+))", std::regex::icase);
+    std::regex libraryRegex(R"(add_library\s*\(\s*(\w+))", std::regex::icase);
+    std::regex projectRegex(R"(project\s*\(\s*(\w+))", std::regex::icase);
+    
+    std::smatch match;
+    std::string::const_iterator searchStart = content.cbegin();
+    
+    // Extract project name
+    if (std::regex_search(content, match, projectRegex)) {
+        projectName = match[1].str();
+    }
+    
+    // Find executables
+    while (std::regex_search(searchStart, content.cend(), match, executableRegex)) {
+        CMakeTarget target;
+        target.name = match[1].str();
+        target.type = CMakeTarget::Type::Executable;
+        targets.push_back(target);
+        searchStart = match.suffix().first;
+    }
+    
+    // Find libraries
+    searchStart = content.cbegin();
+    while (std::regex_search(searchStart, content.cend(), match, libraryRegex)) {
+        CMakeTarget target;
+        target.name = match[1].str();
+        // Determine library type based on content (simplified)
+        if (content.find("STATIC") != std::string::npos) {
+            target.type = CMakeTarget::Type::StaticLibrary;
+        } else if (content.find("SHARED") != std::string::npos) {
+            target.type = CMakeTarget::Type::SharedLibrary;
         } else {
-            return false;
+            target.type = CMakeTarget::Type::StaticLibrary;
         }
+        targets.push_back(target);
+        searchStart = match.suffix().first;
     }
-    
-    while (p < pattern.size() && pattern[p] == '*') {
-        p++;
+}
+
+/**
+ * @brief Entry named 'name' in a previous listing, both walked in sorted order
+ * @param cursor Position in 'previous'; only moves forward
+ */
+template<typename Entry, typename GetName>
+const Entry* FindPreviousEntry(const std::vector<Entry>& previous, std::string_view name,
+                               size_t& cursor, GetName getName) {
+    while (cursor < previous.size() && getName(previous[cursor]) < name) {
+        ++cursor;
+    }
+    if (cursor < previous.size() && getName(previous[cursor]) == name) {
+        return &previous[cursor++];
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Copy editor state (open, modified, expanded) from the live tree
+ *        to a rescanned one, for every entry present in both
+ */
+void CarryOverEditorState(const ProjectFolder& from, ProjectFolder& to) {
+    to.isExpanded = from.isExpanded;
+    
+    auto fileName = [](const ProjectFile& f) { return f.GetFileName(); };
+    size_t cursor = 0;
+    for (ProjectFile& file : to.files) {
+        const ProjectFile* previous = FindPreviousEntry(from.files, file.GetFileName(), cursor, fileName);
+        if (previous) {
+            file.isOpen = previous->isOpen;
+            file.isModified = previous->isModified;
+        }
     }
     
-    return p == pattern.size();
+    auto folderName = [](const ProjectFolder& f) { return f.GetName(); };
+    cursor = 0;
+    for (ProjectFolder& subfolder : to.subfolders) {
+        const ProjectFolder* previous = FindPreviousEntry(from.subfolders, subfolder.GetName(), cursor, folderName);
+        if (previous) {
+            CarryOverEditorState(*previous, subfolder);
+        }
+    }
+}
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
 }
 
 } // anonymous namespace
 
+// ============================================================================
+// FILE TREE SCAN STATE
+// ============================================================================
+
+/**
+ * @brief Output of one directory scan, built apart from the live tree
+ */
+struct UCIDEProject::FileTreeScan {
+    std::shared_ptr<ProjectPathArena> arena;
+    std::vector<std::pair<std::string, int64_t>> directories;
+    const UCIDEGlobMatcher* matcher = nullptr;
+    const std::atomic<bool>* cancel = nullptr;
+    
+    // Revalidation only: stamps and subdirectory names of the previous scan
+    // by relative path; a directory whose stamp is unchanged is not listed
+    bool revalidating = false;
+    std::unordered_map<std::string_view, int64_t> previousStamps;
+    std::unordered_map<std::string_view, std::vector<std::string_view>> previousSubdirectories;
+    size_t rescannedDirectories = 0;
+};
+
+/**
+ * @brief Background check of a snapshot-restored tree and CMake targets
+ */
+struct UCIDEProject::Revalidation {
+    std::thread worker;
+    std::atomic<bool> cancel{false};
+    std::atomic<bool> finished{false};
+    std::chrono::steady_clock::time_point started;
+    double milliseconds = 0;
+    
+    // Private copies; excludePatterns, the live tree's editor state and
+    // the stamps may all change while the worker runs
+    UCIDEGlobMatcher matcher;
+    ProjectFolder previousRoot;
+    std::shared_ptr<const ProjectPathArena> previousArena;  // Names of previousRoot
+    std::vector<std::pair<std::string, int64_t>> previousStamps;
+    FileTreeScan scan;
+    ProjectFolder rootFolder;
+    bool fileTreeChanged = false;
+    
+    std::string cmakeListsPath;         // Absolute; empty when CMake is off
+    int64_t cmakeListsModifiedTime = 0;
+    std::vector<CMakeTarget> cmakeTargets;
+    bool cmakeTargetsChanged = false;
+    
+    ~Revalidation() {
+        cancel = true;
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+};
+
 // ============================================================================
 // UCIDEPROJECT IMPLEMENTATION
 // ============================================================================
 
 bool UCIDEProject::LoadFromFile(const std::string& path) {
+    auto loadStart = std::chrono::steady_clock::now();
     try {
-        std::ifstream file(path);
-        if (!file.is_open()) {
-            return false;
-        }
+        CancelRevalidation();
         
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        std::string json = buffer.str();
-        file.close();
-        
-        if (!FromJSON(json)) {
+        UCMappedFile file;
+        if (!file.Open(path)) {
             return false;
         }
         
+        std::string_view json = file.View();
+        uint64_t textHash = HashBytes64(json.data(), json.size());
+        
         projectFilePath = path;
         
         // Extract root directory from project file path
@@ -428,8 +336,36 @@ bool UCIDEProject::LoadFromFile(const std::string& path) {
             rootDirectory = ".";
         }
         
+        // Fast path: binary snapshot built from this exact .ucproj text,
+        // usable at once and checked against the disk in the background
+        auto snapshot = UCIDEProjectSnapshot::Load(*this, textHash);
+        if (snapshot.loaded) {
+            sourceHash = textHash;
+            if (!snapshot.fileTreeRestored) {
+                RefreshFileTree();
+                UCIDEProjectSnapshot::Save(*this, sourceHash);
+            }
+            MarkOpenFiles();
+            StartRevalidation();
+            isModified = false;
+            
+            loadTiming = ProjectLoadTiming();
+            loadTiming.fromSnapshot = true;
+            loadTiming.loadMilliseconds = MillisecondsSince(loadStart);
+            return true;
+        }
+        
+        if (!FromJSON(json)) {
+            return false;
+        }
+        
+        sourceHash = textHash;
         RefreshFileTree();
+        UCIDEProjectSnapshot::Save(*this, sourceHash);
         isModified = false;
+        
+        loadTiming = ProjectLoadTiming();
+        loadTiming.loadMilliseconds = MillisecondsSince(loadStart);
         return true;
         
     } catch (const std::exception&) {
@@ -458,6 +394,10 @@ bool UCIDEProject::SaveToFile(const std::string& path) {
         
         projectFilePath = savePath;
         isModified = false;
+        
+        // Keep the reopen cache in step with the file just written
+        sourceHash = HashBytes64(json.data(), json.size());
+        UCIDEProjectSnapshot::Save(*this, sourceHash);
         return true;
         
     } catch (const std::exception&) {
@@ -465,6 +405,13 @@ bool UCIDEProject::SaveToFile(const std::string& path) {
     }
 }
 
+bool UCIDEProject::SaveSession() const {
+    if (sourceHash == 0) {
+        return false;                   // Never loaded from or saved to a .ucproj
+    }
+    return UCIDEProjectSnapshot::Save(*this, sourceHash);
+}
+
 BuildConfiguration& UCIDEProject::GetActiveConfiguration() {
     if (activeConfigurationIndex >= 0 && 
         activeConfigurationIndex < static_cast<int>(configurations.size())) {
@@ -529,32 +476,108 @@ int UCIDEProject::FindConfiguration(const std::string& name) const {
 }
 
 void UCIDEProject::RefreshFileTree() {
+    CancelRevalidation();
+    
+    FileTreeScan scan;
+    scan.arena = std::make_shared<ProjectPathArena>(rootDirectory, name);
+    scan.matcher = &GetExcludeMatcher();
+    
     rootFolder = ProjectFolder();
-    rootFolder.name = name;
-    rootFolder.absolutePath = rootDirectory;
-    rootFolder.relativePath = "";
+    rootFolder.paths = scan.arena.get();
+    rootFolder.directoryId = ProjectPathArena::ROOT_DIRECTORY;
     rootFolder.isExpanded = true;
     
     if (!rootDirectory.empty() && DirectoryExists(rootDirectory)) {
-        ScanDirectory(rootDirectory, rootFolder, 0);
+        ScanDirectory(scan, rootDirectory, rootFolder, nullptr, scan.matcher->Root(), 0);
     }
+    
+    pathArena = std::move(scan.arena);
+    scannedDirectories = std::move(scan.directories);
 }
 
-void UCIDEProject::ScanDirectory(const std::string& path, ProjectFolder& folder, int depth) {
+void UCIDEProject::ScanDirectory(FileTreeScan& scan, const std::string& path, ProjectFolder& folder,
+                                 const ProjectFolder* previous,
+                                 const UCIDEGlobMatcher::PathState& excludeState, int depth) {
     if (depth > MAX_SCAN_DEPTH) {
         return;
     }
+    if (scan.cancel && scan.cancel->load(std::memory_order_relaxed)) {
+        return;
+    }
+    
+    ProjectPathArena& arena = *scan.arena;
+    const UCIDEGlobMatcher& matcher = *scan.matcher;
+    const std::string& folderPath = arena.GetDirectoryPath(folder.directoryId);
+    
+    // Stamp before listing so a change during the scan invalidates the cache
+    int64_t modifiedTime = GetPathModifiedTime(path);
+    scan.directories.emplace_back(folderPath, modifiedTime);
+    
+    auto folderName = [](const ProjectFolder& f) { return f.GetName(); };
+    auto fileName = [](const ProjectFile& f) { return f.GetFileName(); };
+    size_t previousFolder = 0;
+    size_t previousFile = 0;
+    
+    auto addSubfolder = [&](std::string_view entryName) {
+        // Skipped unlisted when everything below is excluded
+        UCIDEGlobMatcher::PathState subState = matcher.Descend(excludeState, entryName);
+        if (subState.excludesAll) {
+            return;
+        }
+        
+        const ProjectFolder* previousSubfolder = previous ?
+            FindPreviousEntry(previous->subfolders, entryName, previousFolder, folderName) : nullptr;
+        
+        ProjectFolder subfolder;
+        subfolder.paths = &arena;
+        subfolder.directoryId = arena.AddDirectory(folder.directoryId, entryName);
+        subfolder.isExpanded = previousSubfolder ? previousSubfolder->isExpanded : false;
+        
+        std::string subPath = path;
+        subPath += '/';
+        subPath.append(entryName);
+        ScanDirectory(scan, subPath, subfolder, previousSubfolder, subState, depth + 1);
+        
+        // Only add non-empty folders
+        if (!subfolder.files.empty() || !subfolder.subfolders.empty()) {
+            folder.subfolders.push_back(std::move(subfolder));
+        }
+    };
+    
+    if (scan.revalidating) {
+        auto stamp = scan.previousStamps.find(folderPath);
+        if (stamp != scan.previousStamps.end() && modifiedTime != 0 && stamp->second == modifiedTime) {
+            // Listing unchanged since the previous scan: take it over
+            if (previous) {
+                folder.files.reserve(previous->files.size());
+                for (const auto& previousEntry : previous->files) {
+                    ProjectFile file = previousEntry;
+                    file.paths = &arena;
+                    file.directoryId = folder.directoryId;
+                    file.nameId = arena.InternName(previousEntry.GetFileName());
+                    folder.files.push_back(file);
+                }
+            }
+            auto subdirectories = scan.previousSubdirectories.find(folderPath);
+            if (subdirectories != scan.previousSubdirectories.end()) {
+                for (std::string_view subdirectory : subdirectories->second) {
+                    addSubfolder(subdirectory);
+                }
+            }
+            return;
+        }
+        ++scan.rescannedDirectories;
+    }
     
     auto entries = GetDirectoryEntries(path);
     
     for (const auto& entry : entries) {
-        std::string fullPath = path + "/" + entry.first;
-        std::string relativePath = folder.relativePath.empty() ? 
+        std::string relativePath = folderPath.empty() ? 
                                    entry.first : 
-                                   folder.relativePath + "/" + entry.first;
+                                   folderPath + "/" + entry.first;
         
         // Check exclude patterns
-        if (MatchesExcludePattern(relativePath) || MatchesExcludePattern(entry.first)) {
+        if (matcher.MatchesEntry(excludeState, relativePath, entry.first)) {
             continue;
         }
         
@@ -564,28 +587,19 @@ void UCIDEProject::ScanDirectory(const std::string& path, ProjectFolder& folder,
         }
         
         if (entry.second) {
-            // Directory
-            ProjectFolder subfolder;
-            subfolder.name = entry.first;
-            subfolder.absolutePath = fullPath;
-            subfolder.relativePath = relativePath;
-            subfolder.isExpanded = false;
-            
-            ScanDirectory(fullPath, subfolder, depth + 1);
-            
-            // Only add non-empty folders
-            if (!subfolder.files.empty() || !subfolder.subfolders.empty()) {
-                folder.subfolders.push_back(subfolder);
-            }
+            addSubfolder(entry.first);
         } else {
-            // File
+            // File; editor state carries over from the previous scan
+            const ProjectFile* previousEntry = previous ?
+                FindPreviousEntry(previous->files, entry.first, previousFile, fileName) : nullptr;
+            
             ProjectFile file;
-            file.absolutePath = fullPath;
-            file.relativePath = relativePath;
-            file.fileName = entry.first;
+            file.paths = &arena;
+            file.directoryId = folder.directoryId;
+            file.nameId = arena.InternName(entry.first);
             file.DetectType();
-            file.isOpen = false;
-            file.isModified = false;
+            file.isOpen = previousEntry ? previousEntry->isOpen : false;
+            file.isModified = previousEntry ? previousEntry->isModified : false;
             
             folder.files.push_back(file);
         }
@@ -605,21 +619,51 @@ void UCIDEProject::RemoveFile(const std::string& filePath) {
 }
 
 ProjectFile* UCIDEProject::FindFile(const std::string& relativePath) {
-    std::function<ProjectFile*(ProjectFolder&)> search = [&](ProjectFolder& folder) -> ProjectFile* {
-        for (auto& file : folder.files) {
-            if (file.relativePath == relativePath || file.absolutePath == relativePath) {
-                return &file;
-            }
-        }
-        for (auto& subfolder : folder.subfolders) {
-            if (auto* found = search(subfolder)) {
-                return found;
+    if (!pathArena) {
+        return nullptr;
+    }
+    
+    // Absolute paths inside the project are accepted as well
+    std::string_view path = relativePath;
+    const std::string& root = pathArena->GetRoot();
+    if (!root.empty() && path.size() > root.size() &&
+        path.compare(0, root.size(), root) == 0 && path[root.size()] == '/') {
+        path.remove_prefix(root.size() + 1);
+    }
+    
+    uint32_t directoryId = 0;
+    uint32_t nameId = 0;
+    if (!pathArena->Resolve(path, directoryId, nameId) || nameId == ProjectPathArena::INVALID_ID) {
+        return nullptr;
+    }
+    
+    // Walk down the folder tree along the directory chain
+    std::vector<uint32_t> chain;
+    for (uint32_t dir = directoryId; dir != ProjectPathArena::ROOT_DIRECTORY;
+         dir = pathArena->GetDirectoryParent(dir)) {
+        chain.push_back(dir);
+    }
+    ProjectFolder* folder = &rootFolder;
+    for (auto it = chain.rbegin(); it != chain.rend() && folder; ++it) {
+        ProjectFolder* next = nullptr;
+        for (auto& subfolder : folder->subfolders) {
+            if (subfolder.directoryId == *it) {
+                next = &subfolder;
+                break;
             }
         }
+        folder = next;
+    }
+    if (!folder) {
         return nullptr;
-    };
+    }
     
-    return search(rootFolder);
+    for (auto& file : folder->files) {
+        if (file.nameId == nameId) {
+            return &file;
+        }
+    }
+    return nullptr;
 }
 
 const ProjectFile* UCIDEProject::FindFile(const std::string& relativePath) const {
@@ -681,12 +725,14 @@ std::vector<ProjectFile*> UCIDEProject::GetModifiedFiles() {
 }
 
 bool UCIDEProject::MatchesExcludePattern(const std::string& path) const {
-    for (const auto& pattern : excludePatterns) {
-        if (MatchesGlob(path, pattern)) {
-            return true;
-        }
+    return GetExcludeMatcher().Matches(path);
+}
+
+const UCIDEGlobMatcher& UCIDEProject::GetExcludeMatcher() const {
+    if (excludeMatcher.GetPatterns() != excludePatterns) {
+        excludeMatcher.Compile(excludePatterns);
     }
-    return false;
+    return excludeMatcher;
 }
 
 bool UCIDEProject::DetectCMakeProject() {
@@ -713,61 +759,164 @@ bool UCIDEProject::ParseCMakeLists() {
         return false;
     }
     
+    cmakeListsModifiedTime = GetPathModifiedTime(cmakePath);
     std::string content((std::istreambuf_iterator<char>(file)),
                         std::istreambuf_iterator<char>());
     file.close();
     
     cmakeTargets.clear();
     
-    // Simple regex to find add_executable and add_library
-    std::regex executableRegex(R"(add_executable\s*\(\s*(\w+))", std::regex::icase);
-    std::regex libraryRegex(R"(add_library\s*\(\s*(\w+))", std::regex::icase);
-    std::regex projectRegex(R"(project\s*\(\s*(\w+))", std::regex::icase);
+    std::string projectName;
+    ParseCMakeTargets(content, cmakeTargets, projectName);
+    if (name.empty()) {
+        name = projectName;
+    }
     
-    std::smatch match;
-    std::string::const_iterator searchStart = content.cbegin();
+    // Set first target as active if none selected
+    if (cmake.activeTarget.empty() && !cmakeTargets.empty()) {
+        cmake.activeTarget = cmakeTargets[0].name;
+    }
     
-    // Extract project name
-    if (std::regex_search(content, match, projectRegex)) {
-        if (name.empty()) {
-            name = match[1].str();
+    return true;
+}
+
+// ============================================================================
+// BACKGROUND REVALIDATION
+// ============================================================================
+
+void UCIDEProject::StartRevalidation() {
+    CancelRevalidation();
+    
+    auto job = std::make_shared<Revalidation>();
+    job->started = std::chrono::steady_clock::now();
+    job->matcher = GetExcludeMatcher();
+    job->previousRoot = rootFolder;
+    job->previousArena = pathArena;
+    job->previousStamps = scannedDirectories;
+    job->scan.arena = std::make_shared<ProjectPathArena>(rootDirectory, name);
+    job->scan.matcher = &job->matcher;
+    job->scan.cancel = &job->cancel;
+    job->scan.revalidating = true;
+    job->rootFolder.paths = job->scan.arena.get();
+    job->rootFolder.directoryId = ProjectPathArena::ROOT_DIRECTORY;
+    job->rootFolder.isExpanded = rootFolder.isExpanded;
+    if (cmake.enabled && !cmake.cmakeListsPath.empty()) {
+        job->cmakeListsPath = GetAbsolutePath(cmake.cmakeListsPath);
+        job->cmakeListsModifiedTime = cmakeListsModifiedTime;
+    }
+    
+    // The worker only touches the job; the UI keeps editing the live tree
+    // and ApplyRevalidation carries those edits over
+    Revalidation* state = job.get();
+    std::string root = rootDirectory;
+    
+    job->worker = std::thread([state, root]() {
+        const ProjectFolder* previousRoot = &state->previousRoot;
+        const auto* previousStamps = &state->previousStamps;
+        FileTreeScan& scan = state->scan;
+        scan.previousStamps.reserve(previousStamps->size());
+        for (const auto& dir : *previousStamps) {
+            std::string_view path = dir.first;
+            scan.previousStamps.emplace(path, dir.second);
+            if (path.empty()) continue;
+            size_t slash = path.rfind('/');
+            std::string_view parent = (slash == std::string_view::npos) ? std::string_view() : path.substr(0, slash);
+            scan.previousSubdirectories[parent].push_back(path.substr(slash + 1));
+        }
+        for (auto& entry : scan.previousSubdirectories) {
+            std::sort(entry.second.begin(), entry.second.end());
+        }
+        
+        if (DirectoryExists(root)) {
+            ScanDirectory(scan, root, state->rootFolder, previousRoot, state->matcher.Root(), 0);
         }
+        if (state->cancel.load()) {
+            return;
+        }
+        state->fileTreeChanged = scan.rescannedDirectories > 0 ||
+                                 scan.directories.size() != previousStamps->size();
+        
+        if (!state->cmakeListsPath.empty()) {
+            int64_t modifiedTime = GetPathModifiedTime(state->cmakeListsPath);
+            if (modifiedTime != state->cmakeListsModifiedTime) {
+                std::ifstream file(state->cmakeListsPath);
+                if (file.is_open()) {
+                    std::string content((std::istreambuf_iterator<char>(file)),
+                                        std::istreambuf_iterator<char>());
+                    std::string projectName;
+                    ParseCMakeTargets(content, state->cmakeTargets, projectName);
+                }
+                state->cmakeListsModifiedTime = modifiedTime;
+                state->cmakeTargetsChanged = true;
+            }
+        }
+        
+        state->milliseconds = MillisecondsSince(state->started);
+        state->finished.store(true, std::memory_order_release);
+    });
+    
+    revalidation = std::move(job);
+}
+
+void UCIDEProject::CancelRevalidation() {
+    revalidation.reset();               // Revalidation joins its worker
+}
+
+bool UCIDEProject::ApplyRevalidation() {
+    if (!revalidation || !revalidation->finished.load(std::memory_order_acquire)) {
+        return false;
     }
     
-    // Find executables
-    while (std::regex_search(searchStart, content.cend(), match, executableRegex)) {
-        CMakeTarget target;
-        target.name = match[1].str();
-        target.type = CMakeTarget::Type::Executable;
-        cmakeTargets.push_back(target);
-        searchStart = match.suffix().first;
+    std::shared_ptr<Revalidation> job = std::move(revalidation);
+    if (job->worker.joinable()) {
+        job->worker.join();
     }
     
-    // Find libraries
-    searchStart = content.cbegin();
-    while (std::regex_search(searchStart, content.cend(), match, libraryRegex)) {
-        CMakeTarget target;
-        target.name = match[1].str();
-        // Determine library type based on content (simplified)
-        if (content.find("STATIC") != std::string::npos) {
-            target.type = CMakeTarget::Type::StaticLibrary;
-        } else if (content.find("SHARED") != std::string::npos) {
-            target.type = CMakeTarget::Type::SharedLibrary;
-        } else {
-            target.type = CMakeTarget::Type::StaticLibrary;
+    loadTiming.revalidateMilliseconds = job->milliseconds;
+    loadTiming.checkedDirectories = job->scan.directories.size();
+    loadTiming.rescannedDirectories = job->scan.rescannedDirectories;
+    loadTiming.fileTreeChanged = job->fileTreeChanged;
+    loadTiming.cmakeTargetsChanged = job->cmakeTargetsChanged;
+    
+    // An unchanged tree is left in place so nothing holding it is disturbed.
+    // Files opened, saved or folders expanded during the check keep that
+    // state in the new tree
+    if (job->fileTreeChanged) {
+        CarryOverEditorState(rootFolder, job->rootFolder);
+        pathArena = std::move(job->scan.arena);
+        rootFolder = std::move(job->rootFolder);
+        scannedDirectories = std::move(job->scan.directories);
+    }
+    if (job->cmakeTargetsChanged) {
+        cmakeTargets = std::move(job->cmakeTargets);
+        cmakeListsModifiedTime = job->cmakeListsModifiedTime;
+        if (cmake.activeTarget.empty() && !cmakeTargets.empty()) {
+            cmake.activeTarget = cmakeTargets[0].name;
         }
-        cmakeTargets.push_back(target);
-        searchStart = match.suffix().first;
     }
     
-    // Set first target as active if none selected
-    if (cmake.activeTarget.empty() && !cmakeTargets.empty()) {
-        cmake.activeTarget = cmakeTargets[0].name;
+    if (!job->fileTreeChanged && !job->cmakeTargetsChanged) {
+        return false;
     }
-    
+    SaveSession();
     return true;
 }
 
+bool UCIDEProject::WaitForRevalidation() {
+    if (revalidation && revalidation->worker.joinable()) {
+        revalidation->worker.join();
+    }
+    return ApplyRevalidation();
+}
+
+void UCIDEProject::MarkOpenFiles() {
+    for (const auto& path : openFiles) {
+        if (ProjectFile* file = FindFile(path)) {
+            file->isOpen = true;
+        }
+    }
+}
+
 std::vector<std::string> UCIDEProject::GetCMakeTargetNames() const {
     std::vector<std::string> names;
     for (const auto& target : cmakeTargets) {
@@ -867,54 +1016,77 @@ std::string UCIDEProject::ToJSON() const {
     return ss.str();
 }
 
-bool UCIDEProject::FromJSON(const std::string& json) {
+bool UCIDEProject::FromJSON(std::string_view json) {
     try {
+        UCJsonReader reader;
+        UCJsonValue root;
+        if (!reader.Parse(json, root) || !root.IsObject()) {
+            return false;
+        }
+        
         // Parse project section
-        std::string projectSection = ExtractJsonObject(json, "project");
-        if (!projectSection.empty()) {
-            name = ExtractJsonString(projectSection, "name");
-            version = ExtractJsonString(projectSection, "version");
-            description = ExtractJsonString(projectSection, "description");
-            author = ExtractJsonString(projectSection, "author");
-            createdDate = ExtractJsonString(projectSection, "created");
-            modifiedDate = ExtractJsonString(projectSection, "modified");
+        if (const UCJsonValue* project = root.Find("project")) {
+            name = project->GetString("name");
+            version = project->GetString("version");
+            description = project->GetString("description");
+            author = project->GetString("author");
+            createdDate = project->GetString("created");
+            modifiedDate = project->GetString("modified");
         }
         
         // Parse compiler section
-        std::string compilerSection = ExtractJsonObject(json, "compiler");
-        if (!compilerSection.empty()) {
-            primaryCompiler = StringToCompilerType(ExtractJsonString(compilerSection, "type"));
-            compilerPath = ExtractJsonString(compilerSection, "path");
-            std::string defaultConfig = ExtractJsonString(compilerSection, "defaultConfiguration");
-            // Will set active config after parsing configurations
+        std::string defaultConfig;
+        if (const UCJsonValue* compiler = root.Find("compiler")) {
+            primaryCompiler = StringToCompilerType(compiler->GetString("type"));
+            compilerPath = compiler->GetString("path");
+            defaultConfig = compiler->GetString("defaultConfiguration");
         }
         
-        // Parse configurations - simplified parsing
-        // Full implementation would parse the configurations array properly
+        // Parse configurations
+        configurations.clear();
+        if (const UCJsonValue* configs = root.Find("configurations")) {
+            for (const auto& entry : configs->Elements()) {
+                if (!entry.IsObject()) continue;
+                
+                BuildConfiguration cfg;
+                cfg.name = entry.GetString("name", cfg.name);
+                cfg.outputDirectory = entry.GetString("outputDirectory", cfg.outputDirectory);
+                cfg.outputName = entry.GetString("outputName");
+                cfg.outputType = StringToBuildOutputType(entry.GetString("outputType"));
+                cfg.optimizationLevel = static_cast<int>(entry.GetInt("optimizationLevel", 0));
+                cfg.debugSymbols = entry.GetBool("debugSymbols", cfg.debugSymbols);
+                cfg.enableWarnings = entry.GetBool("enableWarnings", cfg.enableWarnings);
+                cfg.treatWarningsAsErrors = entry.GetBool("treatWarningsAsErrors", cfg.treatWarningsAsErrors);
+                cfg.defines = entry.GetStringArray("defines");
+                cfg.includePaths = entry.GetStringArray("includePaths");
+                cfg.libraryPaths = entry.GetStringArray("libraryPaths");
+                cfg.libraries = entry.GetStringArray("libraries");
+                cfg.compilerFlags = entry.GetStringArray("compilerFlags");
+                cfg.linkerFlags = entry.GetStringArray("linkerFlags");
+                configurations.push_back(std::move(cfg));
+            }
+        }
         
         // Parse cmake section
-        std::string cmakeSection = ExtractJsonObject(json, "cmake");
-        if (!cmakeSection.empty()) {
-            cmake.enabled = ExtractJsonBool(cmakeSection, "enabled", false);
-            cmake.cmakeListsPath = ExtractJsonString(cmakeSection, "cmakeListsPath");
-            cmake.activeTarget = ExtractJsonString(cmakeSection, "activeTarget");
-            cmake.buildDirectory = ExtractJsonString(cmakeSection, "buildDirectory");
-            cmake.generator = ExtractJsonString(cmakeSection, "generator");
+        if (const UCJsonValue* cmakeSection = root.Find("cmake")) {
+            cmake.enabled = cmakeSection->GetBool("enabled", false);
+            cmake.cmakeListsPath = cmakeSection->GetString("cmakeListsPath");
+            cmake.activeTarget = cmakeSection->GetString("activeTarget");
+            cmake.buildDirectory = cmakeSection->GetString("buildDirectory");
+            cmake.generator = cmakeSection->GetString("generator");
         }
         
         // Parse files section
-        std::string filesSection = ExtractJsonObject(json, "files");
-        if (!filesSection.empty()) {
-            excludePatterns = ExtractJsonStringArray(filesSection, "excludePatterns");
+        if (const UCJsonValue* files = root.Find("files")) {
+            excludePatterns = files->GetStringArray("excludePatterns");
         }
         
         // Parse editor section
-        std::string editorSection = ExtractJsonObject(json, "editor");
-        if (!editorSection.empty()) {
-            editor.tabSize = ExtractJsonInt(editorSection, "tabSize", 4);
-            editor.insertSpaces = ExtractJsonBool(editorSection, "insertSpaces", true);
-            editor.trimTrailingWhitespace = ExtractJsonBool(editorSection, "trimTrailingWhitespace", true);
-            editor.defaultEncoding = ExtractJsonString(editorSection, "defaultEncoding");
+        if (const UCJsonValue* editorSection = root.Find("editor")) {
+            editor.tabSize = static_cast<int>(editorSection->GetInt("tabSize", 4));
+            editor.insertSpaces = editorSection->GetBool("insertSpaces", true);
+            editor.trimTrailingWhitespace = editorSection->GetBool("trimTrailingWhitespace", true);
+            editor.defaultEncoding = editorSection->GetString("defaultEncoding");
             if (editor.defaultEncoding.empty()) editor.defaultEncoding = "UTF-8";
         }
         
@@ -924,6 +1096,14 @@ bool UCIDEProject::FromJSON(const std::string& json) {
             configurations.push_back(CreateReleaseConfiguration(name));
         }
         
+        activeConfigurationIndex = 0;
+        if (!defaultConfig.empty()) {
+            int index = FindConfiguration(defaultConfig);
+            if (index >= 0) {
+                activeConfigurationIndex = index;
+            }
+        }
+        
         return true;
         
     } catch (const std::exception&) {
@@ -1101,6 +1281,11 @@ std::shared_ptr<UCIDEProject> UCIDEProjectManager::OpenProject(const std::string
         return nullptr;
     }
     
+    const ProjectLoadTiming& timing = project->GetLoadTiming();
+    std::cout << "ULTRA IDE: Opened " << project->name << " in "
+              << std::fixed << std::setprecision(1) << timing.loadMilliseconds << " ms"
+              << (timing.fromSnapshot ? " (snapshot)" : " (full scan)") << std::endl;
+    
     openProjects.push_back(project);
     SetActiveProject(project);
     AddToRecentProjects(projectFilePath);
@@ -1143,6 +1328,30 @@ bool UCIDEProjectManager::SaveProject(std::shared_ptr<UCIDEProject> project) {
     return false;
 }
 
+void UCIDEProjectManager::Update() {
+    for (auto& project : openProjects) {
+        if (!project->IsRevalidating()) {
+            continue;
+        }
+        
+        bool changed = project->ApplyRevalidation();
+        if (project->IsRevalidating()) {
+            continue;                   // Still running
+        }
+        
+        const ProjectLoadTiming& timing = project->GetLoadTiming();
+        std::cout << "ULTRA IDE: Revalidated " << project->name << " in "
+                  << std::fixed << std::setprecision(1) << timing.revalidateMilliseconds << " ms, "
+                  << timing.rescannedDirectories << " of " << timing.checkedDirectories
+                  << " directories changed" << (timing.cmakeTargetsChanged ? ", CMake targets reparsed" : "")
+                  << std::endl;
+        
+        if (changed && onProjectTreeChange) {
+            onProjectTreeChange(project);
+        }
+    }
+}
+
 bool UCIDEProjectManager::CloseProject(std::shared_ptr<UCIDEProject> project) {
     if (!project) return false;
     
@@ -1152,6 +1361,9 @@ bool UCIDEProjectManager::CloseProject(std::shared_ptr<UCIDEProject> project) {
             onProjectClose(project);
         }
         
+        // Open editors and tree state are restored from here next time
+        project->SaveSession();
+        
         openProjects.erase(it);
         
         if (activeProject == project) {
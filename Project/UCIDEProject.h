@@ -6,12 +6,17 @@
 #pragma once
 
 #include "../Build/IUCCompilerPlugin.h"
+#include "UCIDEPathArena.h"
+#include "UCIDEGlobMatcher.h"
 #include <string>
 #include <vector>
 #include <map>
 #include <memory>
 #include <functional>
 #include <chrono>
+#include <string_view>
+#include <utility>
+#include <cstdint>
 
 namespace UltraCanvas {
 namespace IDE {
@@ -24,6 +29,23 @@ constexpr const char* UCIDE_PROJECT_EXTENSION = ".ucproj";
 constexpr const char* UCIDE_PROJECT_VERSION = "1.0.0";
 constexpr int UCIDE_FORMAT_VERSION = 1;
 
+// ============================================================================
+// LOAD TIMING
+// ============================================================================
+
+/**
+ * @brief How the last LoadFromFile went and how long it took
+ */
+struct ProjectLoadTiming {
+    bool fromSnapshot = false;          // Restored from the binary snapshot
+    double loadMilliseconds = 0;        // LoadFromFile until the project was usable
+    double revalidateMilliseconds = 0;  // Background check until its results were ready
+    size_t checkedDirectories = 0;      // Directories stamped by the background check
+    size_t rescannedDirectories = 0;    // Directories whose listing had changed
+    bool fileTreeChanged = false;
+    bool cmakeTargetsChanged = false;
+};
+
 // ============================================================================
 // CMAKE INTEGRATION STRUCTURES
 // ============================================================================
@@ -179,6 +201,39 @@ public:
      */
     bool SaveToFile(const std::string& path = "");
     
+    /**
+     * @brief Write the session snapshot (tree, targets, open files) without
+     * touching the .ucproj file
+     */
+    bool SaveSession() const;
+    
+    /**
+     * @brief Timing of the last LoadFromFile
+     */
+    const ProjectLoadTiming& GetLoadTiming() const { return loadTiming; }
+    
+    // ===== BACKGROUND REVALIDATION =====
+    
+    /**
+     * @brief A project restored from its snapshot is usable immediately;
+     * its file tree and CMake targets are then checked against the disk on
+     * a worker thread. Only directories whose modification time changed are
+     * listed again. The results are swapped in by ApplyRevalidation().
+     */
+    bool IsRevalidating() const { return revalidation != nullptr; }
+    
+    /**
+     * @brief Apply a finished background check (call from the UI thread)
+     * @return true if the file tree or the CMake targets changed
+     */
+    bool ApplyRevalidation();
+    
+    /**
+     * @brief Block until the background check finished, then apply it
+     * @return true if the file tree or the CMake targets changed
+     */
+    bool WaitForRevalidation();
+    
     // ===== CONFIGURATION MANAGEMENT =====
     
     /**
@@ -237,6 +292,11 @@ public:
     ProjectFile* FindFile(const std::string& relativePath);
     const ProjectFile* FindFile(const std::string& relativePath) const;
     
+    /**
+     * @brief Path arena backing rootFolder (nullptr before the first scan)
+     */
+    std::shared_ptr<const ProjectPathArena> GetPathArena() const { return pathArena; }
+    
     /**
      * @brief Get all source files
      */
@@ -283,10 +343,10 @@ public:
     std::string ToJSON() const;
     
     /**
-     * @brief Deserialize project from JSON string
+     * @brief Deserialize project from JSON text
      * @return true if successful
      */
-    bool FromJSON(const std::string& json);
+    bool FromJSON(std::string_view json);
     
     // ===== UTILITY =====
     
@@ -344,12 +404,45 @@ public:
     static BuildConfiguration CreateReleaseConfiguration(const std::string& outputName);
 
 private:
+    friend class UCIDEProjectSnapshot;
+    
+    struct FileTreeScan;
+    struct Revalidation;
+    
     // Private helper methods
-    void ScanDirectory(const std::string& path, ProjectFolder& folder, int depth = 0);
+    static void ScanDirectory(FileTreeScan& scan, const std::string& path, ProjectFolder& folder,
+                              const ProjectFolder* previous,
+                              const UCIDEGlobMatcher::PathState& excludeState, int depth = 0);
+    const UCIDEGlobMatcher& GetExcludeMatcher() const;
+    void StartRevalidation();
+    void CancelRevalidation();
+    void MarkOpenFiles();
     bool isModified = false;
     
+    // Hash of the .ucproj text this project reflects (keys the snapshot)
+    uint64_t sourceHash = 0;
+    
+    ProjectLoadTiming loadTiming;
+    
+    // Every directory visited by the last scan with its modification time
+    // (relative path, ns); used to validate the cached file tree
+    std::vector<std::pair<std::string, int64_t>> scannedDirectories;
+    
+    // Interned paths of rootFolder; replaced (never modified) by each scan
+    std::shared_ptr<ProjectPathArena> pathArena;
+    
+    // excludePatterns compiled on first use after they change
+    mutable UCIDEGlobMatcher excludeMatcher;
+    
+    // CMakeLists.txt modification time when cmakeTargets were parsed
+    int64_t cmakeListsModifiedTime = 0;
+    
     // Maximum directory scan depth to prevent infinite recursion
     static constexpr int MAX_SCAN_DEPTH = 20;
+    
+    // Running background check; works on copies of rootFolder and
+    // scannedDirectories taken when it started
+    std::shared_ptr<Revalidation> revalidation;
 };
 
 // ============================================================================
@@ -392,6 +485,11 @@ public:
      */
     bool SaveProject(std::shared_ptr<UCIDEProject> project);
     
+    /**
+     * @brief Apply finished background revalidations (call once per frame)
+     */
+    void Update();
+    
     /**
      * @brief Close project
      */
@@ -459,6 +557,7 @@ public:
     std::function<void(std::shared_ptr<UCIDEProject>)> onProjectClose;
     std::function<void(std::shared_ptr<UCIDEProject>)> onProjectSave;
     std::function<void(std::shared_ptr<UCIDEProject>)> onActiveProjectChange;
+    std::function<void(std::shared_ptr<UCIDEProject>)> onProjectTreeChange;
     std::function<void(const std::string&)> onProjectError;
 
 private:
@@ -0,0 +1,506 @@
+// Apps/IDE/Project/UCIDEProjectSnapshot.cpp
+// Binary project snapshot implementation
+// Version: 1.0.0
+// Last Modified: 2026-10-17
+// Author: UltraCanvas Framework / ULTRA IDE
+
+#include "UCIDEProjectSnapshot.h"
+#include "UCIDEProject.h"
+#include "UCMappedFile.h"
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <filesystem>
+#include <string_view>
+
+#ifndef _WIN32
+    #include <sys/stat.h>
+#endif
+
+namespace UltraCanvas {
+namespace IDE {
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+uint64_t HashBytes64(const void* data, size_t size, uint64_t seed) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = seed;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+int64_t GetPathModifiedTime(const std::string& path) {
+#ifdef _WIN32
+    std::error_code ec;
+    auto time = std::filesystem::last_write_time(path, ec);
+    if (ec) return 0;
+    return static_cast<int64_t>(time.time_since_epoch().count());
+#else
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) return 0;
+#if defined(__APPLE__)
+    return static_cast<int64_t>(st.st_mtimespec.tv_sec) * 1000000000LL + st.st_mtimespec.tv_nsec;
+#else
+    return static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000LL + st.st_mtim.tv_nsec;
+#endif
+#endif
+}
+
+namespace {
+
+/**
+ * @brief Fixed-size file header preceding the payload
+ */
+struct SnapshotHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t sourceHash;        // Hash of the .ucproj text
+    uint64_t payloadSize;
+    uint64_t payloadHash;
+};
+
+// ============================================================================
+// BINARY WRITER
+// ============================================================================
+
+class BinaryWriter {
+public:
+    void U8(uint8_t v) { buffer.push_back(static_cast<char>(v)); }
+    void U32(uint32_t v) { Raw(&v, sizeof(v)); }
+    void I32(int32_t v) { Raw(&v, sizeof(v)); }
+    void I64(int64_t v) { Raw(&v, sizeof(v)); }
+    void Bool(bool v) { U8(v ? 1 : 0); }
+
+    void String(std::string_view s) {
+        U32(static_cast<uint32_t>(s.size()));
+        buffer.append(s);
+    }
+
+    void StringList(const std::vector<std::string>& list) {
+        U32(static_cast<uint32_t>(list.size()));
+        for (const auto& s : list) String(s);
+    }
+
+    void Raw(const void* data, size_t size) {
+        buffer.append(static_cast<const char*>(data), size);
+    }
+
+    std::string buffer;
+};
+
+// ============================================================================
+// BINARY READER (bounds-checked over the mapped payload)
+// ============================================================================
+
+class BinaryReader {
+public:
+    BinaryReader(const uint8_t* data, size_t size) : data(data), size(size) {}
+
+    bool Ok() const { return ok; }
+
+    uint8_t U8() {
+        uint8_t v = 0;
+        Raw(&v, sizeof(v));
+        return v;
+    }
+    uint32_t U32() {
+        uint32_t v = 0;
+        Raw(&v, sizeof(v));
+        return v;
+    }
+    int32_t I32() {
+        int32_t v = 0;
+        Raw(&v, sizeof(v));
+        return v;
+    }
+    int64_t I64() {
+        int64_t v = 0;
+        Raw(&v, sizeof(v));
+        return v;
+    }
+    bool Bool() { return U8() != 0; }
+
+    std::string String() {
+        uint32_t len = U32();
+        if (!ok || len > size - pos) {
+            ok = false;
+            return std::string();
+        }
+        std::string s(reinterpret_cast<const char*>(data + pos), len);
+        pos += len;
+        return s;
+    }
+
+    std::vector<std::string> StringList() {
+        std::vector<std::string> list;
+        uint32_t count = Count();
+        list.reserve(count);
+        for (uint32_t i = 0; i < count && ok; ++i) {
+            list.push_back(String());
+        }
+        return list;
+    }
+
+    /**
+     * @brief Element count, sanity-checked against remaining bytes
+     */
+    uint32_t Count() {
+        uint32_t count = U32();
+        if (count > size - pos) {
+            ok = false;
+            return 0;
+        }
+        return count;
+    }
+
+private:
+    void Raw(void* out, size_t n) {
+        if (!ok || n > size - pos) {
+            ok = false;
+            return;
+        }
+        std::memcpy(out, data + pos, n);
+        pos += n;
+    }
+
+    const uint8_t* data;
+    size_t size;
+    size_t pos = 0;
+    bool ok = true;
+};
+
+// ============================================================================
+// SECTION ENCODERS
+// ============================================================================
+
+void WriteConfiguration(BinaryWriter& w, const BuildConfiguration& cfg) {
+    w.String(cfg.name);
+    w.String(cfg.outputDirectory);
+    w.String(cfg.outputName);
+    w.U8(static_cast<uint8_t>(cfg.outputType));
+    w.StringList(cfg.sourceFiles);
+    w.StringList(cfg.includePaths);
+    w.StringList(cfg.libraryPaths);
+    w.StringList(cfg.libraries);
+    w.StringList(cfg.defines);
+    w.StringList(cfg.compilerFlags);
+    w.StringList(cfg.linkerFlags);
+    w.I32(cfg.optimizationLevel);
+    w.Bool(cfg.debugSymbols);
+    w.Bool(cfg.enableWarnings);
+    w.Bool(cfg.treatWarningsAsErrors);
+}
+
+BuildConfiguration ReadConfiguration(BinaryReader& r) {
+    BuildConfiguration cfg;
+    cfg.name = r.String();
+    cfg.outputDirectory = r.String();
+    cfg.outputName = r.String();
+    cfg.outputType = static_cast<BuildOutputType>(r.U8());
+    cfg.sourceFiles = r.StringList();
+    cfg.includePaths = r.StringList();
+    cfg.libraryPaths = r.StringList();
+    cfg.libraries = r.StringList();
+    cfg.defines = r.StringList();
+    cfg.compilerFlags = r.StringList();
+    cfg.linkerFlags = r.StringList();
+    cfg.optimizationLevel = r.I32();
+    cfg.debugSymbols = r.Bool();
+    cfg.enableWarnings = r.Bool();
+    cfg.treatWarningsAsErrors = r.Bool();
+    return cfg;
+}
+
+void WriteTarget(BinaryWriter& w, const CMakeTarget& target) {
+    w.String(target.name);
+    w.U8(static_cast<uint8_t>(target.type));
+    w.StringList(target.sources);
+    w.StringList(target.includeDirs);
+    w.StringList(target.defines);
+    w.StringList(target.linkLibraries);
+}
+
+CMakeTarget ReadTarget(BinaryReader& r) {
+    CMakeTarget target;
+    target.name = r.String();
+    target.type = static_cast<CMakeTarget::Type>(r.U8());
+    target.sources = r.StringList();
+    target.includeDirs = r.StringList();
+    target.defines = r.StringList();
+    target.linkLibraries = r.StringList();
+    return target;
+}
+
+/**
+ * @brief Folders and files store only their names; the path arena is
+ * rebuilt from them on load.
+ */
+void WriteFolder(BinaryWriter& w, const ProjectFolder& folder) {
+    w.String(folder.GetName());
+    w.Bool(folder.isExpanded);
+
+    w.U32(static_cast<uint32_t>(folder.files.size()));
+    for (const auto& file : folder.files) {
+        w.String(file.GetFileName());
+        w.U8(static_cast<uint8_t>(file.type));
+    }
+
+    w.U32(static_cast<uint32_t>(folder.subfolders.size()));
+    for (const auto& sub : folder.subfolders) {
+        WriteFolder(w, sub);
+    }
+}
+
+bool ReadFolder(BinaryReader& r, ProjectFolder& folder, ProjectPathArena& arena,
+                uint32_t parentDirectory, int depth) {
+    if (depth > 64) return false;
+
+    std::string name = r.String();
+    folder.paths = &arena;
+    folder.directoryId = (depth == 0) ? ProjectPathArena::ROOT_DIRECTORY :
+                                        arena.AddDirectory(parentDirectory, name);
+    folder.isExpanded = r.Bool();
+
+    uint32_t fileCount = r.Count();
+    folder.files.resize(fileCount);
+    for (uint32_t i = 0; i < fileCount && r.Ok(); ++i) {
+        ProjectFile& file = folder.files[i];
+        file.paths = &arena;
+        file.directoryId = folder.directoryId;
+        file.nameId = arena.InternName(r.String());
+        file.type = static_cast<ProjectFileType>(r.U8());
+    }
+
+    uint32_t subCount = r.Count();
+    folder.subfolders.resize(subCount);
+    for (uint32_t i = 0; i < subCount && r.Ok(); ++i) {
+        if (!ReadFolder(r, folder.subfolders[i], arena, folder.directoryId, depth + 1)) return false;
+    }
+
+    return r.Ok();
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// UCIDEPROJECTSNAPSHOT
+// ============================================================================
+
+std::string UCIDEProjectSnapshot::GetSnapshotPath(const std::string& projectFilePath,
+                                                  const std::string& rootDirectory) {
+    size_t lastSlash = projectFilePath.find_last_of("/\\");
+    std::string fileName = (lastSlash != std::string::npos) ?
+                           projectFilePath.substr(lastSlash + 1) : projectFilePath;
+    return rootDirectory + "/" + UCIDE_SNAPSHOT_DIRECTORY + "/" + fileName + UCIDE_SNAPSHOT_EXTENSION;
+}
+
+bool UCIDEProjectSnapshot::Save(const UCIDEProject& project, uint64_t sourceHash) {
+    if (project.projectFilePath.empty() || project.rootDirectory.empty()) {
+        return false;
+    }
+
+    BinaryWriter w;
+
+    // Identity
+    w.String(project.rootDirectory);
+
+    // Metadata
+    w.String(project.name);
+    w.String(project.version);
+    w.String(project.description);
+    w.String(project.author);
+    w.String(project.createdDate);
+    w.String(project.modifiedDate);
+
+    // Compiler and configurations
+    w.U32(static_cast<uint32_t>(project.primaryCompiler));
+    w.String(project.compilerPath);
+    w.U32(static_cast<uint32_t>(project.configurations.size()));
+    for (const auto& cfg : project.configurations) {
+        WriteConfiguration(w, cfg);
+    }
+    w.I32(project.activeConfigurationIndex);
+    w.StringList(project.excludePatterns);
+
+    // CMake settings and targets
+    w.Bool(project.cmake.enabled);
+    w.String(project.cmake.cmakeListsPath);
+    w.String(project.cmake.buildDirectory);
+    w.String(project.cmake.activeTarget);
+    w.String(project.cmake.generator);
+    w.U32(static_cast<uint32_t>(project.cmake.variables.size()));
+    for (const auto& var : project.cmake.variables) {
+        w.String(var.first);
+        w.String(var.second);
+    }
+    w.I64(project.cmakeListsModifiedTime);
+    w.U32(static_cast<uint32_t>(project.cmakeTargets.size()));
+    for (const auto& target : project.cmakeTargets) {
+        WriteTarget(w, target);
+    }
+
+    // Editor settings
+    w.I32(project.editor.tabSize);
+    w.Bool(project.editor.insertSpaces);
+    w.Bool(project.editor.trimTrailingWhitespace);
+    w.String(project.editor.defaultEncoding);
+    w.Bool(project.editor.showWhitespace);
+    w.Bool(project.editor.wordWrap);
+
+    // Open editors
+    w.StringList(project.openFiles);
+    w.String(project.activeFile);
+
+    // File tree and the directory stamps used to validate it
+    w.U32(static_cast<uint32_t>(project.scannedDirectories.size()));
+    for (const auto& dir : project.scannedDirectories) {
+        w.String(dir.first);
+        w.I64(dir.second);
+    }
+    WriteFolder(w, project.rootFolder);
+
+    SnapshotHeader header;
+    header.magic = UCIDE_SNAPSHOT_MAGIC;
+    header.version = UCIDE_SNAPSHOT_VERSION;
+    header.sourceHash = sourceHash;
+    header.payloadSize = w.buffer.size();
+    header.payloadHash = HashBytes64(w.buffer.data(), w.buffer.size());
+
+    std::string path = GetSnapshotPath(project.projectFilePath, project.rootDirectory);
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+    if (ec) return false;
+
+    // Write to a temporary file and rename so a concurrent reader never
+    // maps a half-written snapshot
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(w.buffer.data(), static_cast<std::streamsize>(w.buffer.size()));
+        if (!file.good()) {
+            file.close();
+            std::remove(tempPath.c_str());
+            return false;
+        }
+    }
+
+    std::filesystem::rename(tempPath, path, ec);
+    if (ec) {
+        std::remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+UCIDEProjectSnapshot::LoadResult UCIDEProjectSnapshot::Load(UCIDEProject& project, uint64_t sourceHash) {
+    LoadResult result;
+
+    UCMappedFile file;
+    if (!file.Open(GetSnapshotPath(project.projectFilePath, project.rootDirectory))) {
+        return result;
+    }
+    if (file.Size() < sizeof(SnapshotHeader)) {
+        return result;
+    }
+
+    SnapshotHeader header;
+    std::memcpy(&header, file.Data(), sizeof(header));
+    if (header.magic != UCIDE_SNAPSHOT_MAGIC ||
+        header.version != UCIDE_SNAPSHOT_VERSION ||
+        header.sourceHash != sourceHash ||
+        header.payloadSize != file.Size() - sizeof(SnapshotHeader)) {
+        return result;
+    }
+
+    const uint8_t* payload = file.Data() + sizeof(SnapshotHeader);
+    if (HashBytes64(payload, header.payloadSize) != header.payloadHash) {
+        return result;
+    }
+
+    BinaryReader r(payload, header.payloadSize);
+    if (r.String() != project.rootDirectory) {
+        return result; // Project moved - tree paths would be wrong
+    }
+
+    // Decode into a scratch project so a corrupt snapshot never leaves
+    // the caller half-initialized
+    UCIDEProject restored;
+    restored.projectFilePath = project.projectFilePath;
+    restored.rootDirectory = project.rootDirectory;
+
+    restored.name = r.String();
+    restored.version = r.String();
+    restored.description = r.String();
+    restored.author = r.String();
+    restored.createdDate = r.String();
+    restored.modifiedDate = r.String();
+
+    restored.primaryCompiler = static_cast<CompilerType>(r.U32());
+    restored.compilerPath = r.String();
+    uint32_t configCount = r.Count();
+    restored.configurations.reserve(configCount);
+    for (uint32_t i = 0; i < configCount && r.Ok(); ++i) {
+        restored.configurations.push_back(ReadConfiguration(r));
+    }
+    restored.activeConfigurationIndex = r.I32();
+    restored.excludePatterns = r.StringList();
+
+    restored.cmake.enabled = r.Bool();
+    restored.cmake.cmakeListsPath = r.String();
+    restored.cmake.buildDirectory = r.String();
+    restored.cmake.activeTarget = r.String();
+    restored.cmake.generator = r.String();
+    uint32_t varCount = r.Count();
+    for (uint32_t i = 0; i < varCount && r.Ok(); ++i) {
+        std::string key = r.String();
+        restored.cmake.variables[key] = r.String();
+    }
+    restored.cmakeListsModifiedTime = r.I64();
+    uint32_t targetCount = r.Count();
+    restored.cmakeTargets.reserve(targetCount);
+    for (uint32_t i = 0; i < targetCount && r.Ok(); ++i) {
+        restored.cmakeTargets.push_back(ReadTarget(r));
+    }
+
+    restored.editor.tabSize = r.I32();
+    restored.editor.insertSpaces = r.Bool();
+    restored.editor.trimTrailingWhitespace = r.Bool();
+    restored.editor.defaultEncoding = r.String();
+    restored.editor.showWhitespace = r.Bool();
+    restored.editor.wordWrap = r.Bool();
+
+    restored.openFiles = r.StringList();
+    restored.activeFile = r.String();
+
+    uint32_t dirCount = r.Count();
+    restored.scannedDirectories.reserve(dirCount);
+    for (uint32_t i = 0; i < dirCount && r.Ok(); ++i) {
+        std::string rel = r.String();
+        restored.scannedDirectories.emplace_back(std::move(rel), r.I64());
+    }
+
+    restored.pathArena = std::make_shared<ProjectPathArena>(restored.rootDirectory, restored.name);
+    if (!ReadFolder(r, restored.rootFolder, *restored.pathArena, ProjectPathArena::ROOT_DIRECTORY, 0) ||
+        !r.Ok()) {
+        return result;
+    }
+
+    // A tree without directory stamps (root missing at scan time) cannot
+    // be revalidated incrementally
+    result.fileTreeRestored = !restored.scannedDirectories.empty();
+    restored.sourceHash = sourceHash;
+
+    project = std::move(restored);
+    result.loaded = true;
+    return result;
+}
+
+} // namespace IDE
+} // namespace UltraCanvas
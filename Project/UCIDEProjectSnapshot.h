@@ -0,0 +1,94 @@
+// Apps/IDE/Project/UCIDEProjectSnapshot.h
+// Versioned binary snapshot of a loaded project (fast reopen cache)
+// Version: 1.0.0
+// Last Modified: 2026-10-17
+// Author: UltraCanvas Framework / ULTRA IDE
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace UltraCanvas {
+namespace IDE {
+
+class UCIDEProject;
+
+// ============================================================================
+// SNAPSHOT FORMAT CONSTANTS
+// ============================================================================
+
+constexpr uint32_t UCIDE_SNAPSHOT_MAGIC = 0x53504355;   // "UCPS" little-endian
+constexpr uint32_t UCIDE_SNAPSHOT_VERSION = 3;
+constexpr const char* UCIDE_SNAPSHOT_DIRECTORY = ".ultraide";
+constexpr const char* UCIDE_SNAPSHOT_EXTENSION = ".snapshot";
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+/**
+ * @brief 64-bit FNV-1a hash
+ */
+uint64_t HashBytes64(const void* data, size_t size,
+                     uint64_t seed = 14695981039346656037ULL);
+
+/**
+ * @brief Modification time of a file or directory in nanoseconds
+ * @return 0 if the path does not exist
+ */
+int64_t GetPathModifiedTime(const std::string& path);
+
+// ============================================================================
+// PROJECT SNAPSHOT
+// ============================================================================
+
+/**
+ * @brief Binary cache of a fully loaded project
+ *
+ * Stores the parsed project settings, build configurations, the scanned
+ * file tree, CMake targets and open editors next to the project in
+ * <root>/.ultraide/<project>.ucproj.snapshot. On reopen the file is
+ * memory-mapped and accepted only when:
+ * - magic and format version match,
+ * - the payload checksum matches,
+ * - the hash of the .ucproj text it was built from matches.
+ *
+ * Load does not touch the disk beyond the snapshot itself: the restored
+ * tree and targets are the last known state and are checked against the
+ * directory and CMakeLists.txt modification times by the project's
+ * background revalidation.
+ */
+class UCIDEProjectSnapshot {
+public:
+    /**
+     * @brief Outcome of a snapshot load
+     */
+    struct LoadResult {
+        bool loaded = false;            // Project settings restored
+        bool fileTreeRestored = false;  // Last known file tree restored (unverified)
+    };
+
+    /**
+     * @brief Snapshot path for a project file
+     */
+    static std::string GetSnapshotPath(const std::string& projectFilePath,
+                                       const std::string& rootDirectory);
+
+    /**
+     * @brief Write snapshot for the project
+     * @param sourceHash HashBytes64 of the .ucproj text the project reflects
+     */
+    static bool Save(const UCIDEProject& project, uint64_t sourceHash);
+
+    /**
+     * @brief Restore project from its snapshot
+     *
+     * project.projectFilePath and project.rootDirectory must be set.
+     * The project is only modified if the snapshot is accepted.
+     */
+    static LoadResult Load(UCIDEProject& project, uint64_t sourceHash);
+};
+
+} // namespace IDE
+} // namespace UltraCanvas
@@ -13,15 +13,51 @@
 namespace UltraCanvas {
 namespace IDE {
 
+namespace {
+
+/**
+ * @brief Path relative to the project root; absolute paths inside the
+ *        project are accepted as well (editors use them)
+ */
+std::string_view RelativeToRoot(std::string_view path, const ProjectPathArena& arena) {
+    const std::string& root = arena.GetRoot();
+    if (path.size() > root.size() && path.compare(0, root.size(), root) == 0 &&
+        path[root.size()] == '/') {
+        path.remove_prefix(root.size() + 1);
+    }
+    return path;
+}
+
+} // anonymous namespace
+
 // ============================================================================
 // CONSTRUCTOR / DESTRUCTOR
 // ============================================================================
 
 UCIDEProjectTreeView::UCIDEProjectTreeView() {
     style = TreeViewStyle();
+    filterWorker = std::thread(&UCIDEProjectTreeView::FilterWorkerLoop, this);
+    vcsWorker = std::thread(&UCIDEProjectTreeView::VcsWorkerLoop, this);
 }
 
 UCIDEProjectTreeView::~UCIDEProjectTreeView() {
+    {
+        std::lock_guard<std::mutex> lock(filterQueueMutex);
+        stopFilterWorker = true;
+        latestFilterId++;
+    }
+    filterQueueCondition.notify_all();
+    if (filterWorker.joinable()) {
+        filterWorker.join();
+    }
+    {
+        std::lock_guard<std::mutex> lock(vcsQueueMutex);
+        stopVcsWorker = true;
+    }
+    vcsQueueCondition.notify_all();
+    if (vcsWorker.joinable()) {
+        vcsWorker.join();
+    }
     Clear();
 }
 
@@ -31,6 +67,19 @@ UCIDEProjectTreeView::~UCIDEProjectTreeView() {
 
 void UCIDEProjectTreeView::SetProject(std::shared_ptr<UCIDEProject> project) {
     currentProject = project;
+    
+    // The worker opens the new repository before its next check
+    vcsChanges.clear();
+    vcsOpen = false;
+    {
+        std::lock_guard<std::mutex> lock(vcsQueueMutex);
+        pendingVcs = VcsRequest();
+        pendingVcs.generation = ++vcsGeneration;
+        pendingVcs.reopen = true;
+        pendingVcs.root = currentProject ? currentProject->rootDirectory : std::string();
+        hasPendingVcs = true;
+    }
+    vcsQueueCondition.notify_one();
     Refresh();
 }
 
@@ -41,26 +90,35 @@ void UCIDEProjectTreeView::Refresh() {
         return;
     }
     
+    pathArena = currentProject->GetPathArena();
+    
     // Create root node for project
     rootNode = std::make_unique<TreeNode>();
-    rootNode->id = GenerateNodeId();
-    rootNode->name = currentProject->name;
-    rootNode->path = "";
-    rootNode->absolutePath = currentProject->rootDirectory;
+    rootNode->name = pathArena ? pathArena->GetDirectoryName(ProjectPathArena::ROOT_DIRECTORY) :
+                                 std::string_view(currentProject->name);
+    rootNode->paths = pathArena.get();
+    rootNode->directoryId = ProjectPathArena::ROOT_DIRECTORY;
     rootNode->type = TreeNodeType::Root;
     rootNode->isExpanded = true;
     rootNode->parent = nullptr;
     
     // Register in lookup maps
-    pathToNodeMap[""] = rootNode.get();
-    idToNodeMap[rootNode->id] = rootNode.get();
+    RegisterNode(rootNode.get());
     
     // Build tree from project's root folder
     BuildTree(currentProject->rootFolder, rootNode.get());
+    NumberNodes();
+    BuildFilterSnapshot();
     
-    // Apply any active filter
-    if (!filterText.empty()) {
-        ApplyFilter(rootNode.get());
+    // A rebuilt tree (new project, rescan) gets a fresh look at the work
+    // tree; until it arrives the new nodes show the last known status
+    ApplyVcsDecorations();
+    StartVcsRefresh();
+    RebuildRows();
+    
+    // Re-run any active filter against the new tree
+    if (!filterText.empty() || !fileTypeFilter.empty()) {
+        StartFilter();
     }
 }
 
@@ -68,9 +126,17 @@ void UCIDEProjectTreeView::Clear() {
     rootNode.reset();
     selectedNode = nullptr;
     hoveredNode = nullptr;
-    pathToNodeMap.clear();
-    idToNodeMap.clear();
-    nextNodeId = 1;
+    visibleRows.clear();
+    nodesByKey.clear();
+    nodesById.clear();
+    vcsDecoratedNodes.clear();
+    filterShownNodes.clear();
+    filterSnapshot.reset();
+    allNodesVisible = true;
+    ++latestFilterId;                   // Results for the old nodes are stale
+    appliedFilterId = latestFilterId;
+    appliedFilterComplete = true;
+    pathArena.reset();
     scrollOffset = 0;
 }
 
@@ -79,27 +145,37 @@ void UCIDEProjectTreeView::Clear() {
 // ============================================================================
 
 TreeNode* UCIDEProjectTreeView::FindNode(const std::string& path) {
-    auto it = pathToNodeMap.find(path);
-    if (it != pathToNodeMap.end()) {
-        return it->second;
-    }
-    return nullptr;
+    return const_cast<TreeNode*>(static_cast<const UCIDEProjectTreeView*>(this)->FindNode(path));
 }
 
 const TreeNode* UCIDEProjectTreeView::FindNode(const std::string& path) const {
-    auto it = pathToNodeMap.find(path);
-    if (it != pathToNodeMap.end()) {
+    if (!pathArena) {
+        return path.empty() ? rootNode.get() : nullptr;
+    }
+    
+    // Resolve through the arena: no path strings are kept per node
+    uint32_t directoryId = 0;
+    uint32_t nameId = 0;
+    if (!pathArena->Resolve(RelativeToRoot(path, *pathArena), directoryId, nameId)) {
+        return nullptr;
+    }
+    if (nameId != ProjectPathArena::INVALID_ID) {
+        uint32_t folderId = pathArena->FindDirectory(directoryId, nameId);
+        if (folderId != ProjectPathArena::INVALID_ID) {
+            directoryId = folderId;
+            nameId = ProjectPathArena::INVALID_ID;
+        }
+    }
+    
+    auto it = nodesByKey.find(NodeKey(directoryId, nameId));
+    if (it != nodesByKey.end()) {
         return it->second;
     }
     return nullptr;
 }
 
-TreeNode* UCIDEProjectTreeView::FindNodeById(const std::string& id) {
-    auto it = idToNodeMap.find(id);
-    if (it != idToNodeMap.end()) {
-        return it->second;
-    }
-    return nullptr;
+TreeNode* UCIDEProjectTreeView::FindNodeById(uint32_t id) {
+    return id < nodesById.size() ? nodesById[id] : nullptr;
 }
 
 void UCIDEProjectTreeView::SelectNode(const std::string& path) {
@@ -122,13 +198,15 @@ void UCIDEProjectTreeView::SelectNode(TreeNode* node) {
     if (selectedNode) {
         selectedNode->isSelected = true;
         
-        // Make sure node is visible (expand parents)
-        TreeNode* parent = selectedNode->parent;
-        while (parent) {
+        // Make sure node is visible (expand parents, outermost first)
+        std::vector<TreeNode*> collapsed;
+        for (TreeNode* parent = selectedNode->parent; parent; parent = parent->parent) {
             if (!parent->isExpanded) {
-                parent->isExpanded = true;
+                collapsed.push_back(parent);
             }
-            parent = parent->parent;
+        }
+        for (auto it = collapsed.rbegin(); it != collapsed.rend(); ++it) {
+            SetExpanded(*it, true);
         }
         
         // Scroll to make visible
@@ -145,7 +223,7 @@ void UCIDEProjectTreeView::ExpandNode(TreeNode* node) {
         return;
     }
     
-    node->isExpanded = true;
+    SetExpanded(node, true);
     
     if (onNodeExpand) {
         onNodeExpand(node);
@@ -157,7 +235,7 @@ void UCIDEProjectTreeView::CollapseNode(TreeNode* node) {
         return;
     }
     
-    node->isExpanded = false;
+    SetExpanded(node, false);
     
     if (onNodeCollapse) {
         onNodeCollapse(node);
@@ -189,6 +267,7 @@ void UCIDEProjectTreeView::ExpandAll() {
     };
     
     expandRecursive(rootNode.get());
+    RebuildRows();
 }
 
 void UCIDEProjectTreeView::CollapseAll() {
@@ -204,6 +283,7 @@ void UCIDEProjectTreeView::CollapseAll() {
     };
     
     collapseRecursive(rootNode.get());
+    RebuildRows();
 }
 
 void UCIDEProjectTreeView::RevealPath(const std::string& path) {
@@ -212,14 +292,7 @@ void UCIDEProjectTreeView::RevealPath(const std::string& path) {
         return;
     }
     
-    // Expand all parents
-    TreeNode* parent = node->parent;
-    while (parent) {
-        parent->isExpanded = true;
-        parent = parent->parent;
-    }
-    
-    // Select and scroll to node
+    // Select expands all parents and scrolls to the node
     SelectNode(node);
 }
 
@@ -235,96 +308,230 @@ void UCIDEProjectTreeView::SetFilter(const std::string& filter) {
         c = std::tolower(c);
     }
     
-    if (rootNode) {
-        ApplyFilter(rootNode.get());
-    }
+    StartFilter();
 }
 
 void UCIDEProjectTreeView::ClearFilter() {
     filterText.clear();
-    
-    // Make all nodes visible
-    if (rootNode) {
-        std::function<void(TreeNode*)> showAll = [&](TreeNode* node) {
-            node->isVisible = true;
-            for (auto& child : node->children) {
-                showAll(child.get());
-            }
-        };
-        showAll(rootNode.get());
-    }
+    StartFilter();
 }
 
 void UCIDEProjectTreeView::SetFileTypeFilter(const std::vector<ProjectFileType>& types) {
     fileTypeFilter = types;
-    if (rootNode) {
-        ApplyFilter(rootNode.get());
-    }
+    StartFilter();
 }
 
 void UCIDEProjectTreeView::ClearFileTypeFilter() {
     fileTypeFilter.clear();
-    if (!filterText.empty() && rootNode) {
-        ApplyFilter(rootNode.get());
-    } else {
-        ClearFilter();
+    StartFilter();
+}
+
+void UCIDEProjectTreeView::StartFilter() {
+    if (filterText.empty() && fileTypeFilter.empty()) {
+        // No filter: cancel any scan and show everything right away
+        appliedFilterId = ++latestFilterId;
+        appliedFilterComplete = true;
+        ShowAllNodes();
+        return;
+    }
+    
+    FilterRequest request;
+    request.text = filterText;
+    for (auto type : fileTypeFilter) {
+        request.typeMask |= 1u << static_cast<uint32_t>(type);
     }
+    request.snapshot = filterSnapshot;
+    if (!request.snapshot) {
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(filterQueueMutex);
+        request.id = ++latestFilterId;  // Supersedes whatever is running
+        pendingFilter = std::move(request);
+        hasPendingFilter = true;
+    }
+    appliedFilterComplete = false;
+    filterQueueCondition.notify_one();
 }
 
-void UCIDEProjectTreeView::ApplyFilter(TreeNode* node) {
-    if (!node) return;
+void UCIDEProjectTreeView::BuildFilterSnapshot() {
+    auto snapshot = std::make_shared<FilterSnapshot>();
+    for (const TreeNode* node : nodesById) {
+        if (!node->IsFile()) continue;
+        snapshot->nameOffsets.push_back(static_cast<uint32_t>(snapshot->lowerNames.size()));
+        for (char c : node->name) {
+            snapshot->lowerNames += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        snapshot->nodeIds.push_back(node->id);
+        snapshot->types.push_back(static_cast<uint8_t>(node->fileType));
+    }
+    snapshot->nameOffsets.push_back(static_cast<uint32_t>(snapshot->lowerNames.size()));
+    filterSnapshot = std::move(snapshot);
+}
+
+void UCIDEProjectTreeView::FilterWorkerLoop() {
+    while (true) {
+        FilterRequest request;
+        {
+            std::unique_lock<std::mutex> lock(filterQueueMutex);
+            filterQueueCondition.wait(lock, [this] { return hasPendingFilter || stopFilterWorker; });
+            if (stopFilterWorker) return;
+            
+            request = std::move(pendingFilter);
+            hasPendingFilter = false;
+        }
+        
+        RunFilter(request);
+    }
+}
+
+void UCIDEProjectTreeView::RunFilter(const FilterRequest& request) {
+    const FilterSnapshot& snapshot = *request.snapshot;
+    const size_t entryCount = snapshot.nodeIds.size();
     
-    if (node->IsFolder()) {
-        // Folder is visible if any child is visible
-        bool anyChildVisible = false;
+    // A query containing the last completed one can only match a subset
+    // of its matches; an unchanged text only needs the type check
+    bool narrow = (lastFilterSnapshot == request.snapshot &&
+                   request.text.find(lastFilterText) != std::string::npos);
+    bool sameText = narrow && request.text == lastFilterText;
+    size_t candidateCount = narrow ? lastTextMatches.size() : entryCount;
+    
+    std::vector<uint32_t> textMatches;
+    std::vector<uint32_t> nodeIds;
+    for (size_t start = 0; start < candidateCount; start += FILTER_CHUNK_SIZE) {
+        if (latestFilterId.load() != request.id) {
+            return;                     // Superseded; keep the last complete state
+        }
         
-        for (auto& child : node->children) {
-            ApplyFilter(child.get());
-            if (child->isVisible) {
-                anyChildVisible = true;
+        size_t end = std::min(start + FILTER_CHUNK_SIZE, candidateCount);
+        for (size_t i = start; i < end; ++i) {
+            uint32_t entry = narrow ? lastTextMatches[i] : static_cast<uint32_t>(i);
+            if (!sameText && !request.text.empty()) {
+                std::string_view name(snapshot.lowerNames.data() + snapshot.nameOffsets[entry],
+                                      snapshot.nameOffsets[entry + 1] - snapshot.nameOffsets[entry]);
+                if (name.find(request.text) == std::string_view::npos) continue;
+            }
+            textMatches.push_back(entry);
+            if (request.typeMask == 0 || (request.typeMask & (1u << snapshot.types[entry]))) {
+                nodeIds.push_back(snapshot.nodeIds[entry]);
             }
         }
         
-        // Root is always visible, other folders depend on children
-        node->isVisible = (node == rootNode.get()) || anyChildVisible;
-        
-        // Auto-expand folders with visible children during filtering
-        if (anyChildVisible && !filterText.empty()) {
-            node->isExpanded = true;
+        // Partial results let the tree fill in while the scan continues
+        if (end < candidateCount && !nodeIds.empty()) {
+            PublishFilterMatches(request.id, nodeIds, false);
         }
-    } else {
-        // File visibility
-        node->isVisible = MatchesFilter(node);
     }
+    
+    if (latestFilterId.load() != request.id) {
+        return;
+    }
+    PublishFilterMatches(request.id, nodeIds, true);
+    
+    lastFilterText = request.text;
+    lastFilterSnapshot = request.snapshot;
+    lastTextMatches = std::move(textMatches);
 }
 
-bool UCIDEProjectTreeView::MatchesFilter(const TreeNode* node) const {
-    // Check file type filter
-    if (!fileTypeFilter.empty()) {
-        bool matchesType = false;
-        for (auto type : fileTypeFilter) {
-            if (node->fileType == type) {
-                matchesType = true;
-                break;
-            }
+void UCIDEProjectTreeView::PublishFilterMatches(uint64_t id, std::vector<uint32_t>& nodeIds, bool complete) {
+    {
+        std::lock_guard<std::mutex> lock(filterResultMutex);
+        if (resultFilterId != id) {
+            resultFilterId = id;
+            resultNodeIds.clear();
         }
-        if (!matchesType) {
+        resultNodeIds.insert(resultNodeIds.end(), nodeIds.begin(), nodeIds.end());
+        resultComplete = complete;
+    }
+    nodeIds.clear();
+    filterResultCondition.notify_all();
+}
+
+bool UCIDEProjectTreeView::ProcessFilterResults() {
+    std::vector<uint32_t> nodeIds;
+    uint64_t id;
+    bool complete;
+    {
+        std::lock_guard<std::mutex> lock(filterResultMutex);
+        id = resultFilterId;
+        if (id != latestFilterId.load() || (id == appliedFilterId && resultNodeIds.empty() &&
+                                            appliedFilterComplete == resultComplete)) {
             return false;
         }
+        nodeIds.swap(resultNodeIds);
+        complete = resultComplete;
     }
     
-    // Check text filter
-    if (filterText.empty()) {
-        return true;
+    if (id != appliedFilterId) {
+        // First batch of a new query: hide what the previous one showed
+        if (allNodesVisible) {
+            for (TreeNode* node : nodesById) {
+                node->isVisible = false;
+            }
+            allNodesVisible = false;
+        } else {
+            for (TreeNode* node : filterShownNodes) {
+                node->isVisible = false;
+            }
+        }
+        filterShownNodes.clear();
+        if (rootNode) {
+            rootNode->isVisible = true;
+            rootNode->isExpanded = true;
+        }
+        appliedFilterId = id;
     }
     
-    // Case-insensitive name matching
-    std::string lowerName = node->name;
-    for (char& c : lowerName) {
-        c = std::tolower(c);
+    for (uint32_t nodeId : nodeIds) {
+        if (nodeId < nodesById.size()) {
+            ShowFilterMatch(nodesById[nodeId]);
+        }
     }
+    appliedFilterComplete = complete;
     
-    return lowerName.find(filterText) != std::string::npos;
+    RebuildRows();
+    return true;
+}
+
+void UCIDEProjectTreeView::WaitForFilter() {
+    while (appliedFilterId != latestFilterId.load() || !appliedFilterComplete) {
+        {
+            std::unique_lock<std::mutex> lock(filterResultMutex);
+            filterResultCondition.wait(lock, [this] {
+                return resultFilterId == latestFilterId.load() && resultComplete;
+            });
+        }
+        ProcessFilterResults();
+    }
+}
+
+void UCIDEProjectTreeView::ShowAllNodes() {
+    if (!allNodesVisible) {
+        for (TreeNode* node : nodesById) {
+            node->isVisible = true;
+        }
+        allNodesVisible = true;
+        filterShownNodes.clear();
+    }
+    RebuildRows();
+}
+
+void UCIDEProjectTreeView::ShowFilterMatch(TreeNode* node) {
+    node->isVisible = true;
+    filterShownNodes.push_back(node);
+    
+    // Folders with visible children are shown, and auto-expanded while
+    // filtering by text (a type filter alone keeps the user's layout);
+    // stop at the first one an earlier match already showed
+    bool expand = !filterText.empty();
+    for (TreeNode* parent = node->parent; parent && !parent->isVisible; parent = parent->parent) {
+        parent->isVisible = true;
+        if (expand) {
+            parent->isExpanded = true;
+        }
+        filterShownNodes.push_back(parent);
+    }
 }
 
 // ============================================================================
@@ -334,7 +541,11 @@ bool UCIDEProjectTreeView::MatchesFilter(const TreeNode* node) const {
 void UCIDEProjectTreeView::SetFileModified(const std::string& path, bool modified) {
     TreeNode* node = FindNode(path);
     if (node) {
+        bool saved = node->isModified && !modified;
         node->isModified = modified;
+        if (saved) {
+            NotifyFileChanged(path);
+        }
     }
 }
 
@@ -352,7 +563,7 @@ std::vector<std::string> UCIDEProjectTreeView::GetModifiedFiles() const {
     
     std::function<void(const TreeNode*)> collect = [&](const TreeNode* node) {
         if (node->isModified && node->IsFile()) {
-            modified.push_back(node->path);
+            modified.push_back(node->GetPath());
         }
         for (const auto& child : node->children) {
             collect(child.get());
@@ -364,27 +575,153 @@ std::vector<std::string> UCIDEProjectTreeView::GetModifiedFiles() const {
 }
 
 // ============================================================================
-// RENDERING
+// VERSION CONTROL STATUS
 // ============================================================================
 
-std::vector<TreeNode*> UCIDEProjectTreeView::GetVisibleNodes() const {
-    std::vector<TreeNode*> nodes;
+bool UCIDEProjectTreeView::RefreshVcsStatus() {
+    if (!currentProject || !vcsOpen) {
+        return false;
+    }
+    StartVcsRefresh();
+    return true;
+}
+
+void UCIDEProjectTreeView::StartVcsRefresh() {
+    if (!currentProject) {
+        return;
+    }
     
-    if (rootNode) {
-        CollectVisibleNodes(rootNode.get(), nodes);
+    // The arena is immutable, so the worker can build paths from it while
+    // the tree is rebuilt or rescanned
+    std::vector<std::pair<uint32_t, uint32_t>> files;
+    if (pathArena) {
+        for (const TreeNode* node : nodesById) {
+            if (node->IsFile()) {
+                files.emplace_back(node->directoryId, node->nameId);
+            }
+        }
     }
     
-    return nodes;
+    {
+        std::lock_guard<std::mutex> lock(vcsQueueMutex);
+        pendingVcs.generation = vcsGeneration;
+        pendingVcs.refresh = true;
+        pendingVcs.arena = pathArena;
+        pendingVcs.files = std::move(files);
+        pendingVcs.changedFiles.clear();    // Covered by the full check
+        hasPendingVcs = true;
+    }
+    vcsQueueCondition.notify_one();
 }
 
-int UCIDEProjectTreeView::GetVisibleRowCount() const {
-    return static_cast<int>(GetVisibleNodes().size());
+void UCIDEProjectTreeView::NotifyFileChanged(const std::string& path) {
+    if (!vcsOpen) {
+        return;
+    }
+    
+    std::string relativePath = pathArena ? std::string(RelativeToRoot(path, *pathArena)) : path;
+    {
+        std::lock_guard<std::mutex> lock(vcsQueueMutex);
+        pendingVcs.generation = vcsGeneration;
+        pendingVcs.changedFiles.push_back(std::move(relativePath));
+        hasPendingVcs = true;
+    }
+    vcsQueueCondition.notify_one();
+}
+
+void UCIDEProjectTreeView::VcsWorkerLoop() {
+    while (true) {
+        VcsRequest request;
+        {
+            std::unique_lock<std::mutex> lock(vcsQueueMutex);
+            vcsQueueCondition.wait(lock, [this] { return hasPendingVcs || stopVcsWorker; });
+            if (stopVcsWorker) return;
+            
+            request = std::move(pendingVcs);
+            pendingVcs = VcsRequest();
+            hasPendingVcs = false;
+        }
+        
+        bool changed = false;
+        if (request.reopen) {
+            gitStatus.Close();
+            if (!request.root.empty()) {
+                gitStatus.Open(request.root);
+            }
+            vcsOpen = gitStatus.IsOpen();
+            changed = true;
+        }
+        if (!gitStatus.IsOpen()) {
+            continue;
+        }
+        
+        if (request.refresh) {
+            std::vector<std::string> projectFiles;
+            projectFiles.reserve(request.files.size());
+            for (const auto& file : request.files) {
+                projectFiles.push_back(request.arena->MakeRelativePath(file.first, file.second));
+            }
+            gitStatus.Refresh(projectFiles);
+            changed = true;
+        }
+        for (const auto& path : request.changedFiles) {
+            changed |= gitStatus.NotifyFileChanged(path);
+        }
+        
+        if (changed) {
+            std::lock_guard<std::mutex> lock(vcsResultMutex);
+            vcsResultGeneration = request.generation;
+            vcsResultChanges = gitStatus.GetChanges();
+            vcsResultReady = true;
+        }
+    }
 }
 
+bool UCIDEProjectTreeView::ProcessVcsResults() {
+    {
+        std::lock_guard<std::mutex> lock(vcsResultMutex);
+        if (!vcsResultReady) {
+            return false;
+        }
+        vcsResultReady = false;
+        if (vcsResultGeneration != vcsGeneration) {
+            return false;                   // For the previous project
+        }
+        vcsChanges.swap(vcsResultChanges);
+    }
+    ApplyVcsDecorations();
+    return true;
+}
+
+void UCIDEProjectTreeView::ApplyVcsDecorations() {
+    for (TreeNode* node : vcsDecoratedNodes) {
+        node->vcsStatus = VcsFileStatus::Unmodified;
+    }
+    vcsDecoratedNodes.clear();
+    
+    for (const auto& change : vcsChanges) {
+        TreeNode* node = FindNode(change.first);
+        if (!node) continue;            // Deleted files have no node
+        
+        node->vcsStatus = change.second;
+        vcsDecoratedNodes.push_back(node);
+        
+        // Folders show that something below them changed
+        for (TreeNode* parent = node->parent;
+             parent && parent->vcsStatus == VcsFileStatus::Unmodified; parent = parent->parent) {
+            parent->vcsStatus = VcsFileStatus::Modified;
+            vcsDecoratedNodes.push_back(parent);
+        }
+    }
+}
+
+// ============================================================================
+// RENDERING
+// ============================================================================
+
 TreeNode* UCIDEProjectTreeView::GetNodeAtRow(int row) {
-    auto nodes = GetVisibleNodes();
-    if (row >= 0 && row < static_cast<int>(nodes.size())) {
-        return nodes[row];
+    if (row >= 0 && row < static_cast<int>(visibleRows.size())) {
+        return visibleRows[row];
     }
     return nullptr;
 }
@@ -392,16 +729,22 @@ TreeNode* UCIDEProjectTreeView::GetNodeAtRow(int row) {
 int UCIDEProjectTreeView::GetRowOfNode(const TreeNode* node) const {
     if (!node) return -1;
     
-    auto nodes = GetVisibleNodes();
-    for (int i = 0; i < static_cast<int>(nodes.size()); ++i) {
-        if (nodes[i] == node) {
-            return i;
-        }
+    // Rows are in preorder, so the node's order locates it
+    auto it = std::lower_bound(visibleRows.begin(), visibleRows.end(), node->order,
+        [](const TreeNode* row, uint32_t order) { return row->order < order; });
+    if (it != visibleRows.end() && *it == node) {
+        return static_cast<int>(it - visibleRows.begin());
     }
-    
     return -1;
 }
 
+std::pair<int, int> UCIDEProjectTreeView::GetOnScreenRows() const {
+    int rowCount = static_cast<int>(visibleRows.size());
+    int first = std::min(scrollOffset / style.rowHeight, rowCount);
+    int last = std::min((scrollOffset + viewHeight + style.rowHeight - 1) / style.rowHeight, rowCount);
+    return { first, last };
+}
+
 void UCIDEProjectTreeView::CollectVisibleNodes(TreeNode* node, std::vector<TreeNode*>& nodes) const {
     if (!node->isVisible) {
         return;
@@ -459,7 +802,7 @@ bool UCIDEProjectTreeView::HandleClick(int x, int y, bool isDoubleClick, bool is
         } else {
             // Open file on double-click
             if (onFileOpen) {
-                onFileOpen(clickedNode->path);
+                onFileOpen(clickedNode->GetPath());
             }
         }
     }
@@ -484,20 +827,18 @@ bool UCIDEProjectTreeView::HandleKeyPress(int keyCode, bool ctrl, bool shift, bo
     switch (keyCode) {
         case KEY_UP: {
             // Move selection up
-            auto nodes = GetVisibleNodes();
             int currentRow = GetRowOfNode(selectedNode);
             if (currentRow > 0) {
-                SelectNode(nodes[currentRow - 1]);
+                SelectNode(visibleRows[currentRow - 1]);
             }
             return true;
         }
         
         case KEY_DOWN: {
             // Move selection down
-            auto nodes = GetVisibleNodes();
             int currentRow = GetRowOfNode(selectedNode);
-            if (currentRow < static_cast<int>(nodes.size()) - 1) {
-                SelectNode(nodes[currentRow + 1]);
+            if (currentRow < static_cast<int>(visibleRows.size()) - 1) {
+                SelectNode(visibleRows[currentRow + 1]);
             }
             return true;
         }
@@ -533,7 +874,7 @@ bool UCIDEProjectTreeView::HandleKeyPress(int keyCode, bool ctrl, bool shift, bo
                 ToggleNode(selectedNode);
             } else {
                 if (onFileOpen) {
-                    onFileOpen(selectedNode->path);
+                    onFileOpen(selectedNode->GetPath());
                 }
             }
             return true;
@@ -541,7 +882,7 @@ bool UCIDEProjectTreeView::HandleKeyPress(int keyCode, bool ctrl, bool shift, bo
         
         case KEY_DELETE: {
             if (!ctrl && onFileDelete) {
-                onFileDelete(selectedNode->path);
+                onFileDelete(selectedNode->GetPath());
             }
             return true;
         }
@@ -598,8 +939,7 @@ void UCIDEProjectTreeView::BuildTree(const ProjectFolder& folder, TreeNode* pare
         TreeNode* nodePtr = node.get();
         
         // Register in lookup
-        pathToNodeMap[node->path] = nodePtr;
-        idToNodeMap[node->id] = nodePtr;
+        RegisterNode(nodePtr);
         
         parent->children.push_back(std::move(node));
         
@@ -612,8 +952,7 @@ void UCIDEProjectTreeView::BuildTree(const ProjectFolder& folder, TreeNode* pare
         auto node = CreateFileNode(file, parent);
         
         // Register in lookup
-        pathToNodeMap[node->path] = node.get();
-        idToNodeMap[node->id] = node.get();
+        RegisterNode(node.get());
         
         parent->children.push_back(std::move(node));
     }
@@ -625,10 +964,10 @@ void UCIDEProjectTreeView::BuildTree(const ProjectFolder& folder, TreeNode* pare
 std::unique_ptr<TreeNode> UCIDEProjectTreeView::CreateFileNode(const ProjectFile& file, TreeNode* parent) {
     auto node = std::make_unique<TreeNode>();
     
-    node->id = GenerateNodeId();
-    node->name = file.fileName;
-    node->path = file.relativePath;
-    node->absolutePath = file.absolutePath;
+    node->name = file.GetFileName();
+    node->paths = file.paths;
+    node->directoryId = file.directoryId;
+    node->nameId = file.nameId;
     node->type = GetTreeNodeType(file.type);
     node->fileType = file.type;
     node->isExpanded = false;
@@ -644,10 +983,9 @@ std::unique_ptr<TreeNode> UCIDEProjectTreeView::CreateFileNode(const ProjectFile
 std::unique_ptr<TreeNode> UCIDEProjectTreeView::CreateFolderNode(const ProjectFolder& folder, TreeNode* parent) {
     auto node = std::make_unique<TreeNode>();
     
-    node->id = GenerateNodeId();
-    node->name = folder.name;
-    node->path = folder.relativePath;
-    node->absolutePath = folder.absolutePath;
+    node->name = folder.GetName();
+    node->paths = folder.paths;
+    node->directoryId = folder.directoryId;
     node->type = TreeNodeType::Folder;
     node->fileType = ProjectFileType::Unknown;
     node->isExpanded = folder.isExpanded;
@@ -691,8 +1029,68 @@ TreeNodeType UCIDEProjectTreeView::GetTreeNodeType(ProjectFileType fileType) con
     }
 }
 
-std::string UCIDEProjectTreeView::GenerateNodeId() {
-    return "node_" + std::to_string(nextNodeId++);
+void UCIDEProjectTreeView::NumberNodes() {
+    if (!rootNode) return;
+    
+    // Iterative preorder walk; subtreeEnd is filled once a node's last
+    // descendant has been numbered
+    uint32_t next = 0;
+    std::vector<std::pair<TreeNode*, size_t>> stack = { { rootNode.get(), 0 } };
+    rootNode->order = next++;
+    while (!stack.empty()) {
+        auto& top = stack.back();
+        TreeNode* node = top.first;
+        if (top.second < node->children.size()) {
+            TreeNode* child = node->children[top.second++].get();
+            child->order = next++;
+            stack.emplace_back(child, 0);
+        } else {
+            node->subtreeEnd = next - 1;
+            stack.pop_back();
+        }
+    }
+}
+
+void UCIDEProjectTreeView::RebuildRows() {
+    visibleRows.clear();
+    if (rootNode) {
+        CollectVisibleNodes(rootNode.get(), visibleRows);
+    }
+    SetScrollOffset(scrollOffset);
+}
+
+void UCIDEProjectTreeView::SetExpanded(TreeNode* node, bool expanded) {
+    if (node->isExpanded == expanded) {
+        return;
+    }
+    node->isExpanded = expanded;
+    
+    // Nothing to splice if the node itself is not shown
+    int row = GetRowOfNode(node);
+    if (row < 0) {
+        return;
+    }
+    
+    auto first = visibleRows.begin() + row + 1;
+    if (expanded) {
+        std::vector<TreeNode*> rows;
+        for (auto& child : node->children) {
+            CollectVisibleNodes(child.get(), rows);
+        }
+        visibleRows.insert(first, rows.begin(), rows.end());
+    } else {
+        // Descendant rows are exactly those with order in (order, subtreeEnd]
+        auto last = std::upper_bound(first, visibleRows.end(), node->subtreeEnd,
+            [](uint32_t order, const TreeNode* row) { return order < row->order; });
+        visibleRows.erase(first, last);
+        SetScrollOffset(scrollOffset);
+    }
+}
+
+void UCIDEProjectTreeView::RegisterNode(TreeNode* node) {
+    node->id = static_cast<uint32_t>(nodesById.size());
+    nodesById.push_back(node);
+    nodesByKey[NodeKey(node->directoryId, node->nameId)] = node;
 }
 
 void UCIDEProjectTreeView::SortChildren(TreeNode* node) {
@@ -707,8 +1105,8 @@ void UCIDEProjectTreeView::SortChildren(TreeNode* node) {
             }
             
             // Alphabetical (case-insensitive)
-            std::string nameA = a->name;
-            std::string nameB = b->name;
+            std::string nameA(a->name);
+            std::string nameB(b->name);
             for (char& c : nameA) c = std::tolower(c);
             for (char& c : nameB) c = std::tolower(c);
             
@@ -6,12 +6,19 @@
 #pragma once
 
 #include "UCIDEProject.h"
+#include "UCIDEGitStatus.h"
 #include "../Build/IUCCompilerPlugin.h"
 #include <string>
 #include <vector>
 #include <memory>
 #include <functional>
 #include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <unordered_map>
+#include <string_view>
 
 namespace UltraCanvas {
 namespace IDE {
@@ -59,12 +66,16 @@ inline std::string GetTreeNodeIcon(TreeNodeType type) {
 
 /**
  * @brief Represents a single node in the project tree
+ *
+ * Name and paths come from the project's ProjectPathArena, which the
+ * tree view keeps alive for as long as the nodes exist.
  */
 struct TreeNode {
-    std::string id;                     // Unique node ID
-    std::string name;                   // Display name
-    std::string path;                   // Relative path
-    std::string absolutePath;           // Full path
+    uint32_t id = 0;                    // Unique node ID
+    std::string_view name;              // Display name
+    const ProjectPathArena* paths = nullptr;
+    uint32_t directoryId = ProjectPathArena::ROOT_DIRECTORY;  // Folder itself, or a file's folder
+    uint32_t nameId = ProjectPathArena::INVALID_ID;           // File name (INVALID_ID for folders)
     TreeNodeType type = TreeNodeType::OtherFile;
     
     // State
@@ -73,11 +84,17 @@ struct TreeNode {
     bool isModified = false;            // File has unsaved changes
     bool isOpen = false;                // File is open in editor
     bool isVisible = true;              // Visible (for filtering)
+    VcsFileStatus vcsStatus = VcsFileStatus::Unmodified;   // Folders: Modified if anything below changed
     
     // Hierarchy
     TreeNode* parent = nullptr;
     std::vector<std::unique_ptr<TreeNode>> children;
     
+    // Preorder position and that of the last descendant; the subtree is
+    // [order, subtreeEnd] and visible rows are sorted by order
+    uint32_t order = 0;
+    uint32_t subtreeEnd = 0;
+    
     // File info
     ProjectFileType fileType = ProjectFileType::Unknown;
     size_t fileSize = 0;
@@ -97,6 +114,24 @@ struct TreeNode {
         return !IsFolder();
     }
     
+    /**
+     * @brief Path relative to project root
+     */
+    std::string GetPath() const {
+        if (!paths) return std::string();
+        return IsFolder() ? paths->GetDirectoryPath(directoryId) :
+                            paths->MakeRelativePath(directoryId, nameId);
+    }
+    
+    /**
+     * @brief Full absolute path
+     */
+    std::string GetAbsolutePath() const {
+        if (!paths) return std::string();
+        return IsFolder() ? paths->GetAbsoluteDirectoryPath(directoryId) :
+                            paths->MakeAbsolutePath(directoryId, nameId);
+    }
+    
     /**
      * @brief Get child count
      */
@@ -118,7 +153,7 @@ struct TreeNode {
     /**
      * @brief Find child by name
      */
-    TreeNode* FindChild(const std::string& childName) {
+    TreeNode* FindChild(std::string_view childName) {
         for (auto& child : children) {
             if (child->name == childName) {
                 return child.get();
@@ -262,7 +297,7 @@ public:
     const TreeNode* GetRoot() const { return rootNode.get(); }
     
     /**
-     * @brief Find node by path
+     * @brief Find node by path, relative to the project root or absolute
      */
     TreeNode* FindNode(const std::string& path);
     const TreeNode* FindNode(const std::string& path) const;
@@ -270,7 +305,7 @@ public:
     /**
      * @brief Find node by ID
      */
-    TreeNode* FindNodeById(const std::string& id);
+    TreeNode* FindNodeById(uint32_t id);
     
     /**
      * @brief Get selected node
@@ -322,6 +357,12 @@ public:
     
     /**
      * @brief Set filter text (shows matching files)
+     *
+     * Matching runs on a background thread against a snapshot of the file
+     * names; results are applied by ProcessFilterResults() on the UI
+     * thread, progressively while the scan is running. A query that
+     * extends the previous one only re-checks the previous matches, and a
+     * newer query cancels the one in flight.
      */
     void SetFilter(const std::string& filter);
     
@@ -345,6 +386,24 @@ public:
      */
     void ClearFileTypeFilter();
     
+    /**
+     * @brief Apply filter results published by the background scan
+     *
+     * Call from the UI thread (once per frame).
+     * @return true if the visible rows changed
+     */
+    bool ProcessFilterResults();
+    
+    /**
+     * @brief Whether a filter query is still being computed
+     */
+    bool IsFiltering() const { return appliedFilterId != latestFilterId.load() || !appliedFilterComplete; }
+    
+    /**
+     * @brief Block until the current filter query is complete and applied
+     */
+    void WaitForFilter();
+    
     // ===== FILE MODIFICATION TRACKING =====
     
     /**
@@ -362,28 +421,66 @@ public:
      */
     std::vector<std::string> GetModifiedFiles() const;
     
+    // ===== VERSION CONTROL STATUS =====
+    
+    /**
+     * @brief Re-check the working tree against the git index
+     *
+     * The check (an lstat of every tracked file) runs on a background
+     * thread; ProcessVcsResults() applies the result on the UI thread.
+     * Cheap enough to request on every focus change.
+     * @return false if the project is not in a git work tree
+     */
+    bool RefreshVcsStatus();
+    
+    /**
+     * @brief Re-check one file after it was written (save, file-watch event)
+     */
+    void NotifyFileChanged(const std::string& path);
+    
+    /**
+     * @brief Apply git status published by the background check
+     *
+     * Call from the UI thread (once per frame).
+     * @return true if the decorations changed
+     */
+    bool ProcessVcsResults();
+    
+    /**
+     * @brief Every file that is not Unmodified, as last applied
+     */
+    const std::unordered_map<std::string, VcsFileStatus>& GetVcsChanges() const { return vcsChanges; }
+    
     // ===== RENDERING =====
     
     /**
      * @brief Get visible nodes for rendering (flattened)
+     *
+     * The row list is maintained incrementally: expanding or collapsing
+     * a folder splices only its subtree in or out.
      */
-    std::vector<TreeNode*> GetVisibleNodes() const;
+    const std::vector<TreeNode*>& GetVisibleNodes() const { return visibleRows; }
     
     /**
      * @brief Get total visible row count
      */
-    int GetVisibleRowCount() const;
+    int GetVisibleRowCount() const { return static_cast<int>(visibleRows.size()); }
     
     /**
-     * @brief Get node at row index
+     * @brief Get node at row index (O(1))
      */
     TreeNode* GetNodeAtRow(int row);
     
     /**
-     * @brief Get row index of node
+     * @brief Get row index of node (O(log N)), -1 if not shown
      */
     int GetRowOfNode(const TreeNode* node) const;
     
+    /**
+     * @brief Range of rows intersecting the view [first, last)
+     */
+    std::pair<int, int> GetOnScreenRows() const;
+    
     // ===== STYLE =====
     
     /**
@@ -512,30 +609,72 @@ private:
     TreeNodeType GetTreeNodeType(ProjectFileType fileType) const;
     
     /**
-     * @brief Generate unique node ID
+     * @brief Assign the next node ID and register the node for lookup
      */
-    std::string GenerateNodeId();
+    void RegisterNode(TreeNode* node);
+    
+    /**
+     * @brief Lookup key of a folder (nameId INVALID_ID) or file
+     */
+    static uint64_t NodeKey(uint32_t directoryId, uint32_t nameId) {
+        return (static_cast<uint64_t>(directoryId) << 32) | nameId;
+    }
     
     /**
-     * @brief Apply filter to nodes
+     * @brief Queue the current filter text and file types for the worker
      */
-    void ApplyFilter(TreeNode* node);
+    void StartFilter();
     
     /**
-     * @brief Check if node matches filter
+     * @brief Capture file names and types for background matching
      */
-    bool MatchesFilter(const TreeNode* node) const;
+    void BuildFilterSnapshot();
+    
+    /**
+     * @brief Make every node visible again (no filter active)
+     */
+    void ShowAllNodes();
+    
+    /**
+     * @brief Show a matched file together with its folders
+     */
+    void ShowFilterMatch(TreeNode* node);
     
     /**
      * @brief Collect visible nodes recursively
      */
     void CollectVisibleNodes(TreeNode* node, std::vector<TreeNode*>& nodes) const;
     
+    /**
+     * @brief Assign preorder positions after the tree is built
+     */
+    void NumberNodes();
+    
+    /**
+     * @brief Recompute the whole row list (after bulk state changes)
+     */
+    void RebuildRows();
+    
+    /**
+     * @brief Change expansion state, splicing the node's rows in or out
+     */
+    void SetExpanded(TreeNode* node, bool expanded);
+    
     /**
      * @brief Sort children of node
      */
     void SortChildren(TreeNode* node);
     
+    /**
+     * @brief Copy the applied git status onto the nodes
+     */
+    void ApplyVcsDecorations();
+    
+    /**
+     * @brief Queue a full status check of the current tree
+     */
+    void StartVcsRefresh();
+    
     // ===== STATE =====
     
     std::shared_ptr<UCIDEProject> currentProject;
@@ -551,11 +690,110 @@ private:
     int scrollOffset = 0;
     int viewHeight = 400;
     
-    int nextNodeId = 1;
-    
-    // Node lookup cache
-    std::map<std::string, TreeNode*> pathToNodeMap;
-    std::map<std::string, TreeNode*> idToNodeMap;
+    // Flattened visible rows in preorder
+    std::vector<TreeNode*> visibleRows;
+    
+    // Applied git status and the nodes it decorated
+    std::unordered_map<std::string, VcsFileStatus> vcsChanges;
+    std::vector<TreeNode*> vcsDecoratedNodes;
+    
+    // ===== BACKGROUND VCS STATUS =====
+    
+    /**
+     * @brief Work queued for the status worker; later requests merge in
+     */
+    struct VcsRequest {
+        uint64_t generation = 0;            // vcsGeneration it was queued for
+        bool reopen = false;                // Open the repository of root first
+        std::string root;                   // Project root ("" to close)
+        bool refresh = false;               // Full check of the files below
+        std::shared_ptr<const ProjectPathArena> arena;
+        std::vector<std::pair<uint32_t, uint32_t>> files;  // Project files as (directory, name id)
+        std::vector<std::string> changedFiles;  // Single files to re-check
+    };
+    
+    void VcsWorkerLoop();
+    
+    // Worker-only: the repository reader and its caches
+    UCIDEGitStatus gitStatus;
+    
+    std::thread vcsWorker;
+    std::mutex vcsQueueMutex;
+    std::condition_variable vcsQueueCondition;
+    bool hasPendingVcs = false;
+    bool stopVcsWorker = false;
+    VcsRequest pendingVcs;
+    std::atomic<bool> vcsOpen{false};   // Published by the worker after opening
+    
+    // Published by the worker, consumed by ProcessVcsResults
+    std::mutex vcsResultMutex;
+    bool vcsResultReady = false;
+    uint64_t vcsResultGeneration = 0;
+    std::unordered_map<std::string, VcsFileStatus> vcsResultChanges;
+    
+    // Bumped per project, so results for the previous one are dropped
+    uint64_t vcsGeneration = 0;
+    
+    // ===== BACKGROUND FILTERING =====
+    
+    /**
+     * @brief Immutable copy of what the filter needs, shared with the worker
+     */
+    struct FilterSnapshot {
+        std::string lowerNames;             // Lower-cased file names back to back
+        std::vector<uint32_t> nameOffsets;  // Entry i is [nameOffsets[i], nameOffsets[i + 1])
+        std::vector<uint32_t> nodeIds;      // Tree node of each entry
+        std::vector<uint8_t> types;         // ProjectFileType of each entry
+    };
+    
+    struct FilterRequest {
+        uint64_t id = 0;
+        std::string text;                   // Lower-cased
+        uint32_t typeMask = 0;              // Bit per ProjectFileType, 0 = any
+        std::shared_ptr<const FilterSnapshot> snapshot;
+    };
+    
+    void FilterWorkerLoop();
+    void RunFilter(const FilterRequest& request);
+    void PublishFilterMatches(uint64_t id, std::vector<uint32_t>& nodeIds, bool complete);
+    
+    std::shared_ptr<const FilterSnapshot> filterSnapshot;
+    
+    std::thread filterWorker;
+    std::mutex filterQueueMutex;
+    std::condition_variable filterQueueCondition;
+    bool hasPendingFilter = false;
+    bool stopFilterWorker = false;
+    FilterRequest pendingFilter;
+    std::atomic<uint64_t> latestFilterId{0};
+    
+    // Worker-only: text matches of the last completed query, for narrowing
+    std::string lastFilterText;
+    std::shared_ptr<const FilterSnapshot> lastFilterSnapshot;
+    std::vector<uint32_t> lastTextMatches;  // Entry indices
+    
+    // Published by the worker, consumed by ProcessFilterResults
+    std::mutex filterResultMutex;
+    std::condition_variable filterResultCondition;
+    uint64_t resultFilterId = 0;
+    std::vector<uint32_t> resultNodeIds;
+    bool resultComplete = true;
+    
+    // UI-thread state of the applied filter
+    uint64_t appliedFilterId = 0;
+    bool appliedFilterComplete = true;
+    bool allNodesVisible = true;
+    std::vector<TreeNode*> filterShownNodes;
+    
+    // Entries scanned between cancellation checks / partial publishes
+    static constexpr size_t FILTER_CHUNK_SIZE = 16384;
+    
+    // Paths of the tree being shown; kept alive independently of rescans
+    std::shared_ptr<const ProjectPathArena> pathArena;
+    
+    // Node lookup: (directory, name) key -> node, and id -> node
+    std::unordered_map<uint64_t, TreeNode*> nodesByKey;
+    std::vector<TreeNode*> nodesById;
 };
 
 // ============================================================================
@@ -0,0 +1,825 @@
+// Apps/IDE/Project/UCIDESymbolIndex.cpp
+// Persistent project symbol index implementation
+// Version: 1.0.0
+// Last Modified: 2026-10-17
+// Author: UltraCanvas Framework / ULTRA IDE
+
+#include "UCIDESymbolIndex.h"
+#include "UCIDEProjectSnapshot.h"
+#include <algorithm>
+#include <numeric>
+#include <unordered_set>
+#include <fstream>
+#include <filesystem>
+#include <cstring>
+
+namespace UltraCanvas {
+namespace IDE {
+
+// ============================================================================
+// HELPERS
+// ============================================================================
+
+namespace {
+
+inline char Fold(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + 32) : c;
+}
+
+/**
+ * @brief Compare a against b case-insensitively (ASCII)
+ */
+int CompareFolded(std::string_view a, std::string_view b) {
+    size_t n = std::min(a.size(), b.size());
+    for (size_t i = 0; i < n; ++i) {
+        char ca = Fold(a[i]);
+        char cb = Fold(b[i]);
+        if (ca != cb) return static_cast<unsigned char>(ca) < static_cast<unsigned char>(cb) ? -1 : 1;
+    }
+    if (a.size() == b.size()) return 0;
+    return a.size() < b.size() ? -1 : 1;
+}
+
+bool StartsWithFolded(std::string_view text, std::string_view foldedPrefix) {
+    if (text.size() < foldedPrefix.size()) return false;
+    for (size_t i = 0; i < foldedPrefix.size(); ++i) {
+        if (Fold(text[i]) != foldedPrefix[i]) return false;
+    }
+    return true;
+}
+
+bool ContainsFolded(std::string_view text, std::string_view foldedNeedle) {
+    if (foldedNeedle.empty()) return true;
+    if (text.size() < foldedNeedle.size()) return false;
+    const size_t last = text.size() - foldedNeedle.size();
+    for (size_t i = 0; i <= last; ++i) {
+        if (Fold(text[i]) == foldedNeedle[0] && StartsWithFolded(text.substr(i), foldedNeedle)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string GetExtension(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) return "";
+    std::string ext = path.substr(dot + 1);
+    for (char& c : ext) c = Fold(c);
+    return ext;
+}
+
+/**
+ * @brief Deduplicating string pool for the index writer
+ */
+class StringPool {
+public:
+    uint32_t Add(std::string_view text) {
+        auto it = offsets.find(std::string(text));
+        if (it != offsets.end()) return it->second;
+        uint32_t offset = static_cast<uint32_t>(data.size());
+        data.append(text);
+        offsets.emplace(std::string(text), offset);
+        return offset;
+    }
+
+    const std::string& Data() const { return data; }
+
+private:
+    std::string data;
+    std::unordered_map<std::string, uint32_t> offsets;
+};
+
+/**
+ * @brief A query hit before it is turned into a SymbolInfo
+ */
+struct RankedHit {
+    int rank;                           // 0 exact, 1 prefix, 2 substring
+    size_t nameLength;
+    const SymbolInfo* overlaySymbol;    // Overlay hit, or
+    uint32_t baseSymbol;                // mapped symbol id
+};
+
+} // anonymous namespace
+
+const char* SymbolKindToString(SymbolKind kind) {
+    switch (kind) {
+        case SymbolKind::Namespace:  return "namespace";
+        case SymbolKind::Class:      return "class";
+        case SymbolKind::Struct:     return "struct";
+        case SymbolKind::Union:      return "union";
+        case SymbolKind::Enum:       return "enum";
+        case SymbolKind::Interface:  return "interface";
+        case SymbolKind::Function:   return "function";
+        case SymbolKind::Method:     return "method";
+        case SymbolKind::Field:      return "field";
+        case SymbolKind::Variable:   return "variable";
+        case SymbolKind::Typedef:    return "typedef";
+        case SymbolKind::Macro:      return "macro";
+        case SymbolKind::Module:     return "module";
+        case SymbolKind::Program:    return "program";
+        case SymbolKind::Subroutine: return "subroutine";
+        case SymbolKind::Package:    return "package";
+        case SymbolKind::Type:       return "type";
+    }
+    return "symbol";
+}
+
+// ============================================================================
+// SCANNERS
+// ============================================================================
+
+UCIDESymbolIndex::~UCIDESymbolIndex() {
+    Close();
+}
+
+void UCIDESymbolIndex::RegisterScanner(const std::vector<std::string>& extensions, SymbolScanner scanner) {
+    for (const auto& ext : extensions) {
+        scanners[ext] = scanner;
+    }
+}
+
+bool UCIDESymbolIndex::CanIndex(const std::string& path) const {
+    return ScannerFor(path) != nullptr;
+}
+
+const SymbolScanner* UCIDESymbolIndex::ScannerFor(const std::string& path) const {
+    auto it = scanners.find(GetExtension(path));
+    return it != scanners.end() ? &it->second : nullptr;
+}
+
+// ============================================================================
+// MAPPED INDEX
+// ============================================================================
+
+std::string UCIDESymbolIndex::GetIndexPath() const {
+    return rootDirectory + "/" + UCIDE_SNAPSHOT_DIRECTORY + "/" + UCIDE_SYMBOL_INDEX_FILE;
+}
+
+bool UCIDESymbolIndex::MapIndexLocked(const std::string& path) {
+    header = nullptr;
+    baseFiles = nullptr;
+    baseSymbols = nullptr;
+    baseSortedIds = nullptr;
+    baseStrings = nullptr;
+    basePathToIndex.clear();
+    baseHashToIndex.clear();
+    baseShadowed.clear();
+    mapped.Close();
+
+    if (!mapped.Open(path) || mapped.Size() < sizeof(DiskHeader)) {
+        mapped.Close();
+        return false;
+    }
+
+    const uint8_t* data = mapped.Data();
+    const auto* candidate = reinterpret_cast<const DiskHeader*>(data);
+    if (candidate->magic != UCIDE_SYMBOL_INDEX_MAGIC || candidate->version != UCIDE_SYMBOL_INDEX_VERSION) {
+        mapped.Close();
+        return false;
+    }
+
+    // Section bounds; all sections keep 8-byte alignment except the pool
+    const uint64_t filesOffset = sizeof(DiskHeader);
+    const uint64_t symbolsOffset = filesOffset + uint64_t(candidate->fileCount) * sizeof(DiskFile);
+    const uint64_t sortedOffset = symbolsOffset + uint64_t(candidate->symbolCount) * sizeof(DiskSymbol);
+    const uint64_t stringsOffset = sortedOffset + uint64_t(candidate->symbolCount) * sizeof(uint32_t);
+    if (stringsOffset + candidate->stringsSize != mapped.Size()) {
+        mapped.Close();
+        return false;
+    }
+
+    const auto* files = reinterpret_cast<const DiskFile*>(data + filesOffset);
+    const auto* symbols = reinterpret_cast<const DiskSymbol*>(data + symbolsOffset);
+    const auto* sorted = reinterpret_cast<const uint32_t*>(data + sortedOffset);
+    const uint64_t poolSize = candidate->stringsSize;
+
+    // Validate every record once so queries can index without checks
+    for (uint32_t i = 0; i < candidate->fileCount; ++i) {
+        const DiskFile& file = files[i];
+        if (uint64_t(file.pathOffset) + file.pathLength > poolSize ||
+            uint64_t(file.firstSymbol) + file.symbolCount > candidate->symbolCount) {
+            mapped.Close();
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < candidate->symbolCount; ++i) {
+        const DiskSymbol& symbol = symbols[i];
+        if (uint64_t(symbol.nameOffset) + symbol.nameLength > poolSize ||
+            uint64_t(symbol.containerOffset) + symbol.containerLength > poolSize ||
+            symbol.fileIndex >= candidate->fileCount ||
+            symbol.kind > static_cast<uint8_t>(SymbolKind::Type) ||
+            sorted[i] >= candidate->symbolCount) {
+            mapped.Close();
+            return false;
+        }
+    }
+
+    header = candidate;
+    baseFiles = files;
+    baseSymbols = symbols;
+    baseSortedIds = sorted;
+    baseStrings = reinterpret_cast<const char*>(data + stringsOffset);
+
+    basePathToIndex.reserve(header->fileCount);
+    baseHashToIndex.reserve(header->fileCount);
+    for (uint32_t i = 0; i < header->fileCount; ++i) {
+        basePathToIndex.emplace(BaseString(baseFiles[i].pathOffset, baseFiles[i].pathLength), i);
+        baseHashToIndex.emplace(baseFiles[i].contentHash, i);
+    }
+    baseShadowed.assign(header->fileCount, false);
+    return true;
+}
+
+std::string_view UCIDESymbolIndex::BaseString(uint32_t offset, uint32_t length) const {
+    return std::string_view(baseStrings + offset, length);
+}
+
+SymbolInfo UCIDESymbolIndex::BaseSymbol(uint32_t symbolId) const {
+    const DiskSymbol& symbol = baseSymbols[symbolId];
+    const DiskFile& file = baseFiles[symbol.fileIndex];
+
+    SymbolInfo info;
+    info.name = BaseString(symbol.nameOffset, symbol.nameLength);
+    info.container = BaseString(symbol.containerOffset, symbol.containerLength);
+    info.relativePath = BaseString(file.pathOffset, file.pathLength);
+    info.kind = static_cast<SymbolKind>(symbol.kind);
+    info.line = static_cast<int>(symbol.line);
+    info.isDefinition = symbol.isDefinition != 0;
+    return info;
+}
+
+std::vector<SymbolInfo> UCIDESymbolIndex::BaseFileSymbols(uint32_t fileIndex) const {
+    std::vector<SymbolInfo> symbols;
+    const DiskFile& file = baseFiles[fileIndex];
+    symbols.reserve(file.symbolCount);
+    for (uint32_t i = 0; i < file.symbolCount; ++i) {
+        symbols.push_back(BaseSymbol(file.firstSymbol + i));
+    }
+    return symbols;
+}
+
+bool UCIDESymbolIndex::IsBaseFileShadowed(uint32_t fileIndex) const {
+    return baseShadowed[fileIndex];
+}
+
+// ============================================================================
+// LIFECYCLE
+// ============================================================================
+
+bool UCIDESymbolIndex::Open(const std::string& root) {
+    Close();
+
+    std::lock_guard<std::mutex> writeLock(writeMutex);
+    std::unique_lock<std::shared_mutex> lock(indexMutex);
+    rootDirectory = root;
+    return MapIndexLocked(GetIndexPath());
+}
+
+void UCIDESymbolIndex::Close() {
+    CancelUpdate();
+    if (rootDirectory.empty()) return;
+
+    Save();
+
+    std::lock_guard<std::mutex> writeLock(writeMutex);
+    std::unique_lock<std::shared_mutex> lock(indexMutex);
+    MapIndexLocked("");
+    overlay.clear();
+    dirty = false;
+    rootDirectory.clear();
+}
+
+bool UCIDESymbolIndex::Save() {
+    std::lock_guard<std::mutex> writeLock(writeMutex);
+    if (rootDirectory.empty()) return false;
+
+    std::string path = GetIndexPath();
+    std::string tempPath = path + ".tmp";
+
+    {
+        std::shared_lock<std::shared_mutex> lock(indexMutex);
+        if (!dirty) return true;
+
+        std::vector<DiskFile> files;
+        std::vector<DiskSymbol> symbols;
+        std::vector<std::string> foldedNames;
+        StringPool pool;
+
+        auto addSymbol = [&](std::string_view name, std::string_view container, SymbolKind kind,
+                             int line, bool isDefinition, uint32_t fileIndex) {
+            DiskSymbol symbol{};
+            symbol.nameOffset = pool.Add(name);
+            symbol.nameLength = static_cast<uint16_t>(std::min<size_t>(name.size(), UINT16_MAX));
+            symbol.kind = static_cast<uint8_t>(kind);
+            symbol.isDefinition = isDefinition ? 1 : 0;
+            symbol.containerOffset = pool.Add(container);
+            symbol.containerLength = static_cast<uint16_t>(std::min<size_t>(container.size(), UINT16_MAX));
+            symbol.line = static_cast<uint32_t>(std::max(line, 0));
+            symbol.fileIndex = fileIndex;
+            symbols.push_back(symbol);
+        };
+
+        // Unchanged files straight from the mapped index
+        if (header) {
+            for (uint32_t i = 0; i < header->fileCount; ++i) {
+                if (baseShadowed[i]) continue;
+                const DiskFile& source = baseFiles[i];
+                DiskFile file = source;
+                file.pathOffset = pool.Add(BaseString(source.pathOffset, source.pathLength));
+                file.firstSymbol = static_cast<uint32_t>(symbols.size());
+                uint32_t fileIndex = static_cast<uint32_t>(files.size());
+                for (uint32_t s = 0; s < source.symbolCount; ++s) {
+                    const DiskSymbol& symbol = baseSymbols[source.firstSymbol + s];
+                    addSymbol(BaseString(symbol.nameOffset, symbol.nameLength),
+                              BaseString(symbol.containerOffset, symbol.containerLength),
+                              static_cast<SymbolKind>(symbol.kind), static_cast<int>(symbol.line),
+                              symbol.isDefinition != 0, fileIndex);
+                }
+                files.push_back(file);
+            }
+        }
+
+        // Files that changed since
+        for (const auto& pair : overlay) {
+            const FileEntry& entry = pair.second;
+            if (entry.removed) continue;
+            DiskFile file{};
+            file.pathOffset = pool.Add(entry.relativePath);
+            file.pathLength = static_cast<uint32_t>(entry.relativePath.size());
+            file.modifiedTime = entry.modifiedTime;
+            file.size = entry.size;
+            file.contentHash = entry.contentHash;
+            file.firstSymbol = static_cast<uint32_t>(symbols.size());
+            file.symbolCount = static_cast<uint32_t>(entry.symbols.size());
+            uint32_t fileIndex = static_cast<uint32_t>(files.size());
+            for (const auto& symbol : entry.symbols) {
+                addSymbol(symbol.name, symbol.container, symbol.kind, symbol.line,
+                          symbol.isDefinition, fileIndex);
+            }
+            files.push_back(file);
+        }
+
+        // Name order for binary search
+        const std::string& strings = pool.Data();
+        std::vector<uint32_t> sorted(symbols.size());
+        std::iota(sorted.begin(), sorted.end(), 0u);
+        std::sort(sorted.begin(), sorted.end(), [&](uint32_t a, uint32_t b) {
+            std::string_view nameA(strings.data() + symbols[a].nameOffset, symbols[a].nameLength);
+            std::string_view nameB(strings.data() + symbols[b].nameOffset, symbols[b].nameLength);
+            int cmp = CompareFolded(nameA, nameB);
+            if (cmp != 0) return cmp < 0;
+            return nameA < nameB;
+        });
+
+        DiskHeader diskHeader{};
+        diskHeader.magic = UCIDE_SYMBOL_INDEX_MAGIC;
+        diskHeader.version = UCIDE_SYMBOL_INDEX_VERSION;
+        diskHeader.fileCount = static_cast<uint32_t>(files.size());
+        diskHeader.symbolCount = static_cast<uint32_t>(symbols.size());
+        diskHeader.stringsSize = strings.size();
+
+        std::error_code ec;
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) return false;
+        out.write(reinterpret_cast<const char*>(&diskHeader), sizeof(diskHeader));
+        out.write(reinterpret_cast<const char*>(files.data()),
+                  static_cast<std::streamsize>(files.size() * sizeof(DiskFile)));
+        out.write(reinterpret_cast<const char*>(symbols.data()),
+                  static_cast<std::streamsize>(symbols.size() * sizeof(DiskSymbol)));
+        out.write(reinterpret_cast<const char*>(sorted.data()),
+                  static_cast<std::streamsize>(sorted.size() * sizeof(uint32_t)));
+        out.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+        if (!out.good()) {
+            out.close();
+            std::filesystem::remove(tempPath, ec);
+            return false;
+        }
+    }
+
+    // Swap in the new file. The old mapping is released first so the rename
+    // also works where mapped files cannot be replaced.
+    std::unique_lock<std::shared_mutex> lock(indexMutex);
+    MapIndexLocked("");
+    std::error_code ec;
+    std::filesystem::rename(tempPath, path, ec);
+    bool ok = !ec && MapIndexLocked(path);
+    if (ok) {
+        overlay.clear();
+        dirty = false;
+    } else {
+        // Keep serving from the overlay; the old file is still in place
+        std::filesystem::remove(tempPath, ec);
+        MapIndexLocked(path);
+        for (const auto& pair : overlay) {
+            auto it = basePathToIndex.find(pair.first);
+            if (it != basePathToIndex.end()) baseShadowed[it->second] = true;
+        }
+    }
+    return ok;
+}
+
+// ============================================================================
+// UPDATES
+// ============================================================================
+
+bool UCIDESymbolIndex::LookupLocked(const std::string& relativePath, int64_t& modifiedTime,
+                                    uint64_t& size, uint64_t& contentHash) const {
+    auto overlayIt = overlay.find(relativePath);
+    if (overlayIt != overlay.end()) {
+        if (overlayIt->second.removed) return false;
+        modifiedTime = overlayIt->second.modifiedTime;
+        size = overlayIt->second.size;
+        contentHash = overlayIt->second.contentHash;
+        return true;
+    }
+    auto baseIt = basePathToIndex.find(relativePath);
+    if (baseIt != basePathToIndex.end()) {
+        const DiskFile& file = baseFiles[baseIt->second];
+        modifiedTime = file.modifiedTime;
+        size = file.size;
+        contentHash = file.contentHash;
+        return true;
+    }
+    return false;
+}
+
+bool UCIDESymbolIndex::FindSymbolsByHashLocked(uint64_t contentHash, std::vector<SymbolInfo>& symbols) const {
+    auto baseIt = baseHashToIndex.find(contentHash);
+    if (baseIt != baseHashToIndex.end()) {
+        symbols = BaseFileSymbols(baseIt->second);
+        return true;
+    }
+    return false;
+}
+
+bool UCIDESymbolIndex::ScanFile(const std::string& relativePath, FileEntry& entry, bool& changed) const {
+    changed = false;
+    const SymbolScanner* scanner = ScannerFor(relativePath);
+    if (!scanner) return false;
+
+    std::string absolutePath = rootDirectory + "/" + relativePath;
+    entry.relativePath = relativePath;
+
+    int64_t oldModified = 0;
+    uint64_t oldSize = 0;
+    uint64_t oldHash = 0;
+    bool known;
+    {
+        std::shared_lock<std::shared_mutex> lock(indexMutex);
+        known = LookupLocked(relativePath, oldModified, oldSize, oldHash);
+    }
+
+    int64_t modifiedTime = GetPathModifiedTime(absolutePath);
+    if (modifiedTime == 0) {
+        entry.removed = true;
+        changed = known;
+        return true;
+    }
+
+    std::error_code ec;
+    uint64_t size = std::filesystem::file_size(absolutePath, ec);
+    if (ec) return false;
+    if (known && oldModified == modifiedTime && oldSize == size) return true;
+
+    UCMappedFile file;
+    if (!file.Open(absolutePath)) return false;
+    std::string_view content = file.View();
+
+    entry.modifiedTime = modifiedTime;
+    entry.size = content.size();
+    entry.contentHash = HashBytes64(content.data(), content.size());
+    changed = true;
+
+    bool reused;
+    if (known && oldHash == entry.contentHash) {
+        // Touched but identical: keep the symbols, record the new stamp
+        entry.symbols = GetFileSymbols(relativePath);
+        return true;
+    }
+    {
+        std::shared_lock<std::shared_mutex> lock(indexMutex);
+        reused = FindSymbolsByHashLocked(entry.contentHash, entry.symbols);
+    }
+    if (!reused) {
+        entry.symbols.clear();
+        if (!(*scanner)(absolutePath, content, entry.symbols)) {
+            entry.symbols.clear();
+        }
+    }
+    for (auto& symbol : entry.symbols) {
+        symbol.relativePath = relativePath;
+    }
+    return true;
+}
+
+void UCIDESymbolIndex::ApplyLocked(FileEntry entry) {
+    auto baseIt = basePathToIndex.find(entry.relativePath);
+    bool inBase = baseIt != basePathToIndex.end();
+    if (inBase) baseShadowed[baseIt->second] = true;
+
+    if (entry.removed && !inBase) {
+        overlay.erase(entry.relativePath);
+    } else {
+        std::string key = entry.relativePath;
+        overlay[key] = std::move(entry);
+    }
+    dirty = true;
+}
+
+bool UCIDESymbolIndex::UpdateFile(const std::string& relativePath) {
+    FileEntry entry;
+    bool changed = false;
+    if (!ScanFile(relativePath, entry, changed)) return false;
+    if (!changed) return true;
+
+    std::lock_guard<std::mutex> writeLock(writeMutex);
+    std::unique_lock<std::shared_mutex> lock(indexMutex);
+    ApplyLocked(std::move(entry));
+    return true;
+}
+
+void UCIDESymbolIndex::RemoveFile(const std::string& relativePath) {
+    FileEntry entry;
+    entry.relativePath = relativePath;
+    entry.removed = true;
+
+    std::lock_guard<std::mutex> writeLock(writeMutex);
+    std::unique_lock<std::shared_mutex> lock(indexMutex);
+    ApplyLocked(std::move(entry));
+}
+
+void UCIDESymbolIndex::StartUpdate(const UCIDEProject& project, ProgressCallback onProgress,
+                                   CompleteCallback onComplete) {
+    CancelUpdate();
+
+    std::vector<std::string> paths;
+    std::vector<const ProjectFolder*> stack = { &project.rootFolder };
+    while (!stack.empty()) {
+        const ProjectFolder* folder = stack.back();
+        stack.pop_back();
+        for (const auto& file : folder->files) {
+            if (CanIndex(std::string(file.GetFileName()))) paths.push_back(file.GetRelativePath());
+        }
+        for (const auto& sub : folder->subfolders) {
+            stack.push_back(&sub);
+        }
+    }
+
+    uint64_t generation = ++updateGeneration;
+    updating = true;
+    updateThread = std::thread(&UCIDESymbolIndex::UpdateLoop, this, generation, std::move(paths),
+                               std::move(onProgress), std::move(onComplete));
+}
+
+void UCIDESymbolIndex::CancelUpdate() {
+    ++updateGeneration;
+    if (updateThread.joinable()) updateThread.join();
+    updating = false;
+}
+
+void UCIDESymbolIndex::UpdateLoop(uint64_t generation, std::vector<std::string> paths,
+                                  ProgressCallback onProgress, CompleteCallback onComplete) {
+    auto cancelled = [&]() { return updateGeneration.load(std::memory_order_relaxed) != generation; };
+
+    std::atomic<size_t> nextFile{0};
+    std::atomic<size_t> filesDone{0};
+    std::atomic<size_t> filesScanned{0};
+    std::mutex progressMutex;
+    constexpr size_t PROGRESS_INTERVAL = 1024;
+
+    auto worker = [&]() {
+        while (!cancelled()) {
+            size_t index = nextFile.fetch_add(1, std::memory_order_relaxed);
+            if (index >= paths.size()) break;
+
+            FileEntry entry;
+            bool changed = false;
+            if (ScanFile(paths[index], entry, changed) && changed) {
+                filesScanned.fetch_add(1, std::memory_order_relaxed);
+                std::lock_guard<std::mutex> writeLock(writeMutex);
+                std::unique_lock<std::shared_mutex> lock(indexMutex);
+                ApplyLocked(std::move(entry));
+            }
+
+            size_t done = filesDone.fetch_add(1, std::memory_order_relaxed) + 1;
+            if (onProgress && done % PROGRESS_INTERVAL == 0) {
+                std::lock_guard<std::mutex> lock(progressMutex);
+                onProgress(done, paths.size());
+            }
+        }
+    };
+
+    size_t threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+    threadCount = std::min(threadCount, std::max<size_t>(1, paths.size()));
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < threadCount; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    if (cancelled()) return;
+
+    // Files that left the project
+    size_t filesRemoved = 0;
+    {
+        std::unordered_set<std::string_view> present(paths.begin(), paths.end());
+        std::vector<std::string> removed;
+
+        std::lock_guard<std::mutex> writeLock(writeMutex);
+        std::unique_lock<std::shared_mutex> lock(indexMutex);
+        for (const auto& pair : basePathToIndex) {
+            if (!baseShadowed[pair.second] && present.find(pair.first) == present.end()) {
+                removed.emplace_back(pair.first);
+            }
+        }
+        for (const auto& pair : overlay) {
+            if (!pair.second.removed && present.find(pair.first) == present.end()) {
+                removed.push_back(pair.first);
+            }
+        }
+        for (auto& path : removed) {
+            FileEntry entry;
+            entry.relativePath = std::move(path);
+            entry.removed = true;
+            ApplyLocked(std::move(entry));
+        }
+        filesRemoved = removed.size();
+    }
+
+    Save();
+
+    if (onProgress) onProgress(paths.size(), paths.size());
+    if (onComplete) onComplete(filesScanned, filesRemoved);
+    updating = false;
+}
+
+// ============================================================================
+// QUERIES
+// ============================================================================
+
+std::vector<SymbolInfo> UCIDESymbolIndex::FindSymbols(const std::string& query, size_t maxResults) const {
+    std::vector<SymbolInfo> results;
+    if (query.empty() || maxResults == 0) return results;
+
+    std::string folded = query;
+    for (char& c : folded) c = Fold(c);
+
+    std::shared_lock<std::shared_mutex> lock(indexMutex);
+    std::vector<RankedHit> hits;
+
+    if (header) {
+        auto nameOf = [&](uint32_t id) {
+            return BaseString(baseSymbols[id].nameOffset, baseSymbols[id].nameLength);
+        };
+
+        // Prefix matches form one contiguous run in name order
+        const uint32_t* begin = baseSortedIds;
+        const uint32_t* end = baseSortedIds + header->symbolCount;
+        const uint32_t* first = std::lower_bound(begin, end, folded, [&](uint32_t id, const std::string& q) {
+            return CompareFolded(nameOf(id), q) < 0;
+        });
+        for (const uint32_t* it = first; it != end; ++it) {
+            std::string_view name = nameOf(*it);
+            if (!StartsWithFolded(name, folded)) break;
+            if (baseShadowed[baseSymbols[*it].fileIndex]) continue;
+            hits.push_back({ name.size() == folded.size() ? 0 : 1, name.size(), nullptr, *it });
+        }
+
+        // Substring matches need a scan, skip it when prefixes already fill the list
+        if (hits.size() < maxResults) {
+            for (uint32_t id = 0; id < header->symbolCount; ++id) {
+                std::string_view name = nameOf(id);
+                if (name.size() <= folded.size() || StartsWithFolded(name, folded)) continue;
+                if (!ContainsFolded(name, folded)) continue;
+                if (baseShadowed[baseSymbols[id].fileIndex]) continue;
+                hits.push_back({ 2, name.size(), nullptr, id });
+            }
+        }
+    }
+
+    for (const auto& pair : overlay) {
+        for (const auto& symbol : pair.second.symbols) {
+            int rank;
+            if (StartsWithFolded(symbol.name, folded)) {
+                rank = symbol.name.size() == folded.size() ? 0 : 1;
+            } else if (ContainsFolded(symbol.name, folded)) {
+                rank = 2;
+            } else {
+                continue;
+            }
+            hits.push_back({ rank, symbol.name.size(), &symbol, 0 });
+        }
+    }
+
+    size_t count = std::min(maxResults, hits.size());
+    std::partial_sort(hits.begin(), hits.begin() + count, hits.end(),
+                      [](const RankedHit& a, const RankedHit& b) {
+        if (a.rank != b.rank) return a.rank < b.rank;
+        return a.nameLength < b.nameLength;
+    });
+
+    results.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        results.push_back(hits[i].overlaySymbol ? *hits[i].overlaySymbol : BaseSymbol(hits[i].baseSymbol));
+    }
+    return results;
+}
+
+std::vector<SymbolInfo> UCIDESymbolIndex::FindDefinitions(const std::string& name,
+                                                          const std::string& container) const {
+    std::vector<SymbolInfo> results;
+    if (name.empty()) return results;
+
+    std::shared_lock<std::shared_mutex> lock(indexMutex);
+
+    if (header) {
+        auto nameOf = [&](uint32_t id) {
+            return BaseString(baseSymbols[id].nameOffset, baseSymbols[id].nameLength);
+        };
+        const uint32_t* begin = baseSortedIds;
+        const uint32_t* end = baseSortedIds + header->symbolCount;
+        auto range = std::equal_range(begin, end, name, [&](const auto& a, const auto& b) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(a)>, uint32_t>) {
+                return CompareFolded(nameOf(a), b) < 0;
+            } else {
+                return CompareFolded(a, nameOf(b)) < 0;
+            }
+        });
+        for (const uint32_t* it = range.first; it != range.second; ++it) {
+            if (nameOf(*it) != name || baseShadowed[baseSymbols[*it].fileIndex]) continue;
+            results.push_back(BaseSymbol(*it));
+        }
+    }
+
+    for (const auto& pair : overlay) {
+        for (const auto& symbol : pair.second.symbols) {
+            if (symbol.name == name) results.push_back(symbol);
+        }
+    }
+
+    // "Foo" matches the containers "Foo" and "ns::Foo"
+    auto inContainer = [&](const SymbolInfo& symbol) {
+        if (container.empty() || symbol.container.size() < container.size()) return false;
+        size_t offset = symbol.container.size() - container.size();
+        return symbol.container.compare(offset, container.size(), container) == 0 &&
+               (offset == 0 || symbol.container.compare(offset - 2, 2, "::") == 0);
+    };
+
+    std::stable_sort(results.begin(), results.end(), [&](const SymbolInfo& a, const SymbolInfo& b) {
+        bool containerA = inContainer(a);
+        bool containerB = inContainer(b);
+        if (containerA != containerB) return containerA;
+        if (a.isDefinition != b.isDefinition) return a.isDefinition;
+        if (a.relativePath != b.relativePath) return a.relativePath < b.relativePath;
+        return a.line < b.line;
+    });
+    return results;
+}
+
+std::vector<SymbolInfo> UCIDESymbolIndex::GetFileSymbols(const std::string& relativePath) const {
+    std::shared_lock<std::shared_mutex> lock(indexMutex);
+
+    auto overlayIt = overlay.find(relativePath);
+    if (overlayIt != overlay.end()) {
+        return overlayIt->second.removed ? std::vector<SymbolInfo>() : overlayIt->second.symbols;
+    }
+    auto baseIt = basePathToIndex.find(relativePath);
+    if (baseIt != basePathToIndex.end()) {
+        return BaseFileSymbols(baseIt->second);
+    }
+    return {};
+}
+
+size_t UCIDESymbolIndex::GetFileCount() const {
+    std::shared_lock<std::shared_mutex> lock(indexMutex);
+    size_t count = 0;
+    if (header) {
+        count = header->fileCount - std::count(baseShadowed.begin(), baseShadowed.end(), true);
+    }
+    for (const auto& pair : overlay) {
+        if (!pair.second.removed) ++count;
+    }
+    return count;
+}
+
+size_t UCIDESymbolIndex::GetSymbolCount() const {
+    std::shared_lock<std::shared_mutex> lock(indexMutex);
+    size_t count = 0;
+    if (header) {
+        for (uint32_t i = 0; i < header->fileCount; ++i) {
+            if (!baseShadowed[i]) count += baseFiles[i].symbolCount;
+        }
+    }
+    for (const auto& pair : overlay) {
+        count += pair.second.symbols.size();
+    }
+    return count;
+}
+
+} // namespace IDE
+} // namespace UltraCanvas
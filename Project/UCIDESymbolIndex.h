@@ -0,0 +1,286 @@
+// Apps/IDE/Project/UCIDESymbolIndex.h
+// Persistent project symbol index for "Go to Symbol" / "Go to Definition"
+// Version: 1.0.0
+// Last Modified: 2026-10-17
+// Author: UltraCanvas Framework / ULTRA IDE
+#pragma once
+
+#include "UCIDEProject.h"
+#include "UCMappedFile.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <cstdint>
+
+namespace UltraCanvas {
+namespace IDE {
+
+// ============================================================================
+// SYMBOLS
+// ============================================================================
+
+/**
+ * @brief Kind of an indexed symbol
+ */
+enum class SymbolKind : uint8_t {
+    Namespace,
+    Class,
+    Struct,
+    Union,
+    Enum,
+    Interface,
+    Function,
+    Method,
+    Field,
+    Variable,
+    Typedef,
+    Macro,
+    Module,
+    Program,
+    Subroutine,
+    Package,
+    Type
+};
+
+/**
+ * @brief Display name of a symbol kind
+ */
+const char* SymbolKindToString(SymbolKind kind);
+
+/**
+ * @brief A symbol found in a source file
+ */
+struct SymbolInfo {
+    std::string name;                   // Unqualified name
+    std::string container;              // Enclosing class/namespace/table (may be empty)
+    std::string relativePath;           // File relative to project root
+    SymbolKind kind = SymbolKind::Function;
+    int line = 0;                       // 1-based
+    bool isDefinition = true;           // false for declarations (prototypes in a class body)
+};
+
+/**
+ * @brief Extracts symbols from one file
+ *
+ * Receives the absolute path and the file content; scanners that can only
+ * work on paths may ignore the content. Must be thread-safe.
+ * @return false if the file could not be scanned
+ */
+using SymbolScanner = std::function<bool(const std::string& absolutePath, std::string_view content,
+                                         std::vector<SymbolInfo>& symbols)>;
+
+// ============================================================================
+// INDEX FORMAT CONSTANTS
+// ============================================================================
+
+constexpr uint32_t UCIDE_SYMBOL_INDEX_MAGIC = 0x49534355;   // "UCSI" little-endian
+constexpr uint32_t UCIDE_SYMBOL_INDEX_VERSION = 1;
+constexpr const char* UCIDE_SYMBOL_INDEX_FILE = "symbols.index";
+
+// ============================================================================
+// SYMBOL INDEX
+// ============================================================================
+
+/**
+ * @brief Project-wide symbol index persisted in <root>/.ultraide/symbols.index
+ *
+ * The index file is memory-mapped and queried in place: a file table, a
+ * fixed-size symbol table, symbol ids sorted by case-folded name (binary
+ * search for exact and prefix lookups) and a string pool. Files that
+ * changed since the file was written live in an in-memory overlay that
+ * shadows their mapped records; Save() merges both into a new file.
+ *
+ * Updates run in the background and scan changed files in parallel. A
+ * file is rescanned only when its modification time or size changed and
+ * its content hash differs from the indexed one; content already indexed
+ * under another path (copies, renames) reuses those symbols.
+ */
+class UCIDESymbolIndex {
+public:
+    using ProgressCallback = std::function<void(size_t filesDone, size_t filesTotal)>;
+    using CompleteCallback = std::function<void(size_t filesScanned, size_t filesRemoved)>;
+
+    UCIDESymbolIndex() = default;
+    ~UCIDESymbolIndex();
+
+    UCIDESymbolIndex(const UCIDESymbolIndex&) = delete;
+    UCIDESymbolIndex& operator=(const UCIDESymbolIndex&) = delete;
+
+    // ===== SCANNERS =====
+
+    /**
+     * @brief Register a scanner for file extensions (without dot, lowercase)
+     */
+    void RegisterScanner(const std::vector<std::string>& extensions, SymbolScanner scanner);
+
+    /**
+     * @brief Whether a scanner handles this path
+     */
+    bool CanIndex(const std::string& path) const;
+
+    // ===== LIFECYCLE =====
+
+    /**
+     * @brief Map the stored index of a project (if any)
+     * @return true if a valid index file was mapped
+     */
+    bool Open(const std::string& rootDirectory);
+
+    /**
+     * @brief Stop updates, save pending changes and unmap
+     */
+    void Close();
+
+    /**
+     * @brief Bring the index in line with the project files in the background
+     *
+     * Callbacks run on the update thread. A running update is restarted.
+     */
+    void StartUpdate(const UCIDEProject& project, ProgressCallback onProgress = nullptr,
+                     CompleteCallback onComplete = nullptr);
+
+    /**
+     * @brief Stop a running update (keeps what was already scanned)
+     */
+    void CancelUpdate();
+
+    bool IsUpdating() const { return updating.load(); }
+
+    /**
+     * @brief Rescan a single file right away (e.g. after the editor saved it)
+     */
+    bool UpdateFile(const std::string& relativePath);
+
+    /**
+     * @brief Drop a deleted file
+     */
+    void RemoveFile(const std::string& relativePath);
+
+    /**
+     * @brief Write the merged index to disk and map it
+     */
+    bool Save();
+
+    // ===== QUERIES =====
+
+    /**
+     * @brief "Go to Symbol": case-insensitive, exact > prefix > substring
+     */
+    std::vector<SymbolInfo> FindSymbols(const std::string& query, size_t maxResults = 100) const;
+
+    /**
+     * @brief "Go to Definition": exact name, definitions first
+     * @param container Optional enclosing class/namespace to prefer
+     */
+    std::vector<SymbolInfo> FindDefinitions(const std::string& name,
+                                            const std::string& container = "") const;
+
+    /**
+     * @brief All symbols of a file in line order (outline)
+     */
+    std::vector<SymbolInfo> GetFileSymbols(const std::string& relativePath) const;
+
+    size_t GetFileCount() const;
+    size_t GetSymbolCount() const;
+
+private:
+    // ===== ON-DISK LAYOUT =====
+    struct DiskHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t fileCount;
+        uint32_t symbolCount;
+        uint64_t stringsSize;
+        uint64_t reserved;
+    };
+
+    struct DiskFile {
+        uint32_t pathOffset;
+        uint32_t pathLength;
+        int64_t modifiedTime;
+        uint64_t size;
+        uint64_t contentHash;
+        uint32_t firstSymbol;
+        uint32_t symbolCount;
+    };
+
+    struct DiskSymbol {
+        uint32_t nameOffset;
+        uint16_t nameLength;
+        uint8_t kind;
+        uint8_t isDefinition;
+        uint32_t containerOffset;
+        uint16_t containerLength;
+        uint16_t reserved;
+        uint32_t line;
+        uint32_t fileIndex;
+    };
+
+    // Records are read in place from the mapping; keep sections 8-byte aligned
+    static_assert(sizeof(DiskHeader) == 32 && sizeof(DiskFile) == 40 && sizeof(DiskSymbol) == 24,
+                  "symbol index record layout changed; bump UCIDE_SYMBOL_INDEX_VERSION");
+
+    /**
+     * @brief Indexed state of a file held in memory
+     */
+    struct FileEntry {
+        std::string relativePath;
+        int64_t modifiedTime = 0;
+        uint64_t size = 0;
+        uint64_t contentHash = 0;
+        std::vector<SymbolInfo> symbols;
+        bool removed = false;           // Tombstone for a mapped file
+    };
+
+    // Mapped index access (caller holds indexMutex)
+    bool MapIndexLocked(const std::string& path);
+    std::string_view BaseString(uint32_t offset, uint32_t length) const;
+    SymbolInfo BaseSymbol(uint32_t symbolId) const;
+    std::vector<SymbolInfo> BaseFileSymbols(uint32_t fileIndex) const;
+    bool IsBaseFileShadowed(uint32_t fileIndex) const;
+
+    // Looks up the current record of a file (caller holds indexMutex)
+    bool LookupLocked(const std::string& relativePath, int64_t& modifiedTime, uint64_t& size,
+                      uint64_t& contentHash) const;
+    bool FindSymbolsByHashLocked(uint64_t contentHash, std::vector<SymbolInfo>& symbols) const;
+
+    void ApplyLocked(FileEntry entry);
+
+    bool ScanFile(const std::string& relativePath, FileEntry& entry, bool& changed) const;
+    const SymbolScanner* ScannerFor(const std::string& path) const;
+    void UpdateLoop(uint64_t generation, std::vector<std::string> paths,
+                    ProgressCallback onProgress, CompleteCallback onComplete);
+
+    std::string GetIndexPath() const;
+
+    // ===== STATE =====
+    std::string rootDirectory;
+    std::unordered_map<std::string, SymbolScanner> scanners;    // By extension
+
+    mutable std::shared_mutex indexMutex;   // Guards everything below
+    UCMappedFile mapped;
+    const DiskHeader* header = nullptr;
+    const DiskFile* baseFiles = nullptr;
+    const DiskSymbol* baseSymbols = nullptr;
+    const uint32_t* baseSortedIds = nullptr;
+    const char* baseStrings = nullptr;
+    std::unordered_map<std::string_view, uint32_t> basePathToIndex;
+    std::unordered_map<uint64_t, uint32_t> baseHashToIndex;
+    std::vector<bool> baseShadowed;     // Mapped file has an overlay entry
+    std::unordered_map<std::string, FileEntry> overlay;    // Changed since the file was written
+    bool dirty = false;
+
+    std::mutex writeMutex;              // Serializes modifications and Save()
+    std::thread updateThread;
+    std::atomic<uint64_t> updateGeneration{0};
+    std::atomic<bool> updating{false};
+};
+
+} // namespace IDE
+} // namespace UltraCanvas
@@ -0,0 +1,728 @@
+// Apps/IDE/Project/UCIDESymbolScanners.cpp
+// Built-in symbol scanners and adapters for the language plugins
+// Version: 1.0.0
+// Last Modified: 2026-10-17
+// Author: UltraCanvas Framework / ULTRA IDE
+
+#include "UCIDESymbolScanners.h"
+#include <algorithm>
+#include <mutex>
+
+#ifdef ULTRAIDE_PLUGIN_JAVA_ENABLED
+    #include "../Build/Plugins/UCJavaPlugin.h"
+#endif
+#ifdef ULTRAIDE_PLUGIN_LUA_ENABLED
+    #include "../Build/Plugins/UCLuaPlugin.h"
+#endif
+#ifdef ULTRAIDE_PLUGIN_FORTRAN_ENABLED
+    #include "../Build/Plugins/UCFortranPlugin.h"
+#endif
+#ifdef ULTRAIDE_PLUGIN_GO_ENABLED
+    #include "../Build/Plugins/UCGoPlugin.h"
+#endif
+
+namespace UltraCanvas {
+namespace IDE {
+
+// ============================================================================
+// C/C++ TOKENIZER
+// ============================================================================
+
+namespace {
+
+struct CppToken {
+    std::string_view text;
+    int line = 0;
+    bool identifier = false;
+};
+
+inline bool IsIdentStart(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == '$';
+}
+
+inline bool IsIdentChar(char c) {
+    return IsIdentStart(c) || (c >= '0' && c <= '9');
+}
+
+/**
+ * @brief Split C/C++ source into tokens, dropping comments and literals
+ *
+ * String and character literals become a single '"' token so constructs
+ * like extern "C" stay recognizable. #define names are reported directly.
+ */
+void TokenizeCpp(std::string_view src, std::vector<CppToken>& tokens, std::vector<SymbolInfo>& symbols) {
+    static const std::string_view QUOTE = "\"";
+    static const std::string_view NUMBER = "0";
+
+    size_t i = 0;
+    const size_t n = src.size();
+    int line = 1;
+    bool atLineStart = true;
+
+    auto skipToLineEnd = [&]() {
+        // Honors backslash continuations
+        while (i < n && src[i] != '\n') {
+            if (src[i] == '\\' && i + 1 < n && src[i + 1] == '\n') {
+                ++line;
+                i += 2;
+                continue;
+            }
+            if (src[i] == '/' && i + 1 < n && src[i + 1] == '*') {
+                i += 2;
+                while (i + 1 < n && !(src[i] == '*' && src[i + 1] == '/')) {
+                    if (src[i] == '\n') ++line;
+                    ++i;
+                }
+                i += 2;
+                continue;
+            }
+            ++i;
+        }
+    };
+
+    while (i < n) {
+        char c = src[i];
+
+        if (c == '\n') {
+            ++line;
+            ++i;
+            atLineStart = true;
+            continue;
+        }
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\f' || c == '\v') {
+            ++i;
+            continue;
+        }
+
+        // Preprocessor directive
+        if (c == '#' && atLineStart) {
+            ++i;
+            while (i < n && (src[i] == ' ' || src[i] == '\t')) ++i;
+            size_t wordStart = i;
+            while (i < n && IsIdentChar(src[i])) ++i;
+            if (src.substr(wordStart, i - wordStart) == "define") {
+                while (i < n && (src[i] == ' ' || src[i] == '\t')) ++i;
+                size_t nameStart = i;
+                while (i < n && IsIdentChar(src[i])) ++i;
+                if (i > nameStart) {
+                    SymbolInfo symbol;
+                    symbol.name = std::string(src.substr(nameStart, i - nameStart));
+                    symbol.kind = SymbolKind::Macro;
+                    symbol.line = line;
+                    symbols.push_back(std::move(symbol));
+                }
+            }
+            skipToLineEnd();
+            continue;
+        }
+        atLineStart = false;
+
+        // Comments
+        if (c == '/' && i + 1 < n && src[i + 1] == '/') {
+            skipToLineEnd();
+            continue;
+        }
+        if (c == '/' && i + 1 < n && src[i + 1] == '*') {
+            i += 2;
+            while (i + 1 < n && !(src[i] == '*' && src[i + 1] == '/')) {
+                if (src[i] == '\n') ++line;
+                ++i;
+            }
+            i += 2;
+            continue;
+        }
+
+        // String / character literals
+        if (c == '"' || c == '\'') {
+            char quote = c;
+            ++i;
+            while (i < n && src[i] != quote && src[i] != '\n') {
+                if (src[i] == '\\' && i + 1 < n) {
+                    if (src[i + 1] == '\n') ++line;
+                    ++i;
+                }
+                ++i;
+            }
+            ++i;
+            tokens.push_back({ QUOTE, line, false });
+            continue;
+        }
+
+        // Identifiers (and raw string prefixes)
+        if (IsIdentStart(c)) {
+            size_t start = i;
+            while (i < n && IsIdentChar(src[i])) ++i;
+            std::string_view word = src.substr(start, i - start);
+            if (i < n && src[i] == '"' && !word.empty() && word.back() == 'R' &&
+                (word == "R" || word == "LR" || word == "uR" || word == "UR" || word == "u8R")) {
+                // R"delim( ... )delim"
+                size_t open = src.find('(', i + 1);
+                if (open == std::string_view::npos) break;
+                std::string terminator = ")" + std::string(src.substr(i + 1, open - i - 1)) + "\"";
+                size_t close = src.find(terminator, open + 1);
+                size_t end = close == std::string_view::npos ? n : close + terminator.size();
+                line += static_cast<int>(std::count(src.begin() + i, src.begin() + end, '\n'));
+                i = end;
+                tokens.push_back({ QUOTE, line, false });
+                continue;
+            }
+            tokens.push_back({ word, line, true });
+            continue;
+        }
+
+        // Numbers (including digit separators and suffixes)
+        if (c >= '0' && c <= '9') {
+            while (i < n && (IsIdentChar(src[i]) || src[i] == '.' || src[i] == '\'')) ++i;
+            tokens.push_back({ NUMBER, line, false });
+            continue;
+        }
+
+        if (c == ':' && i + 1 < n && src[i + 1] == ':') {
+            tokens.push_back({ src.substr(i, 2), line, false });
+            i += 2;
+            continue;
+        }
+
+        tokens.push_back({ src.substr(i, 1), line, false });
+        ++i;
+    }
+}
+
+// ============================================================================
+// C/C++ DECLARATION PARSER
+// ============================================================================
+
+bool IsNonFunctionKeyword(std::string_view word) {
+    static const std::string_view KEYWORDS[] = {
+        "if", "while", "for", "switch", "return", "sizeof", "decltype", "alignof",
+        "noexcept", "static_assert", "catch", "throw", "new", "delete", "typeid"
+    };
+    return std::find(std::begin(KEYWORDS), std::end(KEYWORDS), word) != std::end(KEYWORDS);
+}
+
+bool IsAttributeKeyword(std::string_view word) {
+    return word == "__attribute__" || word == "__declspec" || word == "alignas";
+}
+
+class CppTagParser {
+public:
+    CppTagParser(const std::vector<CppToken>& tokens, std::vector<SymbolInfo>& symbols)
+        : tokens(tokens), symbols(symbols) {}
+
+    void Parse() {
+        size_t statement = 0;
+        int parenDepth = 0;
+
+        for (size_t i = 0; i < tokens.size(); ++i) {
+            std::string_view t = tokens[i].text;
+            if (t == "(") { ++parenDepth; continue; }
+            if (t == ")") { if (parenDepth > 0) --parenDepth; continue; }
+            if (parenDepth > 0) continue;
+
+            if (t == "{") {
+                bool continuesStatement = false;
+                i = OpenBrace(statement, i, continuesStatement);
+                if (!continuesStatement) statement = i + 1;
+            } else if (t == "}") {
+                if (!scopes.empty()) {
+                    pendingTypedef = scopes.back().typedefName;
+                    scopes.pop_back();
+                }
+                statement = i + 1;
+            } else if (t == ";") {
+                EndStatement(statement, i);
+                pendingTypedef = false;
+                statement = i + 1;
+            } else if (t == ":" && i == statement + 1 &&
+                       (Is(statement, "public") || Is(statement, "private") ||
+                        Is(statement, "protected") || Is(statement, "signals") ||
+                        Is(statement, "slots"))) {
+                statement = i + 1;
+            }
+        }
+    }
+
+private:
+    struct Scope {
+        std::string name;               // Empty for transparent scopes (extern "C", anonymous)
+        bool isClass = false;
+        bool typedefName = false;       // typedef struct {...} Name;
+    };
+
+    bool Is(size_t index, std::string_view text) const {
+        return index < tokens.size() && tokens[index].text == text;
+    }
+
+    std::string Container() const {
+        std::string result;
+        for (const auto& scope : scopes) {
+            if (scope.name.empty()) continue;
+            if (!result.empty()) result += "::";
+            result += scope.name;
+        }
+        return result;
+    }
+
+    bool InClass() const {
+        return !scopes.empty() && scopes.back().isClass;
+    }
+
+    void Emit(std::string name, SymbolKind kind, int line, std::string container, bool isDefinition = true) {
+        SymbolInfo symbol;
+        symbol.name = std::move(name);
+        symbol.container = std::move(container);
+        symbol.kind = kind;
+        symbol.line = line;
+        symbol.isDefinition = isDefinition;
+        symbols.push_back(std::move(symbol));
+    }
+
+    size_t MatchForward(size_t open, std::string_view openText, std::string_view closeText, size_t end) const {
+        int depth = 0;
+        for (size_t i = open; i < end; ++i) {
+            if (tokens[i].text == openText) ++depth;
+            else if (tokens[i].text == closeText && --depth == 0) return i;
+        }
+        return end;
+    }
+
+    size_t SkipBlock(size_t open) const {
+        return MatchForward(open, "{", "}", tokens.size());
+    }
+
+    /**
+     * @brief First token after template<...> / attribute prefixes
+     */
+    size_t SkipPrefix(size_t begin, size_t end) const {
+        size_t i = begin;
+        while (i < end) {
+            if (Is(i, "template") && Is(i + 1, "<")) {
+                i = MatchForward(i + 1, "<", ">", end) + 1;
+            } else if (Is(i, "[") && Is(i + 1, "[")) {
+                i = MatchForward(i, "[", "]", end) + 1;
+            } else if (Is(i, "export") || Is(i, "inline") || Is(i, "static") || Is(i, "constexpr")) {
+                ++i;
+            } else {
+                break;
+            }
+        }
+        return i;
+    }
+
+    /**
+     * @brief Index of the first '(' at depth 0 that is not part of an attribute
+     */
+    size_t FindParameterList(size_t begin, size_t end) const {
+        for (size_t i = begin; i < end; ++i) {
+            if (tokens[i].identifier && IsAttributeKeyword(tokens[i].text) && Is(i + 1, "(")) {
+                i = MatchForward(i + 1, "(", ")", end);
+                continue;
+            }
+            if (Is(i, "operator")) {
+                // operator=(...), operator()(...): skip the operator's own tokens
+                size_t j = i + 1;
+                if (Is(j, "(") && Is(j + 1, ")")) j += 2;
+                while (j < end && !Is(j, "(")) ++j;
+                return j;
+            }
+            if (Is(i, "=")) return end;
+            if (Is(i, "(")) return i;
+        }
+        return end;
+    }
+
+    bool HasTopLevel(size_t begin, size_t end, std::string_view text) const {
+        int depth = 0;
+        for (size_t i = begin; i < end; ++i) {
+            std::string_view t = tokens[i].text;
+            if (t == "(" || t == "[") ++depth;
+            else if (t == ")" || t == "]") --depth;
+            else if (depth == 0 && t == text) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Describe a function head ending at end (exclusive)
+     * @return false if the statement is not a function declarator
+     */
+    bool ParseFunctionHead(size_t begin, size_t end, std::string& name, std::string& qualifier,
+                           int& line, bool& hasInitList) const {
+        size_t paren = FindParameterList(begin, end);
+        if (paren >= end || paren == begin) return false;
+
+        // operator overloads: the name spans several tokens
+        for (size_t i = begin; i < paren; ++i) {
+            if (Is(i, "operator")) {
+                name = "operator";
+                size_t j = i + 1;
+                if (Is(j, "(") && Is(j + 1, ")")) {
+                    name += "()";
+                    j += 2;
+                } else {
+                    for (; j < end && !Is(j, "("); ++j) {
+                        if (tokens[j].identifier) name += ' ';  // operator bool, operator new
+                        name += tokens[j].text;
+                    }
+                }
+                if (!Is(j, "(")) return false;
+                paren = j;
+                line = tokens[i].line;
+                QualifierBefore(i, begin, qualifier);
+                hasInitList = HasInitList(paren, end);
+                return true;
+            }
+        }
+
+        size_t nameIndex = paren - 1;
+        if (!tokens[nameIndex].identifier || IsNonFunctionKeyword(tokens[nameIndex].text)) return false;
+        name = std::string(tokens[nameIndex].text);
+        line = tokens[nameIndex].line;
+        if (nameIndex > begin && Is(nameIndex - 1, "~")) {
+            name = "~" + name;
+            --nameIndex;
+        }
+        QualifierBefore(nameIndex, begin, qualifier);
+        hasInitList = HasInitList(paren, end);
+        return true;
+    }
+
+    /**
+     * @brief Collect A::B:: in front of a name
+     */
+    void QualifierBefore(size_t nameIndex, size_t begin, std::string& qualifier) const {
+        std::vector<std::string_view> parts;
+        size_t i = nameIndex;
+        while (i >= begin + 2 && Is(i - 1, "::")) {
+            size_t j = i - 2;
+            if (Is(j, ">")) {
+                // Skip template arguments backwards
+                int depth = 0;
+                while (j > begin) {
+                    if (Is(j, ">")) ++depth;
+                    else if (Is(j, "<") && --depth == 0) break;
+                    --j;
+                }
+                if (j == begin) break;
+                --j;
+            }
+            if (!tokens[j].identifier) break;
+            parts.push_back(tokens[j].text);
+            i = j;
+        }
+        qualifier.clear();
+        for (auto it = parts.rbegin(); it != parts.rend(); ++it) {
+            if (!qualifier.empty()) qualifier += "::";
+            qualifier += *it;
+        }
+    }
+
+    bool HasInitList(size_t paren, size_t end) const {
+        size_t close = MatchForward(paren, "(", ")", end);
+        for (size_t i = close + 1; i < end; ++i) {
+            if (Is(i, ":")) return true;
+        }
+        return false;
+    }
+
+    std::string QualifiedContainer(const std::string& qualifier) const {
+        std::string container = Container();
+        if (qualifier.empty()) return container;
+        return container.empty() ? qualifier : container + "::" + qualifier;
+    }
+
+    /**
+     * @brief Handle a '{' at statement level
+     * @return Index of the last token consumed
+     */
+    size_t OpenBrace(size_t begin, size_t brace, bool& continuesStatement) {
+        size_t first = SkipPrefix(begin, brace);
+
+        // namespace a::b {
+        if (Is(first, "namespace")) {
+            std::string name;
+            for (size_t i = first + 1; i < brace; ++i) {
+                if (tokens[i].identifier && tokens[i].text != "inline") name += tokens[i].text;
+                else if (Is(i, "::")) name += "::";
+            }
+            if (!name.empty()) Emit(name, SymbolKind::Namespace, tokens[first].line, Container());
+            scopes.push_back({ name, false, false });
+            return brace;
+        }
+
+        // extern "C" {
+        if (Is(first, "extern") && Is(first + 1, "\"") && first + 2 == brace) {
+            scopes.push_back({ "", false, false });
+            return brace;
+        }
+
+        // Brace initializers and lambdas: part of the current statement
+        if (HasTopLevel(first, brace, "=")) {
+            continuesStatement = true;
+            return SkipBlock(brace);
+        }
+
+        // class / struct / union / enum
+        bool isTypedef = Is(first, "typedef");
+        size_t keyword = isTypedef ? first + 1 : first;
+        std::string_view kw = keyword < brace ? tokens[keyword].text : std::string_view();
+        if (kw == "class" || kw == "struct" || kw == "union" || kw == "enum") {
+            SymbolKind kind = kw == "class" ? SymbolKind::Class :
+                              kw == "struct" ? SymbolKind::Struct :
+                              kw == "union" ? SymbolKind::Union : SymbolKind::Enum;
+            std::string name;
+            int line = tokens[keyword].line;
+            for (size_t i = keyword + 1; i < brace; ++i) {
+                std::string_view t = tokens[i].text;
+                if (t == ":" || t == "<") break;
+                if (t == "(") { i = MatchForward(i, "(", ")", brace); continue; }
+                if (tokens[i].identifier && t != "final" && t != "class" && t != "struct" &&
+                    !IsAttributeKeyword(t)) {
+                    name = std::string(t);
+                    line = tokens[i].line;
+                }
+            }
+            if (!name.empty()) Emit(name, kind, line, Container());
+            scopes.push_back({ name, kind != SymbolKind::Enum, isTypedef });
+            return brace;
+        }
+
+        // Function definition
+        std::string name;
+        std::string qualifier;
+        int line = 0;
+        bool hasInitList = false;
+        if (ParseFunctionHead(first, brace, name, qualifier, line, hasInitList)) {
+            // Constructor initializer with braces: member{value}
+            if (hasInitList && brace > 0 && (tokens[brace - 1].identifier || Is(brace - 1, ">"))) {
+                continuesStatement = true;
+                return SkipBlock(brace);
+            }
+            SymbolKind kind = (!qualifier.empty() || InClass()) ? SymbolKind::Method : SymbolKind::Function;
+            Emit(name, kind, line, QualifiedContainer(qualifier));
+            return SkipBlock(brace);
+        }
+
+        // Anything else (unknown macro blocks, control flow at file scope)
+        return SkipBlock(brace);
+    }
+
+    /**
+     * @brief Handle a statement terminated by ';'
+     */
+    void EndStatement(size_t begin, size_t end) {
+        if (begin >= end) return;
+
+        if (pendingTypedef) {
+            for (size_t i = end; i > begin; --i) {
+                if (tokens[i - 1].identifier) {
+                    Emit(std::string(tokens[i - 1].text), SymbolKind::Typedef, tokens[i - 1].line, Container());
+                    break;
+                }
+            }
+            return;
+        }
+
+        size_t first = SkipPrefix(begin, end);
+        if (first >= end) return;
+
+        if (Is(first, "typedef")) {
+            // typedef void (*Name)(int); or typedef Type Name;
+            for (size_t i = first; i + 2 < end; ++i) {
+                if (Is(i, "(") && Is(i + 1, "*") && tokens[i + 2].identifier) {
+                    Emit(std::string(tokens[i + 2].text), SymbolKind::Typedef, tokens[i + 2].line, Container());
+                    return;
+                }
+            }
+            for (size_t i = end; i > first; --i) {
+                if (tokens[i - 1].identifier) {
+                    Emit(std::string(tokens[i - 1].text), SymbolKind::Typedef, tokens[i - 1].line, Container());
+                    return;
+                }
+            }
+            return;
+        }
+
+        if (Is(first, "using")) {
+            if (first + 2 < end && tokens[first + 1].identifier && Is(first + 2, "=")) {
+                Emit(std::string(tokens[first + 1].text), SymbolKind::Typedef, tokens[first + 1].line, Container());
+            }
+            return;
+        }
+
+        if (!InClass()) return;
+        if (Is(first, "friend") || Is(first, "static_assert") || Is(first, "class") ||
+            Is(first, "struct") || Is(first, "enum") || Is(first, "union")) {
+            return;
+        }
+
+        // Method declaration inside a class body
+        std::string name;
+        std::string qualifier;
+        int line = 0;
+        bool hasInitList = false;
+        if (ParseFunctionHead(first, end, name, qualifier, line, hasInitList)) {
+            Emit(name, SymbolKind::Method, line, Container(), false);
+            return;
+        }
+
+        // Field: last identifier before '=', '[', ':' or '{'
+        size_t stop = end;
+        for (size_t i = first; i < end; ++i) {
+            std::string_view t = tokens[i].text;
+            if (t == "=" || t == "[" || t == ":" || t == "{") { stop = i; break; }
+        }
+        for (size_t i = stop; i > first; --i) {
+            if (tokens[i - 1].identifier) {
+                if (i - 1 == first) return; // A lone word is a macro invocation, not a field
+                Emit(std::string(tokens[i - 1].text), SymbolKind::Field, tokens[i - 1].line, Container());
+                return;
+            }
+        }
+    }
+
+    const std::vector<CppToken>& tokens;
+    std::vector<SymbolInfo>& symbols;
+    std::vector<Scope> scopes;
+    bool pendingTypedef = false;
+};
+
+} // anonymous namespace
+
+bool ScanCppSymbols(const std::string&, std::string_view content, std::vector<SymbolInfo>& symbols) {
+    std::vector<CppToken> tokens;
+    tokens.reserve(content.size() / 4);
+    TokenizeCpp(content, tokens, symbols);
+
+    CppTagParser parser(tokens, symbols);
+    parser.Parse();
+
+    std::stable_sort(symbols.begin(), symbols.end(), [](const SymbolInfo& a, const SymbolInfo& b) {
+        return a.line < b.line;
+    });
+    return true;
+}
+
+// ============================================================================
+// PLUGIN ADAPTERS
+// ============================================================================
+
+namespace {
+
+/**
+ * @brief One plugin instance per language, created on first use
+ *
+ * Plugin constructors probe the toolchain, so this runs on the index
+ * update thread rather than at registration. The plugins are not
+ * thread-safe and the index scans files in parallel: the caller holds
+ * the lock for as long as it uses the plugin.
+ */
+template <typename Plugin>
+Plugin& SharedPlugin(std::unique_lock<std::mutex>& lock) {
+    static Plugin plugin;
+    static std::mutex mutex;
+    lock = std::unique_lock<std::mutex>(mutex);
+    return plugin;
+}
+
+} // anonymous namespace
+
+void RegisterDefaultSymbolScanners(UCIDESymbolIndex& index) {
+    index.RegisterScanner({ "c", "h", "cpp", "cc", "cxx", "c++", "hpp", "hh", "hxx", "h++", "inl", "ipp", "tpp" },
+                          ScanCppSymbols);
+
+#ifdef ULTRAIDE_PLUGIN_JAVA_ENABLED
+    index.RegisterScanner({ "java" }, [](const std::string& path, std::string_view,
+                                         std::vector<SymbolInfo>& symbols) {
+        std::unique_lock<std::mutex> lock;
+        UCJavaPlugin& plugin = SharedPlugin<UCJavaPlugin>(lock);
+        JavaClassInfo info = plugin.ParseClassInfo(path);
+        if (!info.name.empty()) {
+            SymbolInfo symbol;
+            symbol.name = info.name;
+            symbol.container = info.packageName;
+            symbol.kind = info.isInterface ? SymbolKind::Interface :
+                          info.isEnum ? SymbolKind::Enum : SymbolKind::Class;
+            symbols.push_back(std::move(symbol));
+        }
+        for (const auto& method : plugin.GetMethods(path)) {
+            SymbolInfo symbol;
+            symbol.name = method.name;
+            symbol.container = method.className.empty() ? info.name : method.className;
+            symbol.kind = SymbolKind::Method;
+            symbol.line = method.startLine;
+            symbols.push_back(std::move(symbol));
+        }
+        return true;
+    });
+#endif
+
+#ifdef ULTRAIDE_PLUGIN_LUA_ENABLED
+    index.RegisterScanner({ "lua" }, [](const std::string& path, std::string_view,
+                                        std::vector<SymbolInfo>& symbols) {
+        std::unique_lock<std::mutex> lock;
+        for (const auto& function : SharedPlugin<UCLuaPlugin>(lock).ScanFunctions(path)) {
+            SymbolInfo symbol;
+            symbol.name = function.name;
+            symbol.container = function.parentTable;
+            symbol.kind = function.isMethod || !function.parentTable.empty() ?
+                          SymbolKind::Method : SymbolKind::Function;
+            symbol.line = function.startLine;
+            symbols.push_back(std::move(symbol));
+        }
+        return true;
+    });
+#endif
+
+#ifdef ULTRAIDE_PLUGIN_FORTRAN_ENABLED
+    index.RegisterScanner({ "f", "for", "ftn", "f77", "f90", "f95", "f03", "f08" },
+                          [](const std::string& path, std::string_view, std::vector<SymbolInfo>& symbols) {
+        std::unique_lock<std::mutex> lock;
+        for (const auto& unit : SharedPlugin<UCFortranPlugin>(lock).ScanProgramUnits(path)) {
+            SymbolInfo symbol;
+            symbol.name = unit.name;
+            switch (unit.type) {
+                case FortranUnitType::Program:    symbol.kind = SymbolKind::Program; break;
+                case FortranUnitType::Module:
+                case FortranUnitType::Submodule:  symbol.kind = SymbolKind::Module; break;
+                case FortranUnitType::Subroutine: symbol.kind = SymbolKind::Subroutine; break;
+                case FortranUnitType::Function:   symbol.kind = SymbolKind::Function; break;
+                case FortranUnitType::BlockData:  symbol.kind = SymbolKind::Variable; break;
+            }
+            symbol.line = unit.startLine;
+            symbols.push_back(std::move(symbol));
+        }
+        return true;
+    });
+#endif
+
+#ifdef ULTRAIDE_PLUGIN_GO_ENABLED
+    index.RegisterScanner({ "go" }, [](const std::string& path, std::string_view,
+                                       std::vector<SymbolInfo>& symbols) {
+        std::unique_lock<std::mutex> lock;
+        UCGoPlugin& plugin = SharedPlugin<UCGoPlugin>(lock);
+        std::string package = plugin.GetPackageName(path);
+        for (const auto& type : plugin.ParseTypes(path)) {
+            SymbolInfo symbol;
+            symbol.name = type.name;
+            symbol.container = package;
+            symbol.kind = type.kind == "struct" ? SymbolKind::Struct :
+                          type.kind == "interface" ? SymbolKind::Interface : SymbolKind::Type;
+            symbol.line = type.line;
+            symbols.push_back(std::move(symbol));
+        }
+        for (const auto& function : plugin.ParseFunctions(path)) {
+            SymbolInfo symbol;
+            symbol.name = function.name;
+            symbol.container = function.isMethod ? function.receiver : package;
+            symbol.kind = function.isMethod ? SymbolKind::Method : SymbolKind::Function;
+            symbol.line = function.startLine;
+            symbols.push_back(std::move(symbol));
+        }
+        return true;
+    });
+#endif
+}
+
+} // namespace IDE
+} // namespace UltraCanvas
@@ -0,0 +1,37 @@
+// Apps/IDE/Project/UCIDESymbolScanners.h
+// Built-in symbol scanners and adapters for the language plugins
+// Version: 1.0.0
+// Last Modified: 2026-10-17
+// Author: UltraCanvas Framework / ULTRA IDE
+#pragma once
+
+#include "UCIDESymbolIndex.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace UltraCanvas {
+namespace IDE {
+
+/**
+ * @brief C/C++ tag extractor
+ *
+ * Single pass over a token stream that skips comments, string literals
+ * and function bodies. Records namespaces, classes/structs/unions/enums,
+ * function and method definitions, in-class method declarations and
+ * fields, typedef/using aliases and #define macros, with the enclosing
+ * class/namespace as container.
+ */
+bool ScanCppSymbols(const std::string& absolutePath, std::string_view content,
+                    std::vector<SymbolInfo>& symbols);
+
+/**
+ * @brief Register the C/C++ extractor and every enabled plugin scanner
+ *
+ * Plugin scanners (Java, Lua, Fortran, Go) are only available when the
+ * plugin is compiled in (ULTRAIDE_PLUGIN_*_ENABLED).
+ */
+void RegisterDefaultSymbolScanners(UCIDESymbolIndex& index);
+
+} // namespace IDE
+} // namespace UltraCanvas
@@ -0,0 +1,62 @@
+// Apps/IDE/Project/UCMappedFile.h
+// Read-only memory-mapped file wrapper
+// Version: 1.0.0
+// Last Modified: 2026-10-17
+// Author: UltraCanvas Framework / ULTRA IDE
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+namespace UltraCanvas {
+namespace IDE {
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ *
+ * Empty files map successfully with Size() == 0. Move-only.
+ */
+class UCMappedFile {
+public:
+    UCMappedFile() = default;
+    ~UCMappedFile();
+
+    UCMappedFile(const UCMappedFile&) = delete;
+    UCMappedFile& operator=(const UCMappedFile&) = delete;
+    UCMappedFile(UCMappedFile&& other) noexcept;
+    UCMappedFile& operator=(UCMappedFile&& other) noexcept;
+
+    /**
+     * @brief Map a file read-only
+     * @return true if the file was opened and mapped
+     */
+    bool Open(const std::string& path);
+
+    /**
+     * @brief Unmap and close
+     */
+    void Close();
+
+    bool IsOpen() const { return isOpen; }
+    const uint8_t* Data() const { return data; }
+    size_t Size() const { return size; }
+
+    std::string_view View() const {
+        return std::string_view(reinterpret_cast<const char*>(data), size);
+    }
+
+private:
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    bool isOpen = false;
+
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+} // namespace IDE
+} // namespace UltraCanvas
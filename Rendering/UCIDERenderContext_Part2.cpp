@@ -44,6 +44,10 @@ void UCIDERenderer::RenderProjectTree() {
     if (!renderContext || !ideLayout || !ideProjectTree) return;
     if (!ideLayout->IsPanelVisible(LayoutPanel::ProjectTree)) return;
     
+    // Pick up matches and git status published by the background workers
+    ideProjectTree->ProcessFilterResults();
+    ideProjectTree->ProcessVcsResults();
+    
     LayoutRegion region = ideLayout->GetPanelRegion(LayoutPanel::ProjectTree);
     
     // Background
@@ -53,17 +57,17 @@ void UCIDERenderer::RenderProjectTree() {
     // Set clipping
     // renderContext->SetClipRect(region.x, region.y, region.width, region.height);
     
-    // Render tree nodes
+    // Render only the rows on screen (scroll offset is in pixels)
     const auto& visibleNodes = ideProjectTree->GetVisibleNodes();
     const auto& style = ideProjectTree->GetStyle();
+    int scrollOffset = ideProjectTree->GetScrollOffset();
+    auto rows = ideProjectTree->GetOnScreenRows();
     
-    int y = region.y - ideProjectTree->GetScrollOffset() * style.rowHeight;
+    int y = region.y + rows.first * style.rowHeight - scrollOffset;
     int clipBottom = region.y + region.height;
     
-    for (const TreeNode* node : visibleNodes) {
-        if (y + style.rowHeight >= region.y && y < clipBottom) {
-            RenderTreeNode(node, y, clipBottom);
-        }
+    for (int row = rows.first; row < rows.second; ++row) {
+        RenderTreeNode(visibleNodes[row], y, clipBottom);
         y += style.rowHeight;
     }
     
@@ -73,7 +77,7 @@ void UCIDERenderer::RenderProjectTree() {
     // Render scrollbar if needed
     int contentHeight = ideProjectTree->GetContentHeight();
     if (contentHeight > region.height) {
-        RenderScrollbar(region, contentHeight, ideProjectTree->GetScrollOffset() * style.rowHeight);
+        RenderScrollbar(region, contentHeight, scrollOffset);
     }
 }
 
@@ -108,7 +112,7 @@ void UCIDERenderer::RenderTreeNode(const TreeNode* node, int& y, int clipBottom)
         if (node->IsFolder()) {
             fileIcon = node->isExpanded ? IDEIcon::FolderOpen : IDEIcon::FolderClosed;
         } else {
-            fileIcon = GetFileTypeIcon(GetFileExtension(node->name));
+            fileIcon = GetFileTypeIcon(GetFileExtension(std::string(node->name)));
         }
         
         RenderIcon(fileIcon, x, y + (style.rowHeight - style.iconSize) / 2, style.iconSize, themeColors.textPrimary);
@@ -116,7 +120,7 @@ void UCIDERenderer::RenderTreeNode(const TreeNode* node, int& y, int clipBottom)
     }
     
     // Node name
-    std::string displayName = node->name;
+    std::string displayName(node->name);
     if (!style.showFileExtensions && node->IsFile()) {
         size_t dotPos = displayName.rfind('.');
         if (dotPos != std::string::npos) {
@@ -125,6 +129,29 @@ void UCIDERenderer::RenderTreeNode(const TreeNode* node, int& y, int clipBottom)
     }
     
     uint32_t textColor = themeColors.textPrimary;
+    
+    // Version control decoration: name colour plus a status letter
+    switch (node->vcsStatus) {
+        case VcsFileStatus::Modified:
+            textColor = themeColors.warningColor;
+            if (node->IsFile()) displayName += "  M";
+            break;
+        case VcsFileStatus::Added:
+            textColor = themeColors.successColor;
+            displayName += "  A";
+            break;
+        case VcsFileStatus::Untracked:
+            textColor = themeColors.successColor;
+            displayName += "  U";
+            break;
+        case VcsFileStatus::Conflicted:
+            textColor = themeColors.errorColor;
+            displayName += "  !";
+            break;
+        default:
+            break;
+    }
+    
     if (node->isModified) {
         textColor = themeColors.warningColor;
         displayName += " •";
@@ -236,6 +236,13 @@ void UCIDEWindow::Update(float deltaTime) {
     
     // Update build manager
     buildManager->Update();
+    
+    // A project reopened from its snapshot is checked against the disk in
+    // the background; swap in the result once it is ready
+    if (currentProject && currentProject->IsRevalidating() &&
+        currentProject->ApplyRevalidation()) {
+        projectTree->Refresh();
+    }
 }
 
 void UCIDEWindow::Render() {
@@ -326,6 +333,7 @@ bool UCIDEWindow::OpenFile(const std::string& path) {
     // Setup editor callbacks
     editor->onTextChange = [this, path]() {
         layout->SetTabModified(path, true);
+        projectTree->SetFileModified(path, true);
         UpdateWindowTitle();
     };
     
@@ -338,6 +346,7 @@ bool UCIDEWindow::OpenFile(const std::string& path) {
     
     // Add tab
     layout->AddTab(path);
+    projectTree->SetFileOpen(path, true);
     
     // Store editor
     editors[path] = std::move(editor);
@@ -368,6 +377,7 @@ bool UCIDEWindow::SaveCurrentFile() {
     if (activeEditor->SaveFile()) {
         std::string path = activeEditor->GetFilePath();
         layout->SetTabModified(path, false);
+        projectTree->SetFileModified(path, false);  // Re-checks its VCS status
         UpdateWindowTitle();
         statusBar->ShowNotification("File saved", 2000);
         return true;
@@ -382,6 +392,7 @@ void UCIDEWindow::SaveAllFiles() {
         if (editor->IsModified()) {
             editor->SaveFile();
             layout->SetTabModified(pair.first, false);
+            projectTree->SetFileModified(pair.first, false);
         }
     }
     UpdateWindowTitle();
@@ -401,6 +412,7 @@ void UCIDEWindow::CloseCurrentFile() {
     
     // Remove tab
     layout->RemoveTab(path);
+    projectTree->SetFileOpen(path, false);
     
     // Remove editor
     editors.erase(path);